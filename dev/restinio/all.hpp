@@ -20,6 +20,7 @@
 #include <restinio/null_timer_manager.hpp>
 #include <restinio/null_logger.hpp>
 #include <restinio/ostream_logger.hpp>
+#include <restinio/async_logger.hpp>
 #include <restinio/uri_helpers.hpp>
 #include <restinio/cast_to.hpp>
 #include <restinio/value_or.hpp>
@@ -0,0 +1,405 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Stuff related to fixed-size chain of asynchronous request-handlers.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/request_handler.hpp>
+
+#include <restinio/impl/header_helpers.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <array>
+#include <functional>
+
+namespace restinio
+{
+
+namespace async_chain
+{
+
+//
+// stage_status_t
+//
+/*!
+ * @brief A result of a stage of asynchronous chain.
+ *
+ * @since v.0.6.14
+ */
+enum class stage_status_t : std::uint8_t
+{
+	//! The stage has done its work. The next stage should be called.
+	next_stage,
+	//! The request is accepted. The chain stops.
+	accepted,
+	//! The request is rejected. The chain stops and the request
+	//! will be rejected.
+	rejected,
+	//! The stage continues its work asynchronously and will resume
+	//! the chain via continuation object later.
+	deferred
+};
+
+//! @name Helper funcs for working with stage_status_t.
+///@{
+RESTINIO_NODISCARD
+constexpr stage_status_t
+next_stage() noexcept
+{
+	return stage_status_t::next_stage;
+}
+
+RESTINIO_NODISCARD
+constexpr stage_status_t
+stage_accepted() noexcept
+{
+	return stage_status_t::accepted;
+}
+
+RESTINIO_NODISCARD
+constexpr stage_status_t
+stage_rejected() noexcept
+{
+	return stage_status_t::rejected;
+}
+
+RESTINIO_NODISCARD
+constexpr stage_status_t
+stage_deferred() noexcept
+{
+	return stage_status_t::deferred;
+}
+///@}
+
+//
+// fixed_size_chain_t
+//
+/*!
+ * @brief A holder of fixed-size chain of asynchronous handlers.
+ *
+ * Every stage of the chain is a functor with the following format:
+ * @code
+ * restinio::async_chain::stage_status_t
+ * stage(
+ * 	const actual_request_handle_t & req,
+ * 	const fixed_size_chain_t::stage_context_t & ctx);
+ * @endcode
+ *
+ * If a stage can make its decision synchronously it just returns
+ * next_stage(), stage_accepted() or stage_rejected(). In that case the
+ * chain works exactly like sync_chain::fixed_size_chain_t and no
+ * additional objects are created.
+ *
+ * If a stage has to wait for something (e.g. for a reply from an
+ * external authentification service) it gets a continuation object by
+ * `ctx.make_continuation()`, stores it somewhere and returns
+ * stage_deferred(). The request is treated as accepted by RESTinio.
+ * When the result is known the continuation has to be resumed with
+ * the result of the stage (from any thread). The rest of the chain is
+ * then executed on the connection's executor.
+ *
+ * If the chain is resumed and the request is rejected (or none of
+ * the rest stages accept it) then the "501 Not Implemented" response is
+ * sent, just like RESTinio does for requests rejected synchronously.
+ *
+ * Usage example:
+ * @code
+ * using chain_t = restinio::async_chain::fixed_size_chain_t<2>;
+ *
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using request_handler_t = chain_t;
+ * };
+ *
+ * restinio::async_chain::stage_status_t authentificator(
+ * 	const restinio::request_handle_t & req,
+ * 	const chain_t::stage_context_t & ctx )
+ * {
+ * 	auth_service.async_check( extract_token( req ),
+ * 		[continuation = ctx.make_continuation()]( bool valid ) {
+ * 			continuation.resume( valid ?
+ * 					restinio::async_chain::next_stage() :
+ * 					restinio::async_chain::stage_rejected() );
+ * 		} );
+ * 	return restinio::async_chain::stage_deferred();
+ * }
+ *
+ * restinio::async_chain::stage_status_t actual_handler(
+ * 	const restinio::request_handle_t & req,
+ * 	const chain_t::stage_context_t & )
+ * {
+ * 	... // Actual processing.
+ * 	return restinio::async_chain::stage_accepted();
+ * }
+ *
+ * restinio::run(
+ * 	on_thread_pool<my_traits>(16)
+ * 		.address(...)
+ * 		.port(...)
+ * 		.request_handler( authentificator, actual_handler )
+ * );
+ * @endcode
+ *
+ * @note
+ * A stage that creates a response for the request (via
+ * `req->create_response()`) must not return stage_deferred().
+ *
+ * @tparam Size The exact number of handlers in the chain.
+ *
+ * @tparam Extra_Data_Factory The type of extra-data-factory specified in
+ * the server's traits.
+ *
+ * @since v.0.6.14
+ */
+template<
+	std::size_t Size,
+	typename Extra_Data_Factory = no_extra_data_factory_t >
+class fixed_size_chain_t
+{
+public:
+	using actual_request_handle_t =
+			generic_request_handle_t< typename Extra_Data_Factory::data_t >;
+
+	//! An object for resuming the chain after a deferred stage.
+	/*!
+	 * Holds the request and its connection, so the connection (and
+	 * the chain itself) lives until the continuation is destroyed.
+	 */
+	class continuation_t
+	{
+		friend class fixed_size_chain_t;
+
+		const fixed_size_chain_t * m_chain;
+		actual_request_handle_t m_request;
+		impl::connection_handle_t m_connection;
+		std::size_t m_next_stage;
+
+		continuation_t(
+			const fixed_size_chain_t & chain,
+			actual_request_handle_t request,
+			impl::connection_handle_t connection,
+			std::size_t next_stage )
+			:	m_chain{ &chain }
+			,	m_request{ std::move(request) }
+			,	m_connection{ std::move(connection) }
+			,	m_next_stage{ next_stage }
+		{}
+
+	public:
+		//! Resume the chain with the result of the deferred stage.
+		/*!
+		 * Can be called from any thread. Should be called only once.
+		 *
+		 * @attention
+		 * stage_deferred() can't be used as @a status.
+		 */
+		void
+		resume( stage_status_t status ) const
+		{
+			if( stage_status_t::deferred == status )
+				throw exception_t{
+						"continuation can't be resumed with deferred status" };
+
+			if( stage_status_t::accepted == status )
+				// The request is handled by the deferred stage.
+				return;
+
+			m_connection->post_to_executor( [self = *this, status] {
+					self.m_chain->continue_on_executor( self, status );
+				} );
+		}
+	};
+
+	//! An object passed to every stage.
+	class stage_context_t
+	{
+		friend class fixed_size_chain_t;
+
+		const fixed_size_chain_t & m_chain;
+		const actual_request_handle_t & m_request;
+		const std::size_t m_next_stage;
+
+		stage_context_t(
+			const fixed_size_chain_t & chain,
+			const actual_request_handle_t & request,
+			std::size_t next_stage ) noexcept
+			:	m_chain{ chain }
+			,	m_request{ request }
+			,	m_next_stage{ next_stage }
+		{}
+
+	public:
+		//! Create a continuation object for the current stage.
+		/*!
+		 * Throws if the response for the request has already been created.
+		 */
+		RESTINIO_NODISCARD
+		continuation_t
+		make_continuation() const
+		{
+			auto & connection = impl::access_req_connection( *m_request );
+			if( !connection )
+				throw exception_t{
+						"unable to make continuation: connection already moved" };
+
+			return continuation_t{ m_chain, m_request, connection, m_next_stage };
+		}
+	};
+
+private:
+	using handler_holder_t = std::function<
+			stage_status_t(const actual_request_handle_t &, const stage_context_t &)
+	>;
+
+	std::array< handler_holder_t, Size > m_handlers;
+
+	template< std::size_t >
+	void
+	store_to() noexcept {}
+
+	template<
+		std::size_t Index,
+		typename Head,
+		typename... Tail >
+	void
+	store_to( Head && head, Tail && ...tail )
+	{
+		m_handlers[ Index ] =
+			[handler = std::move(head)]
+			( const actual_request_handle_t & req, const stage_context_t & ctx )
+				-> stage_status_t
+			{
+				return handler( req, ctx );
+			};
+
+		store_to< Index + 1u >( std::forward<Tail>(tail)... );
+	}
+
+	//! Run stages starting from @a first_stage.
+	/*!
+	 * Returns next_stage() if all stages were tried.
+	 */
+	RESTINIO_NODISCARD
+	stage_status_t
+	run_from(
+		std::size_t first_stage,
+		const actual_request_handle_t & req ) const
+	{
+		for( std::size_t i = first_stage; i != Size; ++i )
+		{
+			const stage_status_t result =
+					m_handlers[ i ]( req, stage_context_t{ *this, req, i + 1u } );
+
+			if( stage_status_t::next_stage != result )
+				// There is no need to try next handler.
+				return result;
+		}
+
+		return next_stage();
+	}
+
+	//! Continue the chain after deferred stage.
+	/*!
+	 * It's called on the connection's executor.
+	 */
+	void
+	continue_on_executor(
+		const continuation_t & cont,
+		stage_status_t status ) const noexcept
+	{
+		restinio::utils::suppress_exceptions_quietly( [&] {
+				try
+				{
+					if( stage_status_t::next_stage == status )
+						status = run_from( cont.m_next_stage, cont.m_request );
+				}
+				catch( const std::exception & )
+				{
+					status = stage_status_t::rejected;
+				}
+
+				switch( status )
+				{
+					case stage_status_t::next_stage:
+					case stage_status_t::rejected:
+						reject( cont );
+						break;
+
+					case stage_status_t::accepted:
+					case stage_status_t::deferred:
+						break;
+				}
+			} );
+	}
+
+	//! Send the negative response for a request that wasn't accepted.
+	static void
+	reject( const continuation_t & cont )
+	{
+		// If a response has been created by some stage then the
+		// connection is already moved out of the request object.
+		if( impl::access_req_connection( *cont.m_request ) )
+			cont.m_connection->write_response_parts(
+					cont.m_request->request_id(),
+					response_output_flags_t{
+						response_parts_attr_t::final_parts,
+						response_connection_attr_t::connection_close },
+					write_group_t{ impl::create_not_implemented_resp() } );
+	}
+
+public:
+	/*!
+	 * @attention
+	 * The default constructor is disabled. It's because a chain should
+	 * be initialized by handlers at the creation time.
+	 */
+	fixed_size_chain_t() = delete;
+
+	/*!
+	 * @brief Initializing constructor.
+	 *
+	 * @note
+	 * The number of parameters should match the value of @a Size
+	 * template parameter.
+	 */
+	template< typename... Handlers >
+	fixed_size_chain_t( Handlers && ...handlers )
+	{
+		static_assert( Size == sizeof...(handlers),
+				"Wrong number of parameters for the constructor of "
+				"fixed_size_chain_t<Size>. Exact `Size` parameters expected" );
+
+		store_to< 0u >( std::forward<Handlers>(handlers)... );
+	}
+
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	operator()( const actual_request_handle_t & req ) const
+	{
+		switch( run_from( 0u, req ) )
+		{
+			case stage_status_t::accepted:
+			case stage_status_t::deferred:
+				return request_accepted();
+
+			case stage_status_t::rejected:
+				return request_rejected();
+
+			case stage_status_t::next_stage:
+				break;
+		}
+
+		return request_not_handled();
+	}
+};
+
+} /* namespace async_chain */
+
+} /* namespace restinio */
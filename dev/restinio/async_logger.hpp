@@ -0,0 +1,621 @@
+/*
+	restinio
+*/
+
+/*!
+	Logger that writes messages to std::ostream on a background thread.
+
+	\since
+	v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/os.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace restinio
+{
+
+//
+// log_level_t
+//
+
+//! Levels of log messages.
+/*!
+	\since
+	v.0.6.14
+*/
+enum class log_level_t : int
+{
+	trace = 0,
+	info = 1,
+	warn = 2,
+	error = 3,
+	//! Disables all messages if used as a threshold.
+	off = 4
+};
+
+//
+// async_logger_settings_t
+//
+
+//! Settings for async_logger_t.
+/*!
+	\since
+	v.0.6.14
+*/
+class async_logger_settings_t
+{
+	public:
+		//! The minimal level of messages to be logged.
+		/*!
+			Can be changed at runtime by async_logger_t::level().
+		*/
+		//! \{
+		async_logger_settings_t &
+		level( log_level_t v ) & noexcept
+		{
+			m_level = v;
+			return *this;
+		}
+
+		async_logger_settings_t &&
+		level( log_level_t v ) && noexcept
+		{
+			return std::move( this->level( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		log_level_t
+		level() const noexcept { return m_level; }
+		//! \}
+
+		//! The capacity of a buffer for messages of one thread.
+		/*!
+			Is rounded up to a power of 2. Messages that don't fit into
+			the buffer are dropped (and counted).
+		*/
+		//! \{
+		async_logger_settings_t &
+		buffer_capacity( std::size_t v ) &
+		{
+			if( !v )
+				throw exception_t{ "buffer_capacity can't be 0" };
+
+			m_buffer_capacity = v;
+			return *this;
+		}
+
+		async_logger_settings_t &&
+		buffer_capacity( std::size_t v ) &&
+		{
+			return std::move( this->buffer_capacity( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		buffer_capacity() const noexcept { return m_buffer_capacity; }
+		//! \}
+
+		//! The interval between writes to the output stream.
+		//! \{
+		async_logger_settings_t &
+		flush_interval( std::chrono::milliseconds v ) & noexcept
+		{
+			m_flush_interval = v;
+			return *this;
+		}
+
+		async_logger_settings_t &&
+		flush_interval( std::chrono::milliseconds v ) && noexcept
+		{
+			return std::move( this->flush_interval( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::chrono::milliseconds
+		flush_interval() const noexcept { return m_flush_interval; }
+		//! \}
+
+	private:
+		log_level_t m_level{ log_level_t::info };
+		std::size_t m_buffer_capacity{ 4096u };
+		std::chrono::milliseconds m_flush_interval{ 20 };
+};
+
+namespace impl
+{
+
+namespace async_logger_details
+{
+
+//
+// record_t
+//
+
+//! One log message.
+struct record_t
+{
+	std::chrono::system_clock::time_point m_when;
+	log_level_t m_level{ log_level_t::info };
+	std::string m_message;
+};
+
+//
+// ring_buffer_t
+//
+
+//! Single-producer single-consumer lock-free buffer for log records.
+/*!
+	The producer is the thread that logs messages. The consumer is
+	any thread that holds the drain lock of the logger.
+*/
+class ring_buffer_t
+{
+	public:
+		explicit ring_buffer_t( std::size_t capacity )
+			:	m_records( round_up_capacity( capacity ) )
+			,	m_mask{ m_records.size() - 1u }
+		{}
+
+		//! Try to store a record.
+		/*!
+			\return false if the buffer is full.
+		*/
+		bool
+		try_push( record_t && record ) noexcept
+		{
+			const auto tail = m_tail.load( std::memory_order_relaxed );
+			if( tail - m_head.load( std::memory_order_acquire ) >
+					m_mask )
+			{
+				m_dropped.fetch_add( 1u, std::memory_order_relaxed );
+				return false;
+			}
+
+			auto & slot = m_records[ tail & m_mask ];
+			slot.m_when = record.m_when;
+			slot.m_level = record.m_level;
+			// Doesn't throw because std::string's move assignment is noexcept.
+			slot.m_message = std::move( record.m_message );
+
+			m_tail.store( tail + 1u, std::memory_order_release );
+			return true;
+		}
+
+		//! Move all available records to @a to.
+		void
+		drain( std::vector< record_t > & to )
+		{
+			auto head = m_head.load( std::memory_order_relaxed );
+			const auto tail = m_tail.load( std::memory_order_acquire );
+			for( ; head != tail; ++head )
+				to.push_back( std::move( m_records[ head & m_mask ] ) );
+
+			m_head.store( head, std::memory_order_release );
+		}
+
+		//! Get and reset the count of dropped records.
+		RESTINIO_NODISCARD
+		std::uint64_t
+		take_dropped() noexcept
+		{
+			return m_dropped.exchange( 0u, std::memory_order_relaxed );
+		}
+
+		//! Is the owner of the logger still alive?
+		/*!
+			Is used for cleanup of thread-local references to buffers.
+		*/
+		std::atomic< bool > m_owner_alive{ true };
+
+	private:
+		std::vector< record_t > m_records;
+		const std::size_t m_mask;
+
+		//! The index of the first record to be consumed.
+		/*!
+			Placed in a separate cache line from m_tail to avoid
+			false sharing between producer and consumer.
+		*/
+		alignas( 64 ) std::atomic< std::size_t > m_head{ 0u };
+		//! The index of the next record to be produced.
+		alignas( 64 ) std::atomic< std::size_t > m_tail{ 0u };
+
+		std::atomic< std::uint64_t > m_dropped{ 0u };
+
+		RESTINIO_NODISCARD
+		static std::size_t
+		round_up_capacity( std::size_t capacity ) noexcept
+		{
+			std::size_t result = 1u;
+			while( result < capacity )
+				result <<= 1u;
+			return result;
+		}
+};
+
+using ring_buffer_shptr_t = std::shared_ptr< ring_buffer_t >;
+
+//
+// thread_buffers_t
+//
+
+//! Buffers of the current thread for all alive loggers.
+/*!
+	Every logger has a unique id, so a buffer of a destroyed logger
+	can't be used by a new logger created at the same address.
+*/
+struct thread_buffers_t
+{
+	std::vector< std::pair< std::uint64_t, ring_buffer_shptr_t > > m_buffers;
+
+	RESTINIO_NODISCARD
+	static thread_buffers_t &
+	instance() noexcept
+	{
+		static thread_local thread_buffers_t buffers;
+		return buffers;
+	}
+
+	RESTINIO_NODISCARD
+	ring_buffer_t *
+	find( std::uint64_t logger_id ) const noexcept
+	{
+		for( const auto & b : m_buffers )
+			if( logger_id == b.first )
+				return b.second.get();
+
+		return nullptr;
+	}
+
+	void
+	add( std::uint64_t logger_id, ring_buffer_shptr_t buffer )
+	{
+		// Buffers of destroyed loggers aren't needed anymore.
+		m_buffers.erase(
+				std::remove_if( m_buffers.begin(), m_buffers.end(),
+					[]( const auto & b ) { return !b.second->m_owner_alive.load(); } ),
+				m_buffers.end() );
+
+		m_buffers.emplace_back( logger_id, std::move( buffer ) );
+	}
+};
+
+RESTINIO_NODISCARD
+inline std::uint64_t
+next_logger_id() noexcept
+{
+	static std::atomic< std::uint64_t > counter{ 0u };
+	return ++counter;
+}
+
+RESTINIO_NODISCARD
+inline const char *
+level_tag( log_level_t level ) noexcept
+{
+	switch( level )
+	{
+		case log_level_t::trace: return "TRACE";
+		case log_level_t::info: return " INFO";
+		case log_level_t::warn: return " WARN";
+		case log_level_t::error: return "ERROR";
+		case log_level_t::off: break;
+	}
+
+	return "  OFF";
+}
+
+} /* namespace async_logger_details */
+
+} /* namespace impl */
+
+//
+// async_logger_t
+//
+
+//! Logger that writes to std::ostream on a background thread.
+/*!
+	A thread that logs a message doesn't format a timestamp and doesn't
+	write to the stream. It only stores the message into its own
+	lock-free buffer. A background thread takes messages from all
+	buffers and writes them to the stream by batches.
+
+	If a buffer is full the message is dropped. The count of dropped
+	messages is reported into the log by the background thread.
+
+	Messages with level less than the current threshold are ignored
+	(message builders aren't called). Messages with level less than
+	\a Min_Level are removed at compile time.
+
+	Usage example:
+	\code
+	struct my_traits : public restinio::default_traits_t {
+		// Trace messages are removed at compile time.
+		using logger_t = restinio::async_logger_t< restinio::log_level_t::info >;
+	};
+	...
+	restinio::run(
+		restinio::on_thread_pool< my_traits >( 4 )
+			.logger( std::cerr,
+				restinio::async_logger_settings_t{}
+					.level( restinio::log_level_t::warn ) )
+			...
+	);
+	\endcode
+
+	\since
+	v.0.6.14
+*/
+template< log_level_t Min_Level = log_level_t::trace >
+class async_logger_t
+{
+	using record_t = impl::async_logger_details::record_t;
+	using ring_buffer_t = impl::async_logger_details::ring_buffer_t;
+	using ring_buffer_shptr_t = impl::async_logger_details::ring_buffer_shptr_t;
+
+	public:
+		async_logger_t( const async_logger_t & ) = delete;
+		async_logger_t & operator = ( const async_logger_t & ) = delete;
+
+		async_logger_t(
+			async_logger_settings_t settings = async_logger_settings_t{} )
+			:	async_logger_t{ std::cout, std::move( settings ) }
+		{}
+
+		async_logger_t(
+			std::ostream & out,
+			async_logger_settings_t settings = async_logger_settings_t{} )
+			:	m_out{ &out }
+			,	m_settings{ std::move( settings ) }
+			,	m_level{ m_settings.level() }
+		{
+			m_writer = std::thread{ [this] { writer_body(); } };
+		}
+
+		~async_logger_t()
+		{
+			{
+				std::lock_guard< std::mutex > lock{ m_writer_lock };
+				m_shutdown = true;
+			}
+			m_writer_cv.notify_one();
+			m_writer.join();
+
+			flush();
+
+			std::lock_guard< std::mutex > lock{ m_buffers_lock };
+			for( auto & b : m_buffers )
+				b->m_owner_alive = false;
+		}
+
+		template< typename Message_Builder >
+		void
+		trace( Message_Builder && msg_builder )
+		{
+			log_message< log_level_t::trace >( msg_builder );
+		}
+
+		template< typename Message_Builder >
+		void
+		info( Message_Builder && msg_builder )
+		{
+			log_message< log_level_t::info >( msg_builder );
+		}
+
+		template< typename Message_Builder >
+		void
+		warn( Message_Builder && msg_builder )
+		{
+			log_message< log_level_t::warn >( msg_builder );
+		}
+
+		template< typename Message_Builder >
+		void
+		error( Message_Builder && msg_builder )
+		{
+			log_message< log_level_t::error >( msg_builder );
+		}
+
+		//! Get the current threshold.
+		RESTINIO_NODISCARD
+		log_level_t
+		level() const noexcept
+		{
+			return m_level.load( std::memory_order_relaxed );
+		}
+
+		//! Change the current threshold.
+		void
+		level( log_level_t v ) noexcept
+		{
+			m_level.store( v, std::memory_order_relaxed );
+		}
+
+		//! The total count of dropped messages.
+		RESTINIO_NODISCARD
+		std::uint64_t
+		dropped() const noexcept
+		{
+			return m_dropped.load( std::memory_order_relaxed );
+		}
+
+		//! Write all stored messages to the stream right now.
+		void
+		flush()
+		{
+			std::lock_guard< std::mutex > lock{ m_drain_lock };
+
+			std::uint64_t dropped = 0u;
+			{
+				std::lock_guard< std::mutex > buffers_lock{ m_buffers_lock };
+				for( auto & b : m_buffers )
+				{
+					b->drain( m_batch );
+					dropped += b->take_dropped();
+				}
+			}
+
+			write_batch( dropped );
+		}
+
+	private:
+		//! The unique id of the logger.
+		const std::uint64_t m_id{
+				impl::async_logger_details::next_logger_id() };
+
+		std::ostream * m_out;
+
+		const async_logger_settings_t m_settings;
+
+		//! The current threshold.
+		std::atomic< log_level_t > m_level;
+
+		//! The total count of dropped messages.
+		std::atomic< std::uint64_t > m_dropped{ 0u };
+
+		//! Lock for m_buffers.
+		/*!
+			Is acquired by a logging thread only on the first message
+			from that thread.
+		*/
+		std::mutex m_buffers_lock;
+		std::vector< ring_buffer_shptr_t > m_buffers;
+
+		//! Lock for consumers of buffers and for m_batch.
+		std::mutex m_drain_lock;
+		std::vector< record_t > m_batch;
+		std::string m_output;
+
+		std::mutex m_writer_lock;
+		std::condition_variable m_writer_cv;
+		bool m_shutdown{ false };
+		std::thread m_writer;
+
+		template< log_level_t Level, typename Message_Builder >
+		void
+		log_message( Message_Builder & msg_builder )
+		{
+			// Should be removed by the compiler if Level < Min_Level.
+			if( Level < Min_Level || Level < level() )
+				return;
+
+			auto * buffer = buffer_for_current_thread();
+			if( !buffer->try_push( record_t{
+					std::chrono::system_clock::now(), Level, msg_builder() } ) )
+				m_dropped.fetch_add( 1u, std::memory_order_relaxed );
+		}
+
+		RESTINIO_NODISCARD
+		ring_buffer_t *
+		buffer_for_current_thread()
+		{
+			auto & thread_buffers =
+					impl::async_logger_details::thread_buffers_t::instance();
+			if( auto * buffer = thread_buffers.find( m_id ) )
+				return buffer;
+
+			auto buffer = std::make_shared< ring_buffer_t >(
+					m_settings.buffer_capacity() );
+			{
+				std::lock_guard< std::mutex > lock{ m_buffers_lock };
+				m_buffers.push_back( buffer );
+			}
+			thread_buffers.add( m_id, buffer );
+
+			return buffer.get();
+		}
+
+		void
+		writer_body()
+		{
+			std::unique_lock< std::mutex > lock{ m_writer_lock };
+			while( !m_shutdown )
+			{
+				m_writer_cv.wait_for( lock, m_settings.flush_interval() );
+
+				lock.unlock();
+				try
+				{
+					flush();
+				}
+				catch( ... )
+				{
+					// There is no place to report a failure of the logger.
+				}
+				lock.lock();
+			}
+		}
+
+		//! Write messages from m_batch to the stream.
+		/*!
+			Must be called when m_drain_lock is acquired.
+		*/
+		void
+		write_batch( std::uint64_t dropped )
+		{
+			if( m_batch.empty() && !dropped )
+				return;
+
+			// Records from different threads are ordered by time.
+			std::stable_sort( m_batch.begin(), m_batch.end(),
+				[]( const record_t & a, const record_t & b ) {
+					return a.m_when < b.m_when;
+				} );
+
+			m_output.clear();
+			for( const auto & r : m_batch )
+				append_line( r.m_when, r.m_level, r.m_message );
+			m_batch.clear();
+
+			if( dropped )
+				append_line(
+						std::chrono::system_clock::now(),
+						log_level_t::warn,
+						fmt::format( "async_logger: {} message(s) dropped", dropped ) );
+
+			m_out->write( m_output.data(),
+					static_cast< std::streamsize >( m_output.size() ) );
+			m_out->flush();
+		}
+
+		void
+		append_line(
+			std::chrono::system_clock::time_point when,
+			log_level_t level,
+			const std::string & msg )
+		{
+			namespace stdchrono = std::chrono;
+
+			auto ms = stdchrono::duration_cast<
+					stdchrono::milliseconds >( when.time_since_epoch() );
+			std::time_t unix_time = stdchrono::duration_cast<
+					stdchrono::seconds >( ms ).count();
+
+			fmt::format_to(
+					std::back_inserter( m_output ),
+					"[{:%Y-%m-%d %H:%M:%S}.{:03d}] {}: {}\n",
+					make_localtime( unix_time ),
+					static_cast< int >( ms.count() % 1000u ),
+					impl::async_logger_details::level_tag( level ),
+					msg );
+		}
+};
+
+} /* namespace restinio */
@@ -0,0 +1,608 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief IP-blocker that uses lists of CIDR blocks.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/asio_include.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/string_view.hpp>
+#include <restinio/ip_blocker.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace restinio
+{
+
+namespace ip_blocker
+{
+
+namespace cidr_details
+{
+
+//
+// key_t
+//
+/*!
+ * @brief 128-bit key for an IP address.
+ *
+ * IPv4 addresses are represented as IPv4-mapped IPv6 addresses
+ * (`::ffff:a.b.c.d`). Because of that IPv4 rules are also applied to
+ * IPv4-mapped IPv6 addresses of incoming connections.
+ *
+ * @since v.0.6.14
+ */
+struct key_t
+{
+	std::uint64_t m_hi{ 0u };
+	std::uint64_t m_lo{ 0u };
+
+	static constexpr unsigned int bits = 128u;
+
+	RESTINIO_NODISCARD
+	static key_t
+	from_address( const asio_ns::ip::address & address ) noexcept
+	{
+		key_t result;
+		if( address.is_v4() )
+		{
+			result.m_hi = 0u;
+			result.m_lo = 0xffff00000000ull | address.to_v4().to_ulong();
+		}
+		else
+		{
+			const auto bytes = address.to_v6().to_bytes();
+			for( std::size_t i = 0u; i != 8u; ++i )
+				result.m_hi = (result.m_hi << 8u) | bytes[ i ];
+			for( std::size_t i = 8u; i != 16u; ++i )
+				result.m_lo = (result.m_lo << 8u) | bytes[ i ];
+		}
+
+		return result;
+	}
+
+	//! Get the value of a bit (the bit 0 is the most significant one).
+	RESTINIO_NODISCARD
+	unsigned int
+	bit( unsigned int index ) const noexcept
+	{
+		return index < 64u ?
+				static_cast<unsigned int>( (m_hi >> (63u - index)) & 1u ) :
+				static_cast<unsigned int>( (m_lo >> (127u - index)) & 1u );
+	}
+
+	//! Get a copy of the key with only first @a length bits kept.
+	RESTINIO_NODISCARD
+	key_t
+	masked( unsigned int length ) const noexcept
+	{
+		key_t result;
+		if( length >= 128u )
+			result = *this;
+		else if( length > 64u )
+		{
+			result.m_hi = m_hi;
+			result.m_lo = m_lo & ~(~std::uint64_t{} >> (length - 64u));
+		}
+		else if( length == 64u )
+			result.m_hi = m_hi;
+		else if( length > 0u )
+			result.m_hi = m_hi & ~(~std::uint64_t{} >> length);
+
+		return result;
+	}
+
+	//! Get the length of the common prefix of two keys.
+	RESTINIO_NODISCARD
+	static unsigned int
+	common_prefix_length( const key_t & a, const key_t & b ) noexcept
+	{
+		const auto hi = a.m_hi ^ b.m_hi;
+		if( hi )
+			return leading_zeros( hi );
+
+		const auto lo = a.m_lo ^ b.m_lo;
+		if( lo )
+			return 64u + leading_zeros( lo );
+
+		return 128u;
+	}
+
+private:
+	RESTINIO_NODISCARD
+	static unsigned int
+	leading_zeros( std::uint64_t v ) noexcept
+	{
+		unsigned int result = 0u;
+		for( std::uint64_t mask = std::uint64_t{1} << 63u;
+				!(v & mask); mask >>= 1u )
+			++result;
+
+		return result;
+	}
+};
+
+} /* namespace cidr_details */
+
+//
+// cidr_t
+//
+/*!
+ * @brief A block of IP addresses in CIDR notation.
+ *
+ * @since v.0.6.14
+ */
+class cidr_t
+{
+	asio_ns::ip::address m_address;
+	unsigned int m_prefix_length;
+
+public:
+	//! Initializing constructor.
+	/*!
+	 * @throw exception_t if @a prefix_length is too big for the address.
+	 */
+	cidr_t( asio_ns::ip::address address, unsigned int prefix_length )
+		:	m_address{ std::move(address) }
+		,	m_prefix_length{ prefix_length }
+	{
+		if( m_prefix_length > max_prefix_length() )
+			throw exception_t{ fmt::format(
+					"invalid prefix length for {}: {}",
+					m_address.to_string(), m_prefix_length ) };
+	}
+
+	//! Parse a CIDR block from a string.
+	/*!
+	 * Accepts strings like `10.0.0.0/8`, `2001:db8::/32`. If prefix
+	 * length is omitted then the block contains just one address.
+	 *
+	 * @throw exception_t if @a what has an invalid format.
+	 */
+	RESTINIO_NODISCARD
+	static cidr_t
+	parse( string_view_t what )
+	{
+		const auto slash_pos = what.find( '/' );
+		const auto address_part = what.substr( 0u, slash_pos );
+
+		asio_ns::error_code ec;
+		auto address = asio_ns::ip::make_address(
+				std::string{ address_part.data(), address_part.size() }, ec );
+		if( ec )
+			throw exception_t{ fmt::format(
+					"invalid address in CIDR block: {}", what ) };
+
+		unsigned int prefix_length = address.is_v4() ? 32u : 128u;
+		if( string_view_t::npos != slash_pos )
+		{
+			const auto length_part = what.substr( slash_pos + 1u );
+			if( length_part.empty() || length_part.size() > 3u )
+				throw exception_t{ fmt::format(
+						"invalid prefix length in CIDR block: {}", what ) };
+
+			prefix_length = 0u;
+			for( const char ch : length_part )
+			{
+				if( ch < '0' || ch > '9' )
+					throw exception_t{ fmt::format(
+							"invalid prefix length in CIDR block: {}", what ) };
+				prefix_length = prefix_length * 10u +
+						static_cast<unsigned int>( ch - '0' );
+			}
+		}
+
+		return cidr_t{ std::move(address), prefix_length };
+	}
+
+	RESTINIO_NODISCARD
+	const asio_ns::ip::address &
+	address() const noexcept { return m_address; }
+
+	RESTINIO_NODISCARD
+	unsigned int
+	prefix_length() const noexcept { return m_prefix_length; }
+
+private:
+	RESTINIO_NODISCARD
+	unsigned int
+	max_prefix_length() const noexcept
+	{
+		return m_address.is_v4() ? 32u : 128u;
+	}
+};
+
+//
+// cidr_rules_t
+//
+/*!
+ * @brief A set of allow/deny rules for CIDR blocks.
+ *
+ * Rules are stored in a path-compressed binary trie (PATRICIA trie).
+ * The lookup finds the longest (most specific) block that contains
+ * an address and returns its action. The default action is returned
+ * if there is no such block.
+ *
+ * Usage example:
+ * @code
+ * restinio::ip_blocker::cidr_rules_t rules{ restinio::ip_blocker::allow() };
+ * rules.deny( "10.0.0.0/8" );
+ * rules.allow( "10.1.2.0/24" );
+ * rules.deny( "2001:db8::/32" );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class cidr_rules_t
+{
+public:
+	explicit cidr_rules_t(
+		inspection_result_t default_result = inspection_result_t::allow )
+		:	m_default_result{ default_result }
+	{}
+
+	//! Add a rule for a CIDR block.
+	/*!
+	 * If there is already a rule for the same block it is replaced.
+	 */
+	void
+	add( const cidr_t & block, inspection_result_t result )
+	{
+		const unsigned int length = block.prefix_length() +
+				( block.address().is_v4() ? 96u : 0u );
+		insert(
+				cidr_details::key_t::from_address( block.address() )
+						.masked( length ),
+				length,
+				result );
+	}
+
+	//! Add a rule that allows connections from a CIDR block.
+	void
+	allow( string_view_t block )
+	{
+		add( cidr_t::parse( block ), inspection_result_t::allow );
+	}
+
+	//! Add a rule that denies connections from a CIDR block.
+	void
+	deny( string_view_t block )
+	{
+		add( cidr_t::parse( block ), inspection_result_t::deny );
+	}
+
+	//! Find the action for an address.
+	RESTINIO_NODISCARD
+	inspection_result_t
+	find( const asio_ns::ip::address & address ) const noexcept
+	{
+		const auto key = cidr_details::key_t::from_address( address );
+
+		auto result = m_default_result;
+		for( auto index = m_root; npos != index; )
+		{
+			const auto & n = m_nodes[ index ];
+			if( cidr_details::key_t::common_prefix_length( key, n.m_key ) <
+					n.m_length )
+				break;
+
+			if( n.m_has_rule )
+				result = n.m_result;
+
+			if( n.m_length >= cidr_details::key_t::bits )
+				break;
+
+			index = n.m_children[ key.bit( n.m_length ) ];
+		}
+
+		return result;
+	}
+
+	//! The number of rules.
+	RESTINIO_NODISCARD
+	std::size_t
+	size() const noexcept { return m_rules_count; }
+
+private:
+	static constexpr std::uint32_t npos = ~std::uint32_t{};
+
+	struct node_t
+	{
+		//! Prefix of the node (bits after m_length are zero).
+		cidr_details::key_t m_key;
+		//! The length of the prefix.
+		unsigned int m_length;
+		std::uint32_t m_children[ 2 ]{ npos, npos };
+		//! Does the node correspond to a rule?
+		/*!
+		 * Intermediate nodes created by splits have no rules.
+		 */
+		bool m_has_rule{ false };
+		inspection_result_t m_result{ inspection_result_t::allow };
+	};
+
+	inspection_result_t m_default_result;
+
+	//! Nodes of the trie.
+	/*!
+	 * Nodes refer to each other by indexes, so the trie is stored
+	 * in one block of memory.
+	 */
+	std::vector< node_t > m_nodes;
+	std::uint32_t m_root{ npos };
+	std::size_t m_rules_count{ 0u };
+
+	std::uint32_t
+	make_node(
+		const cidr_details::key_t & key,
+		unsigned int length )
+	{
+		if( m_nodes.size() >= npos )
+			throw exception_t{ "too many CIDR rules" };
+
+		node_t n;
+		n.m_key = key.masked( length );
+		n.m_length = length;
+		m_nodes.push_back( n );
+		return static_cast< std::uint32_t >( m_nodes.size() - 1u );
+	}
+
+	std::uint32_t
+	make_rule_node(
+		const cidr_details::key_t & key,
+		unsigned int length,
+		inspection_result_t result )
+	{
+		const auto index = make_node( key, length );
+		m_nodes[ index ].m_has_rule = true;
+		m_nodes[ index ].m_result = result;
+		++m_rules_count;
+		return index;
+	}
+
+	void
+	insert(
+		const cidr_details::key_t & key,
+		unsigned int length,
+		inspection_result_t result )
+	{
+		// Parent of the current node and the index of the link from it.
+		// npos for the parent means that the current node is the root.
+		std::uint32_t parent = npos;
+		unsigned int link = 0u;
+		std::uint32_t current = m_root;
+
+		const auto replace_link = [&]( std::uint32_t new_index ) {
+			if( npos == parent )
+				m_root = new_index;
+			else
+				m_nodes[ parent ].m_children[ link ] = new_index;
+		};
+
+		while( npos != current )
+		{
+			const auto node_key = m_nodes[ current ].m_key;
+			const auto node_length = m_nodes[ current ].m_length;
+
+			auto common = cidr_details::key_t::common_prefix_length(
+					key, node_key );
+			if( common > length ) common = length;
+			if( common > node_length ) common = node_length;
+
+			if( common < node_length )
+			{
+				// The current node should be placed under a new node.
+				std::uint32_t new_parent;
+				if( common == length )
+				{
+					// The new rule is a prefix of the current node.
+					new_parent = make_rule_node( key, length, result );
+				}
+				else
+				{
+					// Split the prefix of the current node.
+					new_parent = make_node( key, common );
+					const auto leaf = make_rule_node( key, length, result );
+					m_nodes[ new_parent ].m_children[ key.bit( common ) ] = leaf;
+				}
+
+				m_nodes[ new_parent ].m_children[ node_key.bit( common ) ] =
+						current;
+				replace_link( new_parent );
+				return;
+			}
+
+			if( length == node_length )
+			{
+				// There is already a node for that prefix.
+				auto & n = m_nodes[ current ];
+				if( !n.m_has_rule )
+					++m_rules_count;
+				n.m_has_rule = true;
+				n.m_result = result;
+				return;
+			}
+
+			parent = current;
+			link = key.bit( node_length );
+			current = m_nodes[ current ].m_children[ link ];
+		}
+
+		replace_link( make_rule_node( key, length, result ) );
+	}
+};
+
+//
+// cidr_ip_blocker_t
+//
+/*!
+ * @brief An IP-blocker that uses CIDR rules.
+ *
+ * Rules can be replaced at runtime by update(). A new set of rules
+ * is prepared separately and then published by an atomic replacement
+ * of a pointer to the current set of rules (RCU-style). inspect()
+ * doesn't acquire any locks: it registers itself in an atomic counter
+ * of readers and uses the set of rules that is current at that moment.
+ * update() waits while readers of the previous set of rules are
+ * finished and only then destroys the previous set.
+ *
+ * Usage example:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using ip_blocker_t = restinio::ip_blocker::cidr_ip_blocker_t;
+ * };
+ * ...
+ * auto blocker = std::make_shared< restinio::ip_blocker::cidr_ip_blocker_t >();
+ * restinio::run(
+ * 	restinio::on_thread_pool< my_traits >( 4 )
+ * 		.ip_blocker( blocker )
+ * 		...
+ * );
+ * ...
+ * // Somewhere in another thread.
+ * restinio::ip_blocker::cidr_rules_t rules;
+ * rules.deny( "192.168.0.0/16" );
+ * blocker->update( std::move(rules) );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class cidr_ip_blocker_t
+{
+	using rules_handle_t = std::shared_ptr< const cidr_rules_t >;
+
+	//! The current set of rules.
+	std::atomic< const rules_handle_t * > m_current;
+
+	//! Epoch of the set of rules.
+	/*!
+	 * It's incremented on every update. Readers are counted separately
+	 * for odd and even epochs, so update() waits only for readers
+	 * that could see the previous set of rules.
+	 */
+	std::atomic< std::size_t > m_epoch{ 0u };
+
+	//! Counters of active readers for even and odd epochs.
+	mutable std::atomic< std::size_t > m_readers[ 2 ]{};
+
+	//! Serializes update() calls.
+	std::mutex m_update_lock;
+
+	//! A reader of the current set of rules.
+	/*!
+	 * The set of rules can't be destroyed while a reader exists.
+	 */
+	class reader_t
+	{
+		std::atomic< std::size_t > & m_counter;
+		const rules_handle_t & m_rules;
+
+		static std::atomic< std::size_t > &
+		register_reader( const cidr_ip_blocker_t & owner ) noexcept
+		{
+			for(;;)
+			{
+				const auto parity = owner.m_epoch.load() & 1u;
+				auto & counter = owner.m_readers[ parity ];
+				++counter;
+				// If the epoch is changed then update() could miss
+				// this reader, so the registration is repeated.
+				if( parity == ( owner.m_epoch.load() & 1u ) )
+					return counter;
+				--counter;
+			}
+		}
+
+	public:
+		explicit reader_t( const cidr_ip_blocker_t & owner ) noexcept
+			:	m_counter{ register_reader( owner ) }
+			,	m_rules{ *owner.m_current.load() }
+		{}
+
+		reader_t( const reader_t & ) = delete;
+		reader_t & operator=( const reader_t & ) = delete;
+
+		~reader_t() noexcept
+		{
+			--m_counter;
+		}
+
+		RESTINIO_NODISCARD
+		const rules_handle_t &
+		rules() const noexcept { return m_rules; }
+	};
+
+public:
+	explicit cidr_ip_blocker_t( cidr_rules_t rules = cidr_rules_t{} )
+		:	m_current{ new rules_handle_t{
+				std::make_shared< const cidr_rules_t >( std::move(rules) ) } }
+	{}
+
+	cidr_ip_blocker_t( const cidr_ip_blocker_t & ) = delete;
+	cidr_ip_blocker_t & operator=( const cidr_ip_blocker_t & ) = delete;
+
+	~cidr_ip_blocker_t()
+	{
+		delete m_current.load();
+	}
+
+	//! Replace the current set of rules.
+	/*!
+	 * Returns when there are no readers of the previous set of rules.
+	 */
+	void
+	update( cidr_rules_t rules )
+	{
+		std::unique_ptr< const rules_handle_t > fresh{ new rules_handle_t{
+				std::make_shared< const cidr_rules_t >( std::move(rules) ) } };
+
+		std::lock_guard< std::mutex > lock{ m_update_lock };
+
+		std::unique_ptr< const rules_handle_t > previous{
+				m_current.exchange( fresh.release() ) };
+
+		// Readers registered after the change of the epoch see the new
+		// set of rules. Readers of the older epochs are already finished
+		// (the previous update waited for them).
+		const auto parity = m_epoch++ & 1u;
+		while( 0u != m_readers[ parity ].load() )
+			std::this_thread::yield();
+	}
+
+	//! Get the current set of rules.
+	RESTINIO_NODISCARD
+	rules_handle_t
+	rules() const noexcept
+	{
+		reader_t reader{ *this };
+		return reader.rules();
+	}
+
+	RESTINIO_NODISCARD
+	inspection_result_t
+	inspect( const incoming_info_t & info ) const noexcept
+	{
+		reader_t reader{ *this };
+		return reader.rules()->find( info.remote_endpoint().address() );
+	}
+};
+
+} /* namespace ip_blocker */
+
+} /* namespace restinio */
@@ -37,6 +37,15 @@
 	#define RESTINIO_FALLTHROUGH
 #endif
 
+/*!
+ * @brief Defined if C++20 coroutines can be used.
+ *
+ * @since v.0.6.14
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+	#define RESTINIO_HAS_COROUTINES
+#endif
+
 /*!
  * @brief A wrapper around static_assert for checking that an expression
  * is noexcept and execution of that expression
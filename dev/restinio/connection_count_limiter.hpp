@@ -10,13 +10,18 @@
 
 #pragma once
 
+#include <restinio/compiler_features.hpp>
+#include <restinio/common_types.hpp>
+#include <restinio/optional.hpp>
 #include <restinio/null_mutex.hpp>
 #include <restinio/default_strands.hpp>
 
 #include <restinio/utils/tagged_scalar.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
+#include <vector>
 #include <utility>
 
 namespace restinio
@@ -259,6 +264,176 @@ public:
 	}
 };
 
+/*!
+ * @brief Implementation of connection count limiter for multi-threading
+ * mode that doesn't lock a mutex on every connection.
+ *
+ * The count of active accepts and the count of active connections are
+ * used only as a sum. So the sum is held in a single atomic counter
+ * and the transition of an accept into a connection doesn't change it
+ * at all.
+ *
+ * A mutex is still used for the protection of pending socket's slots.
+ * But pending slots appear only when the limit is reached. The atomic
+ * count of pending slots allows to avoid locking of the mutex in
+ * decrement_parallel_connections() if there is no pending slots.
+ *
+ * @note
+ * A pending slot can be scheduled for a new accept attempt even if
+ * a free place is taken by another accept right after that. In that
+ * case the new call to accept_next() returns the slot to the list of
+ * pending slots.
+ *
+ * @note
+ * This is not Copyable nor Moveable type.
+ *
+ * @since v.0.6.14
+ */
+class atomic_limiter_t
+{
+	//! Mandatory pointer to the acceptor connected with this limiter.
+	not_null_pointer_t< acceptor_callback_iface_t > m_acceptor;
+
+	/*!
+	 * @brief The sum of active accepts and active connections.
+	 *
+	 * Incremented in accept_next() before the invocation of
+	 * acceptor_callback_iface_t::call_accept_now() and decremented
+	 * in decrement_parallel_connections().
+	 */
+	std::atomic< std::size_t > m_busy_slots{ 0u };
+
+	//! The limit for parallel connections.
+	const std::size_t m_max_parallel_connections;
+
+	//! Lock object for the protection of m_pending_indexes.
+	std::mutex m_pending_lock;
+
+	//! The count of items in m_pending_indexes.
+	/*!
+	 * Is changed only when m_pending_lock is acquired, but can be read
+	 * without acquiring the lock.
+	 */
+	std::atomic< std::size_t > m_pending_count{ 0u };
+
+	/*!
+	 * @brief The storage for holding pending socket's slots.
+	 *
+	 * @note
+	 * This storage is used as stack (LIFO working scheme).
+	 *
+	 * @attention
+	 * The capacity for that storage is preallocated in the constructor.
+	 * See the description of actual_limiter_t::m_pending_indexes.
+	 */
+	std::vector< std::size_t > m_pending_indexes;
+
+	RESTINIO_NODISCARD
+	bool
+	has_free_slots() const noexcept
+	{
+		return m_busy_slots.load() < m_max_parallel_connections;
+	}
+
+	//! Try to occupy a slot for a new accept.
+	RESTINIO_NODISCARD
+	bool
+	try_occupy_slot() noexcept
+	{
+		auto current = m_busy_slots.load();
+		while( current < m_max_parallel_connections )
+		{
+			if( m_busy_slots.compare_exchange_weak( current, current + 1u ) )
+				return true;
+		}
+
+		return false;
+	}
+
+	//! Get a pending index if there are free slots.
+	RESTINIO_NODISCARD
+	optional_t< std::size_t >
+	try_extract_pending_index() noexcept
+	{
+		if( !m_pending_count.load() || !has_free_slots() )
+			return nullopt;
+
+		std::lock_guard< std::mutex > lock{ m_pending_lock };
+
+		if( m_pending_indexes.empty() )
+			return nullopt;
+
+		const std::size_t pending_index = m_pending_indexes.back();
+		m_pending_indexes.pop_back();
+		m_pending_count.store( m_pending_indexes.size() );
+
+		return pending_index;
+	}
+
+public:
+	atomic_limiter_t(
+		not_null_pointer_t< acceptor_callback_iface_t > acceptor,
+		max_parallel_connections_t max_parallel_connections,
+		max_active_accepts_t max_pending_indexes )
+		:	m_acceptor{ acceptor }
+		,	m_max_parallel_connections{ max_parallel_connections.value() }
+	{
+		m_pending_indexes.reserve( max_pending_indexes.value() );
+	}
+
+	atomic_limiter_t( const atomic_limiter_t & ) = delete;
+	atomic_limiter_t( atomic_limiter_t && ) = delete;
+
+	void
+	increment_parallel_connections() noexcept
+	{
+		// An active accept becomes an active connection.
+		// The sum of them isn't changed.
+	}
+
+	// Note: this method is noexcept because it can be called from
+	// destructors.
+	void
+	decrement_parallel_connections() noexcept
+	{
+		// Expects that m_busy_slots is always greater than 0.
+		--m_busy_slots;
+
+		if( const auto index_to_activate = try_extract_pending_index() )
+		{
+			m_acceptor->schedule_next_accept_attempt( *index_to_activate );
+		}
+	}
+
+	/*!
+	 * This method either calls acceptor_callback_iface_t::call_accept_now()
+	 * or stores @a index into the internal storage.
+	 */
+	void
+	accept_next( std::size_t index ) noexcept
+	{
+		if( try_occupy_slot() )
+		{
+			m_acceptor->call_accept_now( index );
+			return;
+		}
+
+		{
+			std::lock_guard< std::mutex > lock{ m_pending_lock };
+			m_pending_indexes.push_back( index );
+			m_pending_count.store( m_pending_indexes.size() );
+		}
+
+		// A connection can be closed after the failed attempt to occupy
+		// a slot but before the index was stored. That connection
+		// doesn't see the index, so the index has to be rescheduled here.
+		if( const auto index_to_activate = try_extract_pending_index() )
+		{
+			m_acceptor->schedule_next_accept_attempt( *index_to_activate );
+		}
+	}
+};
+
 } /* namespace impl */
 
 /*!
@@ -332,16 +507,16 @@ public:
  * @brief Implementation of connection count limiter for multi-threading
  * mode.
  *
- * In multi-threading mode std::mutex is used for the protection of
- * limiter object.
+ * In multi-threading mode atomic counters are used for tracking
+ * the count of connections (see atomic_limiter_t).
  *
  * @since v.0.6.12
  */
 template<>
 class connection_count_limiter_t< default_strand_t >
-	:	public connection_count_limits::impl::actual_limiter_t< std::mutex >
+	:	public connection_count_limits::impl::atomic_limiter_t
 {
-	using base_t = connection_count_limits::impl::actual_limiter_t< std::mutex >;
+	using base_t = connection_count_limits::impl::atomic_limiter_t;
 
 public:
 	using base_t::base_t;
@@ -0,0 +1,446 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Support of C++20 coroutines in request handlers.
+ *
+ * This file is empty if the compiler doesn't support coroutines
+ * (see RESTINIO_HAS_COROUTINES).
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#if defined(RESTINIO_HAS_COROUTINES)
+
+#include <restinio/message_builders.hpp>
+#include <restinio/ostream_logger.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+namespace restinio
+{
+
+namespace coro
+{
+
+namespace impl
+{
+
+//! Type of a receiver of exceptions thrown by a coroutine after
+//! its first suspension.
+using exception_sink_t = std::function< void( std::exception_ptr ) >;
+
+//! The sink for coroutines that are being created on the current thread.
+inline const exception_sink_t *&
+current_exception_sink() noexcept
+{
+	static thread_local const exception_sink_t * sink = nullptr;
+	return sink;
+}
+
+//! Set the sink for coroutines created in the scope.
+class exception_sink_scope_t
+{
+	const exception_sink_t * m_previous;
+
+public:
+	explicit exception_sink_scope_t( const exception_sink_t & sink ) noexcept
+		:	m_previous{ std::exchange( current_exception_sink(), &sink ) }
+	{}
+
+	exception_sink_scope_t( const exception_sink_scope_t & ) = delete;
+	exception_sink_scope_t & operator=( const exception_sink_scope_t & ) = delete;
+
+	~exception_sink_scope_t()
+	{
+		current_exception_sink() = m_previous;
+	}
+};
+
+//! The logger for exceptions from coroutines if a user doesn't
+//! specify one.
+inline shared_ostream_logger_t &
+default_exception_logger()
+{
+	static shared_ostream_logger_t logger{ std::cerr };
+	return logger;
+}
+
+} /* namespace impl */
+
+//
+// handler_task_t
+//
+/*!
+ * @brief A type of coroutine that can be used as a request handler.
+ *
+ * The coroutine is started immediately when the request handler is
+ * called. If it completes without suspension then the value passed
+ * to `co_return` is returned to RESTinio. Otherwise RESTinio gets
+ * request_accepted() and the coroutine continues independently (it has
+ * to create a response for the request later).
+ *
+ * If the coroutine throws before its first suspension the exception
+ * is rethrown by handling_status(), so RESTinio handles it as an exception
+ * from an ordinary request handler. An exception thrown after the first
+ * suspension can't be propagated to RESTinio, it is passed to the
+ * logger specified for as_request_handler(). Such an exception is lost
+ * if the coroutine isn't created by as_request_handler().
+ *
+ * Usage example:
+ * @code
+ * restinio::coro::handler_task_t
+ * handler( restinio::request_handle_t req )
+ * {
+ * 	auto resp = req->create_response< restinio::chunked_output_t >();
+ * 	for( auto & part : huge_data )
+ * 	{
+ * 		resp.append_chunk( part );
+ * 		// Wait until the chunk is written to the socket.
+ * 		if( co_await restinio::coro::async_flush( resp ) )
+ * 			co_return restinio::request_accepted(); // Write error.
+ * 	}
+ * 	co_await restinio::coro::async_done( resp );
+ * 	co_return restinio::request_accepted();
+ * }
+ *
+ * restinio::run(
+ * 	restinio::on_this_thread()
+ * 		.port( 8080 )
+ * 		.request_handler( restinio::coro::as_request_handler( handler ) ) );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class handler_task_t
+{
+public:
+	struct promise_type
+	{
+		//! States of coroutine's frame.
+		enum class state_t : int { running, finished, detached };
+
+		std::atomic< state_t > m_state{ state_t::running };
+		request_handling_status_t m_status{ request_accepted() };
+
+		//! An exception thrown by the coroutine.
+		std::exception_ptr m_exception;
+
+		//! A receiver for exceptions thrown after the first suspension.
+		impl::exception_sink_t m_exception_sink;
+
+		promise_type()
+		{
+			if( const auto * sink = impl::current_exception_sink() )
+				m_exception_sink = *sink;
+		}
+
+		handler_task_t
+		get_return_object() noexcept
+		{
+			return handler_task_t{
+					std::coroutine_handle< promise_type >::from_promise( *this ) };
+		}
+
+		std::suspend_never initial_suspend() const noexcept { return {}; }
+
+		//! The frame stays alive only if the task object still exists.
+		struct final_awaiter_t
+		{
+			bool await_ready() const noexcept { return false; }
+
+			bool
+			await_suspend(
+				std::coroutine_handle< promise_type > h ) const noexcept
+			{
+				auto & promise = h.promise();
+
+				// If the task object is already detached the frame
+				// has to be destroyed automatically.
+				if( state_t::detached != promise.m_state.exchange(
+						state_t::finished, std::memory_order_acq_rel ) )
+					// The exception (if any) will be rethrown by
+					// handling_status().
+					return true;
+
+				if( promise.m_exception && promise.m_exception_sink )
+					restinio::utils::suppress_exceptions_quietly( [&] {
+							promise.m_exception_sink( promise.m_exception );
+						} );
+
+				return false;
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		final_awaiter_t final_suspend() const noexcept { return {}; }
+
+		void
+		return_value( request_handling_status_t status ) noexcept
+		{
+			m_status = status;
+		}
+
+		void
+		unhandled_exception() noexcept
+		{
+			m_exception = std::current_exception();
+		}
+	};
+
+	handler_task_t( const handler_task_t & ) = delete;
+	handler_task_t & operator=( const handler_task_t & ) = delete;
+
+	handler_task_t( handler_task_t && other ) noexcept
+		:	m_handle{ std::exchange( other.m_handle, nullptr ) }
+	{}
+
+	handler_task_t & operator=( handler_task_t && ) = delete;
+
+	~handler_task_t()
+	{
+		if( m_handle &&
+			promise_type::state_t::finished == m_handle.promise().m_state.exchange(
+					promise_type::state_t::detached, std::memory_order_acq_rel ) )
+		{
+			m_handle.destroy();
+		}
+	}
+
+	//! Get the result of request handling.
+	/*!
+	 * Returns the value from `co_return` if the coroutine is completed.
+	 * Returns request_accepted() if the coroutine is still running.
+	 *
+	 * @throw The exception thrown by the coroutine if it is completed
+	 * with an exception.
+	 */
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	handling_status() const
+	{
+		if( promise_type::state_t::finished ==
+				m_handle.promise().m_state.load( std::memory_order_acquire ) )
+		{
+			if( m_handle.promise().m_exception )
+				std::rethrow_exception( m_handle.promise().m_exception );
+
+			return m_handle.promise().m_status;
+		}
+
+		return request_accepted();
+	}
+
+private:
+	explicit handler_task_t(
+		std::coroutine_handle< promise_type > handle ) noexcept
+		:	m_handle{ handle }
+	{}
+
+	std::coroutine_handle< promise_type > m_handle;
+};
+
+//
+// as_request_handler
+//
+/*!
+ * @brief Make a request handler from a coroutine function.
+ *
+ * @a coroutine should be callable with a request handle and
+ * return handler_task_t.
+ *
+ * An exception thrown by the coroutine before its first suspension
+ * is propagated to RESTinio. An exception thrown after the first
+ * suspension is logged via @a logger. The @a logger should outlive
+ * all the coroutines created by the handler.
+ *
+ * @since v.0.6.14
+ */
+template< typename Coroutine, typename Logger >
+RESTINIO_NODISCARD
+auto
+as_request_handler( Coroutine coroutine, Logger & logger )
+{
+	return [coroutine = std::move(coroutine),
+			sink = impl::exception_sink_t{
+				[&logger]( std::exception_ptr ex ) {
+					restinio::utils::suppress_exceptions(
+							logger,
+							"coroutine request handler",
+							[&ex] { std::rethrow_exception( ex ); } );
+				} } ]( auto req )
+		-> request_handling_status_t
+	{
+		const impl::exception_sink_scope_t sink_scope{ sink };
+		return coroutine( std::move(req) ).handling_status();
+	};
+}
+
+/*!
+ * @brief Make a request handler from a coroutine function.
+ *
+ * Exceptions thrown by the coroutine after its first suspension
+ * are logged to std::cerr.
+ *
+ * @since v.0.6.14
+ */
+template< typename Coroutine >
+RESTINIO_NODISCARD
+auto
+as_request_handler( Coroutine coroutine )
+{
+	return as_request_handler(
+			std::move(coroutine), impl::default_exception_logger() );
+}
+
+namespace impl
+{
+
+//
+// write_awaiter_t
+//
+/*!
+ * @brief An awaiter for operations that accept write_status_cb_t.
+ *
+ * @a Starter is called in await_suspend() with a write_status_cb_t
+ * that resumes the coroutine. The callback is called on the connection's
+ * executor after the completion of the write, so the coroutine resumes
+ * right there, without additional posts.
+ *
+ * The callback can be called before the return from @a Starter (e.g.
+ * if the connection is already closed). In that case the coroutine isn't
+ * suspended at all.
+ *
+ * @since v.0.6.14
+ */
+template< typename Starter >
+class write_awaiter_t
+{
+	Starter m_starter;
+	std::coroutine_handle<> m_handle;
+	asio_ns::error_code m_result;
+	//! Set by the first of await_suspend() and callback that completes.
+	std::atomic< bool > m_rendezvous{ false };
+
+public:
+	explicit write_awaiter_t( Starter starter )
+		:	m_starter{ std::move(starter) }
+	{}
+
+	bool await_ready() const noexcept { return false; }
+
+	bool
+	await_suspend( std::coroutine_handle<> handle )
+	{
+		m_handle = handle;
+
+		m_starter( [this]( const asio_ns::error_code & ec ) {
+				m_result = ec;
+				if( m_rendezvous.exchange( true, std::memory_order_acq_rel ) )
+					// The coroutine is suspended already.
+					m_handle.resume();
+			} );
+
+		// If the callback is already called the coroutine continues.
+		return !m_rendezvous.exchange( true, std::memory_order_acq_rel );
+	}
+
+	//! Returns the result of write operation.
+	asio_ns::error_code
+	await_resume() const noexcept { return m_result; }
+};
+
+template< typename Starter >
+RESTINIO_NODISCARD
+write_awaiter_t< Starter >
+make_write_awaiter( Starter starter )
+{
+	return write_awaiter_t< Starter >{ std::move(starter) };
+}
+
+} /* namespace impl */
+
+//
+// async_flush
+//
+/*!
+ * @brief Flush ready data of a response and wait for its writing.
+ *
+ * Can be used for user_controlled_output_t and chunked_output_t
+ * responses. The result of `co_await` is the error code of
+ * the write operation.
+ *
+ * @since v.0.6.14
+ */
+template< typename Response_Builder >
+RESTINIO_NODISCARD
+auto
+async_flush( Response_Builder & resp )
+{
+	return impl::make_write_awaiter( [&resp]( write_status_cb_t cb ) {
+			resp.flush( std::move(cb) );
+		} );
+}
+
+//
+// async_done
+//
+/*!
+ * @brief Complete a response and wait for the writing of its last part.
+ *
+ * The result of `co_await` is the error code of the write operation.
+ *
+ * @since v.0.6.14
+ */
+template< typename Response_Builder >
+RESTINIO_NODISCARD
+auto
+async_done( Response_Builder & resp )
+{
+	return impl::make_write_awaiter( [&resp]( write_status_cb_t cb ) {
+			resp.done( std::move(cb) );
+		} );
+}
+
+//
+// async_send_message
+//
+/*!
+ * @brief Send a WebSocket message and wait for its writing.
+ *
+ * @a ws is a restinio::websocket::basic::ws_handle_t, @a msg is
+ * a restinio::websocket::basic::message_t. The result of `co_await` is
+ * the error code of the write operation.
+ *
+ * @since v.0.6.14
+ */
+template< typename Ws_Handle, typename Message >
+RESTINIO_NODISCARD
+auto
+async_send_message( const Ws_Handle & ws, Message msg )
+{
+	return impl::make_write_awaiter(
+		[&ws, msg = std::move(msg)]( write_status_cb_t cb ) mutable {
+			ws->send_message( std::move(msg), std::move(cb) );
+		} );
+}
+
+} /* namespace coro */
+
+} /* namespace restinio */
+
+#endif
@@ -30,6 +30,7 @@
 #include <map>
 #include <array>
 #include <vector>
+#include <cstdint>
 #include <cstring>
 
 namespace restinio
@@ -173,6 +174,15 @@ struct nothing_t {};
  * };
  * @endcode
  *
+ * A specialization for a container of characters can also have
+ * the following method:
+ * @code
+ * 	static void
+ * 	append_fragment( wrapped_type & to, string_view_t fragment );
+ * @endcode
+ * It is used (since v.0.6.14) for adding several characters at once
+ * instead of calling to_container() for every character.
+ *
  * @since v.0.6.6
  */
 template< typename T >
@@ -388,6 +398,17 @@ struct result_value_wrapper< std::basic_string< Char, Args... > >
 		to.append( what );
 	}
 
+	/*!
+	 * @brief Special method for adding several characters at once.
+	 *
+	 * @since v.0.6.14
+	 */
+	static void
+	append_fragment( wrapped_type & to, string_view_t fragment )
+	{
+		to.append( fragment.begin(), fragment.end() );
+	}
+
 	RESTINIO_NODISCARD
 	static result_type &&
 	unwrap_value( wrapped_type & v )
@@ -574,6 +595,154 @@ expected_digits(
 	return { min, max };
 }
 
+//
+// char_set_t
+//
+/*!
+ * @brief A set of characters that can be composed at compile-time.
+ *
+ * The set is stored as a 256-bit lookup table, so the check of
+ * a character is just a single table lookup regardless of the
+ * complexity of the set.
+ *
+ * Usage example:
+ * @code
+ * constexpr auto alpha = char_set_t::range('a', 'z') | char_set_t::range('A', 'Z');
+ * constexpr auto ident_chars = alpha | char_set_t::range('0', '9') | char_set_t::of("_-");
+ *
+ * auto p = produce<std::string>(
+ * 	repeat(1, N, symbol_from_set_p(ident_chars) >> to_container()) );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class char_set_t
+{
+	std::uint64_t m_bits[ 4 ];
+
+	RESTINIO_NODISCARD
+	static constexpr unsigned int
+	index_of( char ch ) noexcept
+	{
+		return static_cast<unsigned char>( ch );
+	}
+
+public:
+	//! Make an empty set.
+	constexpr char_set_t() noexcept : m_bits{ 0u, 0u, 0u, 0u } {}
+
+	//! Make a set that contains all characters from `[left, right]`.
+	RESTINIO_NODISCARD
+	static constexpr char_set_t
+	range( char left, char right ) noexcept
+	{
+		char_set_t result;
+		for( auto i = index_of( left ); i <= index_of( right ); ++i )
+			result.add( static_cast<char>( i ) );
+		return result;
+	}
+
+	//! Make a set that contains all characters from a string literal.
+	/*!
+	 * @note
+	 * The terminating zero of the literal isn't added to the set.
+	 */
+	template< std::size_t N >
+	RESTINIO_NODISCARD
+	static constexpr char_set_t
+	of( const char (&chars)[ N ] ) noexcept
+	{
+		char_set_t result;
+		for( std::size_t i = 0u; i + 1u < N; ++i )
+			result.add( chars[ i ] );
+		return result;
+	}
+
+	//! Make a set that contains all characters for those
+	//! @a predicate returns `true`.
+	/*!
+	 * If @a predicate is a constexpr function then the set
+	 * can be built at compile-time:
+	 * @code
+	 * constexpr bool is_vowel( char ch ) noexcept { ... }
+	 * constexpr auto vowels = char_set_t::matching( &is_vowel );
+	 * @endcode
+	 */
+	template< typename Predicate >
+	RESTINIO_NODISCARD
+	static constexpr char_set_t
+	matching( Predicate predicate ) noexcept
+	{
+		char_set_t result;
+		for( unsigned int i = 0u; i != 256u; ++i )
+			if( predicate( static_cast<char>( i ) ) )
+				result.add( static_cast<char>( i ) );
+		return result;
+	}
+
+	//! Add a character to the set.
+	constexpr char_set_t &
+	add( char ch ) noexcept
+	{
+		m_bits[ index_of( ch ) >> 6 ] |=
+				std::uint64_t{ 1u } << ( index_of( ch ) & 63u );
+		return *this;
+	}
+
+	//! Does the set contain the character?
+	RESTINIO_NODISCARD
+	constexpr bool
+	contains( char ch ) const noexcept
+	{
+		return 0u != ( ( m_bits[ index_of( ch ) >> 6 ] >>
+				( index_of( ch ) & 63u ) ) & 1u );
+	}
+
+	//! Union of two sets.
+	RESTINIO_NODISCARD
+	friend constexpr char_set_t
+	operator|( const char_set_t & a, const char_set_t & b ) noexcept
+	{
+		char_set_t result;
+		for( std::size_t i = 0u; i != 4u; ++i )
+			result.m_bits[ i ] = a.m_bits[ i ] | b.m_bits[ i ];
+		return result;
+	}
+
+	//! Intersection of two sets.
+	RESTINIO_NODISCARD
+	friend constexpr char_set_t
+	operator&( const char_set_t & a, const char_set_t & b ) noexcept
+	{
+		char_set_t result;
+		for( std::size_t i = 0u; i != 4u; ++i )
+			result.m_bits[ i ] = a.m_bits[ i ] & b.m_bits[ i ];
+		return result;
+	}
+
+	//! Characters from @a a that aren't in @a b.
+	RESTINIO_NODISCARD
+	friend constexpr char_set_t
+	operator-( const char_set_t & a, const char_set_t & b ) noexcept
+	{
+		char_set_t result;
+		for( std::size_t i = 0u; i != 4u; ++i )
+			result.m_bits[ i ] = a.m_bits[ i ] & ~b.m_bits[ i ];
+		return result;
+	}
+
+	//! All characters that aren't in the set.
+	RESTINIO_NODISCARD
+	constexpr char_set_t
+	operator~() const noexcept
+	{
+		char_set_t result;
+		for( std::size_t i = 0u; i != 4u; ++i )
+			result.m_bits[ i ] = ~m_bits[ i ];
+		return result;
+	}
+};
+
 namespace impl
 {
 
@@ -824,6 +993,39 @@ public:
 		return m_data.substr( from, length );
 	}
 
+	//! Consume all characters that satisfy a predicate.
+	/*!
+	 * Scans the remaining content of the input stream directly
+	 * (without calls to getch()) and stops at the first character
+	 * for that @a predicate returns `false`, at EOF or when
+	 * @a max_count characters are consumed.
+	 *
+	 * @return the consumed fragment. It can be empty.
+	 *
+	 * @since v.0.6.14
+	 */
+	template< typename Predicate >
+	RESTINIO_NODISCARD
+	string_view_t
+	consume_while(
+		const Predicate & predicate,
+		std::size_t max_count = string_view_t::npos ) noexcept
+	{
+		const auto available = m_data.size() - m_index;
+		const char * const first = m_data.data() + m_index;
+		const char * const last =
+				first + ( max_count < available ? max_count : available );
+
+		const char * current = first;
+		while( current != last && predicate( *current ) )
+			++current;
+
+		const auto consumed = static_cast<std::size_t>( current - first );
+		m_index += consumed;
+
+		return { first, consumed };
+	}
+
 	/*!
 	 * @brief A helper class to automatically return acquired
 	 * content back to the input stream.
@@ -1498,6 +1700,22 @@ public :
 		else
 			return parse_result.error();
 	}
+
+	//! Get access to the producer of the clause.
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	const P &
+	producer() const noexcept { return m_producer; }
+
+	//! Get access to the consumer of the clause.
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	C &
+	consumer() noexcept { return m_consumer; }
 };
 
 /*!
@@ -2039,6 +2257,43 @@ public :
 	}
 };
 
+//
+// can_be_repeated_in_bulk
+//
+/*!
+ * @brief A metafunction that checks that a repetition can be handled
+ * by one scan of the input stream.
+ *
+ * It's possible if there is just one clause to be repeated, the
+ * producer of that clause extracts a single symbol that satisfies
+ * a predicate (the producer has `predicate()` method like
+ * symbol_producer_template_t) and the consumer of that clause is
+ * able to consume a sequence of symbols at once (the consumer has
+ * `consume_fragment()` method).
+ *
+ * In that case `repeat(0, N, symbol_p('a') >> to_container())` is
+ * handled by a tight loop instead of the full machinery of clauses.
+ *
+ * @since v.0.6.14
+ */
+template<
+	typename Subitems_Tuple,
+	typename Target_Type,
+	typename = meta::void_t<> >
+struct can_be_repeated_in_bulk : public std::false_type {};
+
+template< typename P, typename C, typename Target_Type >
+struct can_be_repeated_in_bulk<
+		std::tuple< consume_value_clause_t< P, C > >,
+		Target_Type,
+		meta::void_t<
+			decltype( std::declval< const P & >().predicate() ),
+			decltype( std::declval< C & >().consume_fragment(
+					std::declval< Target_Type & >(),
+					std::declval< string_view_t >() ) ) > >
+	: public std::true_type
+{};
+
 //
 // repeat_clause_t
 //
@@ -2078,6 +2333,41 @@ public :
 	RESTINIO_NODISCARD
 	optional_t< parse_error_t >
 	try_process( source_t & from, Target_Type & dest )
+	{
+		return try_process_impl( from, dest,
+				can_be_repeated_in_bulk< Subitems_Tuple, Target_Type >{} );
+	}
+
+private :
+	//! Handling of a single symbol clause by one scan of the input.
+	template< typename Target_Type >
+	RESTINIO_NODISCARD
+	optional_t< parse_error_t >
+	try_process_impl( source_t & from, Target_Type & dest, std::true_type )
+	{
+		const auto started_at = from.current_position();
+
+		auto & clause = std::get<0>( m_subitems );
+		const auto fragment = from.consume_while(
+				clause.producer().predicate(), m_max_occurences );
+		clause.consumer().consume_fragment( dest, fragment );
+
+		if( fragment.size() >= m_min_occurences )
+			return nullopt;
+
+		parse_error_t error{
+				from.current_position(),
+				error_reason_t::pattern_not_found
+		};
+		from.backto( started_at );
+		return error;
+	}
+
+	//! Handling of an arbitrary sequence of clauses.
+	template< typename Target_Type >
+	RESTINIO_NODISCARD
+	optional_t< parse_error_t >
+	try_process_impl( source_t & from, Target_Type & dest, std::false_type )
 	{
 		source_t::content_consumer_t whole_consumer{ from };
 
@@ -2137,6 +2427,14 @@ public:
 		:	 Predicate{ std::forward<Args>(args)... }
 	{}
 
+	//! Get access to the predicate of the producer.
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	const Predicate &
+	predicate() const noexcept { return *this; }
+
 	RESTINIO_NODISCARD
 	expected_t< char, parse_error_t >
 	try_parse( source_t & from ) const noexcept
@@ -2276,6 +2574,27 @@ struct symbol_from_range_predicate_t
 	}
 };
 
+//
+// symbol_from_set_predicate_t
+//
+/*!
+ * @brief A predicate for cases where a symbol should belong
+ * to specified set.
+ *
+ * @since v.0.6.14
+ */
+struct symbol_from_set_predicate_t
+{
+	char_set_t m_set;
+
+	RESTINIO_NODISCARD
+	bool
+	operator()( const char actual ) const noexcept
+	{
+		return m_set.contains( actual );
+	}
+};
+
 //
 // symbol_producer_t
 //
@@ -2371,6 +2690,27 @@ public:
 	{}
 };
 
+//
+// symbol_from_set_producer_t
+//
+/*!
+ * @brief A producer for the case when a symbol should belong
+ * to specified set.
+ *
+ * @since v.0.6.14
+ */
+class symbol_from_set_producer_t
+	: public symbol_producer_template_t< symbol_from_set_predicate_t >
+{
+	using base_type_t =
+		symbol_producer_template_t< symbol_from_set_predicate_t >;
+
+public:
+	symbol_from_set_producer_t( const char_set_t & set )
+		:	base_type_t{ symbol_from_set_predicate_t{set} }
+	{}
+};
+
 //
 // digit_producer_t
 //
@@ -2441,32 +2781,22 @@ try_parse_digits_with_digits_limit(
 {
 	source_t::content_consumer_t consumer{ from };
 
-	digits_to_consume_t::underlying_int_t symbols_processed{};
+	const auto digits = from.consume_while(
+			is_digit_predicate_t{},
+			static_cast<std::size_t>( digits_limit.max() ) );
 
-	for( auto ch = from.getch(); !ch.m_eof; ch = from.getch() )
+	for( const char ch : digits )
 	{
-		if( is_digit(ch.m_ch) )
-		{
-			acc.next_digit( static_cast<T>(ch.m_ch - '0') );
+		acc.next_digit( static_cast<T>(ch - '0') );
 
-			if( acc.overflow_detected() )
-				return make_unexpected( parse_error_t{
-						consumer.started_at(),
-						error_reason_t::illegal_value_found
-				} );
-
-			++symbols_processed;
-			if( symbols_processed == digits_limit.max() )
-				break;
-		}
-		else
-		{
-			from.putback();
-			break;
-		}
+		if( acc.overflow_detected() )
+			return make_unexpected( parse_error_t{
+					consumer.started_at(),
+					error_reason_t::illegal_value_found
+			} );
 	}
 
-	if( symbols_processed < digits_limit.min() )
+	if( digits.size() < static_cast<std::size_t>( digits_limit.min() ) )
 		// Not all required digits are extracted.
 		return make_unexpected( parse_error_t{
 				from.current_position(),
@@ -2503,46 +2833,34 @@ try_parse_hexdigits_with_digits_limit(
 	digits_to_consume_t digits_limit,
 	Value_Accumulator acc ) noexcept
 {
-	const auto ch_to_digit = []( char ch ) -> std::pair<bool, T> {
+	// Only hexadecimal digits are passed to that lambda.
+	const auto ch_to_digit = []( char ch ) -> T {
 		if( ch >= '0' && ch <= '9' )
-			return std::make_pair( true, static_cast<T>(ch - '0') );
+			return static_cast<T>(ch - '0');
 		else if( ch >= 'A' && ch <= 'F' )
-			return std::make_pair( true, static_cast<T>(10 + (ch - 'A')) );
-		else if( ch >= 'a' && ch <= 'f' )
-			return std::make_pair( true, static_cast<T>(10 + (ch - 'a')) );
+			return static_cast<T>(10 + (ch - 'A'));
 		else
-			return std::make_pair( false, static_cast<T>(0) );
+			return static_cast<T>(10 + (ch - 'a'));
 	};
 
 	source_t::content_consumer_t consumer{ from };
 
-	digits_to_consume_t::underlying_int_t symbols_processed{};
+	const auto digits = from.consume_while(
+			is_hexdigit_predicate_t{},
+			static_cast<std::size_t>( digits_limit.max() ) );
 
-	for( auto ch = from.getch(); !ch.m_eof; ch = from.getch() )
+	for( const char ch : digits )
 	{
-		const auto d = ch_to_digit( ch.m_ch );
-		if( d.first )
-		{
-			acc.next_digit( d.second );
-
-			if( acc.overflow_detected() )
-				return make_unexpected( parse_error_t{
-						consumer.started_at(),
-						error_reason_t::illegal_value_found
-				} );
+		acc.next_digit( ch_to_digit( ch ) );
 
-			++symbols_processed;
-			if( symbols_processed == digits_limit.max() )
-				break;
-		}
-		else
-		{
-			from.putback();
-			break;
-		}
+		if( acc.overflow_detected() )
+			return make_unexpected( parse_error_t{
+					consumer.started_at(),
+					error_reason_t::illegal_value_found
+			} );
 	}
 
-	if( symbols_processed < digits_limit.min() )
+	if( digits.size() < static_cast<std::size_t>( digits_limit.min() ) )
 		// Not all required digits are extracted.
 		return make_unexpected( parse_error_t{
 				from.current_position(),
@@ -2844,6 +3162,14 @@ struct any_value_skipper_t : public consumer_tag
 	template< typename Target_Type, typename Value >
 	void
 	consume( Target_Type &, Value && ) const noexcept {}
+
+	//! Consume several symbols at once.
+	/*!
+	 * @since v.0.6.14
+	 */
+	template< typename Target_Type >
+	void
+	consume_fragment( Target_Type &, string_view_t ) const noexcept {}
 };
 
 //
@@ -3373,6 +3699,17 @@ public:
 		return try_parse_exact_fragment( from,
 				m_fragment.begin(), m_fragment.end() );
 	}
+
+	//! Get the expected fragment.
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	string_view_t
+	fragment() const noexcept
+	{
+		return { m_fragment.data(), m_fragment.size() };
+	}
 };
 
 //
@@ -3405,6 +3742,17 @@ public:
 		return try_parse_exact_fragment( from,
 				m_fragment.begin(), m_fragment.end() );
 	}
+
+	//! Get the expected fragment.
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	string_view_t
+	fragment() const noexcept
+	{
+		return { m_fragment.data(), m_fragment.size() };
+	}
 };
 
 //
@@ -4013,6 +4361,40 @@ symbol_from_range_p( char left, char right ) noexcept
 	return impl::symbol_from_range_producer_t{left, right};
 }
 
+//
+// symbol_from_set_p
+//
+/*!
+ * @brief A factory function to create a symbol_from_set_producer.
+ *
+ * Usage example:
+ * @code
+ * constexpr auto unreserved = char_set_t::range('a', 'z')
+ * 	| char_set_t::range('A', 'Z')
+ * 	| char_set_t::range('0', '9')
+ * 	| char_set_t::of("-._~");
+ *
+ * auto p = produce<std::string>(
+ * 	repeat(1, N, symbol_from_set_p(unreserved) >> to_container()) );
+ * @endcode
+ *
+ * @note
+ * A repetition of that producer (like in the example above) is handled
+ * by one scan of the input without a call to the producer for
+ * every symbol.
+ *
+ * @return a producer that expects a symbol from @a set in the
+ * input stream and returns it if that character is found.
+ * 
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline auto
+symbol_from_set_p( const char_set_t & set ) noexcept
+{
+	return impl::symbol_from_set_producer_t{set};
+}
+
 //
 // symbol
 //
@@ -4078,6 +4460,27 @@ symbol_from_range( char left, char right ) noexcept
 	return symbol_from_range_p(left, right) >> skip();
 }
 
+//
+// symbol_from_set
+//
+/*!
+ * @brief A factory function to create a clause that expects a symbol
+ * from specified set, extracts it and then skips it.
+ *
+ * The call to `symbol_from_set(set)` function is an equivalent of:
+ * @code
+ * symbol_from_set_p(set) >> skip()
+ * @endcode
+ * 
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline auto
+symbol_from_set( const char_set_t & set ) noexcept
+{
+	return symbol_from_set_p(set) >> skip();
+}
+
 //
 // space_p
 //
@@ -4546,6 +4949,37 @@ struct to_container_consumer_t : public consumer_tag
 		using container_adaptor_type = result_wrapper_for_t<Container>;
 		container_adaptor_type::to_container( to, std::move(item) );
 	}
+
+	//! Consume several symbols at once.
+	/*!
+	 * @since v.0.6.14
+	 */
+	template< typename Container >
+	void
+	consume_fragment( Container & to, string_view_t fragment )
+	{
+		using container_adaptor_type = result_wrapper_for_t<Container>;
+		append_fragment< container_adaptor_type >( to, fragment, 0 );
+	}
+
+private :
+	//! Version for containers that support bulk addition of symbols.
+	template< typename Adaptor, typename Container >
+	static auto
+	append_fragment( Container & to, string_view_t fragment, int )
+		-> decltype( Adaptor::append_fragment( to, fragment ) )
+	{
+		Adaptor::append_fragment( to, fragment );
+	}
+
+	//! Version for other containers.
+	template< typename Adaptor, typename Container >
+	static void
+	append_fragment( Container & to, string_view_t fragment, long )
+	{
+		for( const char ch : fragment )
+			Adaptor::to_container( to, char{ ch } );
+	}
 };
 
 } /* namespace impl */
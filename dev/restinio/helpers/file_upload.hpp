@@ -110,6 +110,7 @@ translate_enumeration_error(
 		case source::terminated_by_handler:
 			result = dest::terminated_by_handler; break;
 
+		case source::part_headers_too_large:
 		case source::unexpected_error:
 			/* nothing to do */ break;
 	}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <restinio/helpers/http_field_parsers/authorization.hpp>
+#include <restinio/helpers/http_field_parsers/try_parse_field.hpp>
 
 #include <restinio/utils/base64.hpp>
 
@@ -230,6 +231,32 @@ perform_extraction_attempt(
 	return try_extract_params( parsed_value );
 }
 
+/*!
+ * @brief Extraction of parameters from a cached result of parsing
+ * of HTTP-field.
+ *
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline expected_t< params_t, extraction_error_t >
+perform_extraction_attempt(
+	const try_extract_field_details::result_variant_t<
+			authorization_value_t > & parse_result )
+{
+	if( get_if< field_not_found_t >( &parse_result ) )
+		return make_unexpected( extraction_error_t::no_auth_http_field );
+
+	const auto * parsed_value = get_if< authorization_value_t >(
+			&parse_result );
+	if( !parsed_value )
+		return make_unexpected( extraction_error_t::illegal_http_field_value );
+
+	if( "basic" != parsed_value->auth_scheme )
+		return make_unexpected( extraction_error_t::not_basic_auth_scheme );
+
+	return try_extract_params( *parsed_value );
+}
+
 } /* namespace impl */
 
 //
@@ -369,6 +396,64 @@ try_extract_params(
 	return try_extract_params( req.header(), auth_field_id );
 }
 
+/*!
+ * @brief Helper function for getting parameters of basic authentification
+ * from a request with caching of the parsed HTTP-field.
+ *
+ * It works like try_extract_params() but the result of parsing of
+ * HTTP-field is cached inside the request object (see
+ * try_parse_field_cached()). It allows to parse the HTTP-field only
+ * once if several authentification schemes are checked.
+ *
+ * @attention
+ * The cache isn't thread safe. This function shouldn't be used if the
+ * same request object is accessed from several threads at the same time.
+ *
+ * @since v.0.6.14
+ */
+template< typename Extra_Data >
+RESTINIO_NODISCARD
+inline expected_t< params_t, extraction_error_t >
+try_extract_params_cached(
+	//! A request that should hold a HTTP-field with authentification
+	//! parameters.
+	const generic_request_t< Extra_Data > & req,
+	//! The name of a HTTP-field with authentification parameters.
+	string_view_t auth_field_name )
+{
+	return impl::perform_extraction_attempt(
+			try_parse_field_cached< authorization_value_t >(
+					req, auth_field_name ) );
+}
+
+/*!
+ * @brief Helper function for getting parameters of basic authentification
+ * from a request with caching of the parsed HTTP-field.
+ *
+ * This function is intended to be used when HTTP-field is identified
+ * by its ID.
+ *
+ * @attention
+ * The cache isn't thread safe. This function shouldn't be used if the
+ * same request object is accessed from several threads at the same time.
+ *
+ * @since v.0.6.14
+ */
+template< typename Extra_Data >
+RESTINIO_NODISCARD
+inline expected_t< params_t, extraction_error_t >
+try_extract_params_cached(
+	//! A request that should hold a HTTP-field with authentification
+	//! parameters.
+	const generic_request_t< Extra_Data > & req,
+	//! The ID of a HTTP-field with authentification parameters.
+	http_field_t auth_field_id )
+{
+	return impl::perform_extraction_attempt(
+			try_parse_field_cached< authorization_value_t >(
+					req, auth_field_id ) );
+}
+
 } /* namespace basic_auth */
 
 } /* namespace http_field_parsers */
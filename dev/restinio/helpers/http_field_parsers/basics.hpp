@@ -385,6 +385,27 @@ is_qdtext( const char ch ) noexcept
 			is_obs_text( ch );
 }
 
+//
+// is_qdtext_predicate_t
+//
+/*!
+ * @brief A preducate for symbol_producer_template that checks that
+ * a symbol is a qdtext.
+ *
+ * @since v.0.6.14
+ */
+struct is_qdtext_predicate_t
+{
+	RESTINIO_NODISCARD
+	bool
+	operator()( const char actual ) const noexcept
+	{
+		static constexpr char_set_t qdtext_chars =
+				char_set_t::matching( &is_qdtext );
+		return qdtext_chars.contains( actual );
+	}
+};
+
 //
 // is_ctext
 //
@@ -422,7 +443,9 @@ struct is_ctext_predicate_t
 	bool
 	operator()( const char actual ) const noexcept
 	{
-		return is_ctext(actual);
+		static constexpr char_set_t ctext_chars =
+				char_set_t::matching( &is_ctext );
+		return ctext_chars.contains( actual );
 	}
 };
 
@@ -461,7 +484,9 @@ struct is_token_char_predicate_t
 	bool
 	operator()( const char actual ) const noexcept
 	{
-		return is_token_char(actual);
+		static constexpr char_set_t token_chars =
+				char_set_t::matching( &is_token_char );
+		return token_chars.contains( actual );
 	}
 };
 
@@ -486,20 +511,9 @@ public :
 	try_parse(
 		source_t & from ) const noexcept
 	{
-		std::size_t extracted_spaces{};
-		character_t ch;
-		for( ch = from.getch();
-			!ch.m_eof && is_space(ch.m_ch);
-			ch = from.getch() )
-		{
-			++extracted_spaces;
-		}
+		const auto spaces = from.consume_while( is_space_predicate_t{} );
 
-		if( !ch.m_eof )
-			// The first non-space char should be returned back.
-			from.putback();
-
-		if( extracted_spaces > 0u )
+		if( !spaces.empty() )
 			return result_type{ ' ' };
 
 		return result_type{ nullopt };
@@ -525,43 +539,21 @@ class token_producer_t : public producer_tag< std::string >
 	static optional_t< parse_error_t >
 	try_parse_value( source_t & from, std::string & accumulator )
 	{
-		error_reason_t reason = error_reason_t::pattern_not_found;
-
-		do
+		const auto token = from.consume_while( is_token_char_predicate_t{} );
+		if( token.empty() )
 		{
-			const auto ch = from.getch();
-			if( ch.m_eof )
-			{
-				reason = error_reason_t::unexpected_eof;
-				break;
-			}
-
-			if( !is_token_char(ch.m_ch) )
-			{
-				from.putback();
-				reason = error_reason_t::unexpected_character;
-				break;
-			}
-
-			accumulator += ch.m_ch;
+			return parse_error_t{
+					from.current_position(),
+					from.eof() ? error_reason_t::unexpected_eof
+							: error_reason_t::unexpected_character
+			};
 		}
-		while( true );
 
-		if( accumulator.empty() )
-		{
-			return parse_error_t{ from.current_position(), reason };
-		}
+		accumulator.append( token.data(), token.size() );
 
 		return nullopt;
 	}
 
-	RESTINIO_NODISCARD
-	static constexpr bool
-	is_token_char( const char ch ) noexcept
-	{
-		return is_token_char_predicate_t::is_token_char( ch );
-	}
-
 public :
 	RESTINIO_NODISCARD
 	expected_t< result_type, parse_error_t >
@@ -600,6 +592,11 @@ class quoted_string_producer_t : public producer_tag< std::string >
 		bool second_quote_extracted{ false };
 		do
 		{
+			// All qdtext symbols before the next special symbol
+			// are taken at once.
+			const auto text = from.consume_while( is_qdtext_predicate_t{} );
+			accumulator.append( text.data(), text.size() );
+
 			const auto ch = from.getch();
 			if( ch.m_eof )
 			{
@@ -630,8 +627,6 @@ class quoted_string_producer_t : public producer_tag< std::string >
 					break;
 				}
 			}
-			else if( is_qdtext( ch.m_ch ) )
-				accumulator += ch.m_ch;
 			else
 			{
 				reason = error_reason_t::unexpected_character;
@@ -102,6 +102,41 @@ try_extract_field_value_from(
 		return { parse_result.error() };
 }
 
+//
+// try_extract_cached_field_value_from
+//
+/*!
+ * @brief Get a parsed value of HTTP-field from the cache of a request.
+ *
+ * The value of HTTP-field is parsed only if it isn't in the cache yet.
+ *
+ * @since v.0.6.14
+ */
+template< typename Parsed_Field_Type, typename Extra_Data >
+RESTINIO_NODISCARD
+const result_variant_t< Parsed_Field_Type > &
+try_extract_cached_field_value_from(
+	const generic_request_t< Extra_Data > & req,
+	optional_t< string_view_t > opt_value )
+{
+	if( !opt_value )
+	{
+		static const result_variant_t< Parsed_Field_Type > not_found{
+				field_not_found_t{} };
+		return not_found;
+	}
+
+	// Values of HTTP-fields are stored inside the request object and
+	// are never changed. So the address of a value can be used as a key.
+	return restinio::impl::access_parsed_fields_cache( req )
+		.template get_or_create< result_variant_t< Parsed_Field_Type > >(
+			opt_value->data(),
+			[&opt_value] {
+				return try_extract_field_value_from< Parsed_Field_Type >(
+						opt_value, string_view_t{} );
+			} );
+}
+
 } /* namespace try_extract_field_details */
 
 //
@@ -223,7 +258,107 @@ try_parse_field(
 			default_value );
 }
 
+//
+// try_parse_field_cached
+//
+/*!
+ * @brief A helper function for extraction and parsing a value of
+ * HTTP-field with caching of the result inside the request object.
+ *
+ * This helper is intended to be used when HTTP-field is identified
+ * by its name.
+ *
+ * Unlike try_parse_field() the value of HTTP-field is parsed only once.
+ * All subsequent calls for the same HTTP-field and the same
+ * @a Parsed_Field_Type get a reference to the already parsed value.
+ * It allows to avoid repeated parsing of the same HTTP-field by
+ * several stages of a chain of request handlers.
+ *
+ * Usage example:
+ * @code
+ * auto on_post(const restinio::request_handle_t & req) {
+ * 	using namespace restinio::http_field_parsers;
+ *
+ * 	const auto & auth_field = try_parse_field_cached< authorization_value_t >(
+ * 			*req, "X-My-Authorization");
+ * 	if(auto * auth = restinio::get_if<authorization_value_t>(&auth_field)) {
+ * 		// X-My-Authorization is successfully parsed.
+ * 		...
+ * 	}
+ * }
+ * @endcode
+ *
+ * @attention
+ * The returned reference is valid while the request object exists.
+ * Access to the cache isn't thread safe.
+ *
+ * @tparam Parsed_Field_Type The type of field value to be received as the
+ * result of successful parse if the field is present.
+ *
+ * @tparam Extra_Data The type of extra-data incorporated into an instance
+ * of restinio::generic_request_t. There is no need to specify that type,
+ * it has to be detected automatically by the compiler.
+ *
+ * @since v.0.6.14
+ */
+template< typename Parsed_Field_Type, typename Extra_Data >
+RESTINIO_NODISCARD
+const try_extract_field_details::result_variant_t< Parsed_Field_Type > &
+try_parse_field_cached(
+	//! A request that should hold a HTTP-field.
+	const generic_request_t< Extra_Data > & req,
+	//! The name of HTTP-field to be extracted and parsed.
+	string_view_t field_name )
+{
+	using namespace try_extract_field_details;
+
+	return try_extract_cached_field_value_from< Parsed_Field_Type >(
+			req,
+			req.header().opt_value_of( field_name ) );
+}
+
+/*!
+ * @brief A helper function for extraction and parsing a value of
+ * HTTP-field with caching of the result inside the request object.
+ *
+ * This helper is intended to be used when HTTP-field is identified
+ * by its ID.
+ *
+ * Usage example:
+ * @code
+ * auto on_post(const restinio::request_handle_t & req) {
+ * 	using namespace restinio::http_field_parsers;
+ *
+ * 	const auto & content_type = try_parse_field_cached< content_type_value_t >(
+ * 			*req, restinio::http_field::content_type);
+ * 	if(auto * ct = restinio::get_if<content_type_value_t>(&content_type)) {
+ * 		...
+ * 	}
+ * }
+ * @endcode
+ *
+ * @attention
+ * The returned reference is valid while the request object exists.
+ * Access to the cache isn't thread safe.
+ *
+ * @since v.0.6.14
+ */
+template< typename Parsed_Field_Type, typename Extra_Data >
+RESTINIO_NODISCARD
+const try_extract_field_details::result_variant_t< Parsed_Field_Type > &
+try_parse_field_cached(
+	//! A request that should hold a HTTP-field.
+	const generic_request_t< Extra_Data > & req,
+	//! The ID of a HTTP-field to be extracted and parsed.
+	http_field_t field_id )
+{
+	using namespace try_extract_field_details;
+
+	return try_extract_cached_field_value_from< Parsed_Field_Type >(
+			req,
+			req.header().opt_value_of( field_id ) );
+}
+
 } /* namespace http_field_parsers */
 
 } /* namespace restinio */
-
@@ -19,11 +19,14 @@
 #include <restinio/http_headers.hpp>
 #include <restinio/request_handler.hpp>
 #include <restinio/expected.hpp>
+#include <restinio/exception.hpp>
 
 #include <restinio/impl/string_caseless_compare.hpp>
 
 #include <restinio/utils/metaprogramming.hpp>
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 
 namespace restinio
@@ -380,7 +383,12 @@ enum class enumeration_error_t
 	//! handling_result_t::terminate_enumeration.
 	terminated_by_handler,
 	//! Some unexpected error encountered during the enumeration.
-	unexpected_error
+	unexpected_error,
+	//! Headers of a part are too large.
+	//! This code is returned by streaming_parser_t only.
+	//!
+	//! @since v.0.6.14
+	part_headers_too_large
 };
 
 namespace impl
@@ -729,7 +737,535 @@ enumerate_parts(
 	return make_unexpected( boundary.error() );
 }
 
+namespace impl
+{
+
+//
+// delimiter_searcher_t
+//
+/*!
+ * @brief Boyer-Moore-Horspool search of a delimiter of parts.
+ *
+ * The delimiter is CRLF followed by the boundary mark. The boundary
+ * mark is checked by the constructor, so the delimiter is never
+ * longer than 74 bytes and a skip can be stored in one byte.
+ *
+ * @since v.0.6.14
+ */
+class delimiter_searcher_t
+{
+	std::string m_delimiter;
+	std::array< std::uint8_t, 256u > m_skips;
+
+public:
+	/*!
+	 * @throw exception_t if @a boundary isn't two hyphens followed by
+	 * a valid boundary value (see check_boundary_value()).
+	 */
+	explicit delimiter_searcher_t( string_view_t boundary )
+	{
+		if( boundary.size() < 2u || "--" != boundary.substr( 0u, 2u ) ||
+				check_boundary_value( boundary.substr( 2u ) ) )
+			throw exception_t{ "invalid boundary mark for multipart body" };
+
+		m_delimiter.reserve( 2u + boundary.size() );
+		m_delimiter.append( "\r\n" );
+		m_delimiter.append( boundary.data(), boundary.size() );
+
+		const auto size = m_delimiter.size();
+		m_skips.fill( static_cast< std::uint8_t >( size ) );
+		for( std::size_t i = 0u; i + 1u < size; ++i )
+			m_skips[ static_cast< unsigned char >( m_delimiter[ i ] ) ] =
+					static_cast< std::uint8_t >( size - 1u - i );
+	}
+
+	RESTINIO_NODISCARD
+	string_view_t
+	delimiter() const noexcept { return m_delimiter; }
+
+	//! Find the first occurence of the delimiter.
+	/*!
+	 * @return string_view_t::npos if the delimiter isn't found.
+	 */
+	RESTINIO_NODISCARD
+	std::size_t
+	find( string_view_t where ) const noexcept
+	{
+		const std::size_t size = m_delimiter.size();
+		const char last = m_delimiter[ size - 1u ];
+
+		for( std::size_t pos = 0u; pos + size <= where.size(); )
+		{
+			const char ch = where[ pos + size - 1u ];
+			if( last == ch &&
+					0 == where.compare( pos, size - 1u,
+							m_delimiter.data(), size - 1u ) )
+				return pos;
+
+			pos += m_skips[ static_cast< unsigned char >( ch ) ];
+		}
+
+		return string_view_t::npos;
+	}
+
+	//! Get the length of the longest suffix of @a where that is
+	//! a proper prefix of the delimiter.
+	RESTINIO_NODISCARD
+	std::size_t
+	partial_match_size( string_view_t where ) const noexcept
+	{
+		const std::size_t max_size = (std::min)(
+				where.size(), m_delimiter.size() - 1u );
+
+		// The delimiter starts with CR so only positions of CR
+		// should be checked.
+		for( std::size_t size = max_size; size; --size )
+		{
+			const std::size_t pos = where.size() - size;
+			if( '\r' == where[ pos ] &&
+					0 == where.compare( pos, size, m_delimiter.data(), size ) )
+				return size;
+		}
+
+		return 0u;
+	}
+};
+
+} /* namespace impl */
+
+//
+// streaming_parser_t
+//
+/*!
+ * @brief An incremental parser of a multipart body.
+ *
+ * Unlike enumerate_parts() it doesn't require the whole body to be
+ * in memory: the body is passed to the parser by chunks of arbitrary size
+ * via consume() method. The content of parts is passed to @a Handler
+ * as soon as it is found in the input, so the parser holds only
+ * the headers of the current part and a few bytes that can be the
+ * beginning of the next delimiter.
+ *
+ * The delimiter of parts is searched by Boyer-Moore-Horspool algorithm.
+ *
+ * @a Handler should be a type with the following methods:
+ * @code
+ * // Called when headers of a new part are parsed.
+ * handling_result_t on_part_begin(http_header_fields_t && fields);
+ * // Called for every fragment of the body of the current part.
+ * handling_result_t on_part_data(string_view_t fragment);
+ * // Called when the end of the current part is found.
+ * handling_result_t on_part_end();
+ * @endcode
+ * If a method returns handling_result_t::stop_enumeration then all
+ * remaining input is ignored. If a method returns
+ * handling_result_t::terminate_enumeration then the parsing fails
+ * with enumeration_error_t::terminated_by_handler.
+ *
+ * Usage example:
+ * @code
+ * struct saver_t {
+ * 	std::ofstream m_file;
+ *
+ * 	handling_result_t on_part_begin(restinio::http_header_fields_t && fields) {
+ * 		... // Analyze Content-Disposition, open m_file.
+ * 		return handling_result_t::continue_enumeration;
+ * 	}
+ * 	handling_result_t on_part_data(restinio::string_view_t fragment) {
+ * 		m_file.write(fragment.data(), fragment.size());
+ * 		return handling_result_t::continue_enumeration;
+ * 	}
+ * 	handling_result_t on_part_end() {
+ * 		m_file.close();
+ * 		return handling_result_t::continue_enumeration;
+ * 	}
+ * };
+ *
+ * const auto boundary = detect_boundary_for_multipart_body(
+ * 		req, "multipart", "form-data" );
+ * if( boundary )
+ * {
+ * 	streaming_parser_t< saver_t > parser{ *boundary, saver_t{} };
+ * 	while( auto chunk = read_next_chunk() )
+ * 		if( parser.consume( *chunk ) || parser.is_completed() )
+ * 			break;
+ * 	const auto result = parser.finish();
+ * 	...
+ * }
+ * @endcode
+ *
+ * @note
+ * Preamble and epilogue of the body are ignored.
+ *
+ * @since v.0.6.14
+ */
+template< typename Handler >
+class streaming_parser_t
+{
+public:
+	//! The default limit for the size of headers of one part.
+	static constexpr std::size_t default_max_part_headers_size = 16u * 1024u;
+
+	/*!
+	 * @attention
+	 * @a boundary should contain two leading hyphens, like values
+	 * returned by detect_boundary_for_multipart_body().
+	 *
+	 * @throw exception_t if @a boundary isn't a valid boundary mark.
+	 */
+	streaming_parser_t(
+		//! The boundary mark.
+		string_view_t boundary,
+		//! The handler for parts.
+		Handler handler,
+		//! The limit for the size of headers of one part.
+		std::size_t max_part_headers_size = default_max_part_headers_size )
+		:	m_searcher{ boundary }
+		,	m_handler( std::move(handler) )
+		,	m_max_part_headers_size{ max_part_headers_size }
+		// The first boundary can be at the very beginning of the body
+		// without preceding CRLF. So let's assume that CRLF is already
+		// received.
+		,	m_pending{ "\r\n" }
+	{}
+
+	//! Access to the handler.
+	RESTINIO_NODISCARD
+	Handler &
+	handler() noexcept { return m_handler; }
+
+	//! Is all necessary data received?
+	/*!
+	 * Returns true if the last delimiter is found, or the handler
+	 * stopped the enumeration, or an error is detected. There is no
+	 * need to pass more data to the parser in that case.
+	 */
+	RESTINIO_NODISCARD
+	bool
+	is_completed() const noexcept
+	{
+		return state_t::completed == m_state || state_t::failed == m_state;
+	}
+
+	//! Pass the next chunk of the body to the parser.
+	/*!
+	 * @return an error code if an error is detected. Subsequent calls
+	 * return the same error code.
+	 */
+	optional_t< enumeration_error_t >
+	consume( string_view_t chunk )
+	{
+		while( !chunk.empty() && !is_completed() )
+		{
+			switch( m_state )
+			{
+				case state_t::preamble:
+				case state_t::part_body:
+					chunk = handle_body_data( chunk );
+				break;
+
+				case state_t::delimiter_tail:
+					chunk = handle_delimiter_tail( chunk );
+				break;
+
+				case state_t::part_headers:
+					chunk = handle_headers( chunk );
+				break;
+
+				case state_t::completed:
+				case state_t::failed:
+				break;
+			}
+		}
+
+		return m_error;
+	}
+
+	//! Finish the parsing after the end of input.
+	/*!
+	 * @return the count of parts successfuly handled by the handler or
+	 * an error code.
+	 */
+	RESTINIO_NODISCARD
+	expected_t< std::size_t, enumeration_error_t >
+	finish() const
+	{
+		if( m_error )
+			return make_unexpected( *m_error );
+
+		if( state_t::completed == m_state )
+			return m_parts_handled;
+
+		return make_unexpected( 0u == m_parts_handled ?
+				enumeration_error_t::no_parts_found :
+				enumeration_error_t::unexpected_error );
+	}
+
+private:
+	enum class state_t
+	{
+		//! Data before the first delimiter.
+		preamble,
+		//! Waiting for CRLF or "--" after a delimiter.
+		delimiter_tail,
+		//! Accumulation of headers of a part.
+		part_headers,
+		//! The body of a part.
+		part_body,
+		//! The last delimiter found or enumeration stopped.
+		completed,
+		//! An error detected.
+		failed
+	};
+
+	impl::delimiter_searcher_t m_searcher;
+	Handler m_handler;
+	const std::size_t m_max_part_headers_size;
+
+	state_t m_state{ state_t::preamble };
+	optional_t< enumeration_error_t > m_error;
+	std::size_t m_parts_handled{ 0u };
+
+	//! Data that wasn't handled yet.
+	/*!
+	 * Contains the beginning of the delimiter in preamble and
+	 * part_body states and the beginning of headers in part_headers state.
+	 */
+	std::string m_pending;
+
+	void
+	fail( enumeration_error_t error )
+	{
+		m_state = state_t::failed;
+		m_error = error;
+	}
+
+	//! Returns true if parsing should be continued.
+	bool
+	check_handler_result( handling_result_t result )
+	{
+		switch( result )
+		{
+			case handling_result_t::continue_enumeration:
+				return true;
+
+			case handling_result_t::stop_enumeration:
+				m_state = state_t::completed;
+			break;
+
+			case handling_result_t::terminate_enumeration:
+				fail( enumeration_error_t::terminated_by_handler );
+			break;
+		}
+
+		return false;
+	}
+
+	bool
+	emit_body_data( string_view_t fragment )
+	{
+		if( state_t::part_body != m_state || fragment.empty() )
+			return true;
+
+		return check_handler_result( m_handler.on_part_data( fragment ) );
+	}
+
+	//! Handle the end of body of the current part (or the end of preamble).
+	void
+	on_delimiter_found()
+	{
+		if( state_t::part_body == m_state )
+		{
+			const auto result = m_handler.on_part_end();
+			if( handling_result_t::terminate_enumeration != result )
+				++m_parts_handled;
+			if( !check_handler_result( result ) )
+				return;
+		}
+
+		m_state = state_t::delimiter_tail;
+	}
+
+	//! Search of the delimiter in the body of a part or in the preamble.
+	/*!
+	 * @return the remaining part of @a chunk.
+	 */
+	string_view_t
+	handle_body_data( string_view_t chunk )
+	{
+		if( !m_pending.empty() )
+		{
+			// The beginning of a delimiter can be in m_pending.
+			// Append enough bytes to check it.
+			const auto delimiter_size = m_searcher.delimiter().size();
+			const auto appended = (std::min)( chunk.size(), delimiter_size );
+			m_pending.append( chunk.data(), appended );
+			chunk = chunk.substr( appended );
+
+			const auto pos = m_searcher.find( m_pending );
+			if( string_view_t::npos != pos )
+			{
+				if( !emit_body_data( string_view_t{ m_pending }.substr( 0u, pos ) ) )
+					return chunk;
+
+				// Bytes after the delimiter have to be handled in the
+				// next state.
+				std::string rest{ m_pending, pos + delimiter_size };
+				m_pending.clear();
+				on_delimiter_found();
+				if( !rest.empty() )
+				{
+					consume( rest );
+				}
+				return chunk;
+			}
+
+			const auto partial = m_searcher.partial_match_size( m_pending );
+			if( !emit_body_data( string_view_t{ m_pending }.substr(
+					0u, m_pending.size() - partial ) ) )
+				return chunk;
+			m_pending.erase( 0u, m_pending.size() - partial );
+
+			if( !m_pending.empty() )
+				// The rest of the chunk will be handled on the next iteration.
+				return chunk;
+		}
+
+		const auto pos = m_searcher.find( chunk );
+		if( string_view_t::npos != pos )
+		{
+			if( emit_body_data( chunk.substr( 0u, pos ) ) )
+				on_delimiter_found();
+
+			return chunk.substr( pos + m_searcher.delimiter().size() );
+		}
+
+		const auto partial = m_searcher.partial_match_size( chunk );
+		if( emit_body_data( chunk.substr( 0u, chunk.size() - partial ) ) )
+			m_pending.assign( chunk.data() + chunk.size() - partial, partial );
+
+		return string_view_t{};
+	}
+
+	//! Handling of CRLF or "--" after a delimiter.
+	string_view_t
+	handle_delimiter_tail( string_view_t chunk )
+	{
+		const auto appended = (std::min)( chunk.size(), 2u - m_pending.size() );
+		m_pending.append( chunk.data(), appended );
+		chunk = chunk.substr( appended );
+
+		if( 2u == m_pending.size() )
+		{
+			if( "\r\n" == m_pending )
+				m_state = state_t::part_headers;
+			else if( "--" == m_pending )
+				// The last delimiter found. The rest is the epilogue.
+				m_state = state_t::completed;
+			else
+				fail( enumeration_error_t::unexpected_error );
+
+			m_pending.clear();
+		}
+
+		return chunk;
+	}
+
+	//! Find the end of headers of a part.
+	/*!
+	 * Headers are terminated by an empty line. If there are no headers
+	 * then the empty line is the first one.
+	 *
+	 * @return string_view_t::npos if the end isn't found.
+	 */
+	RESTINIO_NODISCARD
+	static std::size_t
+	find_headers_end( string_view_t where, std::size_t search_from ) noexcept
+	{
+		if( where.size() >= 2u && '\r' == where[ 0 ] && '\n' == where[ 1 ] )
+			return 2u;
+
+		const auto pos = where.find( "\r\n\r\n", search_from );
+		return string_view_t::npos == pos ? pos : pos + 4u;
+	}
+
+	//! Accumulation and parsing of headers of a part.
+	string_view_t
+	handle_headers( string_view_t chunk )
+	{
+		if( m_pending.empty() )
+		{
+			// There is no need to copy headers if they are in the chunk.
+			const auto headers_end = find_headers_end( chunk, 0u );
+			if( string_view_t::npos != headers_end )
+			{
+				handle_complete_headers( chunk.substr( 0u, headers_end ) );
+				return chunk.substr( headers_end );
+			}
+		}
+
+		const auto old_size = m_pending.size();
+		m_pending.append( chunk.data(), (std::min)(
+				chunk.size(), m_max_part_headers_size + 4u - old_size ) );
+
+		const auto headers_end = find_headers_end(
+				m_pending, old_size < 3u ? 0u : old_size - 3u );
+		if( string_view_t::npos == headers_end )
+		{
+			if( m_pending.size() > m_max_part_headers_size )
+				fail( enumeration_error_t::part_headers_too_large );
+
+			return chunk.substr( m_pending.size() - old_size );
+		}
+
+		handle_complete_headers(
+				string_view_t{ m_pending }.substr( 0u, headers_end ) );
+		m_pending.clear();
+
+		return chunk.substr( headers_end - old_size );
+	}
+
+	void
+	handle_complete_headers( string_view_t headers )
+	{
+		if( headers.size() > m_max_part_headers_size )
+		{
+			fail( enumeration_error_t::part_headers_too_large );
+			return;
+		}
+
+		auto parse_result = try_parse_part( headers );
+		if( !parse_result )
+		{
+			fail( enumeration_error_t::unexpected_error );
+			return;
+		}
+
+		m_state = state_t::part_body;
+		check_handler_result(
+				m_handler.on_part_begin( std::move(parse_result->fields) ) );
+	}
+};
+
+//
+// make_streaming_parser
+//
+/*!
+ * @brief A helper for creation of streaming_parser_t.
+ *
+ * @since v.0.6.14
+ */
+template< typename Handler >
+RESTINIO_NODISCARD
+streaming_parser_t< std::decay_t< Handler > >
+make_streaming_parser(
+	string_view_t boundary,
+	Handler && handler )
+{
+	return streaming_parser_t< std::decay_t< Handler > >{
+			boundary, std::forward< Handler >( handler ) };
+}
+
 } /* namespace multipart_body */
 
 } /* namespace restinio */
-
@@ -0,0 +1,569 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Per-client rate limiting based on token buckets.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/cidr_ip_blocker.hpp>
+#include <restinio/http_headers.hpp>
+#include <restinio/request_handler.hpp>
+#include <restinio/buffers.hpp>
+#include <restinio/exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace restinio
+{
+
+namespace rate_limiter
+{
+
+//
+// settings_t
+//
+/*!
+ * @brief Settings for token_bucket_limiter_t.
+ *
+ * Every client gets a bucket of `burst` tokens. The bucket is refilled
+ * at `rate` tokens per second. Every connection (or request) takes one
+ * token. If the bucket is empty the connection (or request) is rejected.
+ *
+ * Clients are identified by a prefix of their IP address. By default
+ * the whole IPv4 address and /64 prefix of IPv6 address are used
+ * (because a single IPv6 client usually owns the whole /64 network).
+ *
+ * @since v.0.6.14
+ */
+class settings_t
+{
+	public:
+		//! The number of tokens added to a bucket every second.
+		//! \{
+		settings_t &
+		rate( double v ) &
+		{
+			if( !(v > 0.0) )
+				throw exception_t{ "rate should be greater than 0" };
+
+			m_rate = v;
+			return *this;
+		}
+
+		settings_t &&
+		rate( double v ) &&
+		{
+			return std::move( this->rate( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		double
+		rate() const noexcept { return m_rate; }
+		//! \}
+
+		//! The capacity of a bucket.
+		//! \{
+		settings_t &
+		burst( double v ) &
+		{
+			if( v < 1.0 )
+				throw exception_t{ "burst should be at least 1" };
+
+			m_burst = v;
+			return *this;
+		}
+
+		settings_t &&
+		burst( double v ) &&
+		{
+			return std::move( this->burst( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		double
+		burst() const noexcept { return m_burst; }
+		//! \}
+
+		//! The length of IPv4 address prefix that identifies a client.
+		//! \{
+		settings_t &
+		ipv4_prefix_length( unsigned int v ) &
+		{
+			if( v > 32u )
+				throw exception_t{ "ipv4_prefix_length can't be greater than 32" };
+
+			m_ipv4_prefix_length = v;
+			return *this;
+		}
+
+		settings_t &&
+		ipv4_prefix_length( unsigned int v ) &&
+		{
+			return std::move( this->ipv4_prefix_length( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		unsigned int
+		ipv4_prefix_length() const noexcept { return m_ipv4_prefix_length; }
+		//! \}
+
+		//! The length of IPv6 address prefix that identifies a client.
+		//! \{
+		settings_t &
+		ipv6_prefix_length( unsigned int v ) &
+		{
+			if( v > 128u )
+				throw exception_t{ "ipv6_prefix_length can't be greater than 128" };
+
+			m_ipv6_prefix_length = v;
+			return *this;
+		}
+
+		settings_t &&
+		ipv6_prefix_length( unsigned int v ) &&
+		{
+			return std::move( this->ipv6_prefix_length( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		unsigned int
+		ipv6_prefix_length() const noexcept { return m_ipv6_prefix_length; }
+		//! \}
+
+		//! The maximum number of tracked clients.
+		/*!
+		 * If this number is exceeded then buckets of the least
+		 * recently seen clients are removed. A client with a removed
+		 * bucket gets a new full bucket.
+		 */
+		//! \{
+		settings_t &
+		max_clients( std::size_t v ) &
+		{
+			if( !v )
+				throw exception_t{ "max_clients can't be 0" };
+
+			m_max_clients = v;
+			return *this;
+		}
+
+		settings_t &&
+		max_clients( std::size_t v ) &&
+		{
+			return std::move( this->max_clients( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		max_clients() const noexcept { return m_max_clients; }
+		//! \}
+
+		//! The number of independent shards of the limiter.
+		/*!
+		 * Every shard has its own lock. The more shards the less
+		 * contention between threads that use the limiter.
+		 */
+		//! \{
+		settings_t &
+		shards_count( std::size_t v ) &
+		{
+			if( !v )
+				throw exception_t{ "shards_count can't be 0" };
+
+			m_shards_count = v;
+			return *this;
+		}
+
+		settings_t &&
+		shards_count( std::size_t v ) &&
+		{
+			return std::move( this->shards_count( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		shards_count() const noexcept { return m_shards_count; }
+		//! \}
+
+	private:
+		double m_rate{ 10.0 };
+		double m_burst{ 20.0 };
+		unsigned int m_ipv4_prefix_length{ 32u };
+		unsigned int m_ipv6_prefix_length{ 64u };
+		std::size_t m_max_clients{ 64u * 1024u };
+		std::size_t m_shards_count{ 16u };
+};
+
+namespace impl
+{
+
+using client_key_t = ip_blocker::cidr_details::key_t;
+
+struct client_key_hash_t
+{
+	RESTINIO_NODISCARD
+	std::size_t
+	operator()( const client_key_t & k ) const noexcept
+	{
+		return std::hash< std::uint64_t >{}(
+				k.m_hi ^ (k.m_lo * 0x9e3779b97f4a7c15ull) );
+	}
+};
+
+struct client_key_equal_t
+{
+	RESTINIO_NODISCARD
+	bool
+	operator()( const client_key_t & a, const client_key_t & b ) const noexcept
+	{
+		return a.m_hi == b.m_hi && a.m_lo == b.m_lo;
+	}
+};
+
+//
+// shard_t
+//
+/*!
+ * @brief One independent part of the limiter.
+ *
+ * Buckets are kept in LRU order inside the shard. So the eviction
+ * is only approximately LRU for the whole limiter.
+ *
+ * @since v.0.6.14
+ */
+class shard_t
+{
+	public:
+		using time_point_t = std::chrono::steady_clock::time_point;
+
+		RESTINIO_NODISCARD
+		bool
+		try_acquire(
+			const client_key_t & key,
+			time_point_t now,
+			const settings_t & settings,
+			std::size_t max_buckets )
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			const auto it = m_index.find( key );
+			if( it == m_index.end() )
+			{
+				while( m_lru.size() >= max_buckets )
+				{
+					m_index.erase( m_lru.back().m_key );
+					m_lru.pop_back();
+				}
+
+				// The first token is taken from a new full bucket.
+				m_lru.push_front( bucket_t{ key, settings.burst() - 1.0, now } );
+				m_index.emplace( key, m_lru.begin() );
+				return true;
+			}
+
+			const auto bucket_it = it->second;
+			// The bucket becomes the most recently used.
+			m_lru.splice( m_lru.begin(), m_lru, bucket_it );
+
+			auto & bucket = *bucket_it;
+			if( now > bucket.m_updated_at )
+			{
+				const std::chrono::duration< double > elapsed =
+						now - bucket.m_updated_at;
+				bucket.m_tokens += elapsed.count() * settings.rate();
+				if( bucket.m_tokens > settings.burst() )
+					bucket.m_tokens = settings.burst();
+				bucket.m_updated_at = now;
+			}
+
+			if( bucket.m_tokens < 1.0 )
+				return false;
+
+			bucket.m_tokens -= 1.0;
+			return true;
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		size()
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+			return m_lru.size();
+		}
+
+	private:
+		struct bucket_t
+		{
+			client_key_t m_key;
+			double m_tokens;
+			time_point_t m_updated_at;
+		};
+
+		using lru_list_t = std::list< bucket_t >;
+
+		std::mutex m_lock;
+
+		//! Buckets in the order of usage (the most recent is the first).
+		lru_list_t m_lru;
+
+		std::unordered_map<
+				client_key_t,
+				lru_list_t::iterator,
+				client_key_hash_t,
+				client_key_equal_t > m_index;
+};
+
+} /* namespace impl */
+
+//
+// token_bucket_limiter_t
+//
+/*!
+ * @brief A thread-safe per-client rate limiter.
+ *
+ * Can be used directly or via connection_rate_limiter_t and
+ * request_rate_limiter_t.
+ *
+ * @since v.0.6.14
+ */
+class token_bucket_limiter_t
+{
+	public:
+		using time_point_t = std::chrono::steady_clock::time_point;
+
+		explicit token_bucket_limiter_t( settings_t settings = settings_t{} )
+			:	m_settings{ std::move( settings ) }
+			,	m_shards( m_settings.shards_count() )
+		{}
+
+		token_bucket_limiter_t( const token_bucket_limiter_t & ) = delete;
+		token_bucket_limiter_t & operator=( const token_bucket_limiter_t & ) = delete;
+
+		token_bucket_limiter_t( token_bucket_limiter_t && ) = delete;
+		token_bucket_limiter_t & operator=( token_bucket_limiter_t && ) = delete;
+
+		//! Try to take a token from the bucket of a client.
+		/*!
+		 * @return true if there was a token in the bucket.
+		 */
+		RESTINIO_NODISCARD
+		bool
+		try_acquire(
+			const asio_ns::ip::address & address,
+			time_point_t now = std::chrono::steady_clock::now() )
+		{
+			const auto key = client_key_of( address );
+			auto & shard = m_shards[
+					impl::client_key_hash_t{}( key ) % m_shards.size() ];
+
+			return shard.try_acquire( key, now, m_settings, max_buckets_per_shard() );
+		}
+
+		//! The number of clients those buckets are tracked now.
+		RESTINIO_NODISCARD
+		std::size_t
+		tracked_clients()
+		{
+			std::size_t result = 0u;
+			for( auto & s : m_shards )
+				result += s.size();
+
+			return result;
+		}
+
+		RESTINIO_NODISCARD
+		const settings_t &
+		settings() const noexcept { return m_settings; }
+
+	private:
+		const settings_t m_settings;
+
+		std::vector< impl::shard_t > m_shards;
+
+		RESTINIO_NODISCARD
+		std::size_t
+		max_buckets_per_shard() const noexcept
+		{
+			const auto v = m_settings.max_clients() / m_shards.size();
+			return v ? v : 1u;
+		}
+
+		RESTINIO_NODISCARD
+		impl::client_key_t
+		client_key_of( const asio_ns::ip::address & address ) const noexcept
+		{
+			// IPv4 addresses are represented as IPv4-mapped IPv6 addresses.
+			const bool is_v4 = address.is_v4() ||
+					( address.is_v6() && address.to_v6().is_v4_mapped() );
+			const auto length = is_v4 ?
+					96u + m_settings.ipv4_prefix_length() :
+					m_settings.ipv6_prefix_length();
+
+			return impl::client_key_t::from_address( address ).masked( length );
+		}
+};
+
+//
+// connection_rate_limiter_t
+//
+/*!
+ * @brief An IP-blocker that limits the rate of new connections
+ * from every client.
+ *
+ * Usage example:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using ip_blocker_t = restinio::rate_limiter::connection_rate_limiter_t;
+ * };
+ * ...
+ * restinio::run(
+ * 	restinio::on_thread_pool< my_traits >( 4 )
+ * 		.ip_blocker( std::make_shared<
+ * 				restinio::rate_limiter::connection_rate_limiter_t >(
+ * 			restinio::rate_limiter::settings_t{}.rate( 5 ).burst( 10 ) ) )
+ * 		...
+ * );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class connection_rate_limiter_t
+{
+	public:
+		explicit connection_rate_limiter_t( settings_t settings = settings_t{} )
+			:	m_limiter{ std::move( settings ) }
+		{}
+
+		RESTINIO_NODISCARD
+		ip_blocker::inspection_result_t
+		inspect( const ip_blocker::incoming_info_t & info ) noexcept
+		{
+			try
+			{
+				return m_limiter.try_acquire( info.remote_endpoint().address() ) ?
+						ip_blocker::allow() : ip_blocker::deny();
+			}
+			catch( const std::exception & )
+			{
+				// Can't track a new client. Don't punish it for that.
+				return ip_blocker::allow();
+			}
+		}
+
+		RESTINIO_NODISCARD
+		token_bucket_limiter_t &
+		limiter() noexcept { return m_limiter; }
+
+	private:
+		token_bucket_limiter_t m_limiter;
+};
+
+//
+// request_rate_limiter_t
+//
+/*!
+ * @brief Limiter of the rate of requests from every client.
+ *
+ * Request handlers are wrapped by request_rate_limiter_t::wrap().
+ * If a client exceeds the limit then the wrapped handler isn't called
+ * and a response with 429 status code is sent.
+ *
+ * Usage example:
+ * @code
+ * restinio::rate_limiter::request_rate_limiter_t limiter{
+ * 	restinio::rate_limiter::settings_t{}.rate( 100 ).burst( 200 ) };
+ * ...
+ * router->http_get( "/api/:id", limiter.wrap(
+ * 	[]( const auto & req, const auto & params ) {...} ) );
+ * @endcode
+ *
+ * The limiter object should outlive all handlers created by wrap().
+ *
+ * @note
+ * This class is thread-safe.
+ *
+ * @since v.0.6.14
+ */
+class request_rate_limiter_t
+{
+	public:
+		explicit request_rate_limiter_t( settings_t settings = settings_t{} )
+			:	m_limiter{ std::move( settings ) }
+			,	m_retry_after{ make_retry_after( m_limiter.settings() ) }
+			,	m_rejection_body{
+					std::make_shared< const std::string >( "Too Many Requests" ) }
+		{}
+
+		//! Make a request handler that checks the rate limit
+		//! before calling @a handler.
+		template< typename Handler >
+		RESTINIO_NODISCARD
+		auto
+		wrap( Handler && handler )
+		{
+			return [this, h = std::forward<Handler>(handler)](
+					const auto & req, auto && ...args ) -> request_handling_status_t
+				{
+					if( !m_limiter.try_acquire( req->remote_endpoint().address() ) )
+						return this->reject( req );
+
+					return h( req, std::forward<decltype(args)>(args)... );
+				};
+		}
+
+		//! Send a response with 429 status code.
+		template< typename Extra_Data >
+		request_handling_status_t
+		reject( const generic_request_handle_t< Extra_Data > & req ) const
+		{
+			return req->create_response( status_too_many_requests() )
+				.append_header( http_field::retry_after, m_retry_after )
+				.append_header( http_field::content_type, "text/plain" )
+				// The body isn't copied, it is shared between all responses.
+				.set_body( writable_item_t{ m_rejection_body } )
+				.done();
+		}
+
+		RESTINIO_NODISCARD
+		token_bucket_limiter_t &
+		limiter() noexcept { return m_limiter; }
+
+	private:
+		token_bucket_limiter_t m_limiter;
+
+		//! Value for Retry-After header field.
+		const std::string m_retry_after;
+
+		const std::shared_ptr< const std::string > m_rejection_body;
+
+		RESTINIO_NODISCARD
+		static std::string
+		make_retry_after( const settings_t & settings )
+		{
+			// The time required to get one token (in whole seconds).
+			// It's limited by one day for very small rates.
+			constexpr double max_seconds = 24.0 * 60.0 * 60.0;
+			const auto seconds = (std::min)(
+					std::ceil( 1.0 / settings.rate() ), max_seconds );
+			return std::to_string( static_cast< unsigned long >( seconds ) );
+		}
+};
+
+} /* namespace rate_limiter */
+
+} /* namespace restinio */
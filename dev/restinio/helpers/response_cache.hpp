@@ -0,0 +1,707 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief An in-memory cache of responses for idempotent request handlers.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/http_headers.hpp>
+#include <restinio/request_handler.hpp>
+#include <restinio/buffers.hpp>
+#include <restinio/exception.hpp>
+
+#include <restinio/utils/percent_encoding.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace restinio
+{
+
+namespace response_cache
+{
+
+//
+// cached_response_t
+//
+/*!
+ * @brief A response that can be stored in the cache.
+ *
+ * A request handler wrapped by response_cache_t should return an
+ * instance of that type instead of sending a response by itself.
+ * The response is sent by the cache. The body of the response is shared
+ * between all responses sent from the cache.
+ *
+ * Usage example:
+ * @code
+ * return restinio::response_cache::cached_response_t{ restinio::status_ok() }
+ * 	.append_header( restinio::http_field::content_type, "application/json" )
+ * 	.set_body( make_json( book ) );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class cached_response_t
+{
+	public:
+		cached_response_t( http_status_line_t status_line )
+			:	m_status_line{ std::move( status_line ) }
+		{}
+
+		//! Add header field.
+		cached_response_t &
+		append_header( std::string field_name, std::string field_value ) &
+		{
+			m_header_fields.add_field(
+					std::move( field_name ), std::move( field_value ) );
+			return *this;
+		}
+
+		//! Add header field.
+		cached_response_t &&
+		append_header( std::string field_name, std::string field_value ) &&
+		{
+			return std::move( this->append_header(
+					std::move( field_name ), std::move( field_value ) ) );
+		}
+
+		//! Add header field.
+		cached_response_t &
+		append_header( http_field_t field_id, std::string field_value ) &
+		{
+			m_header_fields.add_field( field_id, std::move( field_value ) );
+			return *this;
+		}
+
+		//! Add header field.
+		cached_response_t &&
+		append_header( http_field_t field_id, std::string field_value ) &&
+		{
+			return std::move( this->append_header(
+					field_id, std::move( field_value ) ) );
+		}
+
+		//! Set the body of the response.
+		cached_response_t &
+		set_body( std::string body ) &
+		{
+			m_body = std::make_shared< const std::string >( std::move( body ) );
+			return *this;
+		}
+
+		//! Set the body of the response.
+		cached_response_t &&
+		set_body( std::string body ) &&
+		{
+			return std::move( this->set_body( std::move( body ) ) );
+		}
+
+		//! Should the response be stored in the cache?
+		/*!
+		 * It is true by default. Can be set to false if the response
+		 * should be sent but shouldn't be cached (for example, if it is
+		 * an error response).
+		 */
+		cached_response_t &
+		cacheable( bool v ) & noexcept
+		{
+			m_cacheable = v;
+			return *this;
+		}
+
+		//! Should the response be stored in the cache?
+		cached_response_t &&
+		cacheable( bool v ) && noexcept
+		{
+			return std::move( this->cacheable( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		bool
+		cacheable() const noexcept { return m_cacheable; }
+
+		RESTINIO_NODISCARD
+		const http_status_line_t &
+		status_line() const noexcept { return m_status_line; }
+
+		RESTINIO_NODISCARD
+		const http_header_fields_t &
+		header_fields() const noexcept { return m_header_fields; }
+
+		RESTINIO_NODISCARD
+		string_view_t
+		body() const noexcept
+		{
+			return m_body ? string_view_t{ *m_body } : string_view_t{};
+		}
+
+		//! Approximate amount of memory occupied by the response.
+		RESTINIO_NODISCARD
+		std::size_t
+		approx_size() const noexcept
+		{
+			std::size_t result = sizeof( *this ) +
+					m_status_line.reason_phrase().size() +
+					( m_body ? m_body->size() : 0u );
+			m_header_fields.for_each_field(
+				[&result]( const http_header_field_t & f ) {
+					result += sizeof( f ) + f.name().size() + f.value().size();
+				} );
+
+			return result;
+		}
+
+		//! Send the response as a response for @a req.
+		template< typename Extra_Data >
+		request_handling_status_t
+		send( const generic_request_handle_t< Extra_Data > & req ) const
+		{
+			auto resp = req->create_response( m_status_line );
+			m_header_fields.for_each_field(
+				[&resp]( const http_header_field_t & f ) {
+					resp.append_header( f );
+				} );
+
+			if( m_body )
+				// The body isn't copied, it is shared between all responses.
+				resp.set_body( writable_item_t{ m_body } );
+
+			return resp.done();
+		}
+
+	private:
+		http_status_line_t m_status_line;
+		http_header_fields_t m_header_fields;
+		std::shared_ptr< const std::string > m_body;
+		bool m_cacheable{ true };
+};
+
+//
+// settings_t
+//
+/*!
+ * @brief Settings for response_cache_t.
+ *
+ * @since v.0.6.14
+ */
+class settings_t
+{
+	public:
+		//! The maximum total size of cached responses (in bytes).
+		//! \{
+		settings_t &
+		max_size( std::size_t v ) & noexcept
+		{
+			m_max_size = v;
+			return *this;
+		}
+
+		settings_t &&
+		max_size( std::size_t v ) && noexcept
+		{
+			return std::move( this->max_size( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		max_size() const noexcept { return m_max_size; }
+		//! \}
+
+		//! Time to live for a cached response.
+		//! \{
+		settings_t &
+		time_to_live( std::chrono::steady_clock::duration v ) & noexcept
+		{
+			m_time_to_live = v;
+			return *this;
+		}
+
+		settings_t &&
+		time_to_live( std::chrono::steady_clock::duration v ) && noexcept
+		{
+			return std::move( this->time_to_live( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::chrono::steady_clock::duration
+		time_to_live() const noexcept { return m_time_to_live; }
+		//! \}
+
+		//! The number of independent shards of the cache.
+		/*!
+		 * Every shard has its own lock. The more shards the less
+		 * contention between threads that use the cache.
+		 */
+		//! \{
+		settings_t &
+		shards_count( std::size_t v ) &
+		{
+			if( !v )
+				throw exception_t{ "shards_count can't be 0" };
+
+			m_shards_count = v;
+			return *this;
+		}
+
+		settings_t &&
+		shards_count( std::size_t v ) &&
+		{
+			return std::move( this->shards_count( v ) );
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		shards_count() const noexcept { return m_shards_count; }
+		//! \}
+
+		//! Names of request header fields which values are included
+		//! into cache key.
+		/*!
+		 * Responses for requests with different values of those fields
+		 * are cached separately (like `Vary` header field in HTTP).
+		 */
+		//! \{
+		settings_t &
+		vary_by( std::vector< std::string > field_names ) &
+		{
+			m_vary_by = std::move( field_names );
+			return *this;
+		}
+
+		settings_t &&
+		vary_by( std::vector< std::string > field_names ) &&
+		{
+			return std::move( this->vary_by( std::move( field_names ) ) );
+		}
+
+		RESTINIO_NODISCARD
+		const std::vector< std::string > &
+		vary_by() const noexcept { return m_vary_by; }
+		//! \}
+
+	private:
+		std::size_t m_max_size{ 16u * 1024u * 1024u };
+		std::chrono::steady_clock::duration m_time_to_live{
+				std::chrono::seconds( 60 ) };
+		std::size_t m_shards_count{ 16u };
+		std::vector< std::string > m_vary_by;
+};
+
+//
+// stats_t
+//
+/*!
+ * @brief Statistics of cache usage.
+ *
+ * @since v.0.6.14
+ */
+struct stats_t
+{
+	std::uint64_t m_hits;
+	std::uint64_t m_misses;
+	std::size_t m_entries;
+	std::size_t m_size;
+};
+
+namespace impl
+{
+
+//
+// shard_t
+//
+/*!
+ * @brief One independent part of the cache.
+ *
+ * @since v.0.6.14
+ */
+class shard_t
+{
+	public:
+		using response_handle_t = std::shared_ptr< const cached_response_t >;
+		using time_point_t = std::chrono::steady_clock::time_point;
+
+		RESTINIO_NODISCARD
+		response_handle_t
+		find( const std::string & key, time_point_t now )
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			const auto it = m_index.find( key );
+			if( it == m_index.end() )
+				return {};
+
+			const auto entry_it = it->second;
+			if( entry_it->m_expires_at <= now )
+			{
+				remove( entry_it );
+				return {};
+			}
+
+			// The entry becomes the most recently used.
+			m_lru.splice( m_lru.begin(), m_lru, entry_it );
+			return entry_it->m_response;
+		}
+
+		void
+		store(
+			std::string key,
+			std::string target_key,
+			response_handle_t response,
+			time_point_t expires_at,
+			std::size_t max_size )
+		{
+			const std::size_t size = response->approx_size() +
+					key.size() + target_key.size();
+			if( size > max_size )
+				return;
+
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			const auto it = m_index.find( key );
+			if( it != m_index.end() )
+				remove( it->second );
+
+			while( m_size + size > max_size && !m_lru.empty() )
+				remove( std::prev( m_lru.end() ) );
+
+			m_lru.push_front( entry_t{
+					std::move( key ),
+					std::move( target_key ),
+					std::move( response ),
+					expires_at,
+					size } );
+			m_index.emplace( m_lru.front().m_key, m_lru.begin() );
+			m_size += size;
+		}
+
+		void
+		invalidate( const std::string & target_key )
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			for( auto it = m_lru.begin(); it != m_lru.end(); )
+			{
+				const auto current = it++;
+				if( current->m_target_key == target_key )
+					remove( current );
+			}
+		}
+
+		void
+		clear()
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			m_index.clear();
+			m_lru.clear();
+			m_size = 0u;
+		}
+
+		void
+		collect_stats( stats_t & stats )
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+
+			stats.m_entries += m_lru.size();
+			stats.m_size += m_size;
+		}
+
+	private:
+		struct entry_t
+		{
+			//! The full key (method, target and values of vary-by fields).
+			std::string m_key;
+			//! The key without values of vary-by fields.
+			std::string m_target_key;
+			response_handle_t m_response;
+			time_point_t m_expires_at;
+			std::size_t m_size;
+		};
+
+		using lru_list_t = std::list< entry_t >;
+
+		std::mutex m_lock;
+
+		//! Entries in the order of usage (the most recent is the first).
+		lru_list_t m_lru;
+
+		//! Index of entries by full key.
+		/*!
+		 * Keys refer to m_key of entries.
+		 */
+		std::unordered_map< string_view_t, lru_list_t::iterator > m_index;
+
+		//! The total size of entries.
+		std::size_t m_size{ 0u };
+
+		void
+		remove( lru_list_t::iterator it )
+		{
+			m_size -= it->m_size;
+			m_index.erase( string_view_t{ it->m_key } );
+			m_lru.erase( it );
+		}
+};
+
+} /* namespace impl */
+
+//
+// response_cache_t
+//
+/*!
+ * @brief An in-memory cache of responses.
+ *
+ * The cache is intended to be used for request handlers that produce
+ * the same response for the same request (GET and HEAD requests for
+ * resources that rarely change). A request handler is wrapped by
+ * response_cache_t::wrap(). The wrapped handler should return
+ * an instance of cached_response_t.
+ *
+ * The key for a cached response consists of HTTP method, request target
+ * (with normalized percent-encoded unreserved chars), and values of header
+ * fields specified by settings_t::vary_by().
+ *
+ * Only responses to GET and HEAD requests are cached. Requests with other
+ * methods are always passed to the wrapped handler.
+ *
+ * The cache is split into several shards. Every shard has its own lock
+ * and a part of the total size limit. If a shard is full then the least
+ * recently used responses are removed from it.
+ *
+ * Usage example:
+ * @code
+ * restinio::response_cache::response_cache_t cache{
+ * 	restinio::response_cache::settings_t{}
+ * 		.max_size( 64u * 1024u * 1024u )
+ * 		.time_to_live( std::chrono::seconds{ 30 } )
+ * 		.vary_by( { "Accept" } ) };
+ *
+ * router->http_get( "/books/:id", cache.wrap(
+ * 	[]( const auto & req, auto params ) {
+ * 		return restinio::response_cache::cached_response_t{ restinio::status_ok() }
+ * 			.append_header( restinio::http_field::content_type, "application/json" )
+ * 			.set_body( load_book( params[ "id" ] ) );
+ * 	} ) );
+ * ...
+ * // The book is modified.
+ * cache.invalidate( restinio::http_method_get(), "/books/42" );
+ * @endcode
+ *
+ * @attention
+ * The cache object should outlive all handlers created by wrap().
+ *
+ * @note
+ * This class is thread-safe.
+ *
+ * @since v.0.6.14
+ */
+class response_cache_t
+{
+	public:
+		explicit response_cache_t( settings_t settings = settings_t{} )
+			:	m_settings{ std::move( settings ) }
+			,	m_shards( m_settings.shards_count() )
+		{}
+
+		response_cache_t( const response_cache_t & ) = delete;
+		response_cache_t & operator=( const response_cache_t & ) = delete;
+
+		response_cache_t( response_cache_t && ) = delete;
+		response_cache_t & operator=( response_cache_t && ) = delete;
+
+		//! Make a request handler that uses the cache.
+		/*!
+		 * @a handler receives all arguments passed to the resulting
+		 * request handler (so it can be used with any router) and
+		 * should return an instance of cached_response_t.
+		 */
+		template< typename Handler >
+		RESTINIO_NODISCARD
+		auto
+		wrap( Handler && handler )
+		{
+			return [this, h = std::forward<Handler>(handler)](
+					const auto & req, auto && ...args ) -> request_handling_status_t
+				{
+					return this->handle( req, [&] {
+							return h( req, std::forward<decltype(args)>(args)... );
+						} );
+				};
+		}
+
+		//! Handle a request by using a cached response or the response
+		//! produced by @a producer.
+		template< typename Extra_Data, typename Producer >
+		request_handling_status_t
+		handle(
+			const generic_request_handle_t< Extra_Data > & req,
+			Producer && producer )
+		{
+			const auto method = req->header().method();
+			if( http_method_get() != method && http_method_head() != method )
+				return producer().send( req );
+
+			const auto target_key = make_target_key(
+					method, req->header().request_target() );
+			if( !target_key )
+				// The target can't be normalized. Don't cache the response.
+				return producer().send( req );
+
+			auto key = make_key( *target_key, req->header() );
+			auto & shard = shard_for( *target_key );
+
+			const auto now = std::chrono::steady_clock::now();
+			if( auto cached = shard.find( key, now ) )
+			{
+				++m_hits;
+				return cached->send( req );
+			}
+
+			++m_misses;
+			auto response = std::make_shared< const cached_response_t >(
+					producer() );
+			if( response->cacheable() )
+				shard.store(
+						std::move( key ),
+						std::move( *target_key ),
+						response,
+						now + m_settings.time_to_live(),
+						shard_max_size() );
+
+			return response->send( req );
+		}
+
+		//! Remove all cached responses for a request target.
+		/*!
+		 * All responses for different values of vary-by fields
+		 * are removed.
+		 */
+		void
+		invalidate( http_method_id_t method, string_view_t target )
+		{
+			const auto target_key = make_target_key( method, target );
+			if( target_key )
+				shard_for( *target_key ).invalidate( *target_key );
+		}
+
+		//! Remove all cached responses.
+		void
+		invalidate_all()
+		{
+			for( auto & s : m_shards )
+				s.clear();
+		}
+
+		//! Get statistics of cache usage.
+		RESTINIO_NODISCARD
+		stats_t
+		stats()
+		{
+			stats_t result{ m_hits.load(), m_misses.load(), 0u, 0u };
+			for( auto & s : m_shards )
+				s.collect_stats( result );
+
+			return result;
+		}
+
+	private:
+		const settings_t m_settings;
+
+		std::vector< impl::shard_t > m_shards;
+
+		std::atomic< std::uint64_t > m_hits{ 0u };
+		std::atomic< std::uint64_t > m_misses{ 0u };
+
+		RESTINIO_NODISCARD
+		std::size_t
+		shard_max_size() const noexcept
+		{
+			return m_settings.max_size() / m_shards.size();
+		}
+
+		RESTINIO_NODISCARD
+		impl::shard_t &
+		shard_for( const std::string & target_key )
+		{
+			return m_shards[ std::hash< std::string >{}( target_key ) %
+					m_shards.size() ];
+		}
+
+		//! Make the part of the key that doesn't depend on vary-by fields.
+		/*!
+		 * Returns an empty optional if the target has an invalid format.
+		 */
+		RESTINIO_NODISCARD
+		static optional_t< std::string >
+		make_target_key( http_method_id_t method, string_view_t target )
+		{
+			namespace normalization =
+					restinio::utils::uri_normalization::unreserved_chars;
+
+			const string_view_t method_name{ method.c_str() };
+			try
+			{
+				const auto size = normalization::estimate_required_capacity(
+						target );
+
+				std::string result;
+				result.reserve( method_name.size() + 1u + size );
+				result.append( method_name.data(), method_name.size() );
+				result += ' ';
+				if( size != target.size() )
+				{
+					result.resize( method_name.size() + 1u + size );
+					normalization::normalize_to(
+							target, &result[ method_name.size() + 1u ] );
+				}
+				else
+					result.append( target.data(), target.size() );
+
+				return result;
+			}
+			catch( const std::exception & )
+			{
+				return nullopt;
+			}
+		}
+
+		RESTINIO_NODISCARD
+		std::string
+		make_key(
+			const std::string & target_key,
+			const http_request_header_t & header ) const
+		{
+			std::string result{ target_key };
+			for( const auto & name : m_settings.vary_by() )
+			{
+				// Absent field and field with empty value should be
+				// distinguished.
+				result += '\n';
+				if( const auto value = header.opt_value_of( name ) )
+				{
+					result += ':';
+					result.append( value->data(), value->size() );
+				}
+			}
+
+			return result;
+		}
+};
+
+} /* namespace response_cache */
+
+} /* namespace restinio */
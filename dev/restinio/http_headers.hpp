@@ -12,6 +12,7 @@
 
 #include <restinio/impl/string_caseless_compare.hpp>
 
+#include <restinio/compiler_features.hpp>
 #include <restinio/exception.hpp>
 #include <restinio/string_view.hpp>
 #include <restinio/optional.hpp>
@@ -21,6 +22,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <array>
 #include <vector>
 #include <algorithm>
 
@@ -241,307 +243,170 @@ enum class http_field_t : std::uint8_t //By now 152 + 34 + 1 items fits to uint8
 //! Helper alies to omitt `_t` suffix.
 using http_field = http_field_t;
 
-//
-// string_to_field()
-//
+namespace impl
+{
 
-//! Helper function to get method string name.
-//! \{
-inline http_field_t
-string_to_field( string_view_t field ) noexcept
+namespace field_hash_details
 {
-	const char * field_name = field.data();
-	const std::size_t field_name_size = field.size();
 
-#define RESTINIO_HTTP_CHECK_FOR_FIELD( field_id, candidate_field_name ) \
-	if( impl::is_equal_caseless(field_name, #candidate_field_name , field_name_size ) ) \
-		return http_field_t:: field_id;
+//! The count of fields from RESTINIO_HTTP_FIELDS_MAP.
+constexpr std::size_t known_fields_count =
+	static_cast< std::size_t >( http_field_t::field_unspecified );
 
-	// TODO: make most popular fields to be checked first.
+//! Bits of hash value used as index in the table.
+constexpr unsigned table_bits = 12u;
 
-	switch( field_name_size )
+//! The size of the table of slots.
+constexpr std::size_t table_size = std::size_t{ 1u } << table_bits;
+
+static_assert( known_fields_count < 0xFFu,
+	"a slot should be able to store index of any field plus one" );
+static_assert( known_fields_count * 8u < table_size,
+	"the table is too small for finding a perfect hash quickly" );
+
+//! Case-insensitive FNV-1a hash of a field name.
+/*!
+	The case folding is done by setting 0x20 bit. For other than letters
+	it could give the same results for different chars, but it is
+	not a problem because a candidate is always verified by
+	is_equal_caseless().
+*/
+constexpr std::uint32_t
+hash( std::uint32_t seed, const char * name, std::size_t size ) noexcept
+{
+	std::uint32_t h = 2166136261u ^ seed;
+	for( std::size_t i = 0u; i != size; ++i )
 	{
-		case 2:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_,                          If )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( im,                           IM )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( te,                           TE )
-			break;
-
-		case 3:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( age,                          Age )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( dav,                          DAV )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ext,                          Ext )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( man,                          Man )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( opt,                          Opt )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( p3p,                          P3P )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pep,                          PEP )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( tcn,                          TCN )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ttl,                          TTL )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( uri,                          URI )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( via,                          Via )
-			break;
-
-		case 4:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( host,                         Host )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( a_im,                         A-IM )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alpn,                         ALPN )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( dasl,                         DASL )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( date,                         Date )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( etag,                         ETag )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( from,                         From )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( link,                         Link )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( safe,                         Safe )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( slug,                         SLUG )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( vary,                         Vary )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cost,                         Cost )
-			break;
-
-		case 5:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( allow,                        Allow )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_ext,                        C-Ext )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_man,                        C-Man )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_opt,                        C-Opt )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep,                        C-PEP )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( close,                        Close )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( depth,                        Depth )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( label,                        Label )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( meter,                        Meter )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( range,                        Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( topic,                        Topic )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( subok,                        SubOK )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( subst,                        Subst )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( title,                        Title )
-			break;
-
-		case 6:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept,                       Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie,                       Cookie )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( server,                       Server )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( digest,                       Digest )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( expect,                       Expect )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( origin,                       Origin )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pragma,                       Pragma )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( prefer,                       Prefer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_,                      Public )
-			break;
-
-		case 7:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_svc,                      Alt-Svc )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie2,                      Cookie2 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( expires,                      Expires )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( hobareg,                      Hobareg )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( referer,                      Referer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( timeout,                      Timeout )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( trailer,                      Trailer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( urgency,                      Urgency )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( upgrade,                      Upgrade )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( warning,                      Warning )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( version,                      Version )
-			break;
-
-		case 8:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_used,                     Alt-Used )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_match,                     If-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_range,                     If-Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( location,                     Location )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pep_info,                     Pep-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( position,                     Position )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol,                     Protocol )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( optional,                     Optional )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_color,                     UA-Color )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_media,                     UA-Media )
-			break;
-
-		case 9:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( forwarded,                    Forwarded )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( negotiate,                    Negotiate )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( overwrite,                    Overwrite )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_pixels,                    UA-Pixels )
-			break;
-
-		case 10:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alternates,                   Alternates )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep_info,                   C-PEP-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_id,                   Content-ID )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( delta_base,                   Delta-Base )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( getprofile,                   GetProfile )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( keep_alive,                   Keep-Alive )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( lock_token,                   Lock-Token )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pics_label,                   PICS-Label )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie,                   Set-Cookie )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( setprofile,                   SetProfile )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( soapaction,                   SoapAction )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( status_uri,                   Status-URI )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( user_agent,                   User-Agent )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( compliance,                   Compliance )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( message_id,                   Message-ID )
-			break;
-
-		case 11:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_post,                  Accept-Post )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_md5,                  Content-MD5 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( destination,                  Destination )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( retry_after,                  Retry-After )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie2,                  Set-Cookie2 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( want_digest,                  Want-Digest )
-			break;
-
-		case 12:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_type,                 Content-Type )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_patch,                 Accept-Patch )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_base,                 Content-Base )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( derived_from,                 Derived-From )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( max_forwards,                 Max-Forwards )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( mime_version,                 MIME-Version )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_tag,                 Schedule-Tag )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( redirect_ref,                 Redirect-Ref )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( variant_vary,                 Variant-Vary )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check,                 Method-Check )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( referer_root,                 Referer-Root )
-			break;
-
-		case 13:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_ranges,                Accept-Ranges )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authorization,                Authorization )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cache_control,                Cache-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_range,                Content-Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( default_style,                Default-Style )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_none_match,                If-None-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( last_modified,                Last-Modified )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ordering_type,                Ordering-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( profileobject,                ProfileObject )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_info,                Protocol-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_resolution,                UA-Resolution )
-			break;
-
-		case 14:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_charset,               Accept-Charset )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( http2_settings,               HTTP2-Settings )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_query,               Protocol-Query )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_features,               Proxy-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_reply,               Schedule-Reply )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( non_compliance,               Non-Compliance )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control,               Access-Control )
-			break;
-
-		case 15:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_encoding,              Accept-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_features,              Accept-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_language,              Accept-Language )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_datetime,              Accept-Datetime )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_version,              Content-Version )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( differential_id,              Differential-ID )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins,              Public-Key-Pins )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( security_scheme,              Security-Scheme )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_frame_options,              X-Frame-Options )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept,              X-Device-Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( resolution_hint,              Resolution-Hint )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ediint_features,              EDIINT-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_windowpixels,              UA-Windowpixels )
-			break;
-
-		case 16:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_additions,             Accept-Additions )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( caldav_timezones,             CalDAV-Timezones )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_encoding,             Content-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_language,             Content-Language )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_location,             Content-Location )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( memento_datetime,             Memento-Datetime )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_request,             Protocol-Request )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( www_authenticate,             WWW-Authenticate )
-			break;
-
-		case 17:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_modified_since,            If-Modified-Since )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_instruction,            Proxy-Instruction )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_key,            Sec-WebSocket-Key )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_control,            Surrogate-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( transfer_encoding,            Transfer-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( resolver_location,            Resolver-Location )
-			break;
-
-		case 18:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_style_type,           Content-Style-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( preference_applied,           Preference-Applied )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authenticate,           Proxy-Authenticate )
-			break;
-
-		case 19:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_info,          Authentication-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_disposition,          Content-Disposition )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_script_type,          Content-Script-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_unmodified_since,          If-Unmodified-Since )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authorization,          Proxy-Authorization )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_user_agent,          X-Device-User-Agent )
-			break;
-
-		case 20:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_accept,         Sec-WebSocket-Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_capability,         Surrogate-Capability )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check_expires,         Method-Check-Expires )
-			break;
-
-		case 21:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( apply_to_redirect_ref,        Apply-To-Redirect-Ref )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_schedule_tag_match,        If-Schedule-Tag-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_version,        Sec-WebSocket-Version )
-			break;
-
-		case 22:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_control,       Authentication-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_protocol,       Sec-WebSocket-Protocol )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_max_age,       Access-Control-Max-Age )
-			break;
-
-		case 23:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_charset,      X-Device-Accept-Charset )
-			break;
-
-		case 24:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_extensions,     Sec-WebSocket-Extensions )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_encoding,     X-Device-Accept-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_language,     X-Device-Accept-Language )
-			break;
-
-		case 25:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( optional_www_authenticate,    Optional-WWW-Authenticate )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authentication_info,    Proxy-Authentication-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( strict_transport_security,    Strict-Transport-Security )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_transfer_encoding,    Content-Transfer-Encoding )
-			break;
-
-		case 27:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins_report_only,  Public-Key-Pins-Report-Only )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_origin,  Access-Control-Allow-Origin )
-			break;
-
-		case 28:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_headers, Access-Control-Allow-Headers )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_methods, Access-Control-Allow-Methods )
-			break;
-
-		case 29:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_method,    Access-Control-Request-Method )
-			break;
-
-		case 30:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_headers,   Access-Control-Request-Headers )
-			break;
-
-		case 32:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_credentials, Access-Control-Allow-Credentials )
-			break;
+		h ^= static_cast< unsigned char >( name[ i ] ) | 0x20u;
+		h *= 16777619u;
 	}
 
-#undef RESTINIO_HTTP_CHECK_FOR_FIELD
+	return h;
+}
+
+//! Index of a slot for a hash value.
+constexpr std::size_t
+slot_index( std::uint32_t h ) noexcept
+{
+	return static_cast< std::size_t >( h >> ( 32u - table_bits ) );
+}
+
+//! Length of a string literal.
+constexpr std::size_t
+length_of( const char * str ) noexcept
+{
+	std::size_t r = 0u;
+	while( str[ r ] ) ++r;
+	return r;
+}
+
+//! The seed of the hash function.
+/*!
+	It is the smallest seed without collisions for the names from
+	RESTINIO_HTTP_FIELDS_MAP. It has to be changed if the list of
+	fields is changed and the static_assert for table_t fails.
+*/
+constexpr std::uint32_t seed = 29u;
+
+//
+// table_t
+//
+
+//! Perfect hash table for names from RESTINIO_HTTP_FIELDS_MAP.
+/*!
+	The table is built at the compile time. The seed of the hash function
+	is a constant that gives no collisions between known names, this is
+	checked by static_assert below.
+
+	A slot contains the index of a field plus one or zero if there is
+	no field for that slot.
+*/
+class table_t
+{
+	public:
+		constexpr table_t() noexcept
+			:	m_names{
+#define RESTINIO_HTTP_FIELD_HASH_NAME_GEN( ignored, string_name ) #string_name,
+					RESTINIO_HTTP_FIELDS_MAP( RESTINIO_HTTP_FIELD_HASH_NAME_GEN )
+#undef RESTINIO_HTTP_FIELD_HASH_NAME_GEN
+				}
+		{
+			for( std::size_t i = 0u; i != known_fields_count; ++i )
+			{
+				m_lengths[ i ] = length_of( m_names[ i ] );
+				m_slots[ slot_index( hash( seed, m_names[ i ], m_lengths[ i ] ) ) ] =
+						static_cast< std::uint8_t >( i + 1u );
+			}
+		}
+
+		//! Are all known names placed into different slots?
+		/*!
+			A collision overwrites the slot of another name, so there are
+			fewer occupied slots than known names in that case.
+		*/
+		constexpr bool
+		is_perfect() const noexcept
+		{
+			std::size_t occupied = 0u;
+			for( std::size_t i = 0u; i != table_size; ++i )
+				if( m_slots[ i ] )
+					++occupied;
+
+			return known_fields_count == occupied;
+		}
+
+		//! Find a field by its name.
+		RESTINIO_NODISCARD
+		http_field_t
+		lookup( string_view_t name ) const noexcept
+		{
+			const auto slot = m_slots[ slot_index(
+					hash( seed, name.data(), name.size() ) ) ];
+			if( slot )
+			{
+				const std::size_t i = slot - 1u;
+				if( m_lengths[ i ] == name.size() &&
+					impl::is_equal_caseless( name.data(), m_names[ i ], name.size() ) )
+					return static_cast< http_field_t >( i );
+			}
+
+			return http_field_t::field_unspecified;
+		}
+
+	private:
+		std::uint8_t m_slots[ table_size ]{};
+		const char * m_names[ known_fields_count ];
+		std::size_t m_lengths[ known_fields_count ]{};
+};
+
+static_assert( table_t{}.is_perfect(),
+	"field_hash_details::seed gives collisions, another seed is required" );
+
+} /* namespace field_hash_details */
+
+//! Access to the perfect hash table of known field names.
+inline const field_hash_details::table_t &
+field_hash_table() noexcept
+{
+	static constexpr field_hash_details::table_t table{};
+	return table;
+}
+
+} /* namespace impl */
+
+//
+// string_to_field()
+//
 
-	return http_field_t::field_unspecified;
+//! Helper function to get method string name.
+/*!
+	Since v.0.6.14 it uses a perfect hash generated at the compile time,
+	so the lookup takes one hash calculation and one comparison of strings.
+*/
+inline http_field_t
+string_to_field( string_view_t field ) noexcept
+{
+	return impl::field_hash_table().lookup( field );
 }
 
 //
@@ -737,16 +602,33 @@ class http_header_fields_t
 			m_fields.reserve( RESTINIO_HEADER_FIELDS_DEFAULT_RESERVE_COUNT );
 		}
 		http_header_fields_t(const http_header_fields_t &) = default;
-		http_header_fields_t(http_header_fields_t &&) = default;
+		http_header_fields_t(http_header_fields_t && other) noexcept
+			:	m_fields{ std::move( other.m_fields ) }
+			,	m_known_fields_index{ other.m_known_fields_index }
+		{
+			other.clear_fields();
+		}
 		virtual ~http_header_fields_t() {}
 
 		http_header_fields_t & operator=(const http_header_fields_t &) = default;
-		http_header_fields_t & operator=(http_header_fields_t &&) = default;
+		http_header_fields_t & operator=(http_header_fields_t && other) noexcept
+		{
+			if( this != &other )
+			{
+				m_fields = std::move( other.m_fields );
+				m_known_fields_index = other.m_known_fields_index;
+				other.clear_fields();
+			}
+			return *this;
+		}
 
 		void
 		swap_fields( http_header_fields_t & http_header_fields )
 		{
 			std::swap( m_fields, http_header_fields.m_fields );
+			std::swap(
+				m_known_fields_index,
+				http_header_fields.m_known_fields_index );
 		}
 
 		//! Check field by name.
@@ -792,7 +674,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back( std::move( http_header_field ) );
+				emplace_field( std::move( http_header_field ) );
 			}
 		}
 
@@ -811,7 +693,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back(
+				emplace_field(
 					std::move( field_name ),
 					std::move( field_value ) );
 			}
@@ -837,7 +719,7 @@ class http_header_fields_t
 				}
 				else
 				{
-					m_fields.emplace_back(
+					emplace_field(
 						field_id,
 						std::move( field_value ) );
 				}
@@ -863,7 +745,7 @@ class http_header_fields_t
 		{
 			if( http_field_t::field_unspecified != field_id )
 			{
-				m_fields.emplace_back(
+				emplace_field(
 					field_id,
 					std::move( field_value ) );
 			}
@@ -883,7 +765,7 @@ class http_header_fields_t
 			std::string field_name,
 			std::string field_value )
 		{
-			m_fields.emplace_back(
+			emplace_field(
 				std::move( field_name ),
 				std::move( field_value ) );
 		}
@@ -900,7 +782,7 @@ class http_header_fields_t
 		void
 		add_field( http_header_field_t http_header_field )
 		{
-			m_fields.push_back( std::move(http_header_field) );
+			emplace_field( std::move(http_header_field) );
 		}
 
 		//! Append field with name.
@@ -917,7 +799,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back( field_name, field_value );
+				emplace_field( field_name, field_value );
 			}
 		}
 
@@ -941,7 +823,7 @@ class http_header_fields_t
 				}
 				else
 				{
-					m_fields.emplace_back( field_id, field_value );
+					emplace_field( field_id, field_value );
 				}
 			}
 		}
@@ -1178,6 +1060,7 @@ class http_header_fields_t
 			if( m_fields.end() != it )
 			{
 				m_fields.erase( it );
+				rebuild_known_fields_index();
 				return true;
 			}
 
@@ -1204,6 +1087,7 @@ class http_header_fields_t
 				if( m_fields.end() != it )
 				{
 					m_fields.erase( it );
+					rebuild_known_fields_index();
 					return true;
 				}
 			}
@@ -1232,6 +1116,9 @@ class http_header_fields_t
 					++it;
 			}
 
+			if( count )
+				rebuild_known_fields_index();
+
 			return count;
 		}
 
@@ -1259,6 +1146,9 @@ class http_header_fields_t
 				}
 			}
 
+			if( count )
+				rebuild_known_fields_index();
+
 			return count;
 		}
 
@@ -1511,42 +1401,102 @@ class http_header_fields_t
 			m_fields.back().append_value( field_value );
 		}
 
+		//! Add a new field to the end of the list.
+		template< typename... Args >
+		void
+		emplace_field( Args && ...args )
+		{
+			m_fields.emplace_back( std::forward< Args >( args )... );
+
+			const auto id = m_fields.back().field_id();
+			if( http_field_t::field_unspecified != id )
+			{
+				auto & position = m_known_fields_index[
+						static_cast< std::size_t >( id ) ];
+				if( 0u == position )
+					position = make_index_position( m_fields.size() );
+			}
+		}
+
+		//! Make a value for the index from a position of a field plus one.
+		static std::uint8_t
+		make_index_position( std::size_t position ) noexcept
+		{
+			return position < std::size_t{ overflowed_position } ?
+					static_cast< std::uint8_t >( position ) :
+					std::uint8_t{ overflowed_position };
+		}
+
+		//! Remove all fields.
+		void
+		clear_fields() noexcept
+		{
+			m_fields.clear();
+			m_known_fields_index.fill( 0u );
+		}
+
+		//! Recreate the index after removal of fields.
+		void
+		rebuild_known_fields_index() noexcept
+		{
+			m_known_fields_index.fill( 0u );
+
+			std::size_t position = 0u;
+			for( const auto & f : m_fields )
+			{
+				++position;
+				if( http_field_t::field_unspecified != f.field_id() )
+				{
+					auto & item = m_known_fields_index[
+							static_cast< std::size_t >( f.field_id() ) ];
+					if( 0u == item )
+						item = make_index_position( position );
+				}
+			}
+		}
+
 		fields_container_t::iterator
 		find( string_view_t field_name ) noexcept
 		{
-			return std::find_if(
-				m_fields.begin(),
-				m_fields.end(),
-				[&]( const auto & f ){
-					return impl::is_equal_caseless( f.name(), field_name );
-				} );
+			return m_fields.begin() + ( cfind( field_name ) - m_fields.cbegin() );
 		}
 
 		fields_container_t::const_iterator
 		cfind( string_view_t field_name ) const noexcept
 		{
+			// A known name can be found via the index.
+			const auto field_id = string_to_field( field_name );
+			if( http_field_t::field_unspecified != field_id )
+				return cfind( field_id );
+
 			return std::find_if(
 				m_fields.cbegin(),
 				m_fields.cend(),
 				[&]( const auto & f ){
-					return impl::is_equal_caseless( f.name(), field_name );
+					return http_field_t::field_unspecified == f.field_id() &&
+						impl::is_equal_caseless( f.name(), field_name );
 				} );
 		}
 
 		fields_container_t::iterator
 		find( http_field_t field_id ) noexcept
 		{
-			return std::find_if(
-				m_fields.begin(),
-				m_fields.end(),
-				[&]( const auto & f ){
-					return f.field_id() == field_id;
-				} );
+			return m_fields.begin() + ( cfind( field_id ) - m_fields.cbegin() );
 		}
 
 		fields_container_t::const_iterator
 		cfind( http_field_t field_id ) const noexcept
 		{
+			if( http_field_t::field_unspecified != field_id )
+			{
+				const auto position = m_known_fields_index[
+						static_cast< std::size_t >( field_id ) ];
+				if( 0u == position )
+					return m_fields.cend();
+				if( overflowed_position != position )
+					return m_fields.cbegin() + ( position - 1u );
+			}
+
 			return std::find_if(
 				m_fields.cbegin(),
 				m_fields.cend(),
@@ -1556,6 +1506,32 @@ class http_header_fields_t
 		}
 
 		fields_container_t m_fields;
+
+		//! Type of index of known fields.
+		/*!
+			An item contains the position of the first occurrence of
+			the corresponding field plus one. Zero means that there is
+			no such field.
+
+			@since v.0.6.14
+		*/
+		using known_fields_index_t = std::array<
+				std::uint8_t,
+				impl::field_hash_details::known_fields_count >;
+
+		//! Special position for fields located too far from the beginning.
+		/*!
+			Such fields are searched by linear scan.
+
+			@since v.0.6.14
+		*/
+		enum : std::uint8_t { overflowed_position = 0xFFu };
+
+		//! Positions of known fields for O(1) lookup.
+		/*!
+			@since v.0.6.14
+		*/
+		known_fields_index_t m_known_fields_index{};
 };
 
 //
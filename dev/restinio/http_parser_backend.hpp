@@ -0,0 +1,1040 @@
+/*
+	restinio
+*/
+
+/*!
+	@file
+	@brief Backends for parsing incoming HTTP/1.x requests.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <http_parser.h>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <restinio/impl/http_parser_ctx.hpp>
+#include <restinio/impl/http_parser_simd.hpp>
+#include <restinio/impl/string_caseless_compare.hpp>
+
+#include <restinio/utils/impl/safe_uint_truncate.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <limits>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//! Include parser callbacks.
+#include "impl/parser_callbacks.ipp"
+
+//
+// create_parser_settings()
+//
+
+//! Helper for setting parser settings.
+inline http_parser_settings
+create_parser_settings() noexcept
+{
+	http_parser_settings parser_settings;
+	http_parser_settings_init( &parser_settings );
+
+	parser_settings.on_message_begin =
+		[]( http_parser * parser ) -> int {
+			return restinio_message_begin_cb( parser );
+		};
+
+	parser_settings.on_url =
+		[]( http_parser * parser, const char * at, size_t length ) -> int {
+			return restinio_url_cb( parser, at, length );
+		};
+
+	parser_settings.on_header_field =
+		[]( http_parser * parser, const char * at, size_t length ) -> int {
+			return restinio_header_field_cb( parser, at, length );
+		};
+
+	parser_settings.on_header_value =
+			[]( http_parser * parser, const char * at, size_t length ) -> int {
+			return restinio_header_value_cb( parser, at, length );
+		};
+
+	parser_settings.on_headers_complete =
+		[]( http_parser * parser ) -> int {
+			return restinio_headers_complete_cb( parser );
+		};
+
+	parser_settings.on_body =
+		[]( http_parser * parser, const char * at, size_t length ) -> int {
+			return restinio_body_cb( parser, at, length );
+		};
+
+	parser_settings.on_chunk_header =
+		[]( http_parser * parser ) -> int {
+			return restinio_chunk_header_cb( parser );
+		};
+
+	parser_settings.on_chunk_complete =
+		[]( http_parser * parser ) -> int {
+			return restinio_chunk_complete_cb( parser );
+		};
+
+	parser_settings.on_message_complete =
+		[]( http_parser * parser ) -> int {
+			return restinio_message_complete_cb( parser );
+		};
+
+	return parser_settings;
+}
+
+} /* namespace impl */
+
+namespace http_parser_backend
+{
+
+//
+// nodejs_backend_t
+//
+
+/*!
+ * @brief A backend that uses nodejs/http_parser.
+ *
+ * It is the default backend.
+ *
+ * Every parser backend should have the following interface:
+ * @code
+ * class some_backend_t
+ * {
+ * public:
+ * 	// Backend is created once per connection.
+ * 	explicit some_backend_t( restinio::incoming_http_msg_limits_t limits );
+ *
+ * 	// Prepare for parsing a new message.
+ * 	void reset();
+ *
+ * 	// Parse the next portion of data. Returns the number of bytes
+ * 	// consumed. The parsing stops right after the end of the message
+ * 	// (the rest of data belongs to the next pipelined request).
+ * 	std::size_t parse( const char * data, std::size_t length );
+ *
+ * 	// Results of the parsing. Flags m_message_started and
+ * 	// m_message_complete of the context should be maintained
+ * 	// by the backend.
+ * 	restinio::impl::http_parser_ctx_t & ctx() noexcept;
+ * 	const restinio::impl::http_parser_ctx_t & ctx() const noexcept;
+ *
+ * 	bool is_error() const noexcept;
+ * 	std::string error_description() const;
+ *
+ * 	// These values are valid only when the message is complete.
+ * 	// Method is reported as nodejs/http_parser's http_method value.
+ * 	int method() const noexcept;
+ * 	bool is_upgrade() const noexcept;
+ * 	bool should_keep_alive() const noexcept;
+ *
+ * 	// The number of bytes of the current message already parsed.
+ * 	std::uint64_t bytes_parsed() const noexcept;
+ * };
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class nodejs_backend_t
+{
+	public:
+		explicit nodejs_backend_t( incoming_http_msg_limits_t limits )
+			:	m_ctx{ limits }
+		{
+			reset();
+		}
+
+		nodejs_backend_t( const nodejs_backend_t & ) = delete;
+		nodejs_backend_t & operator=( const nodejs_backend_t & ) = delete;
+
+		void
+		reset()
+		{
+			// Reinit parser.
+			http_parser_init( &m_parser, HTTP_REQUEST );
+
+			// Reset context and attach it to parser.
+			m_ctx.reset();
+			m_parser.data = &m_ctx;
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		parse( const char * data, std::size_t length )
+		{
+			return http_parser_execute( &m_parser, &settings(), data, length );
+		}
+
+		RESTINIO_NODISCARD
+		impl::http_parser_ctx_t &
+		ctx() noexcept { return m_ctx; }
+
+		RESTINIO_NODISCARD
+		const impl::http_parser_ctx_t &
+		ctx() const noexcept { return m_ctx; }
+
+		RESTINIO_NODISCARD
+		bool
+		is_error() const noexcept
+		{
+			return HPE_OK != m_parser.http_errno &&
+					HPE_PAUSED != m_parser.http_errno;
+		}
+
+		RESTINIO_NODISCARD
+		std::string
+		error_description() const
+		{
+			const auto err = HTTP_PARSER_ERRNO( &m_parser );
+			return fmt::format( "{}: {}",
+					http_errno_name( err ),
+					http_errno_description( err ) );
+		}
+
+		RESTINIO_NODISCARD
+		int
+		method() const noexcept { return static_cast< int >( m_parser.method ); }
+
+		RESTINIO_NODISCARD
+		bool
+		is_upgrade() const noexcept { return 0 != m_parser.upgrade; }
+
+		RESTINIO_NODISCARD
+		bool
+		should_keep_alive() const noexcept
+		{
+			return 0 != http_should_keep_alive( &m_parser );
+		}
+
+		RESTINIO_NODISCARD
+		std::uint64_t
+		bytes_parsed() const noexcept { return m_parser.nread; }
+
+	private:
+		//! Parser settings are common for all connections.
+		static const http_parser_settings &
+		settings() noexcept
+		{
+			static const http_parser_settings parser_settings =
+					impl::create_parser_settings();
+			return parser_settings;
+		}
+
+		http_parser m_parser;
+		impl::http_parser_ctx_t m_ctx;
+};
+
+namespace fast_backend_details
+{
+
+//! Is a byte a tchar from RFC 7230.
+RESTINIO_NODISCARD
+constexpr bool
+is_token_char( char ch ) noexcept
+{
+	return ( ch >= 'a' && ch <= 'z' ) || ( ch >= 'A' && ch <= 'Z' ) ||
+			( ch >= '0' && ch <= '9' ) ||
+			'!' == ch || '#' == ch || '$' == ch || '%' == ch || '&' == ch ||
+			'\'' == ch || '*' == ch || '+' == ch || '-' == ch || '.' == ch ||
+			'^' == ch || '_' == ch || '`' == ch || '|' == ch || '~' == ch;
+}
+
+RESTINIO_NODISCARD
+constexpr bool
+is_ows( char ch ) noexcept
+{
+	return ' ' == ch || '\t' == ch;
+}
+
+//! Get nodejs/http_parser's method value for a token.
+/*!
+	@return -1 for unknown methods.
+*/
+RESTINIO_NODISCARD
+inline int
+method_from_token( string_view_t token ) noexcept
+{
+#define RESTINIO_HTTP_METHOD_FROM_TOKEN(num, name, str) \
+	if( token == string_view_t{ #str } ) return HTTP_##name;
+
+	HTTP_METHOD_MAP( RESTINIO_HTTP_METHOD_FROM_TOKEN )
+
+#undef RESTINIO_HTTP_METHOD_FROM_TOKEN
+
+	return -1;
+}
+
+//! Does a comma-separated list contain a token (case-insensitive).
+RESTINIO_NODISCARD
+inline bool
+contains_token( string_view_t list, string_view_t token ) noexcept
+{
+	while( !list.empty() )
+	{
+		const auto comma = list.find( ',' );
+		auto item = list.substr( 0u, comma );
+		list = string_view_t::npos == comma ?
+				string_view_t{} : list.substr( comma + 1u );
+
+		while( !item.empty() && is_ows( item.front() ) )
+			item.remove_prefix( 1u );
+		while( !item.empty() && is_ows( item.back() ) )
+			item.remove_suffix( 1u );
+
+		if( impl::is_equal_caseless( item, token ) )
+			return true;
+	}
+
+	return false;
+}
+
+//! Is the last item of a comma-separated list is a token.
+RESTINIO_NODISCARD
+inline bool
+last_token_is( string_view_t list, string_view_t token ) noexcept
+{
+	const auto comma = list.rfind( ',' );
+	auto item = string_view_t::npos == comma ?
+			list : list.substr( comma + 1u );
+
+	while( !item.empty() && is_ows( item.front() ) )
+		item.remove_prefix( 1u );
+
+	return impl::is_equal_caseless( item, token );
+}
+
+//! Parse a non-negative decimal number without sign and spaces.
+RESTINIO_NODISCARD
+inline bool
+parse_decimal( string_view_t what, std::uint64_t & result ) noexcept
+{
+	if( what.empty() )
+		return false;
+
+	std::uint64_t r = 0u;
+	for( const char ch : what )
+	{
+		if( ch < '0' || ch > '9' )
+			return false;
+
+		const auto digit = static_cast< std::uint64_t >( ch - '0' );
+		if( r > ( std::numeric_limits< std::uint64_t >::max() - digit ) / 10u )
+			return false;
+
+		r = r * 10u + digit;
+	}
+
+	result = r;
+	return true;
+}
+
+} /* namespace fast_backend_details */
+
+//
+// fast_backend_t
+//
+
+/*!
+ * @brief An alternative backend that parses the whole header block
+ * in one pass.
+ *
+ * Unlike nodejs/http_parser (that works byte by byte and calls
+ * a callback for every fragment of a request) this backend at first
+ * finds the end of the header block and then extracts the request line
+ * and header fields from it. Delimiters are found by SIMD instructions
+ * (AVX2 or SSE4.2 if they are enabled for the compilation, see
+ * restinio::impl::http_parser_simd) with the scalar fallback.
+ *
+ * If the whole header block is in the input buffer it is parsed
+ * in place. Otherwise the received part is copied to an internal buffer
+ * until the end of the header block arrives.
+ *
+ * Bodies with `Content-Length` and with `Transfer-Encoding: chunked`
+ * (including trailing fields) are supported.
+ *
+ * The backend is stricter than nodejs/http_parser: lines must be
+ * terminated by CRLF and obsolete line folding isn't supported.
+ *
+ * Usage example:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using http_parser_backend_t = restinio::http_parser_backend::fast_backend_t;
+ * };
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class fast_backend_t
+{
+	public:
+		//! Max size of header block (the same as in nodejs/http_parser).
+		static constexpr std::size_t max_header_block_size = 80u * 1024u;
+
+		//! Max size of chunk-size line (with chunk extensions).
+		static constexpr std::size_t max_chunk_size_line = 1024u;
+
+		explicit fast_backend_t( incoming_http_msg_limits_t limits )
+			:	m_ctx{ limits }
+		{
+			reset();
+		}
+
+		fast_backend_t( const fast_backend_t & ) = delete;
+		fast_backend_t & operator=( const fast_backend_t & ) = delete;
+
+		void
+		reset()
+		{
+			m_ctx.reset();
+			m_state = state_t::request_start;
+			m_error = "";
+			m_block.clear();
+			m_method = -1;
+			m_upgrade = false;
+			m_keep_alive = false;
+			m_bytes_parsed = 0u;
+			m_body_remaining = 0u;
+			m_crlf_remaining = 0u;
+		}
+
+		RESTINIO_NODISCARD
+		std::size_t
+		parse( const char * data, std::size_t length )
+		{
+			std::size_t consumed = 0u;
+
+			while( consumed != length &&
+				state_t::message_complete != m_state &&
+				state_t::error != m_state )
+			{
+				consumed += parse_step( data + consumed, length - consumed );
+			}
+
+			return consumed;
+		}
+
+		RESTINIO_NODISCARD
+		impl::http_parser_ctx_t &
+		ctx() noexcept { return m_ctx; }
+
+		RESTINIO_NODISCARD
+		const impl::http_parser_ctx_t &
+		ctx() const noexcept { return m_ctx; }
+
+		RESTINIO_NODISCARD
+		bool
+		is_error() const noexcept { return state_t::error == m_state; }
+
+		RESTINIO_NODISCARD
+		std::string
+		error_description() const { return m_error; }
+
+		RESTINIO_NODISCARD
+		int
+		method() const noexcept { return m_method; }
+
+		RESTINIO_NODISCARD
+		bool
+		is_upgrade() const noexcept { return m_upgrade; }
+
+		RESTINIO_NODISCARD
+		bool
+		should_keep_alive() const noexcept { return m_keep_alive; }
+
+		RESTINIO_NODISCARD
+		std::uint64_t
+		bytes_parsed() const noexcept { return m_bytes_parsed; }
+
+	private:
+		enum class state_t
+		{
+			//! Skipping CRLF before the request line.
+			request_start,
+			header_block,
+			identity_body,
+			chunk_size_line,
+			chunk_data,
+			chunk_data_crlf,
+			trailers,
+			message_complete,
+			error
+		};
+
+		//! Flags from header fields.
+		struct header_flags_t
+		{
+			bool m_has_content_length{ false };
+			std::uint64_t m_content_length{ 0u };
+			bool m_chunked{ false };
+			bool m_has_upgrade{ false };
+			bool m_connection_close{ false };
+			bool m_connection_keep_alive{ false };
+			bool m_connection_upgrade{ false };
+		};
+
+		RESTINIO_NODISCARD
+		std::size_t
+		parse_step( const char * data, std::size_t length )
+		{
+			std::size_t consumed = 0u;
+
+			switch( m_state )
+			{
+				case state_t::request_start:
+					// Like nodejs/http_parser empty lines before
+					// the request line are ignored.
+					while( consumed != length &&
+						( '\r' == data[ consumed ] || '\n' == data[ consumed ] ) )
+						++consumed;
+
+					if( consumed != length )
+					{
+						m_state = state_t::header_block;
+						m_ctx.m_message_started = true;
+					}
+
+					// Skipped bytes aren't treated as a part of the request.
+					return consumed;
+
+				case state_t::header_block:
+					consumed = consume_block(
+							data, length, 0u,
+							[this]( const char * first, const char * last ) {
+								handle_header_block( first, last );
+							} );
+				break;
+
+				case state_t::identity_body:
+					consumed = consume_body_bytes( data, length );
+					if( 0u == m_body_remaining )
+						complete_message();
+				break;
+
+				case state_t::chunk_size_line:
+					consumed = consume_chunk_size_line( data, length );
+				break;
+
+				case state_t::chunk_data:
+					consumed = consume_body_bytes( data, length );
+					if( 0u == m_body_remaining )
+					{
+						m_state = state_t::chunk_data_crlf;
+						m_crlf_remaining = 2u;
+					}
+				break;
+
+				case state_t::chunk_data_crlf:
+					consumed = consume_crlf( data, length );
+					if( 0u == m_crlf_remaining )
+						start_chunk_size_line();
+				break;
+
+				case state_t::trailers:
+					// The trailer section is seeded by CRLF of the last
+					// chunk-size line, so the end of the section
+					// is always "\r\n\r\n".
+					consumed = consume_block(
+							data, length, 2u,
+							[this]( const char * first, const char * last ) {
+								handle_trailers( first, last );
+							} );
+				break;
+
+				case state_t::message_complete:
+				case state_t::error:
+				break;
+			}
+
+			m_bytes_parsed += consumed;
+
+			return consumed;
+		}
+
+		//! Accumulate data until the end of a block ("\r\n\r\n").
+		/*!
+			If the block is entirely in @a data then it is handled
+			in place, without copying.
+
+			@a seed_size is the number of bytes already in m_block
+			that isn't a part of the incoming data.
+		*/
+		template< typename Handler >
+		std::size_t
+		consume_block(
+			const char * data,
+			std::size_t length,
+			std::size_t seed_size,
+			Handler && handler )
+		{
+			namespace simd = impl::http_parser_simd;
+
+			if( m_block.empty() )
+			{
+				// The search is limited the same way as for the copied
+				// block, so an oversized block is rejected below.
+				const auto to_search = std::min(
+						length, max_header_block_size + seed_size + 1u );
+				const char * end =
+						simd::find_header_block_end( data, data + to_search );
+				if( end )
+				{
+					handler( data, end );
+					return static_cast< std::size_t >( end - data );
+				}
+			}
+
+			const auto old_size = m_block.size();
+			const auto available = max_header_block_size + seed_size - old_size;
+			// One extra byte to detect the overflow.
+			const auto to_copy = std::min( length, available + 1u );
+			m_block.append( data, to_copy );
+
+			// The end can start in the previous part.
+			const auto search_from = old_size < 3u ? 0u : old_size - 3u;
+			const char * end = simd::find_header_block_end(
+					m_block.data() + search_from,
+					m_block.data() + m_block.size() );
+
+			if( !end )
+			{
+				if( m_block.size() > max_header_block_size + seed_size )
+					set_error( "HPE_HEADER_OVERFLOW: header size overflow" );
+
+				return to_copy;
+			}
+
+			const auto block_size =
+					static_cast< std::size_t >( end - m_block.data() );
+
+			handler( m_block.data(), end );
+			m_block.clear();
+
+			return block_size - old_size;
+		}
+
+		void
+		set_error( const char * description ) noexcept
+		{
+			m_state = state_t::error;
+			m_error = description;
+		}
+
+		//! Parse the request line and header fields.
+		/*!
+			[first, last) ends with "\r\n\r\n".
+		*/
+		void
+		handle_header_block( const char * first, const char * last )
+		{
+			using namespace fast_backend_details;
+
+			const auto & limits = m_ctx.m_limits;
+
+			// Method.
+			const char * p = first;
+			while( is_token_char( *p ) )
+				++p;
+
+			m_method = method_from_token(
+					string_view_t{ first, static_cast< std::size_t >( p - first ) } );
+			if( m_method < 0 || ' ' != *p )
+				return set_error( "HPE_INVALID_METHOD: invalid HTTP method" );
+
+			// Request-target.
+			const char * target = ++p;
+			p = impl::http_parser_simd::find_target_end( p, last );
+			if( p == target || ' ' != *p )
+				return set_error( "HPE_INVALID_URL: invalid URL" );
+
+			const auto target_size = static_cast< std::size_t >( p - target );
+			if( target_size > limits.max_url_size() )
+				return set_error( "HPE_CB_url: URL is too long" );
+
+			m_ctx.m_header.append_request_target( target, target_size );
+
+			// HTTP-version.
+			++p;
+			if( p[ 0 ] != 'H' || p[ 1 ] != 'T' || p[ 2 ] != 'T' ||
+				p[ 3 ] != 'P' || p[ 4 ] != '/' ||
+				p[ 5 ] < '0' || p[ 5 ] > '9' || p[ 6 ] != '.' ||
+				p[ 7 ] < '0' || p[ 7 ] > '9' ||
+				p[ 8 ] != '\r' || p[ 9 ] != '\n' )
+				return set_error( "HPE_INVALID_VERSION: invalid HTTP version" );
+
+			const auto http_major = static_cast< std::uint16_t >( p[ 5 ] - '0' );
+			const auto http_minor = static_cast< std::uint16_t >( p[ 7 ] - '0' );
+			m_ctx.m_header.http_major( http_major );
+			m_ctx.m_header.http_minor( http_minor );
+			p += 10;
+
+			header_flags_t flags;
+			if( !parse_fields( p, last, m_ctx.m_header, &flags ) )
+				return;
+
+			m_ctx.m_leading_headers_completed = true;
+
+			if( flags.m_chunked && flags.m_has_content_length )
+				return set_error(
+						"HPE_UNEXPECTED_CONTENT_LENGTH: "
+						"unexpected content-length header" );
+
+			m_upgrade = ( flags.m_has_upgrade && flags.m_connection_upgrade ) ||
+					HTTP_CONNECT == m_method;
+
+			if( http_major > 0u && http_minor > 0u )
+				m_keep_alive = !flags.m_connection_close;
+			else
+				m_keep_alive = flags.m_connection_keep_alive;
+
+			const bool has_body = flags.m_chunked ||
+					( flags.m_has_content_length && 0u != flags.m_content_length );
+
+			if( !has_body || ( m_upgrade && HTTP_CONNECT == m_method ) )
+				// The rest of data (if any) is in a different protocol
+				// for upgrade requests.
+				return complete_message();
+
+			if( flags.m_chunked )
+				return start_chunk_size_line();
+
+			if( flags.m_content_length > limits.max_body_size() )
+				return set_error( "HPE_CB_headers_complete: body is too long" );
+
+			m_ctx.m_body.reserve(
+					::restinio::utils::impl::uint64_to_size_t(
+							flags.m_content_length ) );
+			m_body_remaining = flags.m_content_length;
+			m_state = state_t::identity_body;
+		}
+
+		//! Parse header fields.
+		/*!
+			[first, last) ends with "\r\n\r\n" or is just "\r\n".
+
+			@return false in the case of an error.
+		*/
+		bool
+		parse_fields(
+			const char * p,
+			const char * last,
+			http_header_fields_t & fields,
+			header_flags_t * flags )
+		{
+			using namespace fast_backend_details;
+
+			const auto & limits = m_ctx.m_limits;
+
+			// The last line is empty.
+			while( p != last - 2 )
+			{
+				// Field name.
+				const char * name = p;
+				while( is_token_char( *p ) )
+					++p;
+
+				const auto name_size = static_cast< std::size_t >( p - name );
+				if( 0u == name_size || ':' != *p )
+				{
+					set_error( "HPE_INVALID_HEADER_TOKEN: "
+							"invalid character in header" );
+					return false;
+				}
+
+				if( m_ctx.m_total_field_count == limits.max_field_count() )
+				{
+					set_error( "HPE_CB_header_field: too many header fields" );
+					return false;
+				}
+
+				if( name_size > limits.max_field_name_size() )
+				{
+					set_error( "HPE_CB_header_field: header name is too long" );
+					return false;
+				}
+
+				// Field value.
+				++p;
+				while( is_ows( *p ) )
+					++p;
+
+				const char * value = p;
+				p = impl::http_parser_simd::find_value_end( p, last );
+				if( '\r' != p[ 0 ] || '\n' != p[ 1 ] || is_ows( p[ 2 ] ) )
+				{
+					// Obsolete line folding isn't supported.
+					set_error( "HPE_INVALID_HEADER_TOKEN: "
+							"invalid character in header" );
+					return false;
+				}
+
+				const char * value_end = p;
+				while( value_end != value && is_ows( value_end[ -1 ] ) )
+					--value_end;
+
+				const auto value_size = static_cast< std::size_t >(
+						value_end - value );
+				if( value_size >= limits.max_field_value_size() )
+				{
+					set_error( "HPE_CB_header_value: header value is too long" );
+					return false;
+				}
+
+				p += 2;
+
+				const string_view_t name_sv{ name, name_size };
+				const string_view_t value_sv{ value, value_size };
+
+				if( flags && !handle_special_field( name_sv, value_sv, *flags ) )
+					return false;
+
+				fields.add_field(
+						std::string{ name_sv.data(), name_sv.size() },
+						std::string{ value_sv.data(), value_sv.size() } );
+				m_ctx.m_total_field_count += 1u;
+			}
+
+			return true;
+		}
+
+		//! Handle fields that affect the parsing.
+		bool
+		handle_special_field(
+			string_view_t name,
+			string_view_t value,
+			header_flags_t & flags )
+		{
+			using namespace fast_backend_details;
+
+			if( impl::is_equal_caseless( name, "Content-Length" ) )
+			{
+				if( flags.m_has_content_length )
+				{
+					set_error( "HPE_UNEXPECTED_CONTENT_LENGTH: "
+							"unexpected content-length header" );
+					return false;
+				}
+
+				if( !parse_decimal( value, flags.m_content_length ) )
+				{
+					set_error( "HPE_INVALID_CONTENT_LENGTH: "
+							"invalid character in content-length header" );
+					return false;
+				}
+
+				flags.m_has_content_length = true;
+			}
+			else if( impl::is_equal_caseless( name, "Transfer-Encoding" ) )
+			{
+				// Only chunked as the final encoding is supported
+				// for requests.
+				if( !last_token_is( value, "chunked" ) )
+				{
+					set_error( "HPE_INVALID_TRANSFER_ENCODING: "
+							"request has invalid transfer-encoding" );
+					return false;
+				}
+
+				flags.m_chunked = true;
+			}
+			else if( impl::is_equal_caseless( name, "Connection" ) )
+			{
+				flags.m_connection_close |= contains_token( value, "close" );
+				flags.m_connection_keep_alive |=
+						contains_token( value, "keep-alive" );
+				flags.m_connection_upgrade |= contains_token( value, "upgrade" );
+			}
+			else if( impl::is_equal_caseless( name, "Upgrade" ) )
+			{
+				flags.m_has_upgrade = true;
+			}
+
+			return true;
+		}
+
+		//! Copy bytes of the body.
+		std::size_t
+		consume_body_bytes( const char * data, std::size_t length )
+		{
+			const auto size = static_cast< std::size_t >(
+					std::min< std::uint64_t >( m_body_remaining, length ) );
+
+			if( static_cast< std::uint64_t >( m_ctx.m_body.size() ) + size >
+					m_ctx.m_limits.max_body_size() )
+			{
+				set_error( "HPE_CB_body: body is too long" );
+				return 0u;
+			}
+
+			m_ctx.m_body.append( data, size );
+			m_body_remaining -= size;
+
+			return size;
+		}
+
+		//! Expect CRLF after the data of a chunk.
+		std::size_t
+		consume_crlf( const char * data, std::size_t length )
+		{
+			std::size_t consumed = 0u;
+			while( 0u != m_crlf_remaining && consumed != length )
+			{
+				const char expected = 2u == m_crlf_remaining ? '\r' : '\n';
+				if( expected != data[ consumed ] )
+				{
+					set_error( "HPE_LF_expected: LF character expected" );
+					return consumed;
+				}
+
+				++consumed;
+				--m_crlf_remaining;
+			}
+
+			return consumed;
+		}
+
+		void
+		start_chunk_size_line()
+		{
+			m_block.clear();
+			m_state = state_t::chunk_size_line;
+		}
+
+		//! Accumulate and parse chunk-size line.
+		std::size_t
+		consume_chunk_size_line( const char * data, std::size_t length )
+		{
+			const auto * lf = static_cast< const char * >(
+					std::memchr( data, '\n', length ) );
+			const auto consumed = lf ?
+					static_cast< std::size_t >( lf - data ) + 1u : length;
+
+			if( m_block.size() + consumed > max_chunk_size_line )
+			{
+				set_error( "HPE_INVALID_CHUNK_SIZE: "
+						"invalid character in chunk size header" );
+				return consumed;
+			}
+
+			m_block.append( data, consumed );
+			if( lf )
+				handle_chunk_size_line();
+
+			return consumed;
+		}
+
+		void
+		handle_chunk_size_line()
+		{
+			const string_view_t line{ m_block };
+
+			std::uint64_t chunk_size = 0u;
+			std::size_t i = 0u;
+			for( ; i != line.size(); ++i )
+			{
+				const char ch = line[ i ];
+				unsigned digit;
+				if( ch >= '0' && ch <= '9' )
+					digit = static_cast< unsigned >( ch - '0' );
+				else if( ch >= 'a' && ch <= 'f' )
+					digit = static_cast< unsigned >( ch - 'a' + 10 );
+				else if( ch >= 'A' && ch <= 'F' )
+					digit = static_cast< unsigned >( ch - 'A' + 10 );
+				else
+					break;
+
+				if( chunk_size > ( std::numeric_limits< std::uint64_t >::max() >> 4 ) )
+					return set_error( "HPE_INVALID_CONTENT_LENGTH: "
+							"invalid character in content-length header" );
+
+				chunk_size = ( chunk_size << 4 ) | digit;
+			}
+
+			// Chunk extensions are ignored.
+			const bool valid_end = line.size() >= 2u &&
+					'\r' == line[ line.size() - 2u ] &&
+					( i == line.size() - 2u || ';' == line[ i ] ||
+						fast_backend_details::is_ows( line[ i ] ) );
+			if( 0u == i || !valid_end )
+				return set_error( "HPE_INVALID_CHUNK_SIZE: "
+						"invalid character in chunk size header" );
+
+			if( 0u == chunk_size )
+			{
+				// The last chunk. Trailer section follows.
+				m_block.assign( "\r\n" );
+				m_state = state_t::trailers;
+				return;
+			}
+
+			if( static_cast< std::uint64_t >( m_ctx.m_body.size() ) + chunk_size >
+					m_ctx.m_limits.max_body_size() )
+				return set_error( "HPE_CB_body: body is too long" );
+
+			m_ctx.m_chunked_info_block.m_chunks.emplace_back(
+					m_ctx.m_body.size(),
+					::restinio::utils::impl::uint64_to_size_t( chunk_size ) );
+
+			m_body_remaining = chunk_size;
+			m_state = state_t::chunk_data;
+		}
+
+		//! Parse trailing fields.
+		/*!
+			[first, last) starts with CRLF and ends with "\r\n\r\n".
+		*/
+		void
+		handle_trailers( const char * first, const char * last )
+		{
+			if( parse_fields(
+					first + 2, last,
+					m_ctx.m_chunked_info_block.m_trailing_fields,
+					nullptr ) )
+				complete_message();
+		}
+
+		void
+		complete_message() noexcept
+		{
+			m_ctx.m_message_complete = true;
+			m_ctx.m_message_started = false;
+			m_state = state_t::message_complete;
+		}
+
+		impl::http_parser_ctx_t m_ctx;
+
+		state_t m_state{ state_t::request_start };
+
+		//! Description of the last error.
+		const char * m_error{ "" };
+
+		//! Buffer for incomplete header block, chunk-size line
+		//! or trailer section.
+		std::string m_block;
+
+		int m_method{ -1 };
+		bool m_upgrade{ false };
+		bool m_keep_alive{ false };
+
+		std::uint64_t m_bytes_parsed{ 0u };
+
+		//! Remaining bytes of the body or of the current chunk.
+		std::uint64_t m_body_remaining{ 0u };
+
+		//! Remaining bytes of CRLF after chunk data.
+		std::size_t m_crlf_remaining{ 0u };
+};
+
+} /* namespace http_parser_backend */
+
+} /* namespace restinio */
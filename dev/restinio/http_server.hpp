@@ -14,6 +14,8 @@
 #include <restinio/impl/acceptor.hpp>
 #include <restinio/traits.hpp>
 
+#include <chrono>
+#include <functional>
 #include <memory>
 
 namespace restinio
@@ -93,6 +95,32 @@ external_io_context( asio_ns::io_context & ctx )
 	};
 }
 
+//
+// drain_progress_t
+//
+/*!
+ * \brief Information about the progress of the drain of http_server.
+ *
+ * \see http_server_t::drain_async()
+ *
+ * \since v.0.6.14
+ */
+struct drain_progress_t
+{
+	//! Count of connections that are still alive.
+	std::size_t m_alive_connections;
+
+	//! Is the drain finished?
+	/*!
+	 * It's the last notification for the drain. The server is
+	 * closed at this moment.
+	 */
+	bool m_finished;
+
+	//! Were the remaining connections closed because of the deadline?
+	bool m_deadline_expired;
+};
+
 //
 // http_server_t
 //
@@ -163,6 +191,25 @@ external_io_context( asio_ns::io_context & ctx )
 	// Wait while server_thread finishes its work.
 	server_thread.join();
 	\endcode
+
+	Since v.0.6.14 a server can be stopped gracefully by
+	http_server_t::drain_async(). The server stops accepting new
+	connections, sends `Connection: close` in the next response of
+	every live connection and waits while the connections are closed:
+	\code
+	server.drain_async(
+			// Wait for connections at most 30 seconds.
+			std::chrono::seconds{ 30 },
+			// Progress callback.
+			[&]( const restinio::drain_progress_t & progress ) {
+				if( progress.m_finished )
+					server.io_context().stop();
+			},
+			// Error callback. Rethrow an exception.
+			[]( auto ex_ptr ) {
+				std::rethrow_exception( ex_ptr );
+			} );
+	\endcode
 */
 template < typename Traits = default_traits_t >
 class http_server_t
@@ -172,6 +219,8 @@ class http_server_t
 		using acceptor_t = impl::acceptor_t< Traits >;
 		using timer_manager_t = typename Traits::timer_manager_t;
 		using timer_manager_handle_t = std::shared_ptr< timer_manager_t >;
+		using connection_registry_handle_t = std::shared_ptr<
+				typename connection_settings_t::connection_registry_t >;
 
 	public:
 		/*!
@@ -197,6 +246,10 @@ class http_server_t
 			settings.ensure_valid_connection_state_listener();
 			// The presence of IP-blocker should also be checked.
 			settings.ensure_valid_ip_blocker();
+			// The presence of metrics object should also be checked.
+			settings.ensure_valid_metrics();
+			// The presence of request tracer should also be checked.
+			settings.ensure_valid_request_tracer();
 
 			// Now we can continue preparation of HTTP server.
 
@@ -208,9 +261,10 @@ class http_server_t
 			auto conn_settings =
 				std::make_shared< connection_settings_t >(
 					std::forward< actual_settings_type >(settings),
-					impl::create_parser_settings< typename Traits::http_methods_mapper_t >(),
 					m_timer_manager );
 
+			m_connection_registry = conn_settings->m_connection_registry;
+
 			m_acceptor =
 				std::make_shared< acceptor_t >(
 					settings,
@@ -241,6 +295,10 @@ class http_server_t
 		//! It is allowed to inherit from http_server_t
 		virtual ~http_server_t()
 		{
+			// The drain progress callback isn't called from the destructor.
+			if( m_drain )
+				m_drain->m_progress_cb = nullptr;
+
 			// Ensure server is closed after destruction of http_server instance.
 			close_sync();
 		}
@@ -354,6 +412,81 @@ class http_server_t
 				call_cleanup_functor();
 				m_running_state = running_state_t::not_running;
 			}
+			else if( running_state_t::draining == m_running_state )
+			{
+				// The drain is interrupted, live connections
+				// aren't waited anymore.
+				finish_drain();
+			}
+		}
+
+		//! Stops server gracefully in async way.
+		/*!
+			The server stops accepting new connections. Every live
+			connection sends `Connection: close` in the next response and
+			is closed after the handling of requests that are already
+			received (including responses that are being sent in parts).
+			Idle keep-alive connections are closed immediately.
+
+			When all the connections are closed or \a timeout is expired
+			the server is closed like by close_sync(). Connections that
+			are still alive at the deadline are closed forcibly.
+
+			\a progress_cb is called with drain_progress_t when the drain
+			is started, when a connection is closed and when the drain is
+			finished. The last call has drain_progress_t::m_finished set.
+			The callback is called on the server's context.
+
+			If the server isn't running \a progress_cb is called with
+			drain_progress_t::m_finished set immediately. A call to
+			drain_async() during the drain is ignored. A call to
+			close_sync() or close_async() during the drain finishes the
+			drain without waiting for connections.
+
+			\note It doesn't call io_context to stop
+			(\see stop_io_context()).
+
+			\note
+			Connections that are switched to websocket mode aren't
+			controlled by the drain.
+
+			\note
+			If the server is destroyed during the drain the drain is
+			finished without waiting for connections and \a progress_cb
+			isn't called anymore (the final notification isn't sent).
+
+			\attention
+			\a progress_cb and \a drain_err_cb should be noexcept
+			functions/lambdas.
+
+			\since v.0.6.14
+		*/
+		template <
+				typename Drain_Progress_CB,
+				typename Drain_Error_CB >
+		void
+		drain_async(
+			std::chrono::steady_clock::duration timeout,
+			Drain_Progress_CB progress_cb,
+			Drain_Error_CB drain_err_cb )
+		{
+			asio_ns::post(
+				m_acceptor->get_open_close_operations_executor(),
+				[ this,
+					timeout,
+					progress_cb = std::move( progress_cb ),
+					err_cb = std::move( drain_err_cb ) ]() mutable {
+					try
+					{
+						start_drain( timeout, std::move( progress_cb ), err_cb );
+					}
+					catch( ... )
+					{
+						call_nothrow_cb( [&err_cb] {
+								err_cb( std::current_exception() );
+							} );
+					}
+				} );
 		}
 
 	private:
@@ -369,16 +502,210 @@ class http_server_t
 		//! Timer manager object.
 		timer_manager_handle_t m_timer_manager;
 
+		//! Registry of live connections.
+		/*!
+		 * \since v.0.6.14
+		 */
+		connection_registry_handle_t m_connection_registry;
+
 		//! State of server.
 		enum class running_state_t
 		{
 			not_running,
 			running,
+			//! The acceptor is closed, but the server waits
+			//! for live connections.
+			/*!
+			 * \since v.0.6.14
+			 */
+			draining,
 		};
 
 		//! Server state.
 		running_state_t m_running_state{ running_state_t::not_running };
 
+		//! Data of the drain in progress.
+		/*!
+		 * \since v.0.6.14
+		 */
+		struct drain_ctx_t
+		{
+			drain_ctx_t(
+				asio_ns::io_context & io_context,
+				std::function< void(const drain_progress_t &) > progress_cb,
+				std::function< void(std::exception_ptr) > err_cb )
+				:	m_deadline_timer{ io_context }
+				,	m_progress_cb{ std::move( progress_cb ) }
+				,	m_err_cb{ std::move( err_cb ) }
+			{}
+
+			asio_ns::steady_timer m_deadline_timer;
+			std::function< void(const drain_progress_t &) > m_progress_cb;
+			std::function< void(std::exception_ptr) > m_err_cb;
+			bool m_deadline_expired{ false };
+		};
+
+		//! The drain in progress.
+		/*!
+		 * Isn't empty only in running_state_t::draining state.
+		 *
+		 * Events of the drain hold weak references to this object, so
+		 * events that are posted before the end of the drain (or before
+		 * the destruction of the server) are ignored.
+		 *
+		 * \since v.0.6.14
+		 */
+		std::shared_ptr< drain_ctx_t > m_drain;
+
+		//! Start the drain.
+		/*!
+		 * \since v.0.6.14
+		 */
+		void
+		start_drain(
+			std::chrono::steady_clock::duration timeout,
+			std::function< void(const drain_progress_t &) > progress_cb,
+			std::function< void(std::exception_ptr) > err_cb )
+		{
+			if( running_state_t::not_running == m_running_state )
+			{
+				call_nothrow_cb( [&progress_cb] {
+						progress_cb( drain_progress_t{ 0u, true, false } );
+					} );
+				return;
+			}
+
+			if( running_state_t::draining == m_running_state )
+				return;
+
+			m_acceptor->close();
+
+			m_drain = std::make_shared< drain_ctx_t >(
+					io_context(),
+					std::move( progress_cb ),
+					std::move( err_cb ) );
+			m_running_state = running_state_t::draining;
+
+			// The listener can be called on a connection's context even
+			// after the end of the drain, so it doesn't touch the server.
+			const std::weak_ptr< drain_ctx_t > drain{ m_drain };
+			const auto alive = m_connection_registry->start_draining(
+				[this, drain,
+					executor = m_acceptor->get_open_close_operations_executor()] {
+					asio_ns::post(
+						executor,
+						[this, drain] {
+							if( drain.lock() )
+								handle_drain_event( &http_server_t::on_drain_progress );
+						} );
+				} );
+
+			if( 0u == alive )
+			{
+				finish_drain();
+				return;
+			}
+
+			call_nothrow_cb( [&] {
+					m_drain->m_progress_cb( drain_progress_t{ alive, false, false } );
+				} );
+
+			m_drain->m_deadline_timer.expires_after( timeout );
+			m_drain->m_deadline_timer.async_wait(
+				asio_ns::bind_executor(
+					m_acceptor->get_open_close_operations_executor(),
+					[this, drain]( const asio_ns::error_code & ec ) {
+						if( !ec && drain.lock() )
+							handle_drain_event( &http_server_t::on_drain_deadline );
+					} ) );
+		}
+
+		//! Call a drain event handler and pass an exception
+		//! to the drain error callback.
+		/*!
+		 * \since v.0.6.14
+		 */
+		void
+		handle_drain_event( void (http_server_t::*handler)() ) noexcept
+		{
+			// The drain can be already finished.
+			if( running_state_t::draining != m_running_state )
+				return;
+
+			// The drain can be finished by the handler, so the error
+			// callback should be taken in advance.
+			std::function< void(std::exception_ptr) > err_cb;
+			try
+			{
+				err_cb = m_drain->m_err_cb;
+				(this->*handler)();
+			}
+			catch( ... )
+			{
+				if( err_cb )
+					call_nothrow_cb( [&err_cb] {
+							err_cb( std::current_exception() );
+						} );
+			}
+		}
+
+		//! A connection was closed during the drain.
+		/*!
+		 * \since v.0.6.14
+		 */
+		void
+		on_drain_progress()
+		{
+			const auto alive = m_connection_registry->size();
+			if( 0u == alive )
+				finish_drain();
+			else
+				call_nothrow_cb( [&] {
+						m_drain->m_progress_cb(
+								drain_progress_t{ alive, false, false } );
+					} );
+		}
+
+		//! The drain deadline is expired.
+		/*!
+		 * \since v.0.6.14
+		 */
+		void
+		on_drain_deadline()
+		{
+			m_drain->m_deadline_expired = true;
+
+			for( auto & conn : m_connection_registry->alive_connections() )
+				conn->drain_deadline_expired();
+
+			finish_drain();
+		}
+
+		//! Close the server at the end of the drain.
+		/*!
+		 * \since v.0.6.14
+		 */
+		void
+		finish_drain()
+		{
+			m_connection_registry->stop_draining();
+
+			std::shared_ptr< drain_ctx_t > drain{ std::move( m_drain ) };
+			m_running_state = running_state_t::not_running;
+
+			drain->m_deadline_timer.cancel();
+			m_timer_manager->stop();
+			call_cleanup_functor();
+
+			if( drain->m_progress_cb )
+				call_nothrow_cb( [&] {
+						drain->m_progress_cb( drain_progress_t{
+								m_connection_registry->size(),
+								true,
+								drain->m_deadline_expired } );
+					} );
+		}
+
 		//! Call a cleanup functor if it is defined.
 		/*!
 		 * \note
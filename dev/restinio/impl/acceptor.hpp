@@ -11,6 +11,7 @@
 #include <memory>
 
 #include <restinio/connection_count_limiter.hpp>
+#include <restinio/impl/metrics_updater.hpp>
 
 #include <restinio/impl/include_fmtlib.hpp>
 
@@ -163,11 +164,15 @@ class acceptor_t final
 	:	public std::enable_shared_from_this< acceptor_t< Traits > >
 	,	protected socket_supplier_t< typename Traits::stream_socket_t >
 	,	protected acceptor_details::ip_blocker_holder_t< typename Traits::ip_blocker_t >
+	,	protected metrics_updater_t< typename Traits::metrics_t >
 	,	protected restinio::connection_count_limits::impl::acceptor_callback_iface_t
 {
 		using ip_blocker_base_t = acceptor_details::ip_blocker_holder_t<
 				typename Traits::ip_blocker_t >;
 
+		using metrics_updater_base_t = metrics_updater_t<
+				typename Traits::metrics_t >;
+
 		using connection_count_limiter_t =
 				typename connection_count_limit_types< Traits >::limiter_t;
 		using connection_lifetime_monitor_t =
@@ -193,6 +198,7 @@ class acceptor_t final
 			logger_t & logger )
 			:	socket_holder_base_t{ settings, io_context }
 			,	ip_blocker_base_t{ settings }
+			,	metrics_updater_base_t{ settings }
 			,	m_port{ settings.port() }
 			,	m_protocol{ settings.protocol() }
 			,	m_address{ settings.address() }
@@ -452,6 +458,7 @@ class acceptor_t final
 			{
 			case restinio::ip_blocker::inspection_result_t::deny:
 				// New connection can be used. It is disabled by IP-blocker.
+				this->increment_metric( metrics::counter_t::connections_denied );
 				m_logger.warn( [&]{
 					return fmt::format(
 							"accepted connection from {} on socket #{} denied by"
@@ -10,22 +10,24 @@
 
 #include <restinio/asio_include.hpp>
 
-#include <http_parser.h>
-
 #include <restinio/impl/include_fmtlib.hpp>
 
 #include <restinio/exception.hpp>
 #include <restinio/http_headers.hpp>
 #include <restinio/request_handler.hpp>
 #include <restinio/connection_count_limiter.hpp>
+#include <restinio/http_parser_backend.hpp>
 #include <restinio/impl/connection_base.hpp>
 #include <restinio/impl/header_helpers.hpp>
 #include <restinio/impl/response_coordinator.hpp>
 #include <restinio/impl/connection_settings.hpp>
+#include <restinio/impl/request_tracer.hpp>
 #include <restinio/impl/fixed_buffer.hpp>
 #include <restinio/impl/write_group_output_ctx.hpp>
 #include <restinio/impl/executor_wrapper.hpp>
 #include <restinio/impl/sendfile_operation.hpp>
+#include <restinio/impl/http2_fallback.hpp>
+#include <restinio/impl/http2/connection.hpp>
 
 #include <restinio/utils/impl/safe_uint_truncate.hpp>
 #include <restinio/utils/at_scope_exit.hpp>
@@ -36,167 +38,6 @@ namespace restinio
 namespace impl
 {
 
-//
-// http_parser_ctx_t
-//
-
-//! Parsing result context for using in parser callbacks.
-/*!
-	All data is used as temps, and is usable only
-	after parsing completes new requests then it is moved out.
-*/
-struct http_parser_ctx_t
-{
-	//! Request data.
-	//! \{
-	http_request_header_t m_header;
-	std::string m_body;
-	//! \}
-
-	//! Parser context temp values and flags.
-	//! \{
-	std::string m_current_field_name;
-	std::size_t m_last_value_total_size{ 0u };
-	bool m_last_was_value{ true };
-
-	/*!
-	 * @since v.0.6.9
-	 */
-	bool m_leading_headers_completed{ false };
-
-	/*!
-	 * @since v.0.6.9
-	 */
-	chunked_input_info_block_t m_chunked_info_block;
-	//! \}
-
-	//! Flag: is http message parsed completely.
-	bool m_message_complete{ false };
-
-	/*!
-	 * @brief Total number of parsed HTTP-fields.
-	 *
-	 * This number includes the number of leading HTTP-fields and the number
-	 * of trailing HTTP-fields (in the case of chunked encoding).
-	 *
-	 * @since v.0.6.12
-	 */
-	std::size_t m_total_field_count{ 0u };
-
-	/*!
-	 * @brief Limits for the incoming message.
-	 *
-	 * @since v.0.6.12
-	 */
-	const incoming_http_msg_limits_t m_limits;
-
-	/*!
-	 * @brief The main constructor.
-	 *
-	 * @since v.0.6.12
-	 */
-	http_parser_ctx_t(
-		incoming_http_msg_limits_t limits )
-		:	m_limits{ limits }
-	{}
-
-	//! Prepare context to handle new request.
-	void
-	reset()
-	{
-		m_header = http_request_header_t{};
-		m_body.clear();
-		m_current_field_name.clear();
-		m_last_value_total_size = 0u;
-		m_last_was_value = true;
-		m_leading_headers_completed = false;
-		m_message_complete = false;
-		m_total_field_count = 0u;
-	}
-
-	//! Creates an instance of chunked_input_info if there is an info
-	//! about chunks in the body.
-	/*!
-	 * @since v.0.6.9
-	 */
-	RESTINIO_NODISCARD
-	chunked_input_info_unique_ptr_t
-	make_chunked_input_info_if_necessary()
-	{
-		chunked_input_info_unique_ptr_t result;
-
-		if( !m_chunked_info_block.m_chunks.empty() ||
-				0u != m_chunked_info_block.m_trailing_fields.fields_count() )
-		{
-			result = std::make_unique< chunked_input_info_t >(
-					std::move( m_chunked_info_block ) );
-		}
-
-		return result;
-	}
-};
-
-//! Include parser callbacks.
-#include "parser_callbacks.ipp"
-
-//
-// create_parser_settings()
-//
-
-//! Helper for setting parser settings.
-/*!
-	Is used to initialize const value in connection_settings_t ctor.
-*/
-template< typename Http_Methods >
-inline http_parser_settings
-create_parser_settings() noexcept
-{
-	http_parser_settings parser_settings;
-	http_parser_settings_init( &parser_settings );
-
-	parser_settings.on_url =
-		[]( http_parser * parser, const char * at, size_t length ) -> int {
-			return restinio_url_cb( parser, at, length );
-		};
-
-	parser_settings.on_header_field =
-		[]( http_parser * parser, const char * at, size_t length ) -> int {
-			return restinio_header_field_cb( parser, at, length );
-		};
-
-	parser_settings.on_header_value =
-			[]( http_parser * parser, const char * at, size_t length ) -> int {
-			return restinio_header_value_cb( parser, at, length );
-		};
-
-	parser_settings.on_headers_complete =
-		[]( http_parser * parser ) -> int {
-			return restinio_headers_complete_cb( parser );
-		};
-
-	parser_settings.on_body =
-		[]( http_parser * parser, const char * at, size_t length ) -> int {
-			return restinio_body_cb( parser, at, length );
-		};
-
-	parser_settings.on_chunk_header =
-		[]( http_parser * parser ) -> int {
-			return restinio_chunk_header_cb( parser );
-		};
-
-	parser_settings.on_chunk_complete =
-		[]( http_parser * parser ) -> int {
-			return restinio_chunk_complete_cb( parser );
-		};
-
-	parser_settings.on_message_complete =
-		[]( http_parser * parser ) -> int {
-			return restinio_message_complete_cb< Http_Methods >( parser );
-		};
-
-	return parser_settings;
-}
-
 //
 // connection_upgrade_stage_t
 //
@@ -214,7 +55,13 @@ enum class connection_upgrade_stage_t : std::uint8_t
 	//! so any response data comming is for that request.
 	//! If connection transforms to websocket connection
 	//! then no further operations are expected.
-	wait_for_upgrade_handling_result_or_nothing
+	wait_for_upgrade_handling_result_or_nothing,
+	//! The connection is switched to HTTP/2, the socket is moved
+	//! to HTTP/2 connection and no further operations are expected.
+	/*!
+		@since v.0.6.14
+	*/
+	switched_to_http2
 };
 
 //
@@ -222,20 +69,18 @@ enum class connection_upgrade_stage_t : std::uint8_t
 //
 
 //! Data associated with connection read routine.
+template < typename Parser_Backend >
 struct connection_input_t
 {
 	connection_input_t(
 		std::size_t buffer_size,
 		incoming_http_msg_limits_t limits )
-		:	m_parser_ctx{ limits }
+		:	m_parser{ limits }
 		,	m_buf{ buffer_size }
 	{}
 
 	//! HTTP-parser.
-	//! \{
-	http_parser m_parser;
-	http_parser_ctx_t m_parser_ctx;
-	//! \}
+	Parser_Backend m_parser;
 
 	//! Input buffer.
 	fixed_buffer_t m_buf;
@@ -247,16 +92,26 @@ struct connection_input_t
 	//! Flag to track whether read operation is performed now.
 	bool m_read_operation_is_running{ false };
 
+	//! Detector of HTTP/2 client preface at the beginning of the connection.
+	/*!
+		@since v.0.6.14
+	*/
+	http2_fallback::preface_detector_t m_http2_preface_detector;
+
+	//! Should the current request be handled as an upgrade request?
+	/*!
+		It is false for requests for an upgrade to h2c because
+		such requests are handled as ordinary HTTP/1.1 requests.
+
+		@since v.0.6.14
+	*/
+	bool m_is_upgrade_request{ false };
+
 	//! Prepare parser for reading new http-message.
 	void
 	reset_parser()
 	{
-		// Reinit parser.
-		http_parser_init( &m_parser, HTTP_REQUEST);
-
-		// Reset context and attach it to parser.
-		m_parser_ctx.reset();
-		m_parser.data = &m_parser_ctx;
+		m_parser.reset();
 	}
 };
 
@@ -280,6 +135,18 @@ make_tls_socket_pointer_for_state_listener(
 	return nullptr;
 }
 
+// An overload for the case of non-TLS-connection.
+/*!
+	There is no ALPN for plain connections.
+
+	@since v.0.6.14
+*/
+inline bool
+is_http2_negotiated( asio_ns::ip::tcp::socket & ) noexcept
+{
+	return false;
+}
+
 //
 // connection_t
 //
@@ -338,11 +205,14 @@ class connection_t final
 					m_settings->m_incoming_http_msg_limits
 				}
 			,	m_response_coordinator{ m_settings->m_max_pipelined_requests }
+			,	m_tracing{ conn_id, *m_settings }
 			,	m_timer_guard{ m_settings->create_timer_guard() }
 			,	m_request_handler{ *( m_settings->m_request_handler ) }
 			,	m_logger{ *( m_settings->m_logger ) }
 			,	m_lifetime_monitor{ std::move(lifetime_monitor) }
 		{
+			m_settings->increment_metric( metrics::counter_t::connections_accepted );
+
 			// Notify of a new connection instance.
 			m_logger.trace( [&]{
 					return fmt::format(
@@ -360,6 +230,13 @@ class connection_t final
 
 		~connection_t() override
 		{
+			m_settings->m_connection_registry->remove( connection_id(), this );
+
+			// HTTP/2 connection counts its closing itself.
+			if( connection_upgrade_stage_t::switched_to_http2 !=
+				m_input.m_connection_upgrade_stage )
+				m_settings->increment_metric( metrics::counter_t::connections_closed );
+
 			restinio::utils::log_trace_noexcept( m_logger,
 				[&]{
 					return fmt::format(
@@ -371,6 +248,11 @@ class connection_t final
 		void
 		init()
 		{
+			// The connection should be visible for draining
+			// since the beginning of its work.
+			m_settings->m_connection_registry->add(
+					shared_from_concrete< connection_base_t >() );
+
 			prepare_connection_and_start_read(
 				m_socket,
 				*this,
@@ -387,6 +269,15 @@ class connection_t final
 								};
 						} );
 
+					// HTTP/2 can be negotiated during TLS handshake.
+					if( is_http2_negotiated( m_socket ) )
+					{
+						handle_http2_client(
+								std::integral_constant< bool, Traits::use_http2 >{},
+								std::string{} );
+						return;
+					}
+
 					// Start timeout checking.
 					m_prepared_weak_ctx = shared_from_this();
 					init_next_timeout_checking();
@@ -408,6 +299,18 @@ class connection_t final
 		void
 		wait_for_http_message()
 		{
+			if( m_last_request_to_drain_known.load( std::memory_order_relaxed ) )
+			{
+				m_logger.trace( [&]{
+					 return fmt::format(
+							"[connection:{}] no more requests are read "
+							"during the drain",
+							connection_id() );
+				} );
+
+				return;
+			}
+
 			m_logger.trace( [&]{
 				 return fmt::format(
 						"[connection:{}] start waiting for request",
@@ -523,6 +426,9 @@ class connection_t final
 								length );
 					} );
 
+					m_settings->increment_metric(
+							metrics::counter_t::bytes_read, length );
+
 					m_input.m_buf.obtained_bytes( length );
 
 					consume_data( m_input.m_buf.bytes(), length );
@@ -544,14 +450,14 @@ class connection_t final
 				// then close connection.
 				if( !error_is_operation_aborted( ec ) )
 				{
-					if ( !error_is_eof( ec ) || 0 != m_input.m_parser.nread )
+					if ( !error_is_eof( ec ) || 0 != m_input.m_parser.bytes_parsed() )
 						trigger_error_and_close( [&]{
 							return fmt::format(
 									"[connection:{}] read socket error: {}; "
 									"parsed bytes: {}",
 									connection_id(),
 									ec.message(),
-									m_input.m_parser.nread );
+									m_input.m_parser.bytes_parsed() );
 						} );
 					else
 					{
@@ -579,48 +485,217 @@ class connection_t final
 		consume_data( const char * data, std::size_t length )
 		{
 			auto & parser = m_input.m_parser;
+			auto & parser_ctx = parser.ctx();
+
+			m_tracing.on_data_arrived();
+
+			// The beginning of the data could be received by previous
+			// read operations and held by HTTP/2 preface detector.
+			// Those bytes are parsed together with the new data.
+			std::string joined_data;
+			std::size_t held_size{};
+			if( !m_input.m_http2_preface_detector.completed() )
+			{
+				const auto held_part =
+						m_input.m_http2_preface_detector.matched_part();
+
+				if( !check_http2_preface( data, length ) )
+					return;
 
-			const auto nparsed =
-				http_parser_execute(
-					&parser,
-					&( m_settings->m_parser_settings ),
-					data,
-					length );
+				if( !held_part.empty() )
+				{
+					held_size = held_part.size();
+					joined_data.reserve( held_size + length );
+					joined_data.append( held_part.data(), held_size );
+					joined_data.append( data, length );
+
+					data = joined_data.data();
+					length = joined_data.size();
+				}
+			}
+
+			const auto nparsed = parser.parse( data, length );
+
+			m_tracing.on_data_parsed(
+					parser_ctx.m_leading_headers_completed,
+					parser_ctx.m_message_complete );
 
 			// If entire http-message was obtained,
 			// parser is stopped and the might be a part of consecutive request
 			// left in buffer, so we mark how many bytes were obtained.
 			// and next message read (if any) will be started from already existing
 			// data left in buffer.
-			m_input.m_buf.consumed_bytes( nparsed );
+			// Held bytes aren't in the buffer anymore.
+			m_input.m_buf.consumed_bytes(
+					nparsed > held_size ? nparsed - held_size : 0u );
 
-			if( HPE_OK != parser.http_errno &&
-				HPE_PAUSED != parser.http_errno )
+			if( parser.is_error() )
 			{
 				// PARSE ERROR:
-				auto err = HTTP_PARSER_ERRNO( &parser );
+				m_settings->increment_metric( metrics::counter_t::parse_errors );
 
 				// TODO: handle case when there are some request in process.
 				trigger_error_and_close( [&]{
 					return fmt::format(
-							"[connection:{}] parser error {}: {}",
+							"[connection:{}] parser error {}",
 							connection_id(),
-							http_errno_name( err ),
-							http_errno_description( err ) );
+							parser.error_description() );
 				} );
 
 				// nothing to do.
 				return;
 			}
 
-			if( m_input.m_parser_ctx.m_message_complete )
+			if( parser_ctx.m_message_complete )
 			{
+				parser_ctx.m_header.method(
+						Traits::http_methods_mapper_t::from_nodejs(
+								parser.method() ) );
+
+				// An upgrade to h2c isn't supported, such requests are
+				// handled as ordinary ones (see RFC 7540, section 3.2).
+				m_input.m_is_upgrade_request = parser.is_upgrade() &&
+						!http2_fallback::is_h2c_upgrade(
+								parser_ctx.m_header.opt_value_of(
+										http_field::upgrade ).value_or(
+												string_view_t{} ) );
+
+				if( !m_input.m_is_upgrade_request )
+					parser_ctx.m_header.should_keep_alive(
+							parser.should_keep_alive() );
+				else
+					parser_ctx.m_header.connection(
+							http_connection_header_t::upgrade );
+
 				on_request_message_complete();
 			}
 			else
 				consume_message();
 		}
 
+		//! Check for HTTP/2 client preface at the beginning of the connection.
+		/*!
+			@return true if @a data should be passed to HTTP-parser.
+
+			@since v.0.6.14
+		*/
+		bool
+		check_http2_preface( const char * data, std::size_t length )
+		{
+			using detector_t = http2_fallback::preface_detector_t;
+			auto & detector = m_input.m_http2_preface_detector;
+			const auto held_part = detector.matched_part();
+
+			switch( detector.check( data, length ) )
+			{
+				case detector_t::result_t::need_more_data:
+					m_input.m_buf.consumed_bytes( length );
+					consume_message();
+					return false;
+
+				case detector_t::result_t::preface_found:
+				{
+					// All the data received so far is passed to HTTP/2.
+					std::string received_data;
+					received_data.reserve( held_part.size() + length );
+					received_data.append( held_part.data(), held_part.size() );
+					received_data.append( data, length );
+
+					handle_http2_client(
+							std::integral_constant< bool, Traits::use_http2 >{},
+							std::move( received_data ) );
+				}
+				return false;
+
+				case detector_t::result_t::not_preface:
+					break;
+			}
+
+			// The beginning of the data could be received by previous
+			// read operations. It wasn't passed to the parser yet.
+			if( detector.matched_part().size() >= 3u )
+			{
+				// PRI method is reserved for HTTP/2 preface only.
+				m_settings->increment_metric( metrics::counter_t::parse_errors );
+
+				trigger_error_and_close( [&]{
+					return fmt::format(
+							"[connection:{}] malformed HTTP/2 client preface",
+							connection_id() );
+				} );
+
+				return false;
+			}
+
+			return true;
+		}
+
+		//! Handle HTTP/2 client if HTTP/2 support is turned off.
+		/*!
+			@since v.0.6.14
+		*/
+		void
+		handle_http2_client( std::false_type, std::string /*received_data*/ )
+		{
+			reject_http2_connection();
+		}
+
+		//! Switch the connection to HTTP/2.
+		/*!
+			The socket and the data received from the client are moved
+			to a new HTTP/2 connection object. The HTTP/2 connection
+			replaces this connection in the connection registry.
+
+			@since v.0.6.14
+		*/
+		void
+		handle_http2_client( std::true_type, std::string received_data )
+		{
+			using http2_connection_t = http2::connection_t< Traits >;
+
+			cancel_timeout_checking();
+			m_input.m_connection_upgrade_stage =
+				connection_upgrade_stage_t::switched_to_http2;
+
+			std::make_shared< http2_connection_t >(
+					connection_id(),
+					std::move( m_socket ),
+					m_settings,
+					m_remote_endpoint,
+					std::move( m_lifetime_monitor ),
+					std::move( received_data ) )->init();
+		}
+
+		//! Tell HTTP/2 client that only HTTP/1.1 is supported and
+		//! close the connection.
+		/*!
+			@since v.0.6.14
+		*/
+		void
+		reject_http2_connection()
+		{
+			m_logger.warn( [&]{
+				return fmt::format(
+						"[connection:{}] HTTP/2 client preface received, "
+						"but HTTP/2 isn't supported",
+						connection_id() );
+			} );
+
+			const auto answer = http2_fallback::http_1_1_required_answer();
+			asio_ns::async_write(
+				m_socket,
+				asio_ns::buffer( answer.data(), answer.size() ),
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[this, ctx = shared_from_this()]
+					( const asio_ns::error_code &, std::size_t ) noexcept
+					{
+						// The connection could be closed by timeout.
+						if( m_socket.is_open() )
+							RESTINIO_ENSURE_NOEXCEPT_CALL( close() );
+					} ) );
+		}
+
 		//! Handle a given request message.
 		void
 		on_request_message_complete()
@@ -628,9 +703,9 @@ class connection_t final
 			try
 			{
 				auto & parser = m_input.m_parser;
-				auto & parser_ctx = m_input.m_parser_ctx;
+				auto & parser_ctx = parser.ctx();
 
-				if( m_input.m_parser.upgrade )
+				if( m_input.m_is_upgrade_request )
 				{
 					// Start upgrade connection operation.
 
@@ -645,15 +720,40 @@ class connection_t final
 					m_input.m_connection_upgrade_stage )
 				{
 					// Run ordinary HTTP logic.
+					if( m_last_request_to_drain_known.load( std::memory_order_relaxed ) )
+					{
+						// The request was read by a read operation started
+						// before the drain. The connection will be closed
+						// after the response to the last request, so the
+						// client has to repeat this request.
+						m_logger.trace( [&]{
+							return fmt::format(
+									"[connection:{}] request is ignored "
+									"during the drain",
+									connection_id() );
+						} );
+
+						close_if_drained();
+						return;
+					}
+
+					if( !m_response_coordinator.empty() )
+						m_settings->increment_metric(
+								metrics::counter_t::pipelined_requests );
+
 					const auto request_id = m_response_coordinator.register_new_request();
 
+					// A request read during the drain is the last one.
+					if( m_drain_started )
+						fix_last_request_to_drain( request_id );
+
 					m_logger.trace( [&]{
 						return fmt::format(
 								"[connection:{}] request received (#{}): {} {}",
 								connection_id(),
 								request_id,
 								http_method_str(
-									static_cast<http_method>( parser.method ) ),
+									static_cast<http_method>( parser.method() ) ),
 								parser_ctx.m_header.request_target() );
 					} );
 
@@ -663,16 +763,8 @@ class connection_t final
 					// so it is possible to omit this timer scheduling.
 					guard_request_handling_operation();
 
-					const auto handling_result =
-						m_request_handler(
-							std::make_shared< generic_request_t >(
-								request_id,
-								std::move( parser_ctx.m_header ),
-								std::move( parser_ctx.m_body ),
-								parser_ctx.make_chunked_input_info_if_necessary(),
-								shared_from_concrete< connection_base_t >(),
-								m_remote_endpoint,
-								m_settings->extra_data_factory() ) );
+					const auto handling_result = call_request_handler(
+							request_id );
 
 					switch( handling_result )
 					{
@@ -709,7 +801,7 @@ class connection_t final
 								"Upgrade: '{}';",
 								connection_id(),
 								http_method_str(
-									static_cast<http_method>( parser.method ) ),
+									static_cast<http_method>( parser.method() ) ),
 								parser_ctx.m_header.request_target(),
 								parser_ctx.m_header.get_field_or(
 									http_field::upgrade, default_value ) );
@@ -757,7 +849,7 @@ class connection_t final
 		handle_upgrade_request()
 		{
 			auto & parser = m_input.m_parser;
-			auto & parser_ctx = m_input.m_parser_ctx;
+			auto & parser_ctx = parser.ctx();
 
 			// If user responses with error
 			// then connection must be able to send
@@ -771,7 +863,7 @@ class connection_t final
 						connection_id(),
 						request_id,
 						http_method_str(
-							static_cast<http_method>( parser.method ) ),
+							static_cast<http_method>( parser.method() ) ),
 						parser_ctx.m_header.request_target() );
 			} );
 
@@ -783,15 +875,7 @@ class connection_t final
 			m_input.m_connection_upgrade_stage =
 				connection_upgrade_stage_t::wait_for_upgrade_handling_result_or_nothing;
 
-			const auto handling_result = m_request_handler(
-				std::make_shared< generic_request_t >(
-					request_id,
-					std::move( parser_ctx.m_header ),
-					std::move( parser_ctx.m_body ),
-					parser_ctx.make_chunked_input_info_if_necessary(),
-					shared_from_concrete< connection_base_t >(),
-					m_remote_endpoint,
-					m_settings->extra_data_factory() ) );
+			const auto handling_result = call_request_handler( request_id );
 			switch( handling_result )
 			{
 				case request_handling_status_t::not_handled:
@@ -841,6 +925,37 @@ class connection_t final
 			// So no even a log messages here.
 		}
 
+		//! Pass the current request to the request handler.
+		/*!
+			Request data must be in input context (m_input).
+
+			@since v.0.6.14
+		*/
+		request_handling_status_t
+		call_request_handler( request_id_t request_id )
+		{
+			auto & parser_ctx = m_input.m_parser.ctx();
+
+			m_settings->increment_metric( metrics::counter_t::requests );
+
+			m_tracing.on_request_registered( request_id );
+
+			auto req = std::make_shared< generic_request_t >(
+					request_id,
+					std::move( parser_ctx.m_header ),
+					std::move( parser_ctx.m_body ),
+					parser_ctx.make_chunked_input_info_if_necessary(),
+					shared_from_concrete< connection_base_t >(),
+					m_remote_endpoint,
+					m_settings->extra_data_factory() );
+
+			m_tracing.on_handler_invoked( request_id );
+
+			return m_settings->measure_latency(
+					metrics::histogram_t::handler_latency,
+					[&] { return m_request_handler( std::move( req ) ); } );
+		}
+
 		//! Write parts for specified request.
 		virtual void
 		write_response_parts(
@@ -881,6 +996,104 @@ class connection_t final
 				} );
 		}
 
+		//! Schedule a callback for execution on the connection's executor.
+		/*!
+		 * @since v.0.6.14
+		 */
+		virtual void
+		post_to_executor( std::function< void() > cb ) override
+		{
+			asio_ns::post(
+				this->get_executor(),
+				[ ctx = shared_from_this(), actual_cb = std::move( cb ) ] {
+					actual_cb();
+				} );
+		}
+
+		//! Switch the connection to the drain mode.
+		/*!
+		 * An idle connection is closed immediately, a busy connection
+		 * is closed after the handling of the current requests.
+		 *
+		 * @since v.0.6.14
+		 */
+		virtual void
+		start_draining() noexcept override
+		{
+			connection_base_t::start_draining();
+
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"connection.start_draining",
+				[this] {
+					asio_ns::post(
+						this->get_executor(),
+						[ ctx = shared_from_this() ]() noexcept {
+							auto & conn_object = cast_to_self( *ctx );
+
+							restinio::utils::log_trace_noexcept( conn_object.m_logger,
+								[&]{
+									return fmt::format(
+										"[connection:{}] start draining",
+										conn_object.connection_id() );
+								} );
+
+							conn_object.on_drain_started();
+						} );
+				} );
+		}
+
+		//! Should the connection be closed after the response
+		//! to a given request?
+		/*!
+		 * Only the response to the last request received before the drain
+		 * is sent with `Connection: close`. Responses to the preceding
+		 * pipelined requests keep the connection alive, otherwise they
+		 * would be dropped by the response coordinator.
+		 *
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		virtual bool
+		should_close_after_response(
+			request_id_t request_id ) const noexcept override
+		{
+			return m_last_request_to_drain_known.load( std::memory_order_acquire ) &&
+					m_last_request_to_drain == request_id;
+		}
+
+		//! Close the connection because the drain deadline is expired.
+		/*!
+		 * @since v.0.6.14
+		 */
+		virtual void
+		drain_deadline_expired() noexcept override
+		{
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"connection.drain_deadline_expired",
+				[this] {
+					asio_ns::post(
+						this->get_executor(),
+						[ ctx = shared_from_this() ]() noexcept {
+							auto & conn_object = cast_to_self( *ctx );
+
+							if( conn_object.m_socket.is_open() )
+							{
+								restinio::utils::log_warn_noexcept( conn_object.m_logger,
+									[&]{
+										return fmt::format(
+											"[connection:{}] drain deadline expired, "
+											"close connection",
+											conn_object.connection_id() );
+									} );
+
+								conn_object.close();
+							}
+						} );
+				} );
+		}
+
 		//! Write parts for specified request.
 		void
 		write_response_parts_impl(
@@ -945,6 +1158,8 @@ class connection_t final
 						response_output_flags,
 						std::move( wg ) );
 
+					m_tracing.on_response_appended( request_id );
+
 					init_write_if_necessary();
 				}
 				else
@@ -1042,6 +1257,11 @@ class connection_t final
 					} );
 				}
 
+				m_tracing.on_write_group_started(
+						next_write_group->second,
+						!m_response_coordinator.is_response_in_progress(
+								next_write_group->second ) );
+
 				// Initialize write context with a new write group.
 				m_write_output_ctx.start_next_write_group(
 					std::move( next_write_group->first ) );
@@ -1152,6 +1372,9 @@ class connection_t final
 					{
 						if( !ec )
 						{
+							m_settings->increment_metric(
+									metrics::counter_t::bytes_written, written );
+
 							restinio::utils::log_trace_noexcept( m_logger,
 								[&]{
 									return fmt::format(
@@ -1223,6 +1446,10 @@ class connection_t final
 
 						if( !ec )
 						{
+							m_settings->increment_metric(
+									metrics::counter_t::sendfile_bytes_written,
+									static_cast< std::uint64_t >( written ) );
+
 							restinio::utils::log_trace_noexcept( m_logger,
 								[&]{
 									return fmt::format(
@@ -1258,6 +1485,8 @@ class connection_t final
 						this->connection_id() );
 			} );
 
+			m_tracing.on_write_group_finished();
+
 			// Group notificators are called from here (if exist):
 			m_write_output_ctx.finish_write_group();
 
@@ -1281,6 +1510,10 @@ class connection_t final
 					// Start another write opertion
 					// if there is something to send.
 					init_write_if_necessary();
+
+					// The connection shouldn't wait for the next request
+					// if the server is being stopped.
+					close_if_drained();
 				}
 				else
 				{
@@ -1358,6 +1591,8 @@ class connection_t final
 		{
 			if( !ec )
 			{
+				m_tracing.on_write_completed();
+
 				RESTINIO_ENSURE_NOEXCEPT_CALL( handle_current_write_ctx() );
 			}
 			else
@@ -1390,6 +1625,90 @@ class connection_t final
 			}
 		}
 
+		//! Does the connection have a request that isn't read completely?
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		bool
+		has_partially_read_request() const noexcept
+		{
+			const auto & detector = m_input.m_http2_preface_detector;
+
+			// NOTE: bytes_parsed() can't be used here because
+			// nodejs/http_parser resets it at the end of the header block.
+			return m_input.m_parser.ctx().m_message_started ||
+					( !detector.completed() && !detector.matched_part().empty() );
+		}
+
+		//! Handle the start of the drain on the connection's executor.
+		/*!
+		 * If there are requests in handling then the last of them
+		 * becomes the last request to be handled by the connection.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		on_drain_started() noexcept
+		{
+			m_drain_started = true;
+
+			if( !m_response_coordinator.empty() )
+				fix_last_request_to_drain(
+						m_response_coordinator.last_registered_request_id() );
+
+			close_if_drained();
+		}
+
+		//! Remember the last request to be handled in the drain mode.
+		/*!
+		 * @since v.0.6.14
+		 */
+		void
+		fix_last_request_to_drain( request_id_t request_id ) noexcept
+		{
+			restinio::utils::log_trace_noexcept( m_logger,
+				[&]{
+					return fmt::format(
+						"[connection:{}] the last request to handle "
+						"during the drain: #{}",
+						connection_id(),
+						request_id );
+				} );
+
+			m_last_request_to_drain = request_id;
+			m_last_request_to_drain_known.store(
+					true, std::memory_order_release );
+		}
+
+		//! Close the connection if it is in the drain mode and
+		//! has nothing to do.
+		/*!
+		 * @since v.0.6.14
+		 */
+		void
+		close_if_drained() noexcept
+		{
+			if( is_draining() &&
+				m_socket.is_open() &&
+				connection_upgrade_stage_t::none ==
+					m_input.m_connection_upgrade_stage &&
+				m_response_coordinator.empty() &&
+				!m_write_output_ctx.transmitting() &&
+				( m_last_request_to_drain_known.load( std::memory_order_relaxed ) ||
+					!has_partially_read_request() ) )
+			{
+				restinio::utils::log_trace_noexcept( m_logger,
+					[&]{
+						return fmt::format(
+							"[connection:{}] connection is drained",
+							connection_id() );
+					} );
+
+				close();
+			}
+		}
+
 		//! Close connection functions.
 		//! \{
 
@@ -1487,7 +1806,7 @@ class connection_t final
 		const endpoint_t m_remote_endpoint;
 
 		//! Input routine.
-		connection_input_t m_input;
+		connection_input_t< typename Traits::http_parser_backend_t > m_input;
 
 		//! Write to socket operation context.
 		write_group_output_ctx_t m_write_output_ctx;
@@ -1498,6 +1817,37 @@ class connection_t final
 		//! Response coordinator.
 		response_coordinator_t m_response_coordinator;
 
+		//! Has the connection started the drain on its executor?
+		/*!
+		 * @since v.0.6.14
+		 */
+		bool m_drain_started{ false };
+
+		//! Id of the last request to be handled in the drain mode.
+		/*!
+		 * The value has sense only if m_last_request_to_drain_known is true.
+		 * It isn't changed after that.
+		 *
+		 * @since v.0.6.14
+		 */
+		request_id_t m_last_request_to_drain{};
+
+		//! Is the last request to be handled in the drain mode known?
+		/*!
+		 * It's set on the connection's executor but it can be read
+		 * by response builders on any thread.
+		 *
+		 * @since v.0.6.14
+		 */
+		std::atomic< bool > m_last_request_to_drain_known{ false };
+
+		/*!
+		 * @brief Reporter of request processing stages.
+		 *
+		 * @since v.0.6.14
+		 */
+		connection_tracing_ctx_t< typename Traits::request_tracer_t > m_tracing;
+
 		//! Timer to controll operations.
 		//! \{
 
@@ -1603,6 +1953,8 @@ class connection_t final
 		void
 		handle_xxx_timeout( const char * operation_name )
 		{
+			m_settings->increment_metric( metrics::counter_t::timeouts );
+
 			m_logger.trace( [&]{
 				return fmt::format(
 						"[connection:{}] {} timed out",
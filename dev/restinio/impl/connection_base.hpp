@@ -8,10 +8,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #include <restinio/tcp_connection_ctx_base.hpp>
 #include <restinio/buffers.hpp>
+#include <restinio/compiler_features.hpp>
 
 namespace restinio
 {
@@ -41,6 +44,94 @@ class connection_base_t
 			response_output_flags_t response_output_flags,
 			//! Part of the response data.
 			write_group_t wg ) = 0;
+
+		//! Schedule a callback for execution on the connection's executor.
+		/*!
+		 * This method can be called from any thread. The callback is
+		 * executed later in the same context where the connection handles
+		 * its I/O events.
+		 *
+		 * @note
+		 * The default implementation calls @a cb immediately. It's intended
+		 * for connections that don't have an executor (e.g. in tests).
+		 *
+		 * @since v.0.6.14
+		 */
+		virtual void
+		post_to_executor( std::function< void() > cb )
+		{
+			cb();
+		}
+
+		//! Switch the connection to the drain mode.
+		/*!
+		 * A connection in the drain mode completes the handling of
+		 * requests already received and closes itself. The response
+		 * to the last received request is sent with `Connection: close`.
+		 *
+		 * This method can be called from any thread.
+		 *
+		 * @note
+		 * The default implementation only marks the connection as draining.
+		 *
+		 * @since v.0.6.14
+		 */
+		virtual void
+		start_draining() noexcept
+		{
+			m_draining.store( true, std::memory_order_release );
+		}
+
+		//! Close the connection because the drain deadline is expired.
+		/*!
+		 * This method can be called from any thread.
+		 *
+		 * @note
+		 * The default implementation does nothing.
+		 *
+		 * @since v.0.6.14
+		 */
+		virtual void
+		drain_deadline_expired() noexcept
+		{}
+
+		//! Should the connection be closed after the response
+		//! to a given request?
+		/*!
+		 * This method is used by response builders for setting
+		 * `Connection: close` in the drain mode. It can be called
+		 * from any thread.
+		 *
+		 * @note
+		 * The default implementation returns true for any request
+		 * if the connection is in the drain mode.
+		 *
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		virtual bool
+		should_close_after_response( request_id_t /*request_id*/ ) const noexcept
+		{
+			return is_draining();
+		}
+
+		//! Is the connection in the drain mode?
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		bool
+		is_draining() const noexcept
+		{
+			return m_draining.load( std::memory_order_acquire );
+		}
+
+	private:
+		//! Is the connection in the drain mode?
+		/*!
+		 * @since v.0.6.14
+		 */
+		std::atomic< bool > m_draining{ false };
 };
 
 //! Alias for http connection handle.
@@ -0,0 +1,252 @@
+/*
+	restinio
+*/
+
+/*!
+	A registry of live HTTP-connections.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/impl/connection_base.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <restinio/null_mutex.hpp>
+#include <restinio/default_strands.hpp>
+
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// connection_registry_t
+//
+
+//! A registry of live HTTP-connections.
+/*!
+	A connection is added to the registry when it starts and is removed
+	from the registry by its destructor. The registry is used by
+	http_server_t for draining the connections (see
+	http_server_t::drain_async()).
+
+	The registry holds only weak references to connections, so it
+	doesn't prolong the lifetime of a connection.
+
+	@note
+	Connections that are switched to websocket mode aren't present
+	in the registry. A connection that is switched to HTTP/2 is replaced
+	in the registry by HTTP/2 connection with the same id.
+
+	@tparam Mutex Type of mutex to be used for protection of the registry.
+	It is expected to be std::mutex or null_mutex_t.
+
+	@since v.0.6.14
+*/
+template< typename Mutex >
+class connection_registry_t
+{
+public:
+	//! Type of a listener to be informed when a connection is removed
+	//! during the drain.
+	/*!
+		The listener can be called on any thread where connections work.
+	*/
+	using drain_listener_t = std::function< void() >;
+
+	connection_registry_t() = default;
+
+	connection_registry_t( const connection_registry_t & ) = delete;
+	connection_registry_t( connection_registry_t && ) = delete;
+	connection_registry_t & operator=( const connection_registry_t & ) = delete;
+	connection_registry_t & operator=( connection_registry_t && ) = delete;
+
+	//! Add a new connection to the registry.
+	/*!
+		A connection with the same id (if any) is replaced.
+
+		If the drain is already started the connection is switched
+		to the drain mode immediately.
+	*/
+	void
+	add( const connection_handle_t & conn )
+	{
+		bool draining;
+		{
+			std::lock_guard< Mutex > lock{ m_lock };
+			m_connections[ conn->connection_id() ] =
+					connection_entry_t{ conn, conn.get() };
+			draining = m_draining;
+		}
+
+		if( draining )
+			conn->start_draining();
+	}
+
+	//! Remove a connection from the registry.
+	/*!
+		The connection is removed only if the registry holds
+		that connection object for @a id (the object can be replaced
+		by HTTP/2 connection).
+
+		The drain listener (if it's set) is informed about the removal.
+	*/
+	void
+	remove( connection_id_t id, const connection_base_t * conn ) noexcept
+	{
+		restinio::utils::suppress_exceptions_quietly( [&] {
+				drain_listener_t listener;
+				{
+					std::lock_guard< Mutex > lock{ m_lock };
+					const auto it = m_connections.find( id );
+					if( m_connections.end() == it || conn != it->second.m_raw )
+						return;
+
+					m_connections.erase( it );
+
+					if( !m_drain_listener )
+						return;
+
+					listener = m_drain_listener;
+				}
+
+				listener();
+			} );
+	}
+
+	//! Get the count of connections in the registry.
+	RESTINIO_NODISCARD
+	std::size_t
+	size() const
+	{
+		std::lock_guard< Mutex > lock{ m_lock };
+		return m_connections.size();
+	}
+
+	//! Switch all the current and all the future connections to
+	//! the drain mode.
+	/*!
+		@return the count of connections in the registry.
+	*/
+	std::size_t
+	start_draining( drain_listener_t listener )
+	{
+		std::size_t alive{};
+		std::vector< connection_handle_t > connections;
+		{
+			std::lock_guard< Mutex > lock{ m_lock };
+			m_draining = true;
+			m_drain_listener = std::move( listener );
+			alive = m_connections.size();
+			connections = collect_alive_connections();
+		}
+
+		for( auto & conn : connections )
+			conn->start_draining();
+
+		return alive;
+	}
+
+	//! Finish the drain mode.
+	/*!
+		The drain listener isn't informed anymore and new connections
+		aren't switched to the drain mode (the server can be opened
+		again after the drain).
+	*/
+	void
+	stop_draining() noexcept
+	{
+		restinio::utils::suppress_exceptions_quietly( [&] {
+				drain_listener_t listener;
+				{
+					std::lock_guard< Mutex > lock{ m_lock };
+					m_draining = false;
+					// The listener will be destroyed outside the lock.
+					listener.swap( m_drain_listener );
+				}
+			} );
+	}
+
+	//! Get handles of connections that are still alive.
+	RESTINIO_NODISCARD
+	std::vector< connection_handle_t >
+	alive_connections() const
+	{
+		std::lock_guard< Mutex > lock{ m_lock };
+		return collect_alive_connections();
+	}
+
+private:
+	//! An entry of the registry.
+	struct connection_entry_t
+	{
+		std::weak_ptr< connection_base_t > m_connection;
+		//! Pointer to the connection object for the identification
+		//! of the object in its destructor.
+		const connection_base_t * m_raw;
+	};
+
+	mutable Mutex m_lock;
+
+	//! Connections in the registry.
+	std::unordered_map< connection_id_t, connection_entry_t > m_connections;
+
+	//! Is the drain started?
+	bool m_draining{ false };
+
+	//! A listener to be informed when a connection is removed
+	//! during the drain.
+	drain_listener_t m_drain_listener;
+
+	//! Collect handles of alive connections.
+	/*!
+		@attention
+		Should be called when m_lock is acquired.
+	*/
+	std::vector< connection_handle_t >
+	collect_alive_connections() const
+	{
+		std::vector< connection_handle_t > result;
+		result.reserve( m_connections.size() );
+
+		for( const auto & item : m_connections )
+		{
+			auto conn = item.second.m_connection.lock();
+			if( conn )
+				result.push_back( std::move( conn ) );
+		}
+
+		return result;
+	}
+};
+
+//
+// connection_registry_mutex_t
+//
+
+//! Type of mutex for connection_registry_t.
+/*!
+	There is no need to protect the registry in single-threading mode,
+	so null_mutex_t is used for noop_strand_t.
+
+	@since v.0.6.14
+*/
+template< typename Strand >
+using connection_registry_mutex_t = typename std::conditional<
+		std::is_same< Strand, noop_strand_t >::value,
+		null_mutex_t,
+		std::mutex >::type;
+
+} /* namespace impl */
+
+} /* namespace restinio */
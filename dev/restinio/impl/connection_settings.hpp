@@ -8,11 +8,13 @@
 
 #pragma once
 
-#include <http_parser.h>
-
 #include <restinio/connection_state_listener.hpp>
 #include <restinio/incoming_http_msg_limits.hpp>
 
+#include <restinio/impl/metrics_updater.hpp>
+#include <restinio/impl/request_tracer.hpp>
+#include <restinio/impl/connection_registry.hpp>
+
 #include <restinio/utils/suppress_exceptions.hpp>
 
 #include <memory>
@@ -111,6 +113,8 @@ struct connection_settings_t final
 	:	public std::enable_shared_from_this< connection_settings_t< Traits > >
 	,	public connection_settings_details::state_listener_holder_t<
 				typename Traits::connection_state_listener_t >
+	,	public metrics_updater_t< typename Traits::metrics_t >
+	,	public request_tracer_holder_t< typename Traits::request_tracer_t >
 {
 	using timer_manager_t = typename Traits::timer_manager_t;
 	using timer_manager_handle_t = std::shared_ptr< timer_manager_t >;
@@ -123,6 +127,17 @@ struct connection_settings_t final
 			connection_settings_details::state_listener_holder_t<
 					typename Traits::connection_state_listener_t >;
 
+	/*!
+	 * @since v.0.6.14
+	 */
+	using metrics_updater_base_t = metrics_updater_t< typename Traits::metrics_t >;
+
+	/*!
+	 * @since v.0.6.14
+	 */
+	using request_tracer_holder_base_t =
+			request_tracer_holder_t< typename Traits::request_tracer_t >;
+
 	/*!
 	 * @brief An alias for shared-pointer to extra-data-factory.
 	 *
@@ -131,6 +146,14 @@ struct connection_settings_t final
 	using extra_data_factory_handle_t =
 			std::shared_ptr< typename Traits::extra_data_factory_t >;
 
+	/*!
+	 * @brief An alias for the registry of live connections.
+	 *
+	 * @since v.0.6.14
+	 */
+	using connection_registry_t = impl::connection_registry_t<
+			connection_registry_mutex_t< typename Traits::strand_t > >;
+
 	connection_settings_t( const connection_settings_t & ) = delete;
 	connection_settings_t( const connection_settings_t && ) = delete;
 	connection_settings_t & operator = ( const connection_settings_t & ) = delete;
@@ -139,11 +162,11 @@ struct connection_settings_t final
 	template < typename Settings >
 	connection_settings_t(
 		Settings && settings,
-		http_parser_settings parser_settings,
 		timer_manager_handle_t timer_manager )
 		:	connection_state_listener_holder_t{ settings }
+		,	metrics_updater_base_t{ settings }
+		,	request_tracer_holder_base_t{ settings }
 		,	m_request_handler{ settings.request_handler() }
-		,	m_parser_settings{ parser_settings }
 		,	m_buffer_size{ settings.buffer_size() }
 		,	m_incoming_http_msg_limits{ settings.incoming_http_msg_limits() }
 		,	m_read_next_http_message_timelimit{
@@ -153,6 +176,10 @@ struct connection_settings_t final
 		,	m_handle_request_timeout{
 				settings.handle_request_timeout() }
 		,	m_max_pipelined_requests{ settings.max_pipelined_requests() }
+		,	m_http2_max_concurrent_streams{
+				settings.http2_max_concurrent_streams() }
+		,	m_websocket_ping_interval{ settings.websocket_ping_interval() }
+		,	m_websocket_pong_timeout{ settings.websocket_pong_timeout() }
 		,	m_logger{ settings.logger() }
 		,	m_timer_manager{ std::move( timer_manager ) }
 		,	m_extra_data_factory{ settings.giveaway_extra_data_factory() }
@@ -167,12 +194,6 @@ struct connection_settings_t final
 	//! Request handler factory.
 	std::unique_ptr< request_handler_t > m_request_handler;
 
-	//! Parser settings.
-	/*!
-		Parsing settings are common for each connection.
-	*/
-	const http_parser_settings m_parser_settings;
-
 	//! Params from server_settings_t.
 	//! \{
 	std::size_t m_buffer_size;
@@ -193,9 +214,33 @@ struct connection_settings_t final
 
 	std::size_t m_max_pipelined_requests;
 
+	/*!
+	 * @since v.0.6.14
+	 */
+	std::size_t m_http2_max_concurrent_streams;
+
+	/*!
+	 * @since v.0.6.14
+	 */
+	//! \{
+	std::chrono::steady_clock::duration m_websocket_ping_interval;
+
+	std::chrono::steady_clock::duration m_websocket_pong_timeout;
+	//! \}
+
 	const std::unique_ptr< logger_t > m_logger;
 	//! \}
 
+	/*!
+	 * @brief Registry of live connections.
+	 *
+	 * It is shared with http_server_t for draining the connections.
+	 *
+	 * @since v.0.6.14
+	 */
+	const std::shared_ptr< connection_registry_t > m_connection_registry{
+			std::make_shared< connection_registry_t >() };
+
 	//! Create new timer guard.
 	auto
 	create_timer_guard()
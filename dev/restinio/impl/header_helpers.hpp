@@ -12,6 +12,7 @@
 #include <numeric>
 
 #include <restinio/buffers.hpp>
+#include <restinio/utils/charconv.hpp>
 
 namespace restinio
 {
@@ -60,24 +61,16 @@ calculate_approx_buffer_size_for_header(
 }
 
 //
-// create_header_string()
+// append_status_line()
 //
 
-//! Creates a string for http response header.
-inline std::string
-create_header_string(
-	const http_response_header_t & h,
-	content_length_field_presence_t content_length_field_presence =
-		content_length_field_presence_t::add_content_length,
-	std::size_t buffer_size = 0 )
+//! Append the status line (including "\r\n") of http response header.
+/*!
+ * @since v.0.6.14
+ */
+inline void
+append_status_line( std::string & result, const http_response_header_t & h )
 {
-	std::string result;
-
-	if( 0 != buffer_size )
-		result.reserve( buffer_size );
-	else
-		result.reserve( calculate_approx_buffer_size_for_header( h ) );
-
 	constexpr const char header_part1[] = "HTTP/";
 	result.append( header_part1, ct_string_len( header_part1 ) );
 
@@ -100,8 +93,22 @@ create_header_string(
 
 	constexpr const char header_rn[] = "\r\n";
 	result.append( header_rn, ct_string_len( header_rn ) );
+}
+
+//
+// append_connection_field()
+//
 
-	switch( h.connection() )
+//! Append `Connection` field.
+/*!
+ * @since v.0.6.14
+ */
+inline void
+append_connection_field(
+	std::string & result,
+	http_connection_header_t connection )
+{
+	switch( connection )
 	{
 		case http_connection_header_t::keep_alive:
 		{
@@ -124,29 +131,86 @@ create_header_string(
 			break;
 		}
 	}
+}
 
-	if( content_length_field_presence_t::add_content_length ==
-		content_length_field_presence )
-	{
-		std::array< char, 64 > buf;
-		const auto n =
-			std::snprintf(
-				buf.data(),
-				buf.size(),
-				"Content-Length: %llu\r\n",
-				static_cast< unsigned long long >( h.content_length() ) );
-
-		result.append( buf.data(), static_cast<std::string::size_type>(n) );
-	}
+//
+// append_content_length_field()
+//
+
+//! Append `Content-Length` field.
+/*!
+ * Digits are written directly by utils::to_chars().
+ *
+ * @since v.0.6.14
+ */
+inline void
+append_content_length_field(
+	std::string & result,
+	std::uint64_t content_length )
+{
+	constexpr const char header_part3[] = "Content-Length: ";
+	result.append( header_part3, ct_string_len( header_part3 ) );
+
+	const auto digits = utils::number_to_chars( content_length );
+	result.append( digits.view().data(), digits.view().size() );
+
+	constexpr const char header_rn[] = "\r\n";
+	result.append( header_rn, ct_string_len( header_rn ) );
+}
 
+//
+// append_fields()
+//
+
+//! Append all fields of http header.
+/*!
+ * @since v.0.6.14
+ */
+inline void
+append_fields( std::string & result, const http_header_fields_t & h )
+{
 	constexpr const char header_field_sep[] = ": ";
+	constexpr const char header_rn[] = "\r\n";
 	h.for_each_field( [&result, header_field_sep, header_rn](const auto & f) {
 		result += f.name();
 		result.append( header_field_sep, ct_string_len( header_field_sep ) );
 		result += f.value();
 		result.append( header_rn, ct_string_len( header_rn ) );
 	} );
+}
+
+//
+// create_header_string()
+//
+
+//! Creates a string for http response header.
+inline std::string
+create_header_string(
+	const http_response_header_t & h,
+	content_length_field_presence_t content_length_field_presence =
+		content_length_field_presence_t::add_content_length,
+	std::size_t buffer_size = 0 )
+{
+	std::string result;
+
+	if( 0 != buffer_size )
+		result.reserve( buffer_size );
+	else
+		result.reserve( calculate_approx_buffer_size_for_header( h ) );
 
+	append_status_line( result, h );
+
+	append_connection_field( result, h.connection() );
+
+	if( content_length_field_presence_t::add_content_length ==
+		content_length_field_presence )
+	{
+		append_content_length_field( result, h.content_length() );
+	}
+
+	append_fields( result, h );
+
+	constexpr const char header_rn[] = "\r\n";
 	result.append( header_rn, ct_string_len( header_rn ) );
 
 	return result;
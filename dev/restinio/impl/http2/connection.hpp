@@ -0,0 +1,2044 @@
+/*
+	restinio
+*/
+
+/*!
+	HTTP/2 connection routine.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/asio_include.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <restinio/exception.hpp>
+#include <restinio/http_headers.hpp>
+#include <restinio/optional.hpp>
+#include <restinio/request_handler.hpp>
+#include <restinio/connection_count_limiter.hpp>
+#include <restinio/impl/connection_base.hpp>
+#include <restinio/impl/connection_settings.hpp>
+#include <restinio/impl/executor_wrapper.hpp>
+#include <restinio/impl/header_helpers.hpp>
+#include <restinio/impl/http2_fallback.hpp>
+#include <restinio/impl/http2/frames.hpp>
+#include <restinio/impl/http2/hpack.hpp>
+#include <restinio/impl/http2/response_converter.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http2
+{
+
+//! The maximal size of a header block (with all CONTINUATION frames).
+constexpr std::size_t max_header_block_size = 256u * 1024u;
+
+//! The maximal size of a decoded header list.
+/*!
+	The size is calculated as in SETTINGS_MAX_HEADER_LIST_SIZE
+	(RFC 7540, section 6.5.2).
+*/
+constexpr std::size_t max_header_list_size = 256u * 1024u;
+
+//! The size of the output buffer above which reading is suspended.
+/*!
+	Replies to PING and SETTINGS frames are accumulated in the output
+	buffer, so the client that doesn't read them can't force the server
+	to consume unlimited amount of memory.
+*/
+constexpr std::size_t max_pending_output_size = 1024u * 1024u;
+
+//! Get nodejs/http_parser's code of HTTP method by its name.
+/*!
+	@return http_method_id_t::unknown_method for unknown methods.
+*/
+RESTINIO_NODISCARD
+inline int
+nodejs_method_code( string_view_t name ) noexcept
+{
+#define RESTINIO_HTTP_METHOD_CODE_GEN( func_name, nodejs_code, method_name ) \
+	if( string_view_t{ #method_name } == name ) return nodejs_code;
+
+	RESTINIO_HTTP_METHOD_MAP( RESTINIO_HTTP_METHOD_CODE_GEN )
+#undef RESTINIO_HTTP_METHOD_CODE_GEN
+
+	return http_method_id_t::unknown_method;
+}
+
+//
+// stream_t
+//
+
+//! Data of an HTTP/2 stream.
+/*!
+	Every stream holds exactly one request and the response to it.
+*/
+struct stream_t
+{
+	explicit stream_t( std::int64_t send_window ) noexcept
+		:	m_send_window{ send_window }
+	{}
+
+	//! Header of the request.
+	http_request_header_t m_request_header;
+	//! Body of the request.
+	std::string m_request_body;
+	//! Value of content-length field (if present).
+	optional_t< std::uint64_t > m_content_length;
+	//! Is the request completely received?
+	bool m_request_completed{ false };
+
+	//! Converter of the response from HTTP/1.1 serialization.
+	response_converter_t m_response;
+	//! Are response headers passed to the output?
+	bool m_headers_sent{ false };
+	//! Are final parts of the response received?
+	bool m_final_parts_received{ false };
+	//! Body of the response that isn't sent yet.
+	std::string m_pending_body;
+	//! Octets of m_pending_body that are already sent.
+	std::size_t m_pending_body_sent{};
+	//! The total count of the response body octets received.
+	std::uint64_t m_body_received{};
+	//! The total count of the response body octets sent.
+	std::uint64_t m_body_sent{};
+	//! Write groups with after-write notificators.
+	/*!
+		The first item of the pair is the value of m_body_received
+		after the group.
+	*/
+	std::vector< std::pair< std::uint64_t, write_group_t > > m_notificators;
+
+	//! Flow-control window for sending.
+	std::int64_t m_send_window;
+
+	//! Time point when receiving of the request times out.
+	std::chrono::steady_clock::time_point m_reading_deadline;
+	//! Time point when request handling times out.
+	std::chrono::steady_clock::time_point m_handling_deadline;
+	//! Time point when sending of the response times out.
+	/*!
+		It is set only when the response can't be sent because
+		the flow-control window is exhausted.
+	*/
+	optional_t< std::chrono::steady_clock::time_point > m_sending_deadline;
+};
+
+//
+// connection_t
+//
+
+//! Context for handling HTTP/2 connection.
+/*!
+	The connection implements a minimal subset of HTTP/2 that is
+	necessary for serving requests (RFC 7540):
+
+	- the connection preface and SETTINGS exchange;
+	- HPACK decoding of request headers (see hpack::decoder_t);
+	- multiplexing of requests (every stream is passed to the request
+	  handler as a separate request with request_id equal to stream id);
+	- flow control for sending, incoming data is acknowledged
+	  by WINDOW_UPDATE frames immediately;
+	- PING, RST_STREAM, GOAWAY and WINDOW_UPDATE frames.
+
+	Priorities are ignored, server push isn't used.
+
+	Responses are created by ordinary response builders. They serialize
+	responses as HTTP/1.1 messages, so the connection converts them to
+	HEADERS and DATA frames (see response_converter_t).
+
+	@note
+	Sendfile operations aren't supported, a stream with such a response
+	is reset.
+
+	@since v.0.6.14
+*/
+template < typename Traits >
+class connection_t final
+	:	public connection_base_t
+	,	public executor_wrapper_t< typename Traits::strand_t >
+{
+		using executor_wrapper_base_t = executor_wrapper_t< typename Traits::strand_t >;
+
+	public:
+		using timer_manager_t = typename Traits::timer_manager_t;
+		using timer_guard_t = typename timer_manager_t::timer_guard_t;
+		using request_handler_t = request_handler_type_from_traits_t< Traits >;
+		using generic_request_t = generic_request_type_from_traits_t< Traits >;
+		using logger_t = typename Traits::logger_t;
+		using stream_socket_t = typename Traits::stream_socket_t;
+		using lifetime_monitor_t =
+				typename connection_count_limit_types<Traits>::lifetime_monitor_t;
+
+		connection_t(
+			//! Connection id.
+			connection_id_t conn_id,
+			//! Connection socket.
+			stream_socket_t && socket,
+			//! Settings that are common for connections.
+			connection_settings_handle_t< Traits > settings,
+			//! Remote endpoint for that connection.
+			endpoint_t remote_endpoint,
+			//! Lifetime monitor to be used for handling connection count.
+			lifetime_monitor_t lifetime_monitor,
+			//! Data already received from the client.
+			std::string received_data )
+			:	connection_base_t{ conn_id }
+			,	executor_wrapper_base_t{ socket.get_executor() }
+			,	m_socket{ std::move( socket ) }
+			,	m_settings{ std::move( settings ) }
+			,	m_remote_endpoint{ std::move( remote_endpoint ) }
+			,	m_input{ std::move( received_data ) }
+			,	m_read_buffer( m_settings->m_buffer_size )
+			,	m_timer_guard{ m_settings->create_timer_guard() }
+			,	m_request_handler{ *( m_settings->m_request_handler ) }
+			,	m_logger{ *( m_settings->m_logger ) }
+			,	m_lifetime_monitor{ std::move(lifetime_monitor) }
+		{
+			m_logger.trace( [&]{
+					return fmt::format(
+						"[connection:{}] switch to HTTP/2",
+						connection_id() );
+			} );
+		}
+
+		// Disable copy/move.
+		connection_t( const connection_t & ) = delete;
+		connection_t( connection_t && ) = delete;
+		connection_t & operator = ( const connection_t & ) = delete;
+		connection_t & operator = ( connection_t && ) = delete;
+
+		~connection_t() override
+		{
+			m_settings->m_connection_registry->remove( connection_id(), this );
+
+			m_settings->increment_metric( metrics::counter_t::connections_closed );
+
+			restinio::utils::log_trace_noexcept( m_logger,
+				[&]{
+					return fmt::format(
+						"[connection:{}] HTTP/2 connection destructor called",
+						connection_id() );
+				} );
+		}
+
+		void
+		init()
+		{
+			// Replaces the registration of HTTP/1.1 connection.
+			m_settings->m_connection_registry->add(
+					shared_from_concrete< connection_base_t >() );
+
+			// The server connection preface.
+			std::string payload;
+			append_setting(
+					payload,
+					setting_id_t::max_concurrent_streams,
+					static_cast< std::uint32_t >(
+							m_settings->m_http2_max_concurrent_streams ) );
+			append_setting( payload, setting_id_t::enable_push, 0u );
+			append_setting(
+					payload,
+					setting_id_t::max_header_list_size,
+					static_cast< std::uint32_t >( max_header_list_size ) );
+			append_frame( m_output, frame_type_t::settings, 0u, 0u, payload );
+
+			m_last_activity = std::chrono::steady_clock::now();
+			m_prepared_weak_ctx = shared_from_this();
+			init_next_timeout_checking();
+
+			consume_input();
+			start_read();
+			send_output();
+		}
+
+		//! Write parts for specified request.
+		virtual void
+		write_response_parts(
+			//! Request id.
+			request_id_t request_id,
+			//! Resp output flag.
+			response_output_flags_t response_output_flags,
+			//! Part of the response data.
+			write_group_t wg ) override
+		{
+			asio_ns::dispatch(
+				this->get_executor(),
+				[ this,
+					request_id,
+					response_output_flags,
+					actual_wg = std::move( wg ),
+					ctx = shared_from_this() ]
+				() mutable noexcept
+					{
+						try
+						{
+							write_response_parts_impl(
+								static_cast< std::uint32_t >( request_id ),
+								response_output_flags,
+								std::move( actual_wg ) );
+						}
+						catch( const std::exception & ex )
+						{
+							trigger_error_and_close( [&]{
+								return fmt::format(
+									"[connection:{}] unable to handle response: {}",
+									connection_id(),
+									ex.what() );
+							} );
+						}
+					} );
+		}
+
+		virtual void
+		post_to_executor( std::function< void() > cb ) override
+		{
+			asio_ns::post(
+				this->get_executor(),
+				[ ctx = shared_from_this(), actual_cb = std::move( cb ) ] {
+					actual_cb();
+				} );
+		}
+
+		//! Switch the connection to the drain mode.
+		/*!
+			GOAWAY frame is sent, the connection is closed after
+			the handling of already received requests.
+		*/
+		virtual void
+		start_draining() noexcept override
+		{
+			connection_base_t::start_draining();
+
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"http2_connection.start_draining",
+				[this] {
+					asio_ns::post(
+						this->get_executor(),
+						[ ctx = shared_from_this() ]() noexcept {
+							auto & conn_object = cast_to_self( *ctx );
+
+							if( !conn_object.m_socket.is_open() )
+								return;
+
+							restinio::utils::suppress_exceptions(
+								conn_object.m_logger,
+								"http2_connection.send_goaway",
+								[&] {
+									conn_object.send_goaway( error_code_t::no_error );
+									conn_object.send_output();
+								} );
+
+							conn_object.close_if_drained();
+						} );
+				} );
+		}
+
+		//! Close the connection because the drain deadline is expired.
+		virtual void
+		drain_deadline_expired() noexcept override
+		{
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"http2_connection.drain_deadline_expired",
+				[this] {
+					asio_ns::post(
+						this->get_executor(),
+						[ ctx = shared_from_this() ]() noexcept {
+							auto & conn_object = cast_to_self( *ctx );
+
+							if( conn_object.m_socket.is_open() )
+							{
+								restinio::utils::log_warn_noexcept( conn_object.m_logger,
+									[&]{
+										return fmt::format(
+											"[connection:{}] drain deadline expired, "
+											"close connection",
+											conn_object.connection_id() );
+									} );
+
+								conn_object.close();
+							}
+						} );
+				} );
+		}
+
+		//! HTTP/2 responses never contain `Connection: close`.
+		RESTINIO_NODISCARD
+		virtual bool
+		should_close_after_response(
+			request_id_t /*request_id*/ ) const noexcept override
+		{
+			return false;
+		}
+
+	private:
+		using streams_map_t = std::map< std::uint32_t, stream_t >;
+
+		static connection_t &
+		cast_to_self( tcp_connection_ctx_base_t & base )
+		{
+			return static_cast< connection_t & >( base );
+		}
+
+		//! Reading and parsing of incoming frames.
+		//! \{
+
+		void
+		start_read()
+		{
+			if( m_read_operation_is_running || m_closing || !m_socket.is_open() )
+				return;
+
+			// Reading is resumed after writing of the output.
+			if( m_output.size() > max_pending_output_size )
+				return;
+
+			m_read_operation_is_running = true;
+			m_socket.async_read_some(
+				asio_ns::buffer( m_read_buffer.data(), m_read_buffer.size() ),
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[this, ctx = shared_from_this()]
+					( const asio_ns::error_code & ec, std::size_t length ) noexcept {
+						m_read_operation_is_running = false;
+						RESTINIO_ENSURE_NOEXCEPT_CALL( after_read( ec, length ) );
+					} ) );
+		}
+
+		void
+		after_read( const asio_ns::error_code & ec, std::size_t length ) noexcept
+		{
+			if( ec )
+			{
+				if( error_is_operation_aborted( ec ) )
+					return;
+
+				if( error_is_eof( ec ) )
+				{
+					restinio::utils::log_trace_noexcept( m_logger,
+						[&]{
+							return fmt::format(
+									"[connection:{}] EOF, close connection",
+									connection_id() );
+						} );
+
+					close();
+				}
+				else
+					trigger_error_and_close( [&]{
+						return fmt::format(
+								"[connection:{}] read socket error: {}",
+								connection_id(),
+								ec.message() );
+					} );
+
+				return;
+			}
+
+			try
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+							"[connection:{}] received {} bytes",
+							connection_id(),
+							length );
+				} );
+
+				m_settings->increment_metric(
+						metrics::counter_t::bytes_read, length );
+
+				m_last_activity = std::chrono::steady_clock::now();
+				m_input.append( m_read_buffer.data(), length );
+
+				consume_input();
+				start_read();
+				send_output();
+			}
+			catch( const std::exception & x )
+			{
+				trigger_error_and_close( [&] {
+						return fmt::format(
+								"[connection:{}] unexpected exception during the "
+								"handling of incoming data: {}",
+								connection_id(),
+								x.what() );
+					} );
+			}
+		}
+
+		//! Handle all complete frames in the input buffer.
+		void
+		consume_input()
+		{
+			if( !m_preface_received )
+			{
+				const auto preface = http2_fallback::client_preface();
+				const auto to_compare = (std::min)( m_input.size(), preface.size() );
+				if( 0 != std::memcmp( m_input.data(), preface.data(), to_compare ) )
+				{
+					connection_error(
+							error_code_t::protocol_error,
+							"invalid client connection preface" );
+					return;
+				}
+
+				if( m_input.size() < preface.size() )
+					return;
+
+				m_input.erase( 0u, preface.size() );
+				m_preface_received = true;
+			}
+
+			std::size_t pos = 0u;
+			while( !m_closing && m_socket.is_open() &&
+				m_input.size() - pos >= frame_header_size )
+			{
+				const auto header = parse_frame_header( m_input.data() + pos );
+				if( header.m_length > default_max_frame_size )
+				{
+					connection_error(
+							error_code_t::frame_size_error,
+							"frame is too large" );
+					return;
+				}
+
+				if( m_input.size() - pos - frame_header_size < header.m_length )
+					break;
+
+				const string_view_t payload{
+						m_input.data() + pos + frame_header_size,
+						header.m_length };
+				pos += frame_header_size + header.m_length;
+
+				handle_frame( header, payload );
+			}
+
+			if( !m_closing )
+				m_input.erase( 0u, pos );
+		}
+
+		void
+		handle_frame( const frame_header_t & header, string_view_t payload )
+		{
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] frame received, type: {}, flags: {}, "
+						"stream: {}, length: {}",
+						connection_id(),
+						static_cast< unsigned >( header.m_type ),
+						static_cast< unsigned >( header.m_flags ),
+						header.m_stream_id,
+						header.m_length );
+			} );
+
+			if( !m_settings_received &&
+				( frame_type_t::settings != header.m_type ||
+					header.has_flag( flag_ack ) ) )
+			{
+				connection_error(
+						error_code_t::protocol_error,
+						"the first frame isn't SETTINGS" );
+				return;
+			}
+
+			if( 0u != m_continuation_stream_id &&
+				( frame_type_t::continuation != header.m_type ||
+					m_continuation_stream_id != header.m_stream_id ) )
+			{
+				connection_error(
+						error_code_t::protocol_error,
+						"CONTINUATION frame is expected" );
+				return;
+			}
+
+			switch( header.m_type )
+			{
+				case frame_type_t::data:
+					handle_data_frame( header, payload );
+				break;
+
+				case frame_type_t::headers:
+					handle_headers_frame( header, payload );
+				break;
+
+				case frame_type_t::continuation:
+					handle_continuation_frame( header, payload );
+				break;
+
+				case frame_type_t::priority:
+					if( 0u == header.m_stream_id )
+						connection_error(
+								error_code_t::protocol_error,
+								"PRIORITY frame for stream 0" );
+					else if( 5u != payload.size() )
+						reset_stream( header.m_stream_id, error_code_t::frame_size_error );
+					// Priorities are ignored.
+				break;
+
+				case frame_type_t::rst_stream:
+					handle_rst_stream_frame( header, payload );
+				break;
+
+				case frame_type_t::settings:
+					handle_settings_frame( header, payload );
+				break;
+
+				case frame_type_t::push_promise:
+					connection_error(
+							error_code_t::protocol_error,
+							"PUSH_PROMISE frame from a client" );
+				break;
+
+				case frame_type_t::ping:
+					handle_ping_frame( header, payload );
+				break;
+
+				case frame_type_t::goaway:
+					handle_goaway_frame( header, payload );
+				break;
+
+				case frame_type_t::window_update:
+					handle_window_update_frame( header, payload );
+				break;
+
+				default:
+					// Unknown frames are ignored (RFC 7540, section 4.1).
+				break;
+			}
+		}
+
+		//! Remove padding from the payload of a frame.
+		/*!
+			@return false if the padding is invalid.
+		*/
+		RESTINIO_NODISCARD
+		bool
+		remove_padding( const frame_header_t & header, string_view_t & payload )
+		{
+			if( !header.has_flag( flag_padded ) )
+				return true;
+
+			if( payload.empty() ||
+				static_cast< std::uint8_t >( payload.front() ) >= payload.size() )
+			{
+				connection_error( error_code_t::protocol_error, "invalid padding" );
+				return false;
+			}
+
+			const auto pad_length = static_cast< std::uint8_t >( payload.front() );
+			payload = payload.substr( 1u, payload.size() - 1u - pad_length );
+			return true;
+		}
+
+		void
+		handle_data_frame( const frame_header_t & header, string_view_t payload )
+		{
+			if( 0u == header.m_stream_id )
+			{
+				connection_error(
+						error_code_t::protocol_error, "DATA frame for stream 0" );
+				return;
+			}
+
+			// The whole frame is subject to flow control. Incoming data
+			// is consumed immediately, so the window is restored.
+			if( 0u != header.m_length )
+				append_window_update( m_output, 0u, header.m_length );
+
+			if( !remove_padding( header, payload ) )
+				return;
+
+			auto it = m_streams.find( header.m_stream_id );
+			if( m_streams.end() == it || it->second.m_request_completed )
+			{
+				if( header.m_stream_id > m_last_stream_id )
+					connection_error(
+							error_code_t::protocol_error, "DATA frame for idle stream" );
+				else
+					reset_stream( header.m_stream_id, error_code_t::stream_closed );
+				return;
+			}
+
+			auto & stream = it->second;
+			if( m_settings->m_incoming_http_msg_limits.max_body_size() -
+					stream.m_request_body.size() < payload.size() )
+			{
+				stream_error( header.m_stream_id, "request body is too large" );
+				return;
+			}
+
+			stream.m_request_body.append( payload.data(), payload.size() );
+
+			if( header.has_flag( flag_end_stream ) )
+				on_request_completed( header.m_stream_id );
+			else if( 0u != header.m_length )
+				append_window_update( m_output, header.m_stream_id, header.m_length );
+		}
+
+		void
+		handle_headers_frame( const frame_header_t & header, string_view_t payload )
+		{
+			if( 0u == header.m_stream_id || 0u == ( header.m_stream_id & 1u ) )
+			{
+				connection_error(
+						error_code_t::protocol_error, "invalid stream id of HEADERS frame" );
+				return;
+			}
+
+			if( !remove_padding( header, payload ) )
+				return;
+
+			if( header.has_flag( flag_priority ) )
+			{
+				if( payload.size() < 5u )
+				{
+					connection_error(
+							error_code_t::frame_size_error, "invalid HEADERS frame" );
+					return;
+				}
+				payload.remove_prefix( 5u );
+			}
+
+			m_header_block.assign( payload.data(), payload.size() );
+			m_header_block_end_stream = header.has_flag( flag_end_stream );
+
+			if( header.has_flag( flag_end_headers ) )
+				on_header_block( header.m_stream_id );
+			else
+				m_continuation_stream_id = header.m_stream_id;
+		}
+
+		void
+		handle_continuation_frame(
+			const frame_header_t & header,
+			string_view_t payload )
+		{
+			if( 0u == m_continuation_stream_id )
+			{
+				connection_error(
+						error_code_t::protocol_error, "unexpected CONTINUATION frame" );
+				return;
+			}
+
+			if( max_header_block_size - m_header_block.size() < payload.size() )
+			{
+				connection_error(
+						error_code_t::enhance_your_calm, "header block is too large" );
+				return;
+			}
+
+			m_header_block.append( payload.data(), payload.size() );
+
+			if( header.has_flag( flag_end_headers ) )
+			{
+				m_continuation_stream_id = 0u;
+				on_header_block( header.m_stream_id );
+			}
+		}
+
+		void
+		handle_rst_stream_frame(
+			const frame_header_t & header,
+			string_view_t payload )
+		{
+			if( 0u == header.m_stream_id || header.m_stream_id > m_last_stream_id )
+			{
+				connection_error(
+						error_code_t::protocol_error, "RST_STREAM for idle stream" );
+				return;
+			}
+
+			if( 4u != payload.size() )
+			{
+				connection_error(
+						error_code_t::frame_size_error, "invalid RST_STREAM frame" );
+				return;
+			}
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] stream {} is reset by the client, "
+						"error code: {}",
+						connection_id(),
+						header.m_stream_id,
+						read_uint32( payload.data() ) );
+			} );
+
+			remove_stream( header.m_stream_id );
+		}
+
+		void
+		handle_settings_frame(
+			const frame_header_t & header,
+			string_view_t payload )
+		{
+			if( 0u != header.m_stream_id )
+			{
+				connection_error(
+						error_code_t::protocol_error, "SETTINGS frame for a stream" );
+				return;
+			}
+
+			if( header.has_flag( flag_ack ) )
+			{
+				if( !payload.empty() )
+					connection_error(
+							error_code_t::frame_size_error, "invalid SETTINGS ack" );
+				return;
+			}
+
+			if( 0u != payload.size() % 6u )
+			{
+				connection_error(
+						error_code_t::frame_size_error, "invalid SETTINGS frame" );
+				return;
+			}
+
+			m_settings_received = true;
+
+			for( ; !payload.empty(); payload.remove_prefix( 6u ) )
+			{
+				const auto id = read_uint16( payload.data() );
+				const auto value = read_uint32( payload.data() + 2 );
+
+				switch( static_cast< setting_id_t >( id ) )
+				{
+					case setting_id_t::enable_push:
+						if( value > 1u )
+						{
+							connection_error(
+									error_code_t::protocol_error,
+									"invalid SETTINGS_ENABLE_PUSH" );
+							return;
+						}
+					break;
+
+					case setting_id_t::initial_window_size:
+						if( !update_initial_window_size( value ) )
+							return;
+					break;
+
+					case setting_id_t::max_frame_size:
+						if( value < default_max_frame_size ||
+							value > max_allowed_frame_size )
+						{
+							connection_error(
+									error_code_t::protocol_error,
+									"invalid SETTINGS_MAX_FRAME_SIZE" );
+							return;
+						}
+						m_peer_max_frame_size = value;
+					break;
+
+					default:
+						// Other settings don't affect the server.
+					break;
+				}
+			}
+
+			append_frame( m_output, frame_type_t::settings, flag_ack, 0u, {} );
+
+			// The window could be enlarged.
+			send_pending_data();
+		}
+
+		//! Apply a new value of SETTINGS_INITIAL_WINDOW_SIZE.
+		RESTINIO_NODISCARD
+		bool
+		update_initial_window_size( std::uint32_t value )
+		{
+			if( value > static_cast< std::uint32_t >( max_window_size ) )
+			{
+				connection_error(
+						error_code_t::flow_control_error,
+						"invalid SETTINGS_INITIAL_WINDOW_SIZE" );
+				return false;
+			}
+
+			const auto delta =
+					static_cast< std::int64_t >( value ) - m_peer_initial_window_size;
+			m_peer_initial_window_size = value;
+
+			for( auto & item : m_streams )
+			{
+				item.second.m_send_window += delta;
+				if( item.second.m_send_window > max_window_size )
+				{
+					connection_error(
+							error_code_t::flow_control_error,
+							"flow-control window is too large" );
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void
+		handle_ping_frame( const frame_header_t & header, string_view_t payload )
+		{
+			if( 0u != header.m_stream_id )
+			{
+				connection_error(
+						error_code_t::protocol_error, "PING frame for a stream" );
+				return;
+			}
+
+			if( 8u != payload.size() )
+			{
+				connection_error(
+						error_code_t::frame_size_error, "invalid PING frame" );
+				return;
+			}
+
+			if( !header.has_flag( flag_ack ) )
+				append_frame( m_output, frame_type_t::ping, flag_ack, 0u, payload );
+		}
+
+		void
+		handle_goaway_frame( const frame_header_t & header, string_view_t payload )
+		{
+			if( 0u != header.m_stream_id || payload.size() < 8u )
+			{
+				connection_error(
+						error_code_t::protocol_error, "invalid GOAWAY frame" );
+				return;
+			}
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] GOAWAY received, error code: {}",
+						connection_id(),
+						read_uint32( payload.data() + 4 ) );
+			} );
+
+			// The client won't open new streams, the connection is
+			// closed after the handling of the current requests.
+			m_goaway_received = true;
+			close_if_drained();
+		}
+
+		void
+		handle_window_update_frame(
+			const frame_header_t & header,
+			string_view_t payload )
+		{
+			if( 4u != payload.size() )
+			{
+				connection_error(
+						error_code_t::frame_size_error, "invalid WINDOW_UPDATE frame" );
+				return;
+			}
+
+			const auto increment = read_uint32( payload.data() ) & 0x7FFFFFFFu;
+
+			if( 0u == header.m_stream_id )
+			{
+				if( 0u == increment )
+				{
+					connection_error(
+							error_code_t::protocol_error, "zero WINDOW_UPDATE increment" );
+					return;
+				}
+
+				m_send_window += increment;
+				if( m_send_window > max_window_size )
+				{
+					connection_error(
+							error_code_t::flow_control_error,
+							"flow-control window is too large" );
+					return;
+				}
+			}
+			else
+			{
+				auto it = m_streams.find( header.m_stream_id );
+				if( m_streams.end() == it )
+				{
+					if( header.m_stream_id > m_last_stream_id )
+						connection_error(
+								error_code_t::protocol_error,
+								"WINDOW_UPDATE for idle stream" );
+					// Frames for closed streams are ignored.
+					return;
+				}
+
+				if( 0u == increment )
+				{
+					reset_stream( header.m_stream_id, error_code_t::protocol_error );
+					return;
+				}
+
+				it->second.m_send_window += increment;
+				if( it->second.m_send_window > max_window_size )
+				{
+					reset_stream( header.m_stream_id, error_code_t::flow_control_error );
+					return;
+				}
+			}
+
+			send_pending_data();
+		}
+		//! \}
+
+		//! Handling of requests.
+		//! \{
+
+		//! Handle a complete header block.
+		void
+		on_header_block( std::uint32_t stream_id )
+		{
+			// The header block should be decoded in any case,
+			// otherwise the state of HPACK decoder will be broken.
+			hpack::header_list_t fields;
+			const auto decoding_result = m_hpack_decoder.decode(
+					m_header_block,
+					m_settings->m_incoming_http_msg_limits,
+					max_header_list_size,
+					fields );
+			if( hpack::decoding_result_t::compression_error == decoding_result )
+			{
+				connection_error(
+						error_code_t::compression_error, "unable to decode header block" );
+				return;
+			}
+			m_header_block.clear();
+
+			if( hpack::decoding_result_t::limit_exceeded == decoding_result )
+			{
+				// The state of the connection is consistent, so only
+				// the stream is reset.
+				if( stream_id > m_last_stream_id )
+					m_last_stream_id = stream_id;
+				stream_error( stream_id, "header list is too large" );
+				return;
+			}
+
+			auto it = m_streams.find( stream_id );
+			if( m_streams.end() != it )
+			{
+				// Trailer fields are ignored.
+				if( it->second.m_request_completed || !m_header_block_end_stream )
+					stream_error( stream_id, "unexpected HEADERS frame" );
+				else
+					on_request_completed( stream_id );
+				return;
+			}
+
+			if( stream_id <= m_last_stream_id )
+			{
+				// The stream is already reset or completed.
+				reset_stream( stream_id, error_code_t::stream_closed );
+				return;
+			}
+
+			m_last_stream_id = stream_id;
+
+			if( m_goaway_sent )
+			{
+				// New streams are ignored after GOAWAY.
+				return;
+			}
+
+			// Streams that are reset by the client still occupy the limit
+			// until their handlers are finished.
+			if( m_streams.size() + m_detached_handlers.size() >=
+				m_settings->m_http2_max_concurrent_streams )
+			{
+				reset_stream( stream_id, error_code_t::refused_stream );
+				return;
+			}
+
+			it = m_streams.emplace(
+					stream_id,
+					stream_t{ m_peer_initial_window_size } ).first;
+			it->second.m_reading_deadline = std::chrono::steady_clock::now() +
+					m_settings->m_read_next_http_message_timelimit;
+
+			const char * error = make_request_header( fields, it->second );
+			if( nullptr != error )
+			{
+				stream_error( stream_id, error );
+				return;
+			}
+
+			if( m_header_block_end_stream )
+				on_request_completed( stream_id );
+		}
+
+		//! Make the header of the request from HTTP/2 header fields.
+		/*!
+			@return the description of an error or nullptr.
+		*/
+		const char *
+		make_request_header( hpack::header_list_t & fields, stream_t & stream )
+		{
+			// Limits for fields are already checked by HPACK decoder.
+			const auto & limits = m_settings->m_incoming_http_msg_limits;
+
+			string_view_t method;
+			string_view_t scheme;
+			string_view_t authority;
+			std::string path;
+			std::string cookie;
+			bool regular_field_found = false;
+			bool host_found = false;
+
+			auto & header = stream.m_request_header;
+
+			for( auto & field : fields )
+			{
+				const auto & name = field.first;
+				auto & value = field.second;
+
+				if( name.empty() )
+					return "empty field name";
+
+				if( ':' == name.front() )
+				{
+					// Pseudo-header fields should precede regular fields
+					// and should be present only once.
+					string_view_t * target = nullptr;
+					if( ":method" == name )
+						target = &method;
+					else if( ":scheme" == name )
+						target = &scheme;
+					else if( ":authority" == name )
+						target = &authority;
+					else if( ":path" == name )
+					{
+						if( regular_field_found || !path.empty() || value.empty() )
+							return "invalid :path";
+						path = std::move( value );
+						continue;
+					}
+					else
+						return "unknown pseudo-header field";
+
+					if( regular_field_found || !target->empty() || value.empty() )
+						return "invalid pseudo-header field";
+
+					*target = value;
+					continue;
+				}
+
+				regular_field_found = true;
+
+				for( const auto ch : name )
+					if( ch != to_lower_case( ch ) )
+						return "uppercase field name";
+
+				if( "connection" == name || "keep-alive" == name ||
+					"proxy-connection" == name || "transfer-encoding" == name ||
+					"upgrade" == name )
+					return "connection-specific header field";
+
+				if( "te" == name && "trailers" != value )
+					return "invalid te field";
+
+				if( "cookie" == name )
+				{
+					// Cookies are concatenated (RFC 7540, section 8.1.2.5).
+					if( !cookie.empty() )
+						cookie.append( "; " );
+					cookie.append( value );
+					continue;
+				}
+
+				if( "content-length" == name )
+				{
+					std::uint64_t length{};
+					if( value.empty() || value.size() > 19u )
+						return "invalid content-length";
+					for( const auto ch : value )
+					{
+						if( ch < '0' || ch > '9' )
+							return "invalid content-length";
+						length = length * 10u + static_cast< unsigned >( ch - '0' );
+					}
+					stream.m_content_length = length;
+				}
+
+				if( "host" == name )
+					host_found = true;
+
+				header.add_field( name, std::move( value ) );
+			}
+
+			if( method.empty() || scheme.empty() || path.empty() )
+				return "mandatory pseudo-header field is missing";
+
+			if( path.size() > limits.max_url_size() )
+				return "path is too long";
+
+			const auto method_code = nodejs_method_code( method );
+			if( http_method_id_t::unknown_method == method_code ||
+				HTTP_CONNECT == method_code )
+				return "unsupported method";
+
+			header.method( Traits::http_methods_mapper_t::from_nodejs( method_code ) );
+			header.request_target( std::move( path ) );
+			header.http_major( 2u );
+			header.http_minor( 0u );
+			header.should_keep_alive( true );
+
+			if( !host_found && !authority.empty() )
+				header.set_field(
+						http_field::host,
+						std::string{ authority.data(), authority.size() } );
+
+			if( !cookie.empty() )
+				header.set_field( http_field::cookie, std::move( cookie ) );
+
+			return nullptr;
+		}
+
+		//! The whole request is received, pass it to the request handler.
+		void
+		on_request_completed( std::uint32_t stream_id )
+		{
+			auto & stream = m_streams.at( stream_id );
+			stream.m_request_completed = true;
+
+			if( stream.m_content_length &&
+				*stream.m_content_length != stream.m_request_body.size() )
+			{
+				stream_error( stream_id, "content-length mismatch" );
+				return;
+			}
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] request received (#{}): {} {}",
+						connection_id(),
+						stream_id,
+						stream.m_request_header.method(),
+						stream.m_request_header.request_target() );
+			} );
+
+			m_settings->increment_metric( metrics::counter_t::requests );
+
+			stream.m_handling_deadline = std::chrono::steady_clock::now() +
+					m_settings->m_handle_request_timeout;
+
+			auto req = std::make_shared< generic_request_t >(
+					stream_id,
+					std::move( stream.m_request_header ),
+					std::move( stream.m_request_body ),
+					shared_from_concrete< connection_base_t >(),
+					m_remote_endpoint,
+					m_settings->extra_data_factory() );
+
+			// The response can be written (and the stream can be removed)
+			// during the call to the handler.
+			const auto handling_result = m_settings->measure_latency(
+					metrics::histogram_t::handler_latency,
+					[&] { return m_request_handler( std::move( req ) ); } );
+
+			if( request_handling_status_t::accepted != handling_result )
+				write_response_parts_impl(
+					stream_id,
+					response_output_flags_t{
+						response_parts_attr_t::final_parts,
+						response_connection_attr_t::connection_keepalive },
+					write_group_t{ create_not_implemented_resp() } );
+		}
+		//! \}
+
+		//! Writing of responses.
+		//! \{
+
+		void
+		write_response_parts_impl(
+			std::uint32_t stream_id,
+			response_output_flags_t response_output_flags,
+			write_group_t wg )
+		{
+			const bool final_parts = response_parts_attr_t::final_parts ==
+					response_output_flags.m_response_parts;
+
+			auto it = m_streams.find( stream_id );
+			if( m_streams.end() == it )
+			{
+				const auto detached = m_detached_handlers.find( stream_id );
+				if( m_detached_handlers.end() != detached )
+				{
+					m_logger.trace( [&]{
+						return fmt::format(
+								"[connection:{}] response parts for stream {} "
+								"are ignored, the stream is closed",
+								connection_id(),
+								stream_id );
+					} );
+
+					if( final_parts )
+						m_detached_handlers.erase( detached );
+
+					invoke_after_write_notificator( wg, write_was_not_executed() );
+					return;
+				}
+			}
+
+			if( m_streams.end() == it || !it->second.m_request_completed ||
+				!m_socket.is_open() )
+			{
+				m_logger.warn( [&]{
+					return fmt::format(
+							"[connection:{}] receive response parts for "
+							"stream {}, but the stream is closed",
+							connection_id(),
+							stream_id );
+				} );
+
+				invoke_after_write_notificator( wg, write_was_not_executed() );
+				return;
+			}
+
+			auto & stream = it->second;
+			const auto body_size_before = stream.m_pending_body.size();
+
+			for( const auto & item : wg.items() )
+			{
+				if( writable_item_type_t::trivial_write_operation !=
+					item.write_type() )
+				{
+					invoke_after_write_notificator( wg, write_was_not_executed() );
+					stream_error( stream_id,
+							"sendfile isn't supported for HTTP/2 connections",
+							error_code_t::internal_error );
+					return;
+				}
+
+				const auto buf = item.buf();
+				if( !stream.m_response.feed(
+						string_view_t{
+								asio_ns::buffer_cast< const char * >( buf ),
+								asio_ns::buffer_size( buf ) },
+						stream.m_pending_body ) )
+				{
+					invoke_after_write_notificator( wg, write_was_not_executed() );
+					stream_error( stream_id,
+							"malformed response", error_code_t::internal_error );
+					return;
+				}
+			}
+
+			stream.m_body_received +=
+					stream.m_pending_body.size() - body_size_before;
+
+			if( final_parts )
+			{
+				if( !stream.m_response.header_completed() )
+				{
+					invoke_after_write_notificator( wg, write_was_not_executed() );
+					stream_error( stream_id,
+							"incomplete response header", error_code_t::internal_error );
+					return;
+				}
+
+				stream.m_final_parts_received = true;
+			}
+
+			if( wg.has_after_write_notificator() )
+				stream.m_notificators.emplace_back(
+						stream.m_body_received, std::move( wg ) );
+
+			if( !stream.m_headers_sent && stream.m_response.header_completed() )
+				send_response_headers( stream_id, stream );
+
+			send_pending_data();
+			send_output();
+		}
+
+		//! Put HEADERS (and CONTINUATION) frames to the output.
+		void
+		send_response_headers( std::uint32_t stream_id, stream_t & stream )
+		{
+			std::string block;
+			m_hpack_encoder.start_block( block );
+			m_hpack_encoder.encode_status( block, stream.m_response.status() );
+			for( const auto & field : stream.m_response.fields() )
+				m_hpack_encoder.encode_field( block, field.first, field.second );
+
+			// The stream ends with HEADERS if there is no body.
+			const bool end_stream = stream.m_final_parts_received &&
+					0u == stream.m_body_received;
+
+			string_view_t rest{ block };
+			auto type = frame_type_t::headers;
+			do
+			{
+				const auto fragment = rest.substr( 0u, m_peer_max_frame_size );
+				rest.remove_prefix( fragment.size() );
+
+				std::uint8_t flags = rest.empty() ? flag_end_headers : 0u;
+				if( frame_type_t::headers == type && end_stream )
+					flags |= flag_end_stream;
+
+				append_frame( m_output, type, flags, stream_id, fragment );
+				type = frame_type_t::continuation;
+			}
+			while( !rest.empty() );
+
+			stream.m_headers_sent = true;
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] start response (#{}): {}",
+						connection_id(),
+						stream_id,
+						stream.m_response.status() );
+			} );
+
+			if( end_stream )
+				finish_stream( stream_id, stream );
+		}
+
+		//! Put DATA frames to the output with respect to flow control.
+		/*!
+			Streams are served in round-robin fashion.
+		*/
+		void
+		send_pending_data()
+		{
+			bool progress = true;
+			while( progress && !m_closing )
+			{
+				progress = false;
+
+				for( auto it = m_streams.begin(); it != m_streams.end(); )
+				{
+					const auto stream_id = it->first;
+					auto & stream = it->second;
+					++it;
+
+					if( !stream.m_headers_sent )
+						continue;
+
+					const auto pending =
+							stream.m_pending_body.size() - stream.m_pending_body_sent;
+					// Windows can become negative after a decrease of
+					// SETTINGS_INITIAL_WINDOW_SIZE (RFC 7540, 6.9.2),
+					// such a stream is blocked until WINDOW_UPDATE.
+					const bool window_exhausted =
+							m_send_window <= 0 || stream.m_send_window <= 0;
+					const auto size = window_exhausted ? std::size_t{ 0u } :
+							static_cast< std::size_t >( (std::min)( {
+									static_cast< std::int64_t >( pending ),
+									static_cast< std::int64_t >( m_peer_max_frame_size ),
+									m_send_window,
+									stream.m_send_window } ) );
+
+					const bool end_stream = stream.m_final_parts_received &&
+							pending == size;
+
+					if( 0u == size && !end_stream )
+					{
+						// The response is blocked by flow control.
+						if( 0u != pending && !stream.m_sending_deadline )
+							stream.m_sending_deadline =
+									std::chrono::steady_clock::now() +
+									m_settings->m_write_http_response_timelimit;
+						continue;
+					}
+
+					stream.m_sending_deadline = nullopt;
+
+					append_frame(
+							m_output,
+							frame_type_t::data,
+							end_stream ? flag_end_stream : std::uint8_t{ 0u },
+							stream_id,
+							string_view_t{
+									stream.m_pending_body.data() +
+											stream.m_pending_body_sent,
+									size } );
+
+					m_send_window -= static_cast< std::int64_t >( size );
+					stream.m_send_window -= static_cast< std::int64_t >( size );
+					stream.m_pending_body_sent += size;
+					stream.m_body_sent += size;
+
+					if( stream.m_pending_body_sent == stream.m_pending_body.size() )
+					{
+						stream.m_pending_body.clear();
+						stream.m_pending_body_sent = 0u;
+					}
+
+					move_sent_notificators( stream );
+
+					if( end_stream )
+						finish_stream( stream_id, stream );
+					else
+						progress = progress || 0u != size;
+				}
+			}
+		}
+
+		//! Move notificators of completely sent write groups to
+		//! the list for the next write operation.
+		void
+		move_sent_notificators( stream_t & stream )
+		{
+			auto & notificators = stream.m_notificators;
+			auto it = notificators.begin();
+			for( ; it != notificators.end() && it->first <= stream.m_body_sent; ++it )
+				m_output_notificators.push_back( std::move( it->second ) );
+
+			notificators.erase( notificators.begin(), it );
+		}
+
+		//! The whole response is put to the output.
+		void
+		finish_stream( std::uint32_t stream_id, stream_t & stream )
+		{
+			stream.m_body_sent = stream.m_body_received;
+			move_sent_notificators( stream );
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] response is completed (#{})",
+						connection_id(),
+						stream_id );
+			} );
+
+			m_streams.erase( stream_id );
+		}
+
+		//! Start writing the output if it isn't empty.
+		void
+		send_output()
+		{
+			if( m_write_operation_is_running || !m_socket.is_open() )
+				return;
+
+			if( m_output.empty() )
+			{
+				if( m_closing )
+					close();
+				else
+					close_if_drained();
+				return;
+			}
+
+			m_writing.swap( m_output );
+			m_output.clear();
+			m_writing_notificators.swap( m_output_notificators );
+
+			m_write_operation_is_running = true;
+			m_write_started_at = std::chrono::steady_clock::now();
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[connection:{}] sending data, size: {}",
+						connection_id(),
+						m_writing.size() );
+			} );
+
+			asio_ns::async_write(
+				m_socket,
+				asio_ns::buffer( m_writing ),
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[this, ctx = shared_from_this()]
+					( const asio_ns::error_code & ec, std::size_t written ) noexcept
+					{
+						m_write_operation_is_running = false;
+						RESTINIO_ENSURE_NOEXCEPT_CALL( after_write( ec, written ) );
+					} ) );
+		}
+
+		void
+		after_write( const asio_ns::error_code & ec, std::size_t written ) noexcept
+		{
+			if( !ec )
+			{
+				m_settings->increment_metric(
+						metrics::counter_t::bytes_written, written );
+				m_last_activity = std::chrono::steady_clock::now();
+			}
+
+			m_writing.clear();
+			invoke_after_write_notificators( m_writing_notificators, ec );
+
+			if( ec )
+			{
+				if( !error_is_operation_aborted( ec ) )
+					trigger_error_and_close( [&]{
+						return fmt::format(
+								"[connection:{}] unable to write: {}",
+								connection_id(),
+								ec.message() );
+					} );
+				return;
+			}
+
+			try
+			{
+				send_pending_data();
+				send_output();
+				start_read();
+			}
+			catch( const std::exception & x )
+			{
+				trigger_error_and_close( [&] {
+						return fmt::format(
+								"[connection:{}] unexpected exception after write: {}",
+								connection_id(),
+								x.what() );
+					} );
+			}
+		}
+
+		RESTINIO_NODISCARD
+		static asio_ns::error_code
+		write_was_not_executed() noexcept
+		{
+			return make_asio_compaible_error(
+					asio_convertible_error_t::write_was_not_executed );
+		}
+
+		static void
+		invoke_after_write_notificator(
+			write_group_t & wg,
+			const asio_ns::error_code & ec ) noexcept
+		{
+			restinio::utils::suppress_exceptions_quietly( [&] {
+					wg.invoke_after_write_notificator_if_exists( ec );
+				} );
+		}
+
+		static void
+		invoke_after_write_notificators(
+			std::vector< write_group_t > & groups,
+			const asio_ns::error_code & ec ) noexcept
+		{
+			for( auto & wg : groups )
+				invoke_after_write_notificator( wg, ec );
+
+			groups.clear();
+		}
+		//! \}
+
+		//! Errors and closing.
+		//! \{
+
+		//! Send GOAWAY frame (if it isn't sent yet).
+		void
+		send_goaway( error_code_t error )
+		{
+			if( !m_goaway_sent )
+			{
+				append_goaway( m_output, m_last_stream_id, error );
+				m_goaway_sent = true;
+			}
+		}
+
+		//! Handle a connection error (RFC 7540, section 5.4.1).
+		/*!
+			GOAWAY frame is sent and the connection is closed after that.
+		*/
+		void
+		connection_error( error_code_t error, const char * description )
+		{
+			m_settings->increment_metric( metrics::counter_t::parse_errors );
+
+			m_logger.warn( [&]{
+				return fmt::format(
+						"[connection:{}] HTTP/2 connection error: {}",
+						connection_id(),
+						description );
+			} );
+
+			if( m_goaway_sent )
+			{
+				// GOAWAY with the actual error code should be sent.
+				m_goaway_sent = false;
+			}
+
+			send_goaway( error );
+			m_closing = true;
+		}
+
+		//! Handle a stream error (RFC 7540, section 5.4.2).
+		void
+		stream_error(
+			std::uint32_t stream_id,
+			const char * description,
+			error_code_t error = error_code_t::protocol_error )
+		{
+			m_logger.warn( [&]{
+				return fmt::format(
+						"[connection:{}] HTTP/2 stream {} error: {}",
+						connection_id(),
+						stream_id,
+						description );
+			} );
+
+			reset_stream( stream_id, error );
+		}
+
+		//! Send RST_STREAM and forget the stream.
+		void
+		reset_stream( std::uint32_t stream_id, error_code_t error )
+		{
+			append_rst_stream( m_output, stream_id, error );
+			remove_stream( stream_id );
+		}
+
+		//! Forget the stream.
+		/*!
+			After-write notificators of the stream are invoked with an error.
+		*/
+		void
+		remove_stream( std::uint32_t stream_id ) noexcept
+		{
+			auto it = m_streams.find( stream_id );
+			if( m_streams.end() == it )
+				return;
+
+			auto & stream = it->second;
+			for( auto & item : stream.m_notificators )
+				invoke_after_write_notificator( item.second, write_was_not_executed() );
+
+			// The handler is still running, it should be taken into
+			// account until the response or the handling deadline.
+			if( stream.m_request_completed && !stream.m_final_parts_received &&
+				std::chrono::steady_clock::now() < stream.m_handling_deadline )
+			{
+				restinio::utils::suppress_exceptions_quietly( [&] {
+						m_detached_handlers.emplace(
+								stream_id, stream.m_handling_deadline );
+					} );
+			}
+
+			m_streams.erase( it );
+
+			close_if_drained();
+		}
+
+		//! Close the connection if it is in the drain mode or GOAWAY
+		//! is received and there are no more requests.
+		void
+		close_if_drained() noexcept
+		{
+			if( ( is_draining() || m_goaway_received ) &&
+				m_socket.is_open() &&
+				m_streams.empty() &&
+				!m_write_operation_is_running &&
+				m_output.empty() )
+			{
+				restinio::utils::log_trace_noexcept( m_logger,
+					[&]{
+						return fmt::format(
+							"[connection:{}] connection is drained",
+							connection_id() );
+					} );
+
+				close();
+			}
+		}
+
+		template< typename Message_Builder >
+		void
+		trigger_error_and_close( Message_Builder msg_builder ) noexcept
+		{
+			restinio::utils::log_error_noexcept( m_logger, std::move(msg_builder) );
+
+			close();
+		}
+
+		void
+		close() noexcept
+		{
+			if( !m_socket.is_open() )
+				return;
+
+			restinio::utils::log_trace_noexcept( m_logger,
+				[&]{
+					return fmt::format(
+						"[connection:{}] close",
+						connection_id() );
+				} );
+
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"http2_connection.socket.shutdown",
+				[this] {
+					asio_ns::error_code ignored_ec;
+					m_socket.shutdown(
+						asio_ns::ip::tcp::socket::shutdown_both,
+						ignored_ec );
+				} );
+			restinio::utils::suppress_exceptions(
+				m_logger,
+				"http2_connection.socket.close",
+				[this] {
+					m_socket.close();
+				} );
+
+			RESTINIO_ENSURE_NOEXCEPT_CALL( cancel_timeout_checking() );
+
+			for( auto & item : m_streams )
+				for( auto & notificator : item.second.m_notificators )
+					invoke_after_write_notificator(
+							notificator.second, write_was_not_executed() );
+			m_streams.clear();
+
+			invoke_after_write_notificators(
+					m_output_notificators, write_was_not_executed() );
+
+			m_settings->call_state_listener_suppressing_exceptions(
+				[this]() noexcept {
+					return connection_state::notice_t{
+							this->connection_id(),
+							this->m_remote_endpoint,
+							connection_state::closed_t{}
+						};
+				} );
+		}
+		//! \}
+
+		//! Timeouts.
+		//! \{
+
+		virtual void
+		check_timeout( tcp_connection_ctx_handle_t & self ) override
+		{
+			asio_ns::dispatch(
+				this->get_executor(),
+				[ ctx = std::move( self ) ]() noexcept {
+					auto & conn_object = cast_to_self( *ctx );
+					try
+					{
+						conn_object.check_timeout_impl();
+					}
+					catch( const std::exception & x )
+					{
+						conn_object.trigger_error_and_close( [&] {
+								return fmt::format( "[connection: {}] unexpected "
+										"error during timeout handling: {}",
+										conn_object.connection_id(),
+										x.what() );
+							} );
+					}
+				} );
+		}
+
+		void
+		check_timeout_impl()
+		{
+			if( !m_socket.is_open() )
+				return;
+
+			const auto now = std::chrono::steady_clock::now();
+
+			if( m_write_operation_is_running )
+			{
+				if( now > m_write_started_at +
+						m_settings->m_write_http_response_timelimit )
+				{
+					handle_timeout( "writing response" );
+					return;
+				}
+			}
+			else if( m_streams.empty() &&
+				now > m_last_activity +
+						m_settings->m_read_next_http_message_timelimit )
+			{
+				handle_timeout( "wait for request" );
+				return;
+			}
+
+			for( auto it = m_streams.begin(); it != m_streams.end(); )
+			{
+				const auto stream_id = it->first;
+				const auto & stream = it->second;
+				++it;
+
+				const char * timed_out_operation = nullptr;
+				if( !stream.m_request_completed )
+				{
+					if( now > stream.m_reading_deadline )
+						timed_out_operation = "reading request timed out";
+				}
+				else if( !stream.m_final_parts_received )
+				{
+					if( now > stream.m_handling_deadline )
+						timed_out_operation = "handle request timed out";
+				}
+				else if( stream.m_sending_deadline &&
+					now > *stream.m_sending_deadline )
+					timed_out_operation = "sending response timed out";
+
+				if( nullptr != timed_out_operation )
+				{
+					m_settings->increment_metric( metrics::counter_t::timeouts );
+					stream_error(
+							stream_id, timed_out_operation, error_code_t::cancel );
+				}
+			}
+
+			for( auto it = m_detached_handlers.begin();
+				it != m_detached_handlers.end(); )
+			{
+				if( now > it->second )
+					it = m_detached_handlers.erase( it );
+				else
+					++it;
+			}
+
+			send_output();
+			init_next_timeout_checking();
+		}
+
+		void
+		handle_timeout( const char * operation_name ) noexcept
+		{
+			m_settings->increment_metric( metrics::counter_t::timeouts );
+
+			restinio::utils::log_trace_noexcept( m_logger,
+				[&]{
+					return fmt::format(
+							"[connection:{}] {} timed out",
+							connection_id(),
+							operation_name );
+				} );
+
+			close();
+		}
+
+		void
+		init_next_timeout_checking()
+		{
+			m_timer_guard.schedule( m_prepared_weak_ctx );
+		}
+
+		void
+		cancel_timeout_checking() noexcept
+		{
+			RESTINIO_ENSURE_NOEXCEPT_CALL( m_timer_guard.cancel() );
+		}
+		//! \}
+
+		//! Connection.
+		stream_socket_t m_socket;
+
+		//! Common paramaters of a connection.
+		connection_settings_handle_t< Traits > m_settings;
+
+		//! Remote endpoint for this connection.
+		const endpoint_t m_remote_endpoint;
+
+		//! Received data that isn't handled yet.
+		std::string m_input;
+
+		//! Buffer for read operations.
+		std::vector< char > m_read_buffer;
+
+		//! Flag to track whether read operation is performed now.
+		bool m_read_operation_is_running{ false };
+
+		//! Is the client connection preface received?
+		bool m_preface_received{ false };
+
+		//! Is the first SETTINGS frame received?
+		bool m_settings_received{ false };
+
+		//! Header block that is being received.
+		std::string m_header_block;
+		//! Does HEADERS frame of the current header block have END_STREAM?
+		bool m_header_block_end_stream{ false };
+		//! A stream for which CONTINUATION frame is expected (or 0).
+		std::uint32_t m_continuation_stream_id{};
+
+		hpack::decoder_t m_hpack_decoder;
+		hpack::encoder_t m_hpack_encoder;
+
+		//! Streams that are in handling.
+		streams_map_t m_streams;
+
+		//! Streams that are closed while their handlers are still running.
+		/*!
+			The value is the handling deadline of the stream.
+		*/
+		std::map< std::uint32_t, std::chrono::steady_clock::time_point >
+				m_detached_handlers;
+
+		//! The biggest id of a stream opened by the client.
+		std::uint32_t m_last_stream_id{};
+
+		//! Flow-control window of the connection for sending.
+		std::int64_t m_send_window{ default_window_size };
+
+		//! SETTINGS_INITIAL_WINDOW_SIZE of the client.
+		std::int64_t m_peer_initial_window_size{ default_window_size };
+
+		//! SETTINGS_MAX_FRAME_SIZE of the client.
+		std::size_t m_peer_max_frame_size{ default_max_frame_size };
+
+		//! Frames to be written.
+		std::string m_output;
+		//! Write groups to be notified after writing of m_output.
+		std::vector< write_group_t > m_output_notificators;
+
+		//! Frames that are being written.
+		std::string m_writing;
+		//! Write groups to be notified after writing of m_writing.
+		std::vector< write_group_t > m_writing_notificators;
+
+		//! Flag to track whether write operation is performed now.
+		bool m_write_operation_is_running{ false };
+
+		//! Is GOAWAY sent?
+		bool m_goaway_sent{ false };
+
+		//! Is GOAWAY received?
+		bool m_goaway_received{ false };
+
+		//! Should the connection be closed after writing of m_output?
+		bool m_closing{ false };
+
+		//! Time of the last read or write.
+		std::chrono::steady_clock::time_point m_last_activity;
+
+		//! Start time of the current write operation.
+		std::chrono::steady_clock::time_point m_write_started_at;
+
+		//! Timer guard.
+		timer_guard_t m_timer_guard;
+		//! A prepared weak handle for passing it to timer guard.
+		tcp_connection_ctx_weak_handle_t m_prepared_weak_ctx;
+
+		//! Request handler.
+		request_handler_t & m_request_handler;
+
+		//! Logger for operation
+		logger_t & m_logger;
+
+		//! Monitor of the connection lifetime.
+		lifetime_monitor_t m_lifetime_monitor;
+};
+
+} /* namespace http2 */
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,249 @@
+/*
+	restinio
+*/
+
+/*!
+	HTTP/2 frames (RFC 7540, sections 4 and 6).
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/string_view.hpp>
+#include <restinio/compiler_features.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http2
+{
+
+//! Size of the frame header.
+constexpr std::size_t frame_header_size = 9u;
+
+//! The default and the minimal value of SETTINGS_MAX_FRAME_SIZE.
+constexpr std::uint32_t default_max_frame_size = 16384u;
+
+//! The maximal value of SETTINGS_MAX_FRAME_SIZE.
+constexpr std::uint32_t max_allowed_frame_size = 16777215u;
+
+//! The initial value of flow-control windows.
+constexpr std::int64_t default_window_size = 65535;
+
+//! The maximal size of a flow-control window.
+constexpr std::int64_t max_window_size = 2147483647;
+
+//! Frame types.
+enum class frame_type_t : std::uint8_t
+{
+	data = 0x0,
+	headers = 0x1,
+	priority = 0x2,
+	rst_stream = 0x3,
+	settings = 0x4,
+	push_promise = 0x5,
+	ping = 0x6,
+	goaway = 0x7,
+	window_update = 0x8,
+	continuation = 0x9
+};
+
+//! Frame flags.
+//! \{
+constexpr std::uint8_t flag_end_stream = 0x1u;
+constexpr std::uint8_t flag_ack = 0x1u;
+constexpr std::uint8_t flag_end_headers = 0x4u;
+constexpr std::uint8_t flag_padded = 0x8u;
+constexpr std::uint8_t flag_priority = 0x20u;
+//! \}
+
+//! Error codes.
+enum class error_code_t : std::uint32_t
+{
+	no_error = 0x0,
+	protocol_error = 0x1,
+	internal_error = 0x2,
+	flow_control_error = 0x3,
+	settings_timeout = 0x4,
+	stream_closed = 0x5,
+	frame_size_error = 0x6,
+	refused_stream = 0x7,
+	cancel = 0x8,
+	compression_error = 0x9,
+	connect_error = 0xa,
+	enhance_your_calm = 0xb,
+	inadequate_security = 0xc,
+	http_1_1_required = 0xd
+};
+
+//! Identifiers of settings.
+enum class setting_id_t : std::uint16_t
+{
+	header_table_size = 0x1,
+	enable_push = 0x2,
+	max_concurrent_streams = 0x3,
+	initial_window_size = 0x4,
+	max_frame_size = 0x5,
+	max_header_list_size = 0x6
+};
+
+//
+// frame_header_t
+//
+
+//! The header of a frame.
+struct frame_header_t
+{
+	std::uint32_t m_length{};
+	frame_type_t m_type{ frame_type_t::data };
+	std::uint8_t m_flags{};
+	std::uint32_t m_stream_id{};
+
+	RESTINIO_NODISCARD
+	bool
+	has_flag( std::uint8_t flag ) const noexcept
+	{
+		return 0u != ( m_flags & flag );
+	}
+};
+
+//! Read a 32-bit big-endian value.
+RESTINIO_NODISCARD
+inline std::uint32_t
+read_uint32( const char * data ) noexcept
+{
+	const auto * p = reinterpret_cast< const std::uint8_t * >( data );
+	return ( std::uint32_t{ p[ 0 ] } << 24u ) |
+			( std::uint32_t{ p[ 1 ] } << 16u ) |
+			( std::uint32_t{ p[ 2 ] } << 8u ) |
+			std::uint32_t{ p[ 3 ] };
+}
+
+//! Read a 16-bit big-endian value.
+RESTINIO_NODISCARD
+inline std::uint16_t
+read_uint16( const char * data ) noexcept
+{
+	const auto * p = reinterpret_cast< const std::uint8_t * >( data );
+	return static_cast< std::uint16_t >( ( p[ 0 ] << 8u ) | p[ 1 ] );
+}
+
+//! Parse a frame header.
+/*!
+	@attention
+	@a data should contain at least frame_header_size octets.
+*/
+RESTINIO_NODISCARD
+inline frame_header_t
+parse_frame_header( const char * data ) noexcept
+{
+	const auto * p = reinterpret_cast< const std::uint8_t * >( data );
+
+	frame_header_t result;
+	result.m_length = ( std::uint32_t{ p[ 0 ] } << 16u ) |
+			( std::uint32_t{ p[ 1 ] } << 8u ) |
+			std::uint32_t{ p[ 2 ] };
+	result.m_type = static_cast< frame_type_t >( p[ 3 ] );
+	result.m_flags = p[ 4 ];
+	// The reserved bit is ignored.
+	result.m_stream_id = read_uint32( data + 5 ) & 0x7FFFFFFFu;
+
+	return result;
+}
+
+//! Append a 32-bit big-endian value.
+inline void
+append_uint32( std::string & to, std::uint32_t value )
+{
+	to.push_back( static_cast< char >( ( value >> 24u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( ( value >> 16u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( ( value >> 8u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( value & 0xFFu ) );
+}
+
+//! Append a frame header.
+inline void
+append_frame_header(
+	std::string & to,
+	std::size_t length,
+	frame_type_t type,
+	std::uint8_t flags,
+	std::uint32_t stream_id )
+{
+	to.push_back( static_cast< char >( ( length >> 16u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( ( length >> 8u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( length & 0xFFu ) );
+	to.push_back( static_cast< char >( type ) );
+	to.push_back( static_cast< char >( flags ) );
+	append_uint32( to, stream_id & 0x7FFFFFFFu );
+}
+
+//! Append a whole frame.
+inline void
+append_frame(
+	std::string & to,
+	frame_type_t type,
+	std::uint8_t flags,
+	std::uint32_t stream_id,
+	string_view_t payload )
+{
+	append_frame_header( to, payload.size(), type, flags, stream_id );
+	to.append( payload.data(), payload.size() );
+}
+
+//! Append a setting to the payload of SETTINGS frame.
+inline void
+append_setting( std::string & to, setting_id_t id, std::uint32_t value )
+{
+	const auto raw_id = static_cast< std::uint16_t >( id );
+	to.push_back( static_cast< char >( ( raw_id >> 8u ) & 0xFFu ) );
+	to.push_back( static_cast< char >( raw_id & 0xFFu ) );
+	append_uint32( to, value );
+}
+
+//! Append RST_STREAM frame.
+inline void
+append_rst_stream(
+	std::string & to,
+	std::uint32_t stream_id,
+	error_code_t error )
+{
+	append_frame_header( to, 4u, frame_type_t::rst_stream, 0u, stream_id );
+	append_uint32( to, static_cast< std::uint32_t >( error ) );
+}
+
+//! Append GOAWAY frame.
+inline void
+append_goaway(
+	std::string & to,
+	std::uint32_t last_stream_id,
+	error_code_t error )
+{
+	append_frame_header( to, 8u, frame_type_t::goaway, 0u, 0u );
+	append_uint32( to, last_stream_id & 0x7FFFFFFFu );
+	append_uint32( to, static_cast< std::uint32_t >( error ) );
+}
+
+//! Append WINDOW_UPDATE frame.
+inline void
+append_window_update(
+	std::string & to,
+	std::uint32_t stream_id,
+	std::uint32_t increment )
+{
+	append_frame_header( to, 4u, frame_type_t::window_update, 0u, stream_id );
+	append_uint32( to, increment & 0x7FFFFFFFu );
+}
+
+} /* namespace http2 */
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,758 @@
+/*
+	restinio
+*/
+
+/*!
+	HPACK: header compression for HTTP/2 (RFC 7541).
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/impl/http2/hpack_huffman.hpp>
+
+#include <restinio/string_view.hpp>
+#include <restinio/compiler_features.hpp>
+#include <restinio/incoming_http_msg_limits.hpp>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http2
+{
+
+namespace hpack
+{
+
+//! A header field (name and value).
+using header_field_t = std::pair< std::string, std::string >;
+
+//! A list of decoded header fields in the order of appearance.
+using header_list_t = std::vector< header_field_t >;
+
+//! The overhead of an entry in the dynamic table (RFC 7541, section 4.1).
+constexpr std::size_t entry_size_overhead = 32u;
+
+//! The default size of the dynamic table (RFC 7540, section 6.5.2).
+constexpr std::size_t default_dynamic_table_size = 4096u;
+
+//! Result of decoding of a header block.
+enum class decoding_result_t
+{
+	//! The block is decoded successfully.
+	success,
+	//! The block is malformed, the state of the dynamic table is unknown.
+	compression_error,
+	//! The decoded header list exceeds the limits.
+	/*!
+		The whole block is processed, so the dynamic table is consistent,
+		but the list of decoded fields is empty.
+	*/
+	limit_exceeded
+};
+
+//
+// static_table
+//
+
+//! An entry of the static table.
+struct static_entry_t
+{
+	string_view_t m_name;
+	string_view_t m_value;
+};
+
+//! Count of entries in the static table.
+constexpr std::size_t static_table_size = 61u;
+
+//! The static table from RFC 7541, Appendix A.
+/*!
+	The item with index 0 corresponds to the index 1 of the static table.
+*/
+RESTINIO_NODISCARD
+inline const std::array< static_entry_t, static_table_size > &
+static_table() noexcept
+{
+	static const std::array< static_entry_t, static_table_size > table{ {
+		{ ":authority", "" },
+		{ ":method", "GET" },
+		{ ":method", "POST" },
+		{ ":path", "/" },
+		{ ":path", "/index.html" },
+		{ ":scheme", "http" },
+		{ ":scheme", "https" },
+		{ ":status", "200" },
+		{ ":status", "204" },
+		{ ":status", "206" },
+		{ ":status", "304" },
+		{ ":status", "400" },
+		{ ":status", "404" },
+		{ ":status", "500" },
+		{ "accept-charset", "" },
+		{ "accept-encoding", "gzip, deflate" },
+		{ "accept-language", "" },
+		{ "accept-ranges", "" },
+		{ "accept", "" },
+		{ "access-control-allow-origin", "" },
+		{ "age", "" },
+		{ "allow", "" },
+		{ "authorization", "" },
+		{ "cache-control", "" },
+		{ "content-disposition", "" },
+		{ "content-encoding", "" },
+		{ "content-language", "" },
+		{ "content-length", "" },
+		{ "content-location", "" },
+		{ "content-range", "" },
+		{ "content-type", "" },
+		{ "cookie", "" },
+		{ "date", "" },
+		{ "etag", "" },
+		{ "expect", "" },
+		{ "expires", "" },
+		{ "from", "" },
+		{ "host", "" },
+		{ "if-match", "" },
+		{ "if-modified-since", "" },
+		{ "if-none-match", "" },
+		{ "if-range", "" },
+		{ "if-unmodified-since", "" },
+		{ "last-modified", "" },
+		{ "link", "" },
+		{ "location", "" },
+		{ "max-forwards", "" },
+		{ "proxy-authenticate", "" },
+		{ "proxy-authorization", "" },
+		{ "range", "" },
+		{ "referer", "" },
+		{ "refresh", "" },
+		{ "retry-after", "" },
+		{ "server", "" },
+		{ "set-cookie", "" },
+		{ "strict-transport-security", "" },
+		{ "transfer-encoding", "" },
+		{ "user-agent", "" },
+		{ "vary", "" },
+		{ "via", "" },
+		{ "www-authenticate", "" }
+	} };
+
+	return table;
+}
+
+//
+// huffman_decoding_tree_t
+//
+
+//! A binary tree for decoding of Huffman-encoded strings.
+class huffman_decoding_tree_t
+{
+public:
+	//! A value of node's child that means "no child".
+	static constexpr std::int16_t no_child = -1;
+
+	//! A node of the tree.
+	struct node_t
+	{
+		//! Children for bits 0 and 1.
+		std::array< std::int16_t, 2 > m_children{ { no_child, no_child } };
+		//! Symbol for a leaf, huffman_symbols_count for an inner node.
+		std::uint16_t m_symbol{ huffman_symbols_count };
+	};
+
+	huffman_decoding_tree_t()
+	{
+		m_nodes.emplace_back();
+
+		const auto & codes = huffman_codes();
+		for( std::size_t symbol = 0u; symbol != codes.size(); ++symbol )
+		{
+			std::size_t current = 0u;
+			for( auto bit = codes[ symbol ].m_bits; bit != 0u; --bit )
+			{
+				const auto direction = ( codes[ symbol ].m_code >> ( bit - 1u ) ) & 1u;
+				auto & child = m_nodes[ current ].m_children[ direction ];
+				if( no_child == child )
+				{
+					child = static_cast< std::int16_t >( m_nodes.size() );
+					m_nodes.emplace_back();
+				}
+				current = static_cast< std::size_t >(
+						m_nodes[ current ].m_children[ direction ] );
+			}
+
+			m_nodes[ current ].m_symbol = static_cast< std::uint16_t >( symbol );
+		}
+	}
+
+	RESTINIO_NODISCARD
+	const node_t &
+	node( std::size_t index ) const noexcept { return m_nodes[ index ]; }
+
+	//! Get the tree (it's created at the first call).
+	RESTINIO_NODISCARD
+	static const huffman_decoding_tree_t &
+	instance()
+	{
+		static const huffman_decoding_tree_t tree;
+		return tree;
+	}
+
+private:
+	std::vector< node_t > m_nodes;
+};
+
+//! Decode a Huffman-encoded string.
+/*!
+	@return false if the encoded string is invalid.
+*/
+RESTINIO_NODISCARD
+inline bool
+huffman_decode( string_view_t encoded, std::string & to )
+{
+	const auto & tree = huffman_decoding_tree_t::instance();
+
+	std::size_t current = 0u;
+	// Count of bits since the last decoded symbol.
+	std::size_t pending_bits = 0u;
+	// Are all the bits since the last decoded symbol equal to 1?
+	bool pending_ones = true;
+
+	for( const auto ch : encoded )
+	{
+		const auto octet = static_cast< std::uint8_t >( ch );
+		for( int bit = 7; bit >= 0; --bit )
+		{
+			const auto direction = ( octet >> bit ) & 1u;
+			const auto next = tree.node( current ).m_children[ direction ];
+			if( huffman_decoding_tree_t::no_child == next )
+				return false;
+
+			++pending_bits;
+			pending_ones = pending_ones && 0u != direction;
+
+			current = static_cast< std::size_t >( next );
+			const auto symbol = tree.node( current ).m_symbol;
+			if( huffman_symbols_count != symbol )
+			{
+				if( huffman_eos_symbol == symbol )
+					return false;
+
+				to.push_back( static_cast< char >( symbol ) );
+				current = 0u;
+				pending_bits = 0u;
+				pending_ones = true;
+			}
+		}
+	}
+
+	// Padding should be shorter than 8 bits and should be
+	// the most significant bits of EOS (RFC 7541, section 5.2).
+	return pending_bits < 8u && pending_ones;
+}
+
+//
+// Primitive type representations (RFC 7541, section 5).
+//
+
+//! Append an integer with the prefix of the given size.
+/*!
+	@param first_octet_flags The bits of the first octet that
+	are not a part of the prefix.
+*/
+inline void
+encode_integer(
+	std::string & to,
+	std::uint8_t first_octet_flags,
+	unsigned prefix_bits,
+	std::uint64_t value )
+{
+	const std::uint64_t max_prefix = ( 1u << prefix_bits ) - 1u;
+	if( value < max_prefix )
+	{
+		to.push_back( static_cast< char >( first_octet_flags | value ) );
+		return;
+	}
+
+	to.push_back( static_cast< char >( first_octet_flags | max_prefix ) );
+	value -= max_prefix;
+	while( value >= 0x80u )
+	{
+		to.push_back( static_cast< char >( 0x80u | ( value & 0x7Fu ) ) );
+		value >>= 7u;
+	}
+	to.push_back( static_cast< char >( value ) );
+}
+
+//! Append a string literal without Huffman encoding.
+inline void
+encode_string( std::string & to, string_view_t value )
+{
+	encode_integer( to, 0u, 7u, value.size() );
+	to.append( value.data(), value.size() );
+}
+
+//
+// input_t
+//
+
+//! A reader of a header block.
+class input_t
+{
+public:
+	explicit input_t( string_view_t data ) noexcept
+		:	m_data{ data }
+	{}
+
+	RESTINIO_NODISCARD
+	bool
+	empty() const noexcept { return m_pos == m_data.size(); }
+
+	//! Get the current octet without extracting it.
+	RESTINIO_NODISCARD
+	std::uint8_t
+	current() const noexcept
+	{
+		return static_cast< std::uint8_t >( m_data[ m_pos ] );
+	}
+
+	//! Decode an integer with the prefix of the given size.
+	/*!
+		@return false if the representation is invalid or the value
+		doesn't fit into 32 bits.
+	*/
+	RESTINIO_NODISCARD
+	bool
+	decode_integer( unsigned prefix_bits, std::uint32_t & value ) noexcept
+	{
+		if( empty() )
+			return false;
+
+		const std::uint32_t max_prefix = ( 1u << prefix_bits ) - 1u;
+		std::uint64_t result = current() & max_prefix;
+		++m_pos;
+
+		if( result == max_prefix )
+		{
+			unsigned shift = 0u;
+			std::uint8_t octet;
+			do
+			{
+				if( empty() || shift > 28u )
+					return false;
+
+				octet = current();
+				++m_pos;
+
+				result += static_cast< std::uint64_t >( octet & 0x7Fu ) << shift;
+				shift += 7u;
+			}
+			while( 0u != ( octet & 0x80u ) );
+
+			if( result > 0xFFFFFFFFu )
+				return false;
+		}
+
+		value = static_cast< std::uint32_t >( result );
+		return true;
+	}
+
+	//! Decode a string literal.
+	RESTINIO_NODISCARD
+	bool
+	decode_string( std::string & value )
+	{
+		if( empty() )
+			return false;
+
+		const bool huffman = 0u != ( current() & 0x80u );
+		std::uint32_t length;
+		if( !decode_integer( 7u, length ) || m_data.size() - m_pos < length )
+			return false;
+
+		const auto encoded = m_data.substr( m_pos, length );
+		m_pos += length;
+
+		value.clear();
+		if( huffman )
+			return huffman_decode( encoded, value );
+
+		value.assign( encoded.data(), encoded.size() );
+		return true;
+	}
+
+private:
+	string_view_t m_data;
+	std::size_t m_pos{};
+};
+
+//
+// decoder_t
+//
+
+//! HPACK decoder with its own dynamic table.
+/*!
+	There should be one decoder per HTTP/2 connection.
+*/
+class decoder_t
+{
+public:
+	//! Decode a complete header block.
+	/*!
+		Decoding stops storing fields as soon as @a limits or
+		@a max_header_list_size are exceeded (the size of the list is
+		calculated as in SETTINGS_MAX_HEADER_LIST_SIZE). The rest of
+		the block is still processed to keep the dynamic table consistent.
+
+		@return decoding_result_t::compression_error in the case of
+		a compression error. The connection should be closed in that
+		case because the state of the dynamic table is unknown.
+	*/
+	RESTINIO_NODISCARD
+	decoding_result_t
+	decode(
+		string_view_t block,
+		const incoming_http_msg_limits_t & limits,
+		std::size_t max_header_list_size,
+		header_list_t & headers )
+	{
+		input_t input{ block };
+		list_builder_t builder{ limits, max_header_list_size, headers };
+		bool size_update_allowed = true;
+
+		while( !input.empty() )
+		{
+			const auto octet = input.current();
+			std::uint32_t index;
+
+			if( 0u != ( octet & 0x80u ) )
+			{
+				// Indexed header field.
+				if( !input.decode_integer( 7u, index ) ||
+					!append_entry( index, builder ) )
+					return decoding_result_t::compression_error;
+			}
+			else if( 0x40u == ( octet & 0xC0u ) )
+			{
+				// Literal header field with incremental indexing.
+				header_field_t field;
+				if( !input.decode_integer( 6u, index ) ||
+					!decode_literal( input, index, field ) )
+					return decoding_result_t::compression_error;
+
+				add_entry( field );
+				builder.append( std::move( field ) );
+			}
+			else if( 0x20u == ( octet & 0xE0u ) )
+			{
+				// Dynamic table size update.
+				std::uint32_t new_size;
+				if( !size_update_allowed ||
+					!input.decode_integer( 5u, new_size ) ||
+					new_size > m_max_size_limit )
+					return decoding_result_t::compression_error;
+
+				m_max_size = new_size;
+				evict( 0u );
+				continue;
+			}
+			else
+			{
+				// Literal header field without indexing or never indexed.
+				header_field_t field;
+				if( !input.decode_integer( 4u, index ) ||
+					!decode_literal( input, index, field ) )
+					return decoding_result_t::compression_error;
+
+				builder.append( std::move( field ) );
+			}
+
+			size_update_allowed = false;
+		}
+
+		return builder.exceeded() ?
+				decoding_result_t::limit_exceeded : decoding_result_t::success;
+	}
+
+	//! Get the current size of the dynamic table.
+	RESTINIO_NODISCARD
+	std::size_t
+	dynamic_table_size() const noexcept { return m_size; }
+
+private:
+	//! Dynamic table, the newest entry is the first one.
+	std::deque< header_field_t > m_dynamic_table;
+
+	//! The current size of the dynamic table.
+	std::size_t m_size{};
+
+	//! The current maximum size set by the encoder.
+	std::size_t m_max_size{ default_dynamic_table_size };
+
+	//! The maximum size announced in SETTINGS_HEADER_TABLE_SIZE.
+	const std::size_t m_max_size_limit{ default_dynamic_table_size };
+
+	RESTINIO_NODISCARD
+	static std::size_t
+	entry_size( const header_field_t & entry ) noexcept
+	{
+		return entry.first.size() + entry.second.size() + entry_size_overhead;
+	}
+
+	//! Helper for filling the list of decoded fields within the limits.
+	class list_builder_t
+	{
+	public:
+		list_builder_t(
+			const incoming_http_msg_limits_t & limits,
+			std::size_t max_header_list_size,
+			header_list_t & headers ) noexcept
+			:	m_limits{ limits }
+			,	m_max_header_list_size{ max_header_list_size }
+			,	m_headers{ headers }
+		{}
+
+		//! Check the limits for a field with the specified sizes.
+		/*!
+			@return false if the field shouldn't be stored.
+		*/
+		RESTINIO_NODISCARD
+		bool
+		accept( std::size_t name_size, std::size_t value_size )
+		{
+			if( m_exceeded )
+				return false;
+
+			const auto size = name_size + value_size + entry_size_overhead;
+			if( name_size > m_limits.max_field_name_size() ||
+				value_size > m_limits.max_field_value_size() ||
+				m_headers.size() >= m_limits.max_field_count() ||
+				m_max_header_list_size - m_list_size < size )
+			{
+				// Decoded fields aren't necessary anymore.
+				m_exceeded = true;
+				header_list_t{}.swap( m_headers );
+				return false;
+			}
+
+			m_list_size += size;
+			return true;
+		}
+
+		void
+		append( header_field_t field )
+		{
+			if( accept( field.first.size(), field.second.size() ) )
+				m_headers.push_back( std::move( field ) );
+		}
+
+		void
+		append( string_view_t name, string_view_t value )
+		{
+			if( accept( name.size(), value.size() ) )
+				m_headers.emplace_back(
+						std::string{ name.data(), name.size() },
+						std::string{ value.data(), value.size() } );
+		}
+
+		RESTINIO_NODISCARD
+		bool
+		exceeded() const noexcept { return m_exceeded; }
+
+	private:
+		const incoming_http_msg_limits_t & m_limits;
+		const std::size_t m_max_header_list_size;
+		header_list_t & m_headers;
+
+		//! The size of the stored fields.
+		std::size_t m_list_size{};
+		bool m_exceeded{ false };
+	};
+
+	//! Find an entry with the given index in the static or dynamic table.
+	/*!
+		@return false if there is no such entry.
+	*/
+	RESTINIO_NODISCARD
+	bool
+	find_entry(
+		std::uint32_t index,
+		string_view_t & name,
+		string_view_t & value ) const noexcept
+	{
+		if( 0u == index )
+			return false;
+
+		if( index <= static_table_size )
+		{
+			const auto & entry = static_table()[ index - 1u ];
+			name = entry.m_name;
+			value = entry.m_value;
+			return true;
+		}
+
+		const std::size_t dynamic_index = index - static_table_size - 1u;
+		if( dynamic_index >= m_dynamic_table.size() )
+			return false;
+
+		const auto & entry = m_dynamic_table[ dynamic_index ];
+		name = entry.first;
+		value = entry.second;
+		return true;
+	}
+
+	//! Append an entry with the given index to the decoded fields.
+	RESTINIO_NODISCARD
+	bool
+	append_entry( std::uint32_t index, list_builder_t & builder )
+	{
+		string_view_t name;
+		string_view_t value;
+		if( !find_entry( index, name, value ) )
+			return false;
+
+		builder.append( name, value );
+		return true;
+	}
+
+	//! Decode a literal header field with indexed or literal name.
+	RESTINIO_NODISCARD
+	bool
+	decode_literal(
+		input_t & input,
+		std::uint32_t name_index,
+		header_field_t & field )
+	{
+		if( 0u != name_index )
+		{
+			string_view_t name;
+			string_view_t value;
+			if( !find_entry( name_index, name, value ) )
+				return false;
+
+			field.first.assign( name.data(), name.size() );
+		}
+		else if( !input.decode_string( field.first ) )
+			return false;
+
+		return input.decode_string( field.second );
+	}
+
+	//! Evict entries until there is a room for @a required_size octets.
+	void
+	evict( std::size_t required_size ) noexcept
+	{
+		while( !m_dynamic_table.empty() && m_size + required_size > m_max_size )
+		{
+			m_size -= entry_size( m_dynamic_table.back() );
+			m_dynamic_table.pop_back();
+		}
+	}
+
+	void
+	add_entry( const header_field_t & entry )
+	{
+		const auto size = entry_size( entry );
+		evict( size );
+
+		// An entry larger than the table empties the table
+		// (RFC 7541, section 4.4).
+		if( size <= m_max_size )
+		{
+			m_dynamic_table.push_front( entry );
+			m_size += size;
+		}
+	}
+};
+
+//
+// encoder_t
+//
+
+//! HPACK encoder that doesn't use the dynamic table.
+/*!
+	All header fields are encoded as literals without indexing (with
+	an indexed name if the name is in the static table) and without
+	Huffman encoding. The first header block starts with the dynamic
+	table size update to zero, so the encoder is independent of
+	SETTINGS_HEADER_TABLE_SIZE of the peer.
+*/
+class encoder_t
+{
+public:
+	//! Start a new header block.
+	void
+	start_block( std::string & to )
+	{
+		if( m_first_block )
+		{
+			// Dynamic table size update to 0.
+			encode_integer( to, 0x20u, 5u, 0u );
+			m_first_block = false;
+		}
+	}
+
+	//! Append `:status` pseudo-header.
+	void
+	encode_status( std::string & to, std::uint16_t status )
+	{
+		const auto & table = static_table();
+		const auto status_str = std::to_string( status );
+
+		// Entries 8-14 are `:status` with the most popular values.
+		for( std::size_t i = 7u; i != 14u; ++i )
+			if( table[ i ].m_value == status_str )
+			{
+				encode_integer( to, 0x80u, 7u, i + 1u );
+				return;
+			}
+
+		encode_integer( to, 0u, 4u, 8u );
+		encode_string( to, status_str );
+	}
+
+	//! Append a header field.
+	/*!
+		@attention
+		The name should be in lower case.
+	*/
+	void
+	encode_field( std::string & to, string_view_t name, string_view_t value )
+	{
+		const auto & table = static_table();
+		std::size_t name_index = 0u;
+		for( std::size_t i = 0u; i != table.size(); ++i )
+			if( table[ i ].m_name == name )
+			{
+				name_index = i + 1u;
+				break;
+			}
+
+		encode_integer( to, 0u, 4u, name_index );
+		if( 0u == name_index )
+			encode_string( to, name );
+		encode_string( to, value );
+	}
+
+private:
+	bool m_first_block{ true };
+};
+
+} /* namespace hpack */
+
+} /* namespace http2 */
+
+} /* namespace impl */
+
+} /* namespace restinio */
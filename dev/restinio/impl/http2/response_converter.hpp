@@ -0,0 +1,342 @@
+/*
+	restinio
+*/
+
+/*!
+	Conversion of HTTP/1.1 responses to HTTP/2.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/impl/to_lower_lut.hpp>
+
+#include <restinio/string_view.hpp>
+#include <restinio/compiler_features.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http2
+{
+
+//
+// response_converter_t
+//
+
+//! A converter of HTTP/1.1 response serialization to HTTP/2 entities.
+/*!
+	Response builders serialize a response as HTTP/1.1 message: a status
+	line, header fields and a body (maybe with chunked transfer coding).
+	The converter extracts the status code and header fields from that
+	serialization and removes the chunked transfer coding from the body.
+
+	Header field names are converted to lower case. Connection-specific
+	header fields are removed (RFC 7540, section 8.1.2.2).
+
+	Trailer fields of chunked body are ignored.
+*/
+class response_converter_t
+{
+public:
+	//! A header field of the response.
+	using field_t = std::pair< std::string, std::string >;
+
+	//! Feed the next portion of the serialized response.
+	/*!
+		The body octets are appended to @a body.
+
+		@return false if the serialization is malformed.
+	*/
+	RESTINIO_NODISCARD
+	bool
+	feed( string_view_t data, std::string & body )
+	{
+		while( !data.empty() )
+		{
+			switch( m_state )
+			{
+				case state_t::header:
+					if( !consume_header( data ) )
+						return false;
+				break;
+
+				case state_t::body:
+					body.append( data.data(), data.size() );
+					data = string_view_t{};
+				break;
+
+				case state_t::chunk_size:
+					if( !consume_chunk_size( data ) )
+						return false;
+				break;
+
+				case state_t::chunk_data:
+					consume_chunk_data( data, body );
+				break;
+
+				case state_t::chunk_data_end:
+				case state_t::trailer:
+				case state_t::completed:
+					if( !consume_line( data ) )
+						return false;
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	//! Is the header completely received?
+	RESTINIO_NODISCARD
+	bool
+	header_completed() const noexcept
+	{
+		return state_t::header != m_state;
+	}
+
+	//! Get the status code.
+	/*!
+		@attention
+		It has sense only if header_completed() returns true.
+	*/
+	RESTINIO_NODISCARD
+	std::uint16_t
+	status() const noexcept { return m_status; }
+
+	//! Get the header fields.
+	/*!
+		@attention
+		It has sense only if header_completed() returns true.
+	*/
+	RESTINIO_NODISCARD
+	const std::vector< field_t > &
+	fields() const noexcept { return m_fields; }
+
+private:
+	enum class state_t
+	{
+		//! Status line and header fields.
+		header,
+		//! The body without transfer coding.
+		body,
+		//! A line with the size of the next chunk.
+		chunk_size,
+		//! Data of a chunk.
+		chunk_data,
+		//! CRLF after data of a chunk.
+		chunk_data_end,
+		//! Trailer fields after the last chunk.
+		trailer,
+		//! The whole chunked body is received.
+		completed
+	};
+
+	state_t m_state{ state_t::header };
+
+	//! A part of the current line (or the header) that isn't processed yet.
+	std::string m_line;
+
+	std::uint16_t m_status{};
+	std::vector< field_t > m_fields;
+
+	//! Remaining size of the current chunk.
+	std::uint64_t m_chunk_remaining{};
+
+	//! Extract octets till the end of a line (or the header) to m_line.
+	/*!
+		@return true if the whole line is extracted.
+	*/
+	bool
+	extract_till( string_view_t & data, string_view_t terminator )
+	{
+		// The terminator can be split between portions of data.
+		const auto old_size = m_line.size();
+		const auto search_from = old_size >= terminator.size() ?
+				old_size - terminator.size() + 1u : 0u;
+
+		m_line.append( data.data(), data.size() );
+		const auto pos = m_line.find(
+				terminator.data(), search_from, terminator.size() );
+		if( std::string::npos == pos )
+		{
+			data = string_view_t{};
+			return false;
+		}
+
+		data.remove_prefix( pos + terminator.size() - old_size );
+		m_line.resize( pos );
+		return true;
+	}
+
+	RESTINIO_NODISCARD
+	static string_view_t
+	trim( string_view_t v ) noexcept
+	{
+		while( !v.empty() && ( ' ' == v.front() || '\t' == v.front() ) )
+			v.remove_prefix( 1u );
+		while( !v.empty() && ( ' ' == v.back() || '\t' == v.back() ) )
+			v.remove_suffix( 1u );
+		return v;
+	}
+
+	RESTINIO_NODISCARD
+	static bool
+	is_connection_specific( string_view_t name ) noexcept
+	{
+		return "connection" == name ||
+				"keep-alive" == name ||
+				"proxy-connection" == name ||
+				"transfer-encoding" == name ||
+				"upgrade" == name;
+	}
+
+	RESTINIO_NODISCARD
+	bool
+	consume_header( string_view_t & data )
+	{
+		if( !extract_till( data, string_view_t{ "\r\n\r\n" } ) )
+			return true;
+
+		string_view_t header{ m_line };
+		bool chunked = false;
+
+		// Status line: "HTTP/1.1 200 OK".
+		auto line_end = header.find( "\r\n" );
+		const auto status_line = header.substr( 0u, line_end );
+		const auto space_pos = status_line.find( ' ' );
+		if( string_view_t::npos == space_pos ||
+			status_line.size() < space_pos + 4u )
+			return false;
+
+		for( const auto ch : status_line.substr( space_pos + 1u, 3u ) )
+		{
+			if( ch < '0' || ch > '9' )
+				return false;
+			m_status = static_cast< std::uint16_t >( m_status * 10u + ( ch - '0' ) );
+		}
+
+		while( string_view_t::npos != line_end )
+		{
+			header.remove_prefix( line_end + 2u );
+			line_end = header.find( "\r\n" );
+			const auto line = header.substr( 0u, line_end );
+
+			const auto colon_pos = line.find( ':' );
+			if( string_view_t::npos == colon_pos )
+				return false;
+
+			std::string name;
+			name.reserve( colon_pos );
+			for( const auto ch : line.substr( 0u, colon_pos ) )
+				name.push_back( to_lower_case( ch ) );
+
+			const auto value = trim( line.substr( colon_pos + 1u ) );
+
+			if( "transfer-encoding" == name &&
+				string_view_t::npos != value.find( "chunked" ) )
+				chunked = true;
+
+			if( !is_connection_specific( name ) )
+				m_fields.emplace_back(
+						std::move( name ),
+						std::string{ value.data(), value.size() } );
+		}
+
+		m_line.clear();
+		m_state = chunked ? state_t::chunk_size : state_t::body;
+
+		return true;
+	}
+
+	RESTINIO_NODISCARD
+	bool
+	consume_chunk_size( string_view_t & data )
+	{
+		if( !extract_till( data, string_view_t{ "\r\n" } ) )
+			return true;
+
+		// Chunk extensions are ignored.
+		const auto size_str = trim(
+				string_view_t{ m_line }.substr( 0u, m_line.find( ';' ) ) );
+		if( size_str.empty() || size_str.size() > 15u )
+			return false;
+
+		m_chunk_remaining = 0u;
+		for( const auto ch : size_str )
+		{
+			const auto lower = to_lower_case( ch );
+			unsigned digit;
+			if( lower >= '0' && lower <= '9' )
+				digit = static_cast< unsigned >( lower - '0' );
+			else if( lower >= 'a' && lower <= 'f' )
+				digit = static_cast< unsigned >( lower - 'a' + 10 );
+			else
+				return false;
+
+			m_chunk_remaining = m_chunk_remaining * 16u + digit;
+		}
+
+		m_line.clear();
+		m_state = 0u == m_chunk_remaining ? state_t::trailer : state_t::chunk_data;
+
+		return true;
+	}
+
+	void
+	consume_chunk_data( string_view_t & data, std::string & body )
+	{
+		const auto size = static_cast< std::size_t >(
+				(std::min)( m_chunk_remaining, std::uint64_t{ data.size() } ) );
+
+		body.append( data.data(), size );
+		data.remove_prefix( size );
+		m_chunk_remaining -= size;
+
+		if( 0u == m_chunk_remaining )
+			m_state = state_t::chunk_data_end;
+	}
+
+	RESTINIO_NODISCARD
+	bool
+	consume_line( string_view_t & data )
+	{
+		if( state_t::completed == m_state )
+			// Nothing is expected after the chunked body.
+			return false;
+
+		if( !extract_till( data, string_view_t{ "\r\n" } ) )
+			return true;
+
+		const bool empty_line = m_line.empty();
+		m_line.clear();
+
+		if( state_t::chunk_data_end == m_state )
+		{
+			if( !empty_line )
+				return false;
+
+			m_state = state_t::chunk_size;
+		}
+		else if( empty_line )
+			m_state = state_t::completed;
+
+		return true;
+	}
+};
+
+} /* namespace http2 */
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,197 @@
+/*
+	restinio
+*/
+
+/*!
+	Helpers for handling of HTTP/2 clients by HTTP/1.1 connection.
+
+	HTTP/2 is supported only if it's turned on by `use_http2` flag in
+	server's traits (see http2::connection_t). But HTTP/2 clients should
+	receive a correct answer from a RESTinio server in any case:
+
+	- a client with prior knowledge of HTTP/2 support (h2c) sends
+	  the HTTP/2 connection preface at the very beginning of a connection.
+	  If HTTP/2 is turned off then such a client receives GOAWAY frame
+	  with HTTP_1_1_REQUIRED error code (see RFC 7540, section 9.2.1)
+	  and the connection is closed. Otherwise the connection is switched
+	  to HTTP/2;
+	- a client that asks for an upgrade to h2c (with `Upgrade: h2c`
+	  header field) receives an ordinary HTTP/1.1 response and the
+	  connection isn't switched to the upgrade mode (see RFC 7540,
+	  section 3.2).
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/impl/string_caseless_compare.hpp>
+
+#include <restinio/string_view.hpp>
+#include <restinio/compiler_features.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http2_fallback
+{
+
+//! The connection preface of HTTP/2 client.
+/*!
+	See RFC 7540, section 3.5.
+*/
+RESTINIO_NODISCARD
+inline string_view_t
+client_preface() noexcept
+{
+	return { "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", 24u };
+}
+
+//! The answer for a client with prior knowledge of HTTP/2.
+/*!
+	The server connection preface (an empty SETTINGS frame) followed
+	by GOAWAY frame with last-stream-id 0 and error code
+	HTTP_1_1_REQUIRED (0xd).
+*/
+RESTINIO_NODISCARD
+inline string_view_t
+http_1_1_required_answer() noexcept
+{
+	return {
+		// SETTINGS: length 0, type 0x4, no flags, stream 0.
+		"\x00\x00\x00\x04\x00\x00\x00\x00\x00"
+		// GOAWAY: length 8, type 0x7, no flags, stream 0.
+		"\x00\x00\x08\x07\x00\x00\x00\x00\x00"
+		// Last-Stream-ID: 0.
+		"\x00\x00\x00\x00"
+		// Error Code: HTTP_1_1_REQUIRED.
+		"\x00\x00\x00\x0d",
+		26u
+	};
+}
+
+//
+// preface_detector_t
+//
+//! Detector of HTTP/2 client preface at the beginning of a connection.
+/*!
+	The preface can be split between several read operations, so
+	the detector remembers how many bytes of the preface are already
+	matched.
+*/
+class preface_detector_t
+{
+public:
+	//! Result of a check.
+	enum class result_t
+	{
+		//! The data is the beginning of the preface, more data is needed.
+		need_more_data,
+		//! The whole preface is found.
+		preface_found,
+		//! The data isn't the preface.
+		not_preface
+	};
+
+	//! Is the check completed?
+	/*!
+		The check is completed after the first result different
+		from result_t::need_more_data.
+	*/
+	RESTINIO_NODISCARD
+	bool
+	completed() const noexcept { return m_completed; }
+
+	//! Check the next portion of incoming data.
+	RESTINIO_NODISCARD
+	result_t
+	check( const char * data, std::size_t length ) noexcept
+	{
+		const auto preface = client_preface();
+		const auto to_compare = (std::min)(
+				length, preface.size() - m_matched );
+
+		if( 0 != std::memcmp( data, preface.data() + m_matched, to_compare ) )
+		{
+			m_completed = true;
+			return result_t::not_preface;
+		}
+
+		m_matched += to_compare;
+		if( preface.size() == m_matched )
+		{
+			m_completed = true;
+			return result_t::preface_found;
+		}
+
+		return result_t::need_more_data;
+	}
+
+	//! The beginning of the preface that was matched by previous
+	//! calls to check().
+	/*!
+		This data was received from a client but wasn't passed
+		to HTTP-parser yet.
+	*/
+	RESTINIO_NODISCARD
+	string_view_t
+	matched_part() const noexcept
+	{
+		return client_preface().substr( 0u, m_matched );
+	}
+
+private:
+	std::size_t m_matched{};
+	bool m_completed{ false };
+};
+
+//
+// is_h2c_upgrade
+//
+//! Is a value of Upgrade header field a request for h2c only?
+/*!
+	The value is a comma-separated list of protocols. The function
+	returns true if all items of that list are `h2c`.
+*/
+RESTINIO_NODISCARD
+inline bool
+is_h2c_upgrade( string_view_t upgrade_field_value ) noexcept
+{
+	const auto is_ows = []( char ch ) { return ' ' == ch || '\t' == ch; };
+
+	bool h2c_found = false;
+	while( !upgrade_field_value.empty() )
+	{
+		const auto comma_pos = upgrade_field_value.find( ',' );
+		auto item = upgrade_field_value.substr( 0u, comma_pos );
+		upgrade_field_value = string_view_t::npos == comma_pos ?
+				string_view_t{} : upgrade_field_value.substr( comma_pos + 1u );
+
+		while( !item.empty() && is_ows( item.front() ) )
+			item.remove_prefix( 1u );
+		while( !item.empty() && is_ows( item.back() ) )
+			item.remove_suffix( 1u );
+
+		if( item.empty() )
+			continue;
+
+		if( !is_equal_caseless( item, string_view_t{ "h2c" } ) )
+			return false;
+
+		h2c_found = true;
+	}
+
+	return h2c_found;
+}
+
+} /* namespace http2_fallback */
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,132 @@
+/*
+	restinio
+*/
+
+/*!
+	Parsing result context for HTTP-parser backends.
+*/
+
+#pragma once
+
+#include <restinio/http_headers.hpp>
+#include <restinio/incoming_http_msg_limits.hpp>
+#include <restinio/chunked_input_info.hpp>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// http_parser_ctx_t
+//
+
+//! Parsing result context for using in parser callbacks.
+/*!
+	All data is used as temps, and is usable only
+	after parsing completes new requests then it is moved out.
+*/
+struct http_parser_ctx_t
+{
+	//! Request data.
+	//! \{
+	http_request_header_t m_header;
+	std::string m_body;
+	//! \}
+
+	//! Parser context temp values and flags.
+	//! \{
+	std::string m_current_field_name;
+	std::size_t m_last_value_total_size{ 0u };
+	bool m_last_was_value{ true };
+
+	/*!
+	 * @since v.0.6.9
+	 */
+	bool m_leading_headers_completed{ false };
+
+	/*!
+	 * @since v.0.6.9
+	 */
+	chunked_input_info_block_t m_chunked_info_block;
+	//! \}
+
+	//! Flag: is http message parsed completely.
+	bool m_message_complete{ false };
+
+	/*!
+	 * @brief Flag: is the beginning of http message parsed, but
+	 * the message isn't complete yet.
+	 *
+	 * @since v.0.6.14
+	 */
+	bool m_message_started{ false };
+
+	/*!
+	 * @brief Total number of parsed HTTP-fields.
+	 *
+	 * This number includes the number of leading HTTP-fields and the number
+	 * of trailing HTTP-fields (in the case of chunked encoding).
+	 *
+	 * @since v.0.6.12
+	 */
+	std::size_t m_total_field_count{ 0u };
+
+	/*!
+	 * @brief Limits for the incoming message.
+	 *
+	 * @since v.0.6.12
+	 */
+	const incoming_http_msg_limits_t m_limits;
+
+	/*!
+	 * @brief The main constructor.
+	 *
+	 * @since v.0.6.12
+	 */
+	http_parser_ctx_t(
+		incoming_http_msg_limits_t limits )
+		:	m_limits{ limits }
+	{}
+
+	//! Prepare context to handle new request.
+	void
+	reset()
+	{
+		m_header = http_request_header_t{};
+		m_body.clear();
+		m_current_field_name.clear();
+		m_last_value_total_size = 0u;
+		m_last_was_value = true;
+		m_leading_headers_completed = false;
+		m_message_complete = false;
+		m_message_started = false;
+		m_total_field_count = 0u;
+	}
+
+	//! Creates an instance of chunked_input_info if there is an info
+	//! about chunks in the body.
+	/*!
+	 * @since v.0.6.9
+	 */
+	RESTINIO_NODISCARD
+	chunked_input_info_unique_ptr_t
+	make_chunked_input_info_if_necessary()
+	{
+		chunked_input_info_unique_ptr_t result;
+
+		if( !m_chunked_info_block.m_chunks.empty() ||
+				0u != m_chunked_info_block.m_trailing_fields.fields_count() )
+		{
+			result = std::make_unique< chunked_input_info_t >(
+					std::move( m_chunked_info_block ) );
+		}
+
+		return result;
+	}
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,301 @@
+/*
+	restinio
+*/
+
+/*!
+	Helpers for fast scanning of HTTP header blocks.
+
+	Depending on the target instruction set AVX2 or SSE4.2 is used
+	to process 32 or 16 bytes at a time. If none of them is available
+	(or RESTINIO_HTTP_PARSER_NO_SIMD is defined) scalar code is used.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <cstdint>
+
+#if !defined(RESTINIO_HTTP_PARSER_NO_SIMD)
+	#if defined(__AVX2__)
+		#include <immintrin.h>
+		#define RESTINIO_HTTP_PARSER_SIMD_AVX2
+	#elif defined(__SSE4_2__)
+		#include <nmmintrin.h>
+		#define RESTINIO_HTTP_PARSER_SIMD_SSE42
+	#endif
+#endif
+
+#if defined(_MSC_VER) && \
+	(defined(RESTINIO_HTTP_PARSER_SIMD_AVX2) || \
+		defined(RESTINIO_HTTP_PARSER_SIMD_SSE42))
+	#include <intrin.h>
+#endif
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace http_parser_simd
+{
+
+//! The name of instruction set used for scanning.
+RESTINIO_NODISCARD
+inline const char *
+instruction_set_name() noexcept
+{
+#if defined(RESTINIO_HTTP_PARSER_SIMD_AVX2)
+	return "avx2";
+#elif defined(RESTINIO_HTTP_PARSER_SIMD_SSE42)
+	return "sse4.2";
+#else
+	return "scalar";
+#endif
+}
+
+//! Is a byte a control character that can't appear in a field value.
+/*!
+	HTAB is allowed in field values.
+*/
+RESTINIO_NODISCARD
+constexpr bool
+is_forbidden_value_char( char ch ) noexcept
+{
+	return ( static_cast< unsigned char >( ch ) < 0x20u && '\t' != ch ) ||
+			'\x7F' == ch;
+}
+
+//! Is a byte a control character or space.
+RESTINIO_NODISCARD
+constexpr bool
+is_forbidden_target_char( char ch ) noexcept
+{
+	return static_cast< unsigned char >( ch ) <= 0x20u || '\x7F' == ch;
+}
+
+#if defined(RESTINIO_HTTP_PARSER_SIMD_AVX2) || \
+		defined(RESTINIO_HTTP_PARSER_SIMD_SSE42)
+
+//! Index of the lowest set bit of non-zero @a mask.
+RESTINIO_NODISCARD
+inline unsigned
+lowest_bit_index( std::uint32_t mask ) noexcept
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward( &index, mask );
+	return static_cast< unsigned >( index );
+#else
+	return static_cast< unsigned >( __builtin_ctz( mask ) );
+#endif
+}
+
+#endif
+
+//
+// find_header_block_end()
+//
+
+//! Find the end of HTTP header block.
+/*!
+	@return a pointer to the byte right after "\r\n\r\n" or nullptr if
+	there is no "\r\n\r\n" in [first, last).
+*/
+RESTINIO_NODISCARD
+inline const char *
+find_header_block_end( const char * first, const char * last ) noexcept
+{
+#if defined(RESTINIO_HTTP_PARSER_SIMD_AVX2)
+	const __m256i cr = _mm256_set1_epi8( '\r' );
+	const __m256i lf = _mm256_set1_epi8( '\n' );
+
+	// Four overlapped loads: a bit in the resulting mask is set if
+	// the whole "\r\n\r\n" starts at the corresponding position.
+	for( ; last - first >= 32 + 3; first += 32 )
+	{
+		const auto load = [first]( int offset ) {
+			return _mm256_loadu_si256(
+					reinterpret_cast< const __m256i * >( first + offset ) );
+		};
+
+		const __m256i m = _mm256_and_si256(
+				_mm256_and_si256(
+					_mm256_cmpeq_epi8( load( 0 ), cr ),
+					_mm256_cmpeq_epi8( load( 1 ), lf ) ),
+				_mm256_and_si256(
+					_mm256_cmpeq_epi8( load( 2 ), cr ),
+					_mm256_cmpeq_epi8( load( 3 ), lf ) ) );
+
+		const auto mask = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( m ) );
+		if( mask )
+			return first + lowest_bit_index( mask ) + 4;
+	}
+#elif defined(RESTINIO_HTTP_PARSER_SIMD_SSE42)
+	const __m128i cr = _mm_set1_epi8( '\r' );
+	const __m128i lf = _mm_set1_epi8( '\n' );
+
+	for( ; last - first >= 16 + 3; first += 16 )
+	{
+		const auto load = [first]( int offset ) {
+			return _mm_loadu_si128(
+					reinterpret_cast< const __m128i * >( first + offset ) );
+		};
+
+		const __m128i m = _mm_and_si128(
+				_mm_and_si128(
+					_mm_cmpeq_epi8( load( 0 ), cr ),
+					_mm_cmpeq_epi8( load( 1 ), lf ) ),
+				_mm_and_si128(
+					_mm_cmpeq_epi8( load( 2 ), cr ),
+					_mm_cmpeq_epi8( load( 3 ), lf ) ) );
+
+		const auto mask = static_cast< std::uint32_t >(
+				_mm_movemask_epi8( m ) );
+		if( mask )
+			return first + lowest_bit_index( mask ) + 4;
+	}
+#endif
+
+	for( ; last - first >= 4; ++first )
+	{
+		if( '\r' == first[ 0 ] && '\n' == first[ 1 ] &&
+			'\r' == first[ 2 ] && '\n' == first[ 3 ] )
+			return first + 4;
+	}
+
+	return nullptr;
+}
+
+//
+// find_value_end()
+//
+
+//! Find the first byte that can't be a part of field value.
+/*!
+	For a well-formed field value it will be '\r' from the line end.
+
+	@return @a last if there is no such byte.
+*/
+RESTINIO_NODISCARD
+inline const char *
+find_value_end( const char * first, const char * last ) noexcept
+{
+#if defined(RESTINIO_HTTP_PARSER_SIMD_AVX2)
+	const __m256i min_allowed = _mm256_set1_epi8( 0x20 );
+	const __m256i del = _mm256_set1_epi8( 0x7F );
+	const __m256i tab = _mm256_set1_epi8( '\t' );
+
+	for( ; last - first >= 32; first += 32 )
+	{
+		const __m256i v = _mm256_loadu_si256(
+				reinterpret_cast< const __m256i * >( first ) );
+
+		// v >= 0x20 (as unsigned) if max(v, 0x20) == v.
+		const auto allowed = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8(
+						_mm256_max_epu8( v, min_allowed ), v ) ) );
+		const auto dels = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, del ) ) );
+		const auto tabs = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, tab ) ) );
+
+		const std::uint32_t forbidden = ( ~allowed & ~tabs ) | dels;
+		if( forbidden )
+			return first + lowest_bit_index( forbidden );
+	}
+#elif defined(RESTINIO_HTTP_PARSER_SIMD_SSE42)
+	// Ranges of forbidden bytes: [0x00, 0x08], [0x0A, 0x1F], [0x7F, 0x7F].
+	alignas(16) static const char ranges[ 16 ] =
+			"\x00\x08" "\x0A\x1F" "\x7F\x7F";
+	const __m128i ranges_v = _mm_load_si128(
+			reinterpret_cast< const __m128i * >( ranges ) );
+
+	for( ; last - first >= 16; first += 16 )
+	{
+		const __m128i v = _mm_loadu_si128(
+				reinterpret_cast< const __m128i * >( first ) );
+
+		const int index = _mm_cmpestri(
+				ranges_v, 6, v, 16,
+				_SIDD_LEAST_SIGNIFICANT | _SIDD_CMP_RANGES | _SIDD_UBYTE_OPS );
+		if( 16 != index )
+			return first + index;
+	}
+#endif
+
+	for( ; first != last; ++first )
+		if( is_forbidden_value_char( *first ) )
+			break;
+
+	return first;
+}
+
+//
+// find_target_end()
+//
+
+//! Find the first byte that can't be a part of request-target.
+/*!
+	For a well-formed request line it will be ' ' before HTTP-version.
+
+	@return @a last if there is no such byte.
+*/
+RESTINIO_NODISCARD
+inline const char *
+find_target_end( const char * first, const char * last ) noexcept
+{
+#if defined(RESTINIO_HTTP_PARSER_SIMD_AVX2)
+	const __m256i min_allowed = _mm256_set1_epi8( 0x21 );
+	const __m256i del = _mm256_set1_epi8( 0x7F );
+
+	for( ; last - first >= 32; first += 32 )
+	{
+		const __m256i v = _mm256_loadu_si256(
+				reinterpret_cast< const __m256i * >( first ) );
+
+		const auto allowed = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8(
+						_mm256_max_epu8( v, min_allowed ), v ) ) );
+		const auto dels = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, del ) ) );
+
+		const std::uint32_t forbidden = ~allowed | dels;
+		if( forbidden )
+			return first + lowest_bit_index( forbidden );
+	}
+#elif defined(RESTINIO_HTTP_PARSER_SIMD_SSE42)
+	// Ranges of forbidden bytes: [0x00, 0x20], [0x7F, 0x7F].
+	alignas(16) static const char ranges[ 16 ] = "\x00\x20" "\x7F\x7F";
+	const __m128i ranges_v = _mm_load_si128(
+			reinterpret_cast< const __m128i * >( ranges ) );
+
+	for( ; last - first >= 16; first += 16 )
+	{
+		const __m128i v = _mm_loadu_si128(
+				reinterpret_cast< const __m128i * >( first ) );
+
+		const int index = _mm_cmpestri(
+				ranges_v, 4, v, 16,
+				_SIDD_LEAST_SIGNIFICANT | _SIDD_CMP_RANGES | _SIDD_UBYTE_OPS );
+		if( 16 != index )
+			return first + index;
+	}
+#endif
+
+	for( ; first != last; ++first )
+		if( is_forbidden_target_char( *first ) )
+			break;
+
+	return first;
+}
+
+} /* namespace http_parser_simd */
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,105 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Helpers for updating server metrics.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/metrics.hpp>
+
+#include <restinio/utils/at_scope_exit.hpp>
+
+#include <chrono>
+#include <memory>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// metrics_updater_t
+//
+/*!
+ * @brief A class for holding actual metrics object.
+ *
+ * This class holds shared pointer to actual metrics object and
+ * provides actual implementations of metrics updating methods.
+ *
+ * @since v.0.6.14
+ */
+template< typename Metrics >
+struct metrics_updater_t
+{
+	std::shared_ptr< Metrics > m_metrics;
+
+	template< typename Settings >
+	metrics_updater_t( const Settings & settings )
+		:	m_metrics{ settings.metrics() }
+	{}
+
+	void
+	increment_metric(
+		metrics::counter_t counter,
+		std::uint64_t value = 1u ) const noexcept
+	{
+		m_metrics->increment( counter, value );
+	}
+
+	//! Call @a lambda and record the time spent in it.
+	template< typename Lambda >
+	auto
+	measure_latency( metrics::histogram_t histogram, Lambda && lambda ) const
+		-> decltype( lambda() )
+	{
+		const auto started_at = std::chrono::steady_clock::now();
+		auto recorder = restinio::utils::at_scope_exit( [&] {
+				m_metrics->record(
+						histogram,
+						std::chrono::steady_clock::now() - started_at );
+			} );
+
+		return lambda();
+	}
+};
+
+/*!
+ * @brief A specialization of metrics_updater for case of noop_metrics.
+ *
+ * This class doesn't hold anything and doesn't do anything.
+ *
+ * @since v.0.6.14
+ */
+template<>
+struct metrics_updater_t< metrics::noop_metrics_t >
+{
+	template< typename Settings >
+	metrics_updater_t( const Settings & ) { /* nothing to do */ }
+
+	void
+	increment_metric(
+		metrics::counter_t /*counter*/,
+		std::uint64_t /*value*/ = 1u ) const noexcept
+	{
+		/* nothing to do */
+	}
+
+	template< typename Lambda >
+	auto
+	measure_latency( metrics::histogram_t /*histogram*/, Lambda && lambda ) const
+		-> decltype( lambda() )
+	{
+		return lambda();
+	}
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
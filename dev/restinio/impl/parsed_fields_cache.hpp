@@ -0,0 +1,209 @@
+/*
+	restinio
+*/
+
+/*!
+	A cache for parsed values of HTTP-fields of a request.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if !defined( RESTINIO_PARSED_FIELDS_CACHE_BUFFER_SIZE )
+	#define RESTINIO_PARSED_FIELDS_CACHE_BUFFER_SIZE 256
+#endif
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// parsed_fields_cache_t
+//
+
+//! A cache for parsed values of HTTP-fields.
+/*!
+	An entry in the cache is identified by a pair of a key (that is
+	provided by a user of the cache) and the type of parsed value.
+	So the same field can be parsed into several types of values.
+
+	Entries are placed into an internal buffer while there is enough
+	space in it. Entries that do not fit into the buffer are allocated
+	dynamically.
+
+	Entries are never removed from the cache, so references to
+	cached values remain valid until the destruction of the cache.
+
+	@note
+	This class isn't thread safe.
+
+	@since v.0.6.14
+*/
+class parsed_fields_cache_t
+{
+	//! The common part of every entry.
+	struct entry_t
+	{
+		//! Type of function for destruction of an entry.
+		using destroyer_t = void (*)( entry_t * );
+
+		entry_t * m_next;
+		const void * m_key;
+		const void * m_type;
+		destroyer_t m_destroyer;
+	};
+
+	//! An entry with a value of a particular type.
+	template< typename Value >
+	struct typed_entry_t final : public entry_t
+	{
+		Value m_value;
+
+		template< typename... Args >
+		typed_entry_t(
+			const void * key,
+			destroyer_t destroyer,
+			Args && ...args )
+			:	entry_t{ nullptr, key, type_key< Value >(), destroyer }
+			,	m_value( std::forward< Args >( args )... )
+		{}
+
+		static void
+		destroy_inplace( entry_t * e ) noexcept
+		{
+			static_cast< typed_entry_t * >( e )->~typed_entry_t();
+		}
+
+		static void
+		destroy_dynamic( entry_t * e ) noexcept
+		{
+			delete static_cast< typed_entry_t * >( e );
+		}
+	};
+
+	//! A unique identifier of a type.
+	template< typename Value >
+	static const void *
+	type_key() noexcept
+	{
+		static const char key{};
+		return &key;
+	}
+
+	//! The buffer for entries.
+	alignas( std::max_align_t ) std::array<
+			unsigned char,
+			RESTINIO_PARSED_FIELDS_CACHE_BUFFER_SIZE > m_buffer;
+
+	//! The count of used bytes in the buffer.
+	std::size_t m_buffer_used{};
+
+	//! The list of entries.
+	entry_t * m_head{};
+
+	RESTINIO_NODISCARD
+	entry_t *
+	find( const void * key, const void * type ) const noexcept
+	{
+		for( auto * e = m_head; e; e = e->m_next )
+			if( key == e->m_key && type == e->m_type )
+				return e;
+
+		return nullptr;
+	}
+
+	//! Get space in the buffer for a new entry.
+	/*!
+		@return nullptr if there is no space.
+	*/
+	template< typename Entry >
+	RESTINIO_NODISCARD
+	void *
+	allocate_inplace() noexcept
+	{
+		if( alignof( Entry ) > alignof( std::max_align_t ) )
+			return nullptr;
+
+		const std::size_t aligned_offset =
+				( m_buffer_used + alignof( Entry ) - 1u ) &
+				~( alignof( Entry ) - 1u );
+		if( aligned_offset + sizeof( Entry ) > m_buffer.size() )
+			return nullptr;
+
+		m_buffer_used = aligned_offset + sizeof( Entry );
+		return m_buffer.data() + aligned_offset;
+	}
+
+public:
+	parsed_fields_cache_t() noexcept = default;
+
+	parsed_fields_cache_t( const parsed_fields_cache_t & ) = delete;
+	parsed_fields_cache_t & operator=( const parsed_fields_cache_t & ) = delete;
+
+	~parsed_fields_cache_t() noexcept
+	{
+		while( m_head )
+		{
+			auto * e = m_head;
+			m_head = e->m_next;
+			e->m_destroyer( e );
+		}
+	}
+
+	//! Get a cached value or create it by calling @a factory.
+	/*!
+		@a factory is called only if there is no value of type @a Value
+		for @a key yet. It should return an object of type @a Value.
+
+		If @a factory throws then nothing is added to the cache.
+	*/
+	template< typename Value, typename Factory >
+	RESTINIO_NODISCARD
+	const Value &
+	get_or_create( const void * key, Factory && factory )
+	{
+		using entry_type = typed_entry_t< Value >;
+
+		if( auto * e = find( key, type_key< Value >() ) )
+			return static_cast< entry_type * >( e )->m_value;
+
+		entry_type * e;
+		const auto used_before = m_buffer_used;
+		if( void * place = allocate_inplace< entry_type >() )
+		{
+			try
+			{
+				e = new(place) entry_type{
+						key, &entry_type::destroy_inplace, factory() };
+			}
+			catch( ... )
+			{
+				m_buffer_used = used_before;
+				throw;
+			}
+		}
+		else
+			e = new entry_type{
+					key, &entry_type::destroy_dynamic, factory() };
+
+		e->m_next = m_head;
+		m_head = e;
+
+		return e->m_value;
+	}
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -6,6 +6,21 @@
 	Callbacks used with http parser.
 */
 
+/*!
+ * @since v.0.6.14
+ */
+inline int
+restinio_message_begin_cb( http_parser * parser )
+{
+	auto * ctx =
+		reinterpret_cast< restinio::impl::http_parser_ctx_t * >(
+			parser->data );
+
+	ctx->m_message_started = true;
+
+	return 0;
+}
+
 inline int
 restinio_url_cb( http_parser * parser, const char * at, size_t length )
 {
@@ -221,8 +236,7 @@ restinio_chunk_complete_cb( http_parser * /*parser*/ )
 	return 0;
 }
 
-template< typename Http_Methods >
-int
+inline int
 restinio_message_complete_cb( http_parser * parser )
 {
 	// If entire http-message consumed, we need to stop parser.
@@ -241,12 +255,12 @@ restinio_message_complete_cb( http_parser * parser )
 	}
 
 	ctx->m_message_complete = true;
-	ctx->m_header.method( Http_Methods::from_nodejs( parser->method ) );
+	ctx->m_message_started = false;
+	ctx->m_header.http_major( parser->http_major );
+	ctx->m_header.http_minor( parser->http_minor );
 
-	if( 0 == parser->upgrade )
-		ctx->m_header.should_keep_alive( 0 != http_should_keep_alive( parser ) );
-	else
-		ctx->m_header.connection( http_connection_header_t::upgrade );
+	// NOTE: method, keep-alive and upgrade flags are
+	// set by the connection via http_parser_backend interface.
 
 	return 0;
 }
@@ -0,0 +1,237 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Helpers for reporting stages of request processing to a tracer.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/tracing.hpp>
+
+#include <memory>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// request_tracer_holder_t
+//
+/*!
+ * @brief A class for holding actual tracer object in connection settings.
+ *
+ * @since v.0.6.14
+ */
+template< typename Tracer >
+struct request_tracer_holder_t
+{
+	std::shared_ptr< Tracer > m_request_tracer;
+
+	template< typename Settings >
+	request_tracer_holder_t( const Settings & settings )
+		:	m_request_tracer{ settings.request_tracer() }
+	{}
+};
+
+/*!
+ * @brief A specialization of request_tracer_holder for case of noop_tracer.
+ *
+ * This class doesn't hold anything.
+ *
+ * @since v.0.6.14
+ */
+template<>
+struct request_tracer_holder_t< tracing::noop_tracer_t >
+{
+	template< typename Settings >
+	request_tracer_holder_t( const Settings & ) { /* nothing to do */ }
+};
+
+//
+// connection_tracing_ctx_t
+//
+/*!
+ * @brief Per-connection state for reporting stages of request processing.
+ *
+ * Stages that happen before a request gets its id (reading and parsing)
+ * are remembered and reported when the request is registered in
+ * the response coordinator.
+ *
+ * The object doesn't own the tracer: a connection holds a pointer to
+ * connection settings and connection settings hold the tracer.
+ *
+ * @since v.0.6.14
+ */
+template< typename Tracer >
+class connection_tracing_ctx_t
+{
+	public:
+		connection_tracing_ctx_t(
+			connection_id_t connection_id,
+			const request_tracer_holder_t< Tracer > & holder ) noexcept
+			:	m_connection_id{ connection_id }
+			,	m_tracer{ holder.m_request_tracer.get() }
+		{}
+
+		//! Some bytes of a request are going to be parsed.
+		void
+		on_data_arrived() noexcept
+		{
+			if( !m_first_byte_read )
+				m_first_byte_read = tracing::clock_type_t::now();
+		}
+
+		//! A portion of data was handled by the parser.
+		void
+		on_data_parsed(
+			bool leading_headers_completed,
+			bool message_complete ) noexcept
+		{
+			if( ( leading_headers_completed && !m_headers_completed ) ||
+				message_complete )
+			{
+				const auto now = tracing::clock_type_t::now();
+				if( leading_headers_completed && !m_headers_completed )
+					m_headers_completed = now;
+				if( message_complete )
+					m_body_completed = now;
+			}
+		}
+
+		//! The request got its id.
+		/*!
+		 * Stages remembered for that request are reported and
+		 * the state is reset for the next request.
+		 */
+		void
+		on_request_registered( request_id_t request_id ) noexcept
+		{
+			report( request_id, tracing::stage_t::first_byte_read,
+					m_first_byte_read );
+			report( request_id, tracing::stage_t::headers_completed,
+					m_headers_completed );
+			report( request_id, tracing::stage_t::body_completed,
+					m_body_completed );
+
+			m_first_byte_read = m_headers_completed = m_body_completed =
+					optional_t< tracing::timestamp_t >{};
+		}
+
+		//! The request handler is about to be called.
+		void
+		on_handler_invoked( request_id_t request_id ) noexcept
+		{
+			report_now( request_id, tracing::stage_t::handler_invoked );
+		}
+
+		//! A part of the response was appended to the response coordinator.
+		void
+		on_response_appended( request_id_t request_id ) noexcept
+		{
+			report_now( request_id, tracing::stage_t::response_appended );
+		}
+
+		//! A new write group was taken from the response coordinator.
+		void
+		on_write_group_started(
+			request_id_t request_id,
+			bool last_group_of_response ) noexcept
+		{
+			m_first_write_of_response =
+					!m_last_written_request || *m_last_written_request != request_id;
+			m_last_written_request = request_id;
+			m_last_group_of_response = last_group_of_response;
+		}
+
+		//! A write operation for the current write group completed.
+		void
+		on_write_completed() noexcept
+		{
+			if( m_first_write_of_response && m_last_written_request )
+			{
+				m_first_write_of_response = false;
+				report_now( *m_last_written_request,
+						tracing::stage_t::first_byte_written );
+			}
+		}
+
+		//! All data of the current write group was written.
+		void
+		on_write_group_finished() noexcept
+		{
+			if( m_last_group_of_response && m_last_written_request )
+			{
+				m_last_group_of_response = false;
+				report_now( *m_last_written_request,
+						tracing::stage_t::last_byte_written );
+			}
+		}
+
+	private:
+		void
+		report(
+			request_id_t request_id,
+			tracing::stage_t stage,
+			const optional_t< tracing::timestamp_t > & timestamp ) noexcept
+		{
+			if( timestamp )
+				m_tracer->on_event( tracing::event_t{
+						m_connection_id, request_id, stage, *timestamp } );
+		}
+
+		void
+		report_now( request_id_t request_id, tracing::stage_t stage ) noexcept
+		{
+			m_tracer->on_event( tracing::event_t{
+					m_connection_id, request_id, stage,
+					tracing::clock_type_t::now() } );
+		}
+
+		const connection_id_t m_connection_id;
+		Tracer * const m_tracer;
+
+		optional_t< tracing::timestamp_t > m_first_byte_read;
+		optional_t< tracing::timestamp_t > m_headers_completed;
+		optional_t< tracing::timestamp_t > m_body_completed;
+
+		optional_t< request_id_t > m_last_written_request;
+		bool m_first_write_of_response{ false };
+		bool m_last_group_of_response{ false };
+};
+
+/*!
+ * @brief A specialization of connection_tracing_ctx for case of noop_tracer.
+ *
+ * This class doesn't hold anything and doesn't do anything.
+ *
+ * @since v.0.6.14
+ */
+template<>
+class connection_tracing_ctx_t< tracing::noop_tracer_t >
+{
+	public:
+		connection_tracing_ctx_t(
+			connection_id_t,
+			const request_tracer_holder_t< tracing::noop_tracer_t > & ) noexcept
+		{}
+
+		void on_data_arrived() noexcept {}
+		void on_data_parsed( bool, bool ) noexcept {}
+		void on_request_registered( request_id_t ) noexcept {}
+		void on_handler_invoked( request_id_t ) noexcept {}
+		void on_response_appended( request_id_t ) noexcept {}
+		void on_write_group_started( request_id_t, bool ) noexcept {}
+		void on_write_completed() noexcept {}
+		void on_write_group_finished() noexcept {}
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
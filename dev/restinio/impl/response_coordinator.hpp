@@ -182,6 +182,16 @@ class response_context_table_t
 			return m_contexts[ m_first_element_index ];
 		}
 
+		//! Get first context.
+		/*!
+		 * @since v.0.6.14
+		 */
+		const response_context_t &
+		front() const noexcept
+		{
+			return m_contexts[ m_first_element_index ];
+		}
+
 		//! Get last context.
 		response_context_t &
 		back() noexcept
@@ -191,6 +201,30 @@ class response_context_table_t
 					m_contexts.size() ];
 		}
 
+		//! Get last context.
+		/*!
+		 * @since v.0.6.14
+		 */
+		const response_context_t &
+		back() const noexcept
+		{
+			return m_contexts[
+				(m_first_element_index + (m_elements_exists - 1) ) %
+					m_contexts.size() ];
+		}
+
+		//! Check if there is a context for specified request.
+		/*!
+		 * @since v.0.6.14
+		 */
+		bool
+		contains( request_id_t req_id ) const noexcept
+		{
+			return !empty() &&
+				req_id >= front().request_id() &&
+				req_id <= back().request_id();
+		}
+
 		//! Get context of specified request.
 		response_context_t *
 		get_by_req_id( request_id_t req_id ) noexcept
@@ -303,6 +337,20 @@ class response_coordinator_t
 		bool is_full() const noexcept { return m_context_table.is_full(); }
 		///@}
 
+		//! Check if the response for specified request isn't completely
+		//! handed out yet.
+		/*!
+		 * Returns false when all parts of the response were taken by
+		 * pop_ready_buffers() (or if there is no such request at all).
+		 *
+		 * @since v.0.6.14
+		 */
+		bool
+		is_response_in_progress( request_id_t req_id ) const noexcept
+		{
+			return m_context_table.contains( req_id );
+		}
+
 		//! Check if it is possible to accept more requests.
 		bool
 		is_able_to_get_more_messages() const noexcept
@@ -319,6 +367,19 @@ class response_coordinator_t
 			return m_request_id_counter++;
 		}
 
+		//! Get id of the last registered request.
+		/*!
+		 * @attention
+		 * The value has sense only if the coordinator isn't empty.
+		 *
+		 * @since v.0.6.14
+		 */
+		request_id_t
+		last_registered_request_id() const noexcept
+		{
+			return m_request_id_counter - 1u;
+		}
+
 		//! Add outgoing data for specified request.
 		void
 		append_response(
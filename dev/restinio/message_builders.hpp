@@ -51,6 +51,225 @@ make_date_field_value( std::chrono::system_clock::time_point tp )
 	return make_date_field_value( std::chrono::system_clock::to_time_t( tp ) );
 }
 
+namespace impl
+{
+
+//
+// cached_date_field_value()
+//
+
+//! Get a value for `Date` field with caching.
+/*!
+ * Formatting of `Date` field requires calls to gmtime and strftime.
+ * But the value changes only once per second, so the last formatted
+ * value is cached in a thread-local storage and reused while
+ * the second is the same.
+ *
+ * @note
+ * The returned reference is valid until the next call to this function
+ * on the same thread.
+ *
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline const std::string &
+cached_date_field_value( std::time_t t )
+{
+	struct cache_t
+	{
+		std::time_t m_second{ static_cast< std::time_t >( -1 ) };
+		std::string m_value;
+	};
+
+	static thread_local cache_t cache;
+
+	if( cache.m_second != t )
+	{
+		cache.m_value = make_date_field_value( t );
+		cache.m_second = t;
+	}
+
+	return cache.m_value;
+}
+
+} /* namespace impl */
+
+//
+// response_header_template_t
+//
+
+//! A pre-serialized part of response header.
+/*!
+ * The status line and fixed header fields are serialized only once,
+ * at the construction of the template. When the response is completed
+ * only `Connection`, `Content-Length` and (if it is enabled) `Date` fields
+ * are added to the pre-serialized data.
+ *
+ * Usage example:
+ * @code
+ * const auto json_ok = restinio::response_header_template_t{ restinio::status_ok() }
+ * 	.append_header( restinio::http_field::server, "My server" )
+ * 	.append_header( restinio::http_field::content_type, "application/json" )
+ * 	.append_date_field();
+ *
+ * ...
+ * return req->create_response( json_ok )
+ * 	.set_body( make_json( ... ) )
+ * 	.done();
+ * @endcode
+ *
+ * Fields added to a response builder created from the template are
+ * serialized after the fields of the template.
+ *
+ * @attention
+ * Template object is used by reference so it must outlive all response
+ * builders created from it. Usually templates are created once and
+ * stored as static or global objects. A template isn't modified while
+ * a response is built, so it can be used from several threads at once.
+ *
+ * @attention
+ * If `Date` field is enabled for the template then
+ * append_header_date_field() shouldn't be called for the response builder.
+ *
+ * @since v.0.6.14
+ */
+class response_header_template_t
+{
+	public:
+		explicit response_header_template_t( http_status_line_t status_line )
+			:	m_status_line{ std::move( status_line ) }
+		{
+			impl::append_status_line(
+				m_status_line_str,
+				http_response_header_t{ m_status_line } );
+		}
+
+		//! Add header field.
+		response_header_template_t &
+		append_header(
+			string_view_t field_name,
+			string_view_t field_value ) &
+		{
+			constexpr const char header_field_sep[] = ": ";
+			constexpr const char header_rn[] = "\r\n";
+
+			m_fixed_fields.append( field_name.data(), field_name.size() );
+			m_fixed_fields.append(
+				header_field_sep, impl::ct_string_len( header_field_sep ) );
+			m_fixed_fields.append( field_value.data(), field_value.size() );
+			m_fixed_fields.append( header_rn, impl::ct_string_len( header_rn ) );
+
+			return *this;
+		}
+
+		//! Add header field.
+		response_header_template_t &&
+		append_header(
+			string_view_t field_name,
+			string_view_t field_value ) &&
+		{
+			return std::move( this->append_header( field_name, field_value ) );
+		}
+
+		//! Add header field.
+		response_header_template_t &
+		append_header(
+			http_field_t field_id,
+			string_view_t field_value ) &
+		{
+			return this->append_header(
+				string_view_t{ field_to_string( field_id ) },
+				field_value );
+		}
+
+		//! Add header field.
+		response_header_template_t &&
+		append_header(
+			http_field_t field_id,
+			string_view_t field_value ) &&
+		{
+			return std::move( this->append_header( field_id, field_value ) );
+		}
+
+		//! Add `Date` field with the current time to every response.
+		/*!
+		 * The value is taken from impl::cached_date_field_value().
+		 */
+		response_header_template_t &
+		append_date_field() & noexcept
+		{
+			m_add_date_field = true;
+			return *this;
+		}
+
+		//! Add `Date` field with the current time to every response.
+		response_header_template_t &&
+		append_date_field() && noexcept
+		{
+			return std::move( this->append_date_field() );
+		}
+
+		RESTINIO_NODISCARD
+		const http_status_line_t &
+		status_line() const noexcept
+		{
+			return m_status_line;
+		}
+
+		//! Make the whole header of a response.
+		/*!
+		 * @a h is the header of a response builder. Only its connection
+		 * and content-length and its own fields are used.
+		 */
+		RESTINIO_NODISCARD
+		std::string
+		make_header_string( const http_response_header_t & h ) const
+		{
+			constexpr const char date_field_start[] = "Date: ";
+			constexpr const char header_rn[] = "\r\n";
+
+			std::string result;
+			result.reserve(
+				m_status_line_str.size() +
+				m_fixed_fields.size() +
+				impl::calculate_approx_buffer_size_for_header( h ) );
+
+			result += m_status_line_str;
+
+			impl::append_connection_field( result, h.connection() );
+			impl::append_content_length_field( result, h.content_length() );
+
+			if( m_add_date_field )
+			{
+				result.append(
+					date_field_start, impl::ct_string_len( date_field_start ) );
+				result += impl::cached_date_field_value(
+					std::chrono::system_clock::to_time_t(
+						std::chrono::system_clock::now() ) );
+				result.append( header_rn, impl::ct_string_len( header_rn ) );
+			}
+
+			result += m_fixed_fields;
+
+			impl::append_fields( result, h );
+
+			result.append( header_rn, impl::ct_string_len( header_rn ) );
+
+			return result;
+		}
+
+	private:
+		http_status_line_t m_status_line;
+
+		//! Serialized status line.
+		std::string m_status_line_str;
+
+		//! Serialized fixed fields.
+		std::string m_fixed_fields;
+
+		bool m_add_date_field{ false };
+};
+
 //
 // base_response_builder_t
 //
@@ -163,7 +382,10 @@ class base_response_builder_t
 			std::chrono::system_clock::time_point tp =
 				std::chrono::system_clock::now() ) &
 		{
-			m_header.set_field( http_field_t::date, make_date_field_value( tp ) );
+			m_header.set_field(
+				http_field_t::date,
+				impl::cached_date_field_value(
+					std::chrono::system_clock::to_time_t( tp ) ) );
 			return upcast_reference();
 		}
 
@@ -214,6 +436,21 @@ class base_response_builder_t
 			return 8 + 1 + 3 + 1 + m_header.status_line().reason_phrase().size();
 		}
 
+		//! Switch the response to `Connection: close` if the connection
+		//! is in the drain mode and it's the response to the last request.
+		/*!
+		 * It should be called before the header is serialized.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		close_connection_if_draining(
+			const impl::connection_handle_t & conn ) noexcept
+		{
+			if( conn->should_close_after_response( m_request_id ) )
+				m_header.should_keep_alive( false );
+		}
+
 		http_response_header_t m_header;
 
 		impl::connection_handle_t m_connection;
@@ -269,6 +506,23 @@ class response_builder_t< restinio_controlled_output_t > final
 		// Reuse construstors from base.
 		using base_type_t::base_type_t;
 
+		//! Constructor for a response with pre-serialized header.
+		/*!
+		 * @since v.0.6.14
+		 */
+		response_builder_t(
+			const response_header_template_t & header_template,
+			impl::connection_handle_t connection,
+			request_id_t request_id,
+			bool should_keep_alive )
+			:	base_type_t{
+					header_template.status_line(),
+					std::move( connection ),
+					request_id,
+					should_keep_alive }
+			,	m_header_template{ &header_template }
+		{}
+
 		//! Set body.
 		self_type_t &
 		set_body( writable_item_t body ) &
@@ -305,6 +559,8 @@ class response_builder_t< restinio_controlled_output_t > final
 		{
 			if( m_connection )
 			{
+				close_connection_if_draining( m_connection );
+
 				const response_output_flags_t
 					response_output_flags{
 						response_parts_attr_t::final_parts,
@@ -315,7 +571,9 @@ class response_builder_t< restinio_controlled_output_t > final
 				if_neccessary_reserve_first_element_for_header();
 
 				m_response_parts[ 0 ] =
-					writable_item_t{ impl::create_header_string( m_header ) };
+					writable_item_t{ m_header_template ?
+						m_header_template->make_header_string( m_header ) :
+						impl::create_header_string( m_header ) };
 
 				write_group_t wg{ std::move( m_response_parts ) };
 				wg.status_line_size( calculate_status_line_size() );
@@ -386,6 +644,12 @@ class response_builder_t< restinio_controlled_output_t > final
 
 		std::size_t m_body_size{ 0 };
 		writable_items_container_t m_response_parts;
+
+		//! Optional template for the header.
+		/*!
+		 * @since v.0.6.14
+		 */
+		const response_header_template_t * m_header_template{ nullptr };
 };
 
 //! Tag type for user controlled output response builder.
@@ -521,6 +785,8 @@ class response_builder_t< user_controlled_output_t > final
 
 			if( !m_header_was_sent )
 			{
+				close_connection_if_draining( conn );
+
 				m_should_keep_alive_when_header_was_sent =
 					m_header.should_keep_alive();
 
@@ -729,6 +995,8 @@ class response_builder_t< chunked_output_t > final
 			std::size_t status_line_size{ 0 };
 			if( !m_header_was_sent )
 			{
+				close_connection_if_draining( conn );
+
 				status_line_size = calculate_status_line_size();
 				prepare_header_for_sending();
 			}
@@ -0,0 +1,582 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Stuff related to server metrics.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/string_view.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace restinio
+{
+
+namespace metrics
+{
+
+//
+// counter_t
+//
+/*!
+ * @brief Counters updated by RESTinio's server.
+ *
+ * @since v.0.6.14
+ */
+enum class counter_t : std::size_t
+{
+	//! Connections accepted (and allowed by IP-blocker).
+	connections_accepted,
+	//! Connections denied by IP-blocker.
+	connections_denied,
+	//! HTTP-connections closed (or upgraded to WebSocket).
+	connections_closed,
+	//! Requests passed to the request handler.
+	requests,
+	//! Requests received while previous requests from the same
+	//! connection were still being processed.
+	pipelined_requests,
+	//! Bytes read from HTTP-connections.
+	bytes_read,
+	//! Bytes written to HTTP-connections (except sendfile operations).
+	bytes_written,
+	//! Bytes written to HTTP-connections by sendfile operations.
+	sendfile_bytes_written,
+	//! Errors of HTTP-parser.
+	parse_errors,
+	//! Timed out operations of HTTP-connections.
+	timeouts,
+	//! WebSocket-connections opened.
+	websocket_connections_opened,
+	//! WebSocket-connections closed.
+	websocket_connections_closed,
+	//! Bytes read from WebSocket-connections.
+	websocket_bytes_read,
+	//! Bytes written to WebSocket-connections.
+	websocket_bytes_written
+};
+
+//! The count of items in counter_t.
+constexpr std::size_t counters_count =
+		static_cast< std::size_t >( counter_t::websocket_bytes_written ) + 1u;
+
+//! Get the name of a counter.
+RESTINIO_NODISCARD
+inline const char *
+counter_name( counter_t counter ) noexcept
+{
+	static constexpr const char * names[ counters_count ] = {
+		"connections_accepted",
+		"connections_denied",
+		"connections_closed",
+		"requests",
+		"pipelined_requests",
+		"bytes_read",
+		"bytes_written",
+		"sendfile_bytes_written",
+		"parse_errors",
+		"timeouts",
+		"websocket_connections_opened",
+		"websocket_connections_closed",
+		"websocket_bytes_read",
+		"websocket_bytes_written"
+	};
+
+	return names[ static_cast< std::size_t >( counter ) ];
+}
+
+//
+// histogram_t
+//
+/*!
+ * @brief Latency histograms updated by RESTinio's server.
+ *
+ * @since v.0.6.14
+ */
+enum class histogram_t : std::size_t
+{
+	//! Time spent in the request handler call.
+	/*!
+	 * If the request is handled asynchronously then only the time
+	 * before the return from the handler is measured.
+	 */
+	handler_latency
+};
+
+//! The count of items in histogram_t.
+constexpr std::size_t histograms_count =
+		static_cast< std::size_t >( histogram_t::handler_latency ) + 1u;
+
+//! Get the name of a histogram.
+RESTINIO_NODISCARD
+inline const char *
+histogram_name( histogram_t histogram ) noexcept
+{
+	static constexpr const char * names[ histograms_count ] = {
+		"handler_latency"
+	};
+
+	return names[ static_cast< std::size_t >( histogram ) ];
+}
+
+//
+// noop_metrics_t
+//
+/*!
+ * @brief The default metrics type that collects nothing.
+ *
+ * RESTinio doesn't even read the clock for latency measurements
+ * if this type is used.
+ *
+ * @since v.0.6.14
+ */
+struct noop_metrics_t
+{
+	void
+	increment( counter_t, std::uint64_t ) noexcept {}
+
+	void
+	record( histogram_t, std::chrono::steady_clock::duration ) noexcept {}
+};
+
+namespace impl
+{
+
+//
+// latency_buckets
+//
+/*!
+ * @brief Log-linear buckets for latency values in nanoseconds.
+ *
+ * Every power of two range is split into 4 buckets, so the relative
+ * error of a value is not greater than 25%. Values greater than
+ * 2^40ns (~18 minutes) go to the last bucket.
+ *
+ * @since v.0.6.14
+ */
+namespace latency_buckets
+{
+
+constexpr unsigned int sub_buckets_bits = 2u;
+constexpr std::uint64_t sub_buckets = 1u << sub_buckets_bits;
+constexpr unsigned int max_msb = 40u;
+
+constexpr std::size_t count =
+		static_cast< std::size_t >( (max_msb - 1u) * sub_buckets + sub_buckets );
+
+RESTINIO_NODISCARD
+inline unsigned int
+msb( std::uint64_t v ) noexcept
+{
+	unsigned int result = 0u;
+	while( v >>= 1u )
+		++result;
+	return result;
+}
+
+//! Get the index of the bucket for a value.
+RESTINIO_NODISCARD
+inline std::size_t
+index_of( std::uint64_t nanoseconds ) noexcept
+{
+	if( nanoseconds < sub_buckets )
+		return static_cast< std::size_t >( nanoseconds );
+
+	const auto m = msb( nanoseconds );
+	if( m > max_msb )
+		return count - 1u;
+
+	const auto sub = (nanoseconds >> (m - sub_buckets_bits)) & (sub_buckets - 1u);
+	return static_cast< std::size_t >(
+			(m - sub_buckets_bits + 1u) * sub_buckets + sub );
+}
+
+//! Get the upper bound (exclusive) for values in a bucket.
+RESTINIO_NODISCARD
+inline std::uint64_t
+upper_bound_of( std::size_t index ) noexcept
+{
+	if( index < sub_buckets )
+		return index + 1u;
+
+	const auto m = static_cast< unsigned int >( index / sub_buckets ) +
+			sub_buckets_bits - 1u;
+	const auto sub = index % sub_buckets;
+	return (sub_buckets + sub + 1u) << (m - sub_buckets_bits);
+}
+
+} /* namespace latency_buckets */
+
+} /* namespace impl */
+
+//
+// snapshot_t
+//
+/*!
+ * @brief Values of all metrics at some moment.
+ *
+ * @since v.0.6.14
+ */
+class snapshot_t
+{
+	public:
+		using histogram_buckets_t =
+				std::array< std::uint64_t, impl::latency_buckets::count >;
+
+		RESTINIO_NODISCARD
+		std::uint64_t
+		counter( counter_t c ) const noexcept
+		{
+			return m_counters[ static_cast< std::size_t >( c ) ];
+		}
+
+		//! The count of currently open HTTP- and WebSocket-connections.
+		RESTINIO_NODISCARD
+		std::uint64_t
+		active_connections() const noexcept
+		{
+			return difference(
+						counter( counter_t::connections_accepted ),
+						counter( counter_t::connections_closed ) ) +
+				difference(
+						counter( counter_t::websocket_connections_opened ),
+						counter( counter_t::websocket_connections_closed ) );
+		}
+
+		//! The count of values in a histogram.
+		RESTINIO_NODISCARD
+		std::uint64_t
+		count( histogram_t h ) const noexcept
+		{
+			std::uint64_t result = 0u;
+			for( const auto v : buckets( h ) )
+				result += v;
+			return result;
+		}
+
+		//! The sum of values in a histogram.
+		RESTINIO_NODISCARD
+		std::chrono::nanoseconds
+		sum( histogram_t h ) const noexcept
+		{
+			return std::chrono::nanoseconds(
+					m_sums[ static_cast< std::size_t >( h ) ] );
+		}
+
+		//! Get an estimation of a percentile.
+		/*!
+		 * Returns the upper bound of a bucket that contains the value.
+		 *
+		 * @param q The requested percentile in the range [0, 1].
+		 */
+		RESTINIO_NODISCARD
+		std::chrono::nanoseconds
+		percentile( histogram_t h, double q ) const noexcept
+		{
+			const auto total = count( h );
+			if( !total )
+				return std::chrono::nanoseconds::zero();
+
+			auto rank = static_cast< std::uint64_t >(
+					q * static_cast< double >( total ) + 0.5 );
+			if( !rank ) rank = 1u;
+
+			const auto & b = buckets( h );
+			std::uint64_t seen = 0u;
+			for( std::size_t i = 0u; i != b.size(); ++i )
+			{
+				seen += b[ i ];
+				if( seen >= rank )
+					return std::chrono::nanoseconds(
+							impl::latency_buckets::upper_bound_of( i ) );
+			}
+
+			return std::chrono::nanoseconds(
+					impl::latency_buckets::upper_bound_of( b.size() - 1u ) );
+		}
+
+		RESTINIO_NODISCARD
+		const histogram_buckets_t &
+		buckets( histogram_t h ) const noexcept
+		{
+			return m_buckets[ static_cast< std::size_t >( h ) ];
+		}
+
+		//! Render metrics in Prometheus text exposition format.
+		/*!
+		 * All metric names get @a prefix (with '_' separator).
+		 */
+		RESTINIO_NODISCARD
+		std::string
+		to_prometheus_text( string_view_t prefix = "restinio" ) const
+		{
+			std::string result;
+			auto out = std::back_inserter( result );
+
+			for( std::size_t i = 0u; i != counters_count; ++i )
+			{
+				const auto name = counter_name( static_cast< counter_t >( i ) );
+				fmt::format_to( out,
+						"# TYPE {0}_{1}_total counter\n{0}_{1}_total {2}\n",
+						prefix, name, m_counters[ i ] );
+			}
+
+			fmt::format_to( out,
+					"# TYPE {0}_active_connections gauge\n"
+					"{0}_active_connections {1}\n",
+					prefix, active_connections() );
+
+			for( std::size_t i = 0u; i != histograms_count; ++i )
+			{
+				const auto h = static_cast< histogram_t >( i );
+				append_histogram( out, prefix, h );
+			}
+
+			return result;
+		}
+
+	private:
+		friend class server_metrics_t;
+
+		std::array< std::uint64_t, counters_count > m_counters{};
+		std::array< histogram_buckets_t, histograms_count > m_buckets{};
+		std::array< std::uint64_t, histograms_count > m_sums{};
+
+		RESTINIO_NODISCARD
+		static std::uint64_t
+		difference( std::uint64_t a, std::uint64_t b ) noexcept
+		{
+			// Counters are read one by one, so a closing can be seen
+			// without the corresponding opening.
+			return a > b ? a - b : 0u;
+		}
+
+		template< typename Out >
+		void
+		append_histogram( Out out, string_view_t prefix, histogram_t h ) const
+		{
+			namespace lb = impl::latency_buckets;
+
+			const auto name = histogram_name( h );
+			fmt::format_to( out,
+					"# TYPE {0}_{1}_seconds histogram\n", prefix, name );
+
+			// Only power of two boundaries from ~1us to ~68s are exposed
+			// (every such boundary is a boundary of an internal bucket).
+			constexpr unsigned int first_exposed_msb = 10u;
+			constexpr unsigned int last_exposed_msb = 36u;
+
+			const auto & b = buckets( h );
+			std::uint64_t cumulative = 0u;
+			std::size_t bucket = 0u;
+			for( unsigned int m = first_exposed_msb; m <= last_exposed_msb; ++m )
+			{
+				const std::uint64_t bound = std::uint64_t{1} << m;
+				for( ; bucket != b.size() && lb::upper_bound_of( bucket ) <= bound;
+						++bucket )
+					cumulative += b[ bucket ];
+
+				fmt::format_to( out,
+						"{0}_{1}_seconds_bucket{{le=\"{2:.9g}\"}} {3}\n",
+						prefix, name,
+						static_cast< double >( bound ) / 1e9,
+						cumulative );
+			}
+
+			const auto total = count( h );
+			fmt::format_to( out,
+					"{0}_{1}_seconds_bucket{{le=\"+Inf\"}} {2}\n"
+					"{0}_{1}_seconds_sum {3:.9g}\n"
+					"{0}_{1}_seconds_count {2}\n",
+					prefix, name, total,
+					static_cast< double >( sum( h ).count() ) / 1e9 );
+		}
+};
+
+//
+// server_metrics_t
+//
+/*!
+ * @brief Ready to use implementation of server metrics.
+ *
+ * Counters and histograms are split into per-thread shards. Every
+ * thread updates its own shard by relaxed atomic operations, so there
+ * is no contention between threads and no locks or allocations on
+ * updates. Values from all shards are summed in snapshot().
+ *
+ * Usage example:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using metrics_t = restinio::metrics::server_metrics_t;
+ * };
+ * ...
+ * auto metrics = std::make_shared< restinio::metrics::server_metrics_t >();
+ * auto router = std::make_unique< restinio::router::express_router_t<> >();
+ * router->http_get( "/metrics", [metrics]( const auto & req, const auto & ) {
+ * 	return req->create_response()
+ * 		.append_header( restinio::http_field::content_type,
+ * 			"text/plain; version=0.0.4" )
+ * 		.set_body( metrics->snapshot().to_prometheus_text() )
+ * 		.done();
+ * } );
+ *
+ * restinio::run(
+ * 	restinio::on_thread_pool< my_traits >( 4 )
+ * 		.metrics( metrics )
+ * 		.request_handler( std::move(router) )
+ * 		...
+ * );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class server_metrics_t
+{
+	public:
+		//! Initializing constructor.
+		/*!
+		 * @param shards_count The number of shards. If there are more
+		 * threads than shards then some threads share a shard.
+		 */
+		explicit server_metrics_t(
+			std::size_t shards_count = default_shards_count() )
+			:	m_shards_count{ shards_count }
+		{
+			if( !m_shards_count )
+				throw exception_t{ "shards_count can't be 0" };
+
+			m_shards.reset( new shard_t[ m_shards_count ] );
+		}
+
+		server_metrics_t( const server_metrics_t & ) = delete;
+		server_metrics_t & operator=( const server_metrics_t & ) = delete;
+
+		void
+		increment( counter_t counter, std::uint64_t value = 1u ) noexcept
+		{
+			current_shard().m_counters[ static_cast< std::size_t >( counter ) ]
+				.fetch_add( value, std::memory_order_relaxed );
+		}
+
+		void
+		record(
+			histogram_t histogram,
+			std::chrono::steady_clock::duration value ) noexcept
+		{
+			const auto ns = std::chrono::duration_cast<
+					std::chrono::nanoseconds >( value ).count();
+			const auto v = ns > 0 ? static_cast< std::uint64_t >( ns ) : 0u;
+
+			const auto h = static_cast< std::size_t >( histogram );
+			auto & shard = current_shard();
+			shard.m_buckets[ h ][ impl::latency_buckets::index_of( v ) ]
+				.fetch_add( 1u, std::memory_order_relaxed );
+			shard.m_sums[ h ].fetch_add( v, std::memory_order_relaxed );
+		}
+
+		//! Collect values from all shards.
+		RESTINIO_NODISCARD
+		snapshot_t
+		snapshot() const noexcept
+		{
+			snapshot_t result;
+			for( std::size_t s = 0u; s != m_shards_count; ++s )
+			{
+				const auto & shard = m_shards[ s ];
+
+				for( std::size_t i = 0u; i != counters_count; ++i )
+					result.m_counters[ i ] += shard.m_counters[ i ].load(
+							std::memory_order_relaxed );
+
+				for( std::size_t h = 0u; h != histograms_count; ++h )
+				{
+					for( std::size_t i = 0u; i != impl::latency_buckets::count; ++i )
+						result.m_buckets[ h ][ i ] += shard.m_buckets[ h ][ i ].load(
+								std::memory_order_relaxed );
+
+					result.m_sums[ h ] += shard.m_sums[ h ].load(
+							std::memory_order_relaxed );
+				}
+			}
+
+			return result;
+		}
+
+	private:
+		//! Values updated by one thread.
+		/*!
+		 * Is padded to avoid false sharing with neighbours.
+		 */
+		struct shard_t
+		{
+			char m_leading_padding[ 64 ];
+			std::atomic< std::uint64_t > m_counters[ counters_count ];
+			std::atomic< std::uint64_t >
+					m_buckets[ histograms_count ][ impl::latency_buckets::count ];
+			std::atomic< std::uint64_t > m_sums[ histograms_count ];
+			char m_trailing_padding[ 64 ];
+
+			shard_t() noexcept
+			{
+				for( auto & c : m_counters )
+					c.store( 0u, std::memory_order_relaxed );
+				for( auto & h : m_buckets )
+					for( auto & b : h )
+						b.store( 0u, std::memory_order_relaxed );
+				for( auto & s : m_sums )
+					s.store( 0u, std::memory_order_relaxed );
+			}
+		};
+
+		const std::size_t m_shards_count;
+		std::unique_ptr< shard_t[] > m_shards;
+
+		RESTINIO_NODISCARD
+		static std::size_t
+		default_shards_count() noexcept
+		{
+			const auto v = std::thread::hardware_concurrency();
+			return v ? v : 1u;
+		}
+
+		RESTINIO_NODISCARD
+		shard_t &
+		current_shard() noexcept
+		{
+			return m_shards[ thread_index() % m_shards_count ];
+		}
+
+		//! Get an index of the current thread.
+		/*!
+		 * Indexes are assigned to threads in the order of their first
+		 * update of any metrics object.
+		 */
+		RESTINIO_NODISCARD
+		static std::size_t
+		thread_index() noexcept
+		{
+			static std::atomic< std::size_t > next_index{ 0u };
+			static thread_local const std::size_t index = next_index++;
+			return index;
+		}
+};
+
+} /* namespace metrics */
+
+} /* namespace restinio */
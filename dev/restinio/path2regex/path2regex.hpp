@@ -759,6 +759,14 @@ struct route_regex_matcher_data_t
 
 	regex_t m_regex;
 
+	//! Source of the regex.
+	/*!
+		It is used to build a combined regex for several routes.
+
+		@since v.0.6.14
+	*/
+	std::string m_regex_source;
+
 	//! Char buffer for holding named paramaters.
 	/*!
 		In order to store named parameters 'names' in a continous block of memory
@@ -840,7 +848,9 @@ tokens2regexp(
 				route += "(?=" + delimiter + "|" + ends_with + ")";
 		}
 
-		result.m_regex = Regex_Engine::compile_regex( "^" + route, options.sensitive() );
+		result.m_regex_source = "^" + route;
+		result.m_regex = Regex_Engine::compile_regex(
+				result.m_regex_source, options.sensitive() );
 	}
 	catch( const std::exception & ex )
 	{
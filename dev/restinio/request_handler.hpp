@@ -13,6 +13,7 @@
 #include <restinio/message_builders.hpp>
 #include <restinio/chunked_input_info.hpp>
 #include <restinio/impl/connection_base.hpp>
+#include <restinio/impl/parsed_fields_cache.hpp>
 
 #include <array>
 #include <functional>
@@ -135,6 +136,10 @@ template< typename Extra_Data >
 connection_handle_t &
 access_req_connection( generic_request_t<Extra_Data> & ) noexcept;
 
+template< typename Extra_Data >
+parsed_fields_cache_t &
+access_parsed_fields_cache( const generic_request_t<Extra_Data> & ) noexcept;
+
 //
 // generic_request_extra_data_holder_t
 //
@@ -203,6 +208,10 @@ class generic_request_t final
 	friend impl::connection_handle_t &
 	impl::access_req_connection( generic_request_t<UD> & ) noexcept;
 
+	template< typename UD >
+	friend impl::parsed_fields_cache_t &
+	impl::access_parsed_fields_cache( const generic_request_t<UD> & ) noexcept;
+
 	public:
 		//! Old-format initializing constructor.
 		/*!
@@ -278,6 +287,25 @@ class generic_request_t final
 				m_header.should_keep_alive() };
 		}
 
+		//! Create a response with pre-serialized header.
+		/*!
+		 * @attention
+		 * @a header_template must outlive the returned builder.
+		 *
+		 * @since v.0.6.14
+		 */
+		auto
+		create_response( const response_header_template_t & header_template )
+		{
+			check_connection();
+
+			return response_builder_t< restinio_controlled_output_t >{
+				header_template,
+				std::move( m_connection ),
+				m_request_id,
+				m_header.should_keep_alive() };
+		}
+
 		//! Get request id.
 		auto request_id() const noexcept { return m_request_id; }
 
@@ -425,6 +453,20 @@ class generic_request_t final
 		 * @since v.0.6.13
 		 */
 		impl::generic_request_extra_data_holder_t< Extra_Data > m_extra_data_holder;
+
+		/*!
+		 * @brief Parsed values of HTTP-fields.
+		 *
+		 * The header of a request can't be changed, so values of
+		 * HTTP-fields have to be parsed only once.
+		 *
+		 * The cache is used only by explicit calls to
+		 * try_parse_field_cached() and functions built on it. It isn't
+		 * thread safe.
+		 *
+		 * @since v.0.6.14
+		 */
+		mutable impl::parsed_fields_cache_t m_parsed_fields_cache;
 };
 
 template< typename Extra_Data >
@@ -479,6 +521,13 @@ access_req_connection( generic_request_t<Extra_Data> & req ) noexcept
 	return req.m_connection;
 }
 
+template< typename Extra_Data >
+parsed_fields_cache_t &
+access_parsed_fields_cache( const generic_request_t<Extra_Data> & req ) noexcept
+{
+	return req.m_parsed_fields_cache;
+}
+
 } /* namespace impl */
 
 
@@ -60,7 +60,10 @@ struct boost_regex_engine_t
 		const compiled_regex_t & r,
 		match_results_t & match_results )
 	{
-		boost::cmatch matches;
+		// Storage for submatches is reused between calls.
+		static thread_local boost::cmatch matches;
+
+		match_results.clear();
 		if(
 			boost::regex_search(
 				target_path.data(),
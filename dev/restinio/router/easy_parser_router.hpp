@@ -17,6 +17,8 @@
 
 #include <restinio/helpers/easy_parser.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 namespace restinio
@@ -525,6 +527,124 @@ struct dsl_processor
 	using clauses_tuple = dsl_details::make_clauses_types_t< arg_types >;
 };
 
+//
+// route_literal_prefix_t
+//
+/*!
+ * @brief Description of a literal fragment a route starts with.
+ *
+ * This description is collected from the route DSL at the registration
+ * time and is used by the router to avoid attempts to match a request
+ * against routes that can't be applicable to it.
+ *
+ * @since v.0.6.14
+ */
+struct route_literal_prefix_t
+{
+	//! Concatenation of all leading literal fragments of a route.
+	/*!
+	 * Can be empty if a route starts with a producer.
+	 */
+	std::string m_fragment;
+
+	//! Does the whole route consist only of literal fragments?
+	bool m_is_whole_route{ false };
+};
+
+namespace literal_prefix_details
+{
+
+/*!
+ * @brief Get a value of a literal clause of route DSL.
+ *
+ * Returns an empty optional if @a clause isn't a literal.
+ */
+template< typename T >
+RESTINIO_NODISCARD
+optional_t< string_view_t >
+literal_of( const T & /*clause*/ ) noexcept
+{
+	return nullopt;
+}
+
+template< std::size_t Size >
+RESTINIO_NODISCARD
+optional_t< string_view_t >
+literal_of( const char (&fragment)[Size] ) noexcept
+{
+	return string_view_t{ fragment, Size - 1u };
+}
+
+RESTINIO_NODISCARD
+inline optional_t< string_view_t >
+literal_of( const std::string & fragment ) noexcept
+{
+	return string_view_t{ fragment };
+}
+
+RESTINIO_NODISCARD
+inline optional_t< string_view_t >
+literal_of( const string_view_t & fragment ) noexcept
+{
+	return fragment;
+}
+
+template< std::size_t Size >
+RESTINIO_NODISCARD
+optional_t< string_view_t >
+literal_of(
+	const ep::impl::consume_value_clause_t<
+			ep::impl::exact_fixed_size_fragment_producer_t<Size>,
+			ep::impl::any_value_skipper_t > & clause ) noexcept
+{
+	return clause.producer().fragment();
+}
+
+RESTINIO_NODISCARD
+inline optional_t< string_view_t >
+literal_of(
+	const ep::impl::consume_value_clause_t<
+			ep::impl::exact_fragment_producer_t,
+			ep::impl::any_value_skipper_t > & clause ) noexcept
+{
+	return clause.producer().fragment();
+}
+
+} /* namespace literal_prefix_details */
+
+//
+// detect_route_literal_prefix
+//
+/*!
+ * @brief Collect the literal prefix of a route from the route DSL.
+ *
+ * @since v.0.6.14
+ */
+template< typename... Args >
+RESTINIO_NODISCARD
+route_literal_prefix_t
+detect_route_literal_prefix( const Args & ...args )
+{
+	const optional_t< string_view_t > literals[] = {
+			literal_prefix_details::literal_of( args )...
+		};
+
+	route_literal_prefix_t result;
+	result.m_is_whole_route = true;
+	for( const auto & l : literals )
+	{
+		if( !l )
+		{
+			result.m_is_whole_route = false;
+			break;
+		}
+
+		result.m_fragment.append( l->data(), l->size() );
+	}
+
+	return result;
+}
+
 //
 // path_to_tuple_producer_t
 //
@@ -544,9 +664,32 @@ class path_to_tuple_producer_t
 {
 	using base_type_t = ep::impl::produce_t< Target_Type, Subitems_Tuple >;
 
+	//! Literal prefix of the route.
+	/*!
+	 * @since v.0.6.14
+	 */
+	route_literal_prefix_t m_literal_prefix;
+
 public:
 	using base_type_t::base_type_t;
 
+	/*!
+	 * @since v.0.6.14
+	 */
+	path_to_tuple_producer_t(
+		Subitems_Tuple && subitems,
+		route_literal_prefix_t literal_prefix )
+		:	base_type_t{ std::move(subitems) }
+		,	m_literal_prefix{ std::move(literal_prefix) }
+	{}
+
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	const route_literal_prefix_t &
+	literal_prefix() const noexcept { return m_literal_prefix; }
+
 	template< typename Extra_Data, typename Handler >
 	RESTINIO_NODISCARD
 	static auto
@@ -627,9 +770,32 @@ class path_to_params_producer_t
 {
 	using base_type_t = ep::impl::produce_t< Target_Type, Subitems_Tuple >;
 
+	//! Literal prefix of the route.
+	/*!
+	 * @since v.0.6.14
+	 */
+	route_literal_prefix_t m_literal_prefix;
+
 public:
 	using base_type_t::base_type_t;
 
+	/*!
+	 * @since v.0.6.14
+	 */
+	path_to_params_producer_t(
+		Subitems_Tuple && subitems,
+		route_literal_prefix_t literal_prefix )
+		:	base_type_t{ std::move(subitems) }
+		,	m_literal_prefix{ std::move(literal_prefix) }
+	{}
+
+	/*!
+	 * @since v.0.6.14
+	 */
+	RESTINIO_NODISCARD
+	const route_literal_prefix_t &
+	literal_prefix() const noexcept { return m_literal_prefix; }
+
 	template< typename User_Type, typename Handler >
 	RESTINIO_NODISCARD
 	static auto
@@ -642,6 +808,325 @@ public:
 	}
 };
 
+//
+// literal_prefix_of
+//
+/*!
+ * @brief Get the literal prefix of a route producer.
+ *
+ * Returns nullptr if a route producer isn't created by path_to_tuple or
+ * path_to_params.
+ *
+ * @since v.0.6.14
+ */
+template< typename Producer >
+RESTINIO_NODISCARD
+const route_literal_prefix_t *
+literal_prefix_of( const Producer & /*producer*/ ) noexcept
+{
+	return nullptr;
+}
+
+template< typename Target_Type, typename Subitems_Tuple >
+RESTINIO_NODISCARD
+const route_literal_prefix_t *
+literal_prefix_of(
+	const path_to_tuple_producer_t< Target_Type, Subitems_Tuple > & producer )
+	noexcept
+{
+	return &producer.literal_prefix();
+}
+
+template< typename Target_Type, typename Subitems_Tuple >
+RESTINIO_NODISCARD
+const route_literal_prefix_t *
+literal_prefix_of(
+	const path_to_params_producer_t< Target_Type, Subitems_Tuple > & producer )
+	noexcept
+{
+	return &producer.literal_prefix();
+}
+
+//
+// known_method_of
+//
+/*!
+ * @brief Get an HTTP method a method matcher is bound to.
+ *
+ * Returns an empty optional if the method matcher can match
+ * several methods.
+ *
+ * @since v.0.6.14
+ */
+template< typename Method_Matcher >
+RESTINIO_NODISCARD
+optional_t< http_method_id_t >
+known_method_of( const Method_Matcher & /*matcher*/ ) noexcept
+{
+	return nullopt;
+}
+
+RESTINIO_NODISCARD
+inline optional_t< http_method_id_t >
+known_method_of( const http_method_id_t & method ) noexcept
+{
+	return method;
+}
+
+//
+// first_path_segment_of
+//
+/*!
+ * @brief Get the first segment of a path.
+ *
+ * The first segment is a fragment between the leading slash and
+ * the next slash (or the end of the path).
+ *
+ * Returns an empty optional if the path doesn't start with a slash.
+ *
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline optional_t< string_view_t >
+first_path_segment_of( string_view_t path ) noexcept
+{
+	if( path.empty() || '/' != path.front() )
+		return nullopt;
+
+	path.remove_prefix( 1u );
+	return path.substr( 0u, path.find( '/' ) );
+}
+
+/*!
+ * @brief Get the first segment of a path every request for the route
+ * has to start with.
+ *
+ * Returns an empty optional if the first segment can't be detected
+ * from the literal prefix of the route.
+ *
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline optional_t< string_view_t >
+first_path_segment_of( const route_literal_prefix_t & prefix ) noexcept
+{
+	const string_view_t fragment{ prefix.m_fragment };
+	if( fragment.empty() || '/' != fragment.front() )
+		return nullopt;
+
+	// The first segment is known only if it is fully
+	// described by the literal prefix.
+	const auto slash_pos = fragment.find( '/', 1u );
+	if( string_view_t::npos == slash_pos && !prefix.m_is_whole_route )
+		return nullopt;
+
+	return first_path_segment_of( fragment );
+}
+
+//
+// route_dispatch_table_t
+//
+/*!
+ * @brief An index of routes by HTTP method and by the first
+ * segment of a path.
+ *
+ * Every route is placed into the index by its HTTP method (if a route
+ * is bound to exactly one method) and by the first segment of the path
+ * (if the route starts with a literal fragment that contains the whole
+ * first segment). Routes that can't be classified are placed into
+ * "any method" and/or "any segment" buckets.
+ *
+ * The lookup for a request returns only routes from appropriate buckets
+ * and keeps the order of route registration.
+ *
+ * @since v.0.6.14
+ */
+class route_dispatch_table_t
+{
+public:
+	//! Type of container for indexes of routes.
+	/*!
+	 * Indexes are always stored in increasing order because
+	 * routes are added in the order of their registration.
+	 */
+	using indexes_container_t = std::vector< std::size_t >;
+
+	//! Add another route to the index.
+	void
+	add(
+		optional_t< http_method_id_t > method,
+		optional_t< string_view_t > first_segment,
+		std::size_t route_index )
+	{
+		auto & segments = method ?
+				segments_for_method( method->raw_id() ) : m_any_method;
+
+		if( first_segment )
+			segments.indexes_for_segment( *first_segment )
+					.push_back( route_index );
+		else
+			segments.m_any_segment.push_back( route_index );
+	}
+
+	//! Call a lambda for every route that can match a request.
+	/*!
+	 * Routes are enumerated in the order of their registration.
+	 *
+	 * Lambda should have the format:
+	 * @code
+	 * bool lambda(std::size_t route_index);
+	 * @endcode
+	 * If lambda returns `true` the enumeration is stopped.
+	 */
+	template< typename Lambda >
+	void
+	for_each_candidate(
+		http_method_id_t method,
+		string_view_t path,
+		Lambda && lambda ) const
+	{
+		const auto first_segment = first_path_segment_of( path );
+
+		// There can be up to four non-empty buckets for every request:
+		// known method/known segment, known method/any segment,
+		// any method/known segment, any method/any segment.
+		range_t ranges[ 4u ];
+		std::size_t ranges_count{};
+
+		const auto collect = [&]( const segments_index_t & segments ) {
+			if( first_segment )
+				if( const auto * indexes = segments.find_segment( *first_segment ) )
+					ranges[ ranges_count++ ] = range_t{ *indexes };
+			if( !segments.m_any_segment.empty() )
+				ranges[ ranges_count++ ] = range_t{ segments.m_any_segment };
+		};
+
+		if( const auto * segments = find_method( method.raw_id() ) )
+			collect( *segments );
+		collect( m_any_method );
+
+		// Merge sorted sequences of indexes to preserve
+		// the order of registration.
+		for(;;)
+		{
+			range_t * min_range = nullptr;
+			for( std::size_t i = 0u; i != ranges_count; ++i )
+			{
+				auto & r = ranges[ i ];
+				if( r.m_current != r.m_end &&
+						( !min_range || *(r.m_current) < *(min_range->m_current) ) )
+					min_range = &r;
+			}
+
+			if( !min_range )
+				break;
+
+			const auto route_index = *(min_range->m_current);
+			++(min_range->m_current);
+			if( lambda( route_index ) )
+				break;
+		}
+	}
+
+private:
+	//! Routes for one HTTP method grouped by the first segment of path.
+	struct segments_index_t
+	{
+		using by_segment_container_t = std::vector<
+				std::pair< std::string, indexes_container_t > >;
+
+		//! Routes with known first segment.
+		/*!
+		 * This container is sorted by segment value.
+		 */
+		by_segment_container_t m_by_segment;
+
+		//! Routes without known first segment.
+		indexes_container_t m_any_segment;
+
+		template< typename Container >
+		RESTINIO_NODISCARD
+		static auto
+		lower_bound( Container & by_segment, string_view_t segment ) noexcept
+		{
+			return std::lower_bound(
+					by_segment.begin(), by_segment.end(), segment,
+					[]( const auto & item, string_view_t v ) {
+						return string_view_t{ item.first } < v;
+					} );
+		}
+
+		RESTINIO_NODISCARD
+		const indexes_container_t *
+		find_segment( string_view_t segment ) const noexcept
+		{
+			const auto it = lower_bound( m_by_segment, segment );
+			if( it != m_by_segment.end() && segment == it->first )
+				return &(it->second);
+			return nullptr;
+		}
+
+		RESTINIO_NODISCARD
+		indexes_container_t &
+		indexes_for_segment( string_view_t segment )
+		{
+			auto it = lower_bound( m_by_segment, segment );
+			if( it == m_by_segment.end() || segment != it->first )
+				it = m_by_segment.emplace( it,
+						std::string{ segment.data(), segment.size() },
+						indexes_container_t{} );
+			return it->second;
+		}
+	};
+
+	//! A view of one sorted sequence of indexes.
+	struct range_t
+	{
+		indexes_container_t::const_iterator m_current;
+		indexes_container_t::const_iterator m_end;
+
+		range_t() = default;
+
+		range_t( const indexes_container_t & indexes ) noexcept
+			:	m_current{ indexes.begin() }
+			,	m_end{ indexes.end() }
+		{}
+	};
+
+	//! Routes bound to a particular HTTP method.
+	/*!
+	 * This container is sorted by raw_id of HTTP method.
+	 */
+	std::vector< std::pair< int, segments_index_t > > m_by_method;
+
+	//! Routes that can be applied to several HTTP methods.
+	segments_index_t m_any_method;
+
+	RESTINIO_NODISCARD
+	const segments_index_t *
+	find_method( int raw_id ) const noexcept
+	{
+		const auto it = std::lower_bound(
+				m_by_method.begin(), m_by_method.end(), raw_id,
+				[]( const auto & item, int v ) { return item.first < v; } );
+		if( it != m_by_method.end() && raw_id == it->first )
+			return &(it->second);
+		return nullptr;
+	}
+
+	RESTINIO_NODISCARD
+	segments_index_t &
+	segments_for_method( int raw_id )
+	{
+		auto it = std::lower_bound(
+				m_by_method.begin(), m_by_method.end(), raw_id,
+				[]( const auto & item, int v ) { return item.first < v; } );
+		if( it == m_by_method.end() || raw_id != it->first )
+			it = m_by_method.emplace( it, raw_id, segments_index_t{} );
+		return it->second;
+	}
+};
+
 } /* namespace impl */
 
 using namespace restinio::easy_parser;
@@ -701,8 +1186,13 @@ path_to_tuple( Args && ...args )
 			result_tuple_type,
 			subclauses_tuple_type >;
 
+	// NOTE: the literal prefix has to be detected before
+	// args are forwarded to subclauses_tuple_type.
+	auto literal_prefix = impl::detect_route_literal_prefix( args... );
+
 	return producer_type{
-			subclauses_tuple_type{ std::forward<Args>(args)... }
+			subclauses_tuple_type{ std::forward<Args>(args)... },
+			std::move(literal_prefix)
 	};
 }
 
@@ -755,8 +1245,13 @@ path_to_params( Args && ...args )
 			result_tuple_type,
 			subclauses_tuple_type >;
 
+	// NOTE: the literal prefix has to be detected before
+	// args are forwarded to subclauses_tuple_type.
+	auto literal_prefix = impl::detect_route_literal_prefix( args... );
+
 	return producer_type{
-			subclauses_tuple_type{ std::forward<Args>(args)... }
+			subclauses_tuple_type{ std::forward<Args>(args)... },
+			std::move(literal_prefix)
 	};
 }
 
@@ -864,6 +1359,47 @@ unescape()
 	return impl::unescape_transformer_t< Unescape_Traits >{};
 }
 
+//
+// match_stats_t
+//
+/*!
+ * @brief Statistics of matching of one request against routes.
+ *
+ * An instance of that type is passed to match stats listener
+ * (if it is set for a router) after the processing of every request.
+ *
+ * Usage example:
+ * @code
+ * router->match_stats_listener(
+ * 	[](const epr::match_stats_t & stats) {
+ * 		attempts_histogram.add(stats.m_attempts);
+ * 	});
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+struct match_stats_t
+{
+	//! The number of routes a request has been tried against.
+	std::size_t m_attempts;
+
+	//! The total number of routes in the router.
+	std::size_t m_total_routes;
+
+	//! Has a request been matched with a route?
+	bool m_matched;
+};
+
+//
+// match_stats_listener_t
+//
+/*!
+ * @brief Type of listener for match statistics.
+ *
+ * @since v.0.6.14
+ */
+using match_stats_listener_t = std::function< void(const match_stats_t &) >;
+
 } /* namespace easy_parser_router */
 
 //
@@ -976,14 +1512,34 @@ public:
 			path_to_inspect.remove_suffix( 1u );
 
 		target_path_holder_t target_path{ path_to_inspect };
-		for( const auto & entry : m_entries )
-		{
-			const auto r = entry->try_handle( req, target_path );
-			if( r )
-			{
-				return *r;
-			}
-		}
+
+		// Only routes that are applicable to the method and
+		// the first segment of the path are tried.
+		optional_t< request_handling_status_t > result;
+		std::size_t attempts{};
+		m_dispatch_table.for_each_candidate(
+				req->header().method(),
+				// Trailing spaces are ignored by easy_parser::try_parse.
+				restinio::easy_parser::impl::remove_trailing_spaces(
+						target_path.view() ),
+				[&]( std::size_t route_index ) {
+					++attempts;
+					const auto r = m_entries[ route_index ]->try_handle(
+							req, target_path );
+					if( r )
+						result = *r;
+					return static_cast<bool>(r);
+				} );
+
+		if( m_match_stats_listener )
+			m_match_stats_listener( easy_parser_router::match_stats_t{
+					attempts,
+					m_entries.size(),
+					static_cast<bool>(result)
+				} );
+
+		if( result )
+			return *result;
 
 		// Here: none of the routes matches this handler.
 		if( m_non_matched_request_handler )
@@ -1014,12 +1570,37 @@ public:
 		using actual_entry_type = actual_router_entry_t<
 				extra_data_t, producer_type, handler_type >;
 
+		const auto method = known_method_of( method_matcher );
+
+		// NOTE: the first segment is copied because the route
+		// will be moved into the entry.
+		optional_t< std::string > first_segment;
+		if( const auto * literal_prefix = literal_prefix_of( route ) )
+			if( const auto segment = first_path_segment_of( *literal_prefix ) )
+				first_segment = std::string{ segment->data(), segment->size() };
+
 		auto entry = std::make_unique< actual_entry_type >(
 				std::forward<Method_Matcher>(method_matcher),
 				std::forward<Route_Producer>(route),
 				std::forward<Handler>(handler) );
 
 		m_entries.push_back( std::move(entry) );
+
+		// The dispatch table should refer only to existing entries.
+		try
+		{
+			m_dispatch_table.add(
+					method,
+					first_segment ?
+							optional_t< string_view_t >{ *first_segment } :
+							optional_t< string_view_t >{},
+					m_entries.size() - 1u );
+		}
+		catch( ... )
+		{
+			m_entries.pop_back();
+			throw;
+		}
 	}
 
 	//! Set handler for HTTP GET request.
@@ -1095,6 +1676,21 @@ public:
 		m_non_matched_request_handler= std::move( nmrh );
 	}
 
+	//! Set listener for match statistics.
+	/*!
+	 * The listener is called for every request passed to the router.
+	 * It is called before the call of non_matched_request_handler
+	 * (if a request doesn't match any route).
+	 *
+	 * @since v.0.6.14
+	 */
+	void
+	match_stats_listener(
+		easy_parser_router::match_stats_listener_t listener )
+	{
+		m_match_stats_listener = std::move( listener );
+	}
+
 private:
 	using entries_container_t = std::vector<
 			easy_parser_router::impl::router_entry_unique_ptr_t< extra_data_t >
@@ -1102,9 +1698,21 @@ private:
 
 	entries_container_t m_entries;
 
+	//! Index of routes by HTTP method and the first segment of path.
+	/*!
+	 * @since v.0.6.14
+	 */
+	easy_parser_router::impl::route_dispatch_table_t m_dispatch_table;
+
 	//! Handler that is called for requests that don't match any route.
 	generic_non_matched_request_handler_t< extra_data_t >
 			m_non_matched_request_handler;
+
+	//! Listener for match statistics.
+	/*!
+	 * @since v.0.6.14
+	 */
+	easy_parser_router::match_stats_listener_t m_match_stats_listener;
 };
 
 //
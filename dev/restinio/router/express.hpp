@@ -20,8 +20,10 @@
 
 #include <restinio/utils/from_string.hpp>
 #include <restinio/utils/percent_encoding.hpp>
+#include <restinio/utils/impl/small_vector.hpp>
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace restinio
@@ -57,10 +59,21 @@ struct route_params_accessor_t;
 class route_params_t final
 {
 	public:
+		//! The number of parameters that can be stored without
+		//! memory allocation.
+		/*!
+			@since v.0.6.14
+		*/
+		static constexpr std::size_t inline_params_capacity = 4u;
+
 		using named_parameters_container_t =
-			std::vector< std::pair< string_view_t, string_view_t > >;
+			restinio::utils::impl::small_vector_t<
+					std::pair< string_view_t, string_view_t >,
+					inline_params_capacity >;
 		using indexed_parameters_container_t =
-			std::vector< string_view_t >;
+			restinio::utils::impl::small_vector_t<
+					string_view_t,
+					inline_params_capacity >;
 
 	private:
 		friend struct impl::route_params_accessor_t;
@@ -330,6 +343,22 @@ class route_matcher_t
 			route_params_t & parameters ) const
 		{
 			match_results_t matches;
+			return match_route( target_path, parameters, matches );
+		}
+
+		//! Try to match a given request target with this route.
+		/*!
+		 * This version allows to reuse @a matches between several
+		 * match attempts.
+		 *
+		 * @since v.0.6.14
+		 */
+		bool
+		match_route(
+			target_path_holder_t & target_path,
+			route_params_t & parameters,
+			match_results_t & matches ) const
+		{
 			if( Regex_Engine::try_match(
 					target_path.view(),
 					m_route_regex,
@@ -337,57 +366,102 @@ class route_matcher_t
 			{
 				assert( m_param_appender_sequence.size() + 1 >= matches.size() );
 
-				// Data for route_params_t initialization.
+				assign_params( target_path, matches, 0u, parameters );
 
-				auto captured_params = target_path.giveout_data();
+				return true;
+			}
 
-				const string_view_t match{
-					captured_params.get() + Regex_Engine::submatch_begin_pos( matches[0] ),
-					Regex_Engine::submatch_end_pos( matches[0] ) -
-						Regex_Engine::submatch_begin_pos( matches[0] ) } ;
+			return false;
+		}
 
-				route_params_t::named_parameters_container_t named_parameters;
-				route_params_t::indexed_parameters_container_t indexed_parameters;
+		//! Does HTTP method match this route?
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		bool
+		match_method( http_method_id_t method ) const
+		{
+			return m_method_matcher->match( method );
+		}
 
-				route_params_appender_t param_appender{ named_parameters, indexed_parameters };
+		//! Get the number of capture groups for route parameters.
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		std::size_t
+		params_groups_count() const noexcept
+		{
+			return m_param_appender_sequence.size();
+		}
 
-				// Std regex and pcre engines handle
-				// trailing groups with empty values differently.
-				// Std despite they are empty includes them in the list of match results;
-				// Pcre on the other hand does not.
-				// So the second for is for pushing empty values
-				std::size_t i = 1;
-				for( ; i < matches.size(); ++i )
-				{
-					const auto & m = matches[ i ];
-					m_param_appender_sequence[ i - 1](
-						param_appender,
-						string_view_t{
-							captured_params.get() + Regex_Engine::submatch_begin_pos( m ),
-							Regex_Engine::submatch_end_pos( m ) -
-								Regex_Engine::submatch_begin_pos( m ) } );
-				}
+		//! Init route parameters from results of a successful match.
+		/*!
+		 * The submatch with index @a route_group_index should describe
+		 * the whole route. Values of parameters are taken from the
+		 * subsequent submatches.
+		 *
+		 * @note
+		 * Index @a route_group_index is 0 if the route regex is used.
+		 * But it can be greater than 0 if the route is a part of
+		 * a combined regex.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		assign_params(
+			target_path_holder_t & target_path,
+			const match_results_t & matches,
+			std::size_t route_group_index,
+			route_params_t & parameters ) const
+		{
+			// Data for route_params_t initialization.
 
-				for( ; i < m_param_appender_sequence.size() + 1; ++i )
-				{
-					m_param_appender_sequence[ i - 1 ](
-						param_appender,
-						string_view_t{ captured_params.get(), 0 } );
-				}
+			const auto path_size = target_path.view().size();
+			auto captured_params = target_path.giveout_data();
 
-				// Init route parameters.
-				route_params_accessor_t::match(
-						parameters,
-						std::move( captured_params ),
-						m_named_params_buffer, // Do not move (it is used on each match).
-						std::move( match ),
-						std::move( named_parameters ),
-						std::move( indexed_parameters ) );
+			// Submatches for groups that didn't participate in the match
+			// can point outside of the path, they are treated as empty values.
+			const auto make_value = [&]( const auto & m ) {
+				const auto begin = Regex_Engine::submatch_begin_pos( m );
+				const auto end = Regex_Engine::submatch_end_pos( m );
+				if( begin > end || end > path_size )
+					return string_view_t{ captured_params.get(), 0 };
 
-				return true;
+				return string_view_t{ captured_params.get() + begin, end - begin };
+			};
+
+			const string_view_t match = make_value( matches[ route_group_index ] );
+
+			route_params_t::named_parameters_container_t named_parameters;
+			route_params_t::indexed_parameters_container_t indexed_parameters;
+
+			route_params_appender_t param_appender{ named_parameters, indexed_parameters };
+
+			// Std regex and pcre engines handle
+			// trailing groups with empty values differently.
+			// Std despite they are empty includes them in the list of match results;
+			// Pcre on the other hand does not.
+			// So empty values are pushed for missing groups.
+			for( std::size_t i = 0; i < m_param_appender_sequence.size(); ++i )
+			{
+				const auto group_index = route_group_index + 1 + i;
+				m_param_appender_sequence[ i ](
+					param_appender,
+					group_index < matches.size() ?
+						make_value( matches[ group_index ] ) :
+						string_view_t{ captured_params.get(), 0 } );
 			}
 
-			return false;
+			// Init route parameters.
+			route_params_accessor_t::match(
+					parameters,
+					std::move( captured_params ),
+					m_named_params_buffer, // Do not move (it is used on each match).
+					std::move( match ),
+					std::move( named_parameters ),
+					std::move( indexed_parameters ) );
 		}
 
 		inline bool
@@ -400,6 +474,20 @@ class route_matcher_t
 					match_route( target_path, parameters );
 		}
 
+		/*!
+		 * @since v.0.6.14
+		 */
+		inline bool
+		operator () (
+			const http_request_header_t & h,
+			target_path_holder_t & target_path,
+			route_params_t & parameters,
+			match_results_t & matches ) const
+		{
+			return m_method_matcher->match( h.method() ) &&
+					match_route( target_path, parameters, matches );
+		}
+
 	private:
 		//! HTTP method to match.
 		buffered_matcher_holder_t m_method_matcher;
@@ -489,12 +577,15 @@ class generic_express_route_entry_t
 		generic_express_route_entry_t(
 			Method_Matcher && method_matcher,
 			matcher_init_data_t matcher_data,
+			bool is_case_sensitive,
 			actual_request_handler_t handler )
 			:	m_matcher{
 					std::forward<Method_Matcher>( method_matcher ),
 					std::move( matcher_data.m_regex ),
 					std::move( matcher_data.m_named_params_buffer ),
 					std::move( matcher_data.m_param_appender_sequence ) }
+			,	m_regex_source{ std::move( matcher_data.m_regex_source ) }
+			,	m_is_case_sensitive{ is_case_sensitive }
 			,	m_handler{ std::move( handler ) }
 		{}
 
@@ -522,6 +613,7 @@ class generic_express_route_entry_t
 					path2regex::path2regex< impl::route_params_appender_t, Regex_Engine >(
 						route_path,
 						options ),
+					options.sensitive(),
 					std::move( handler ) }
 		{}
 
@@ -549,6 +641,25 @@ class generic_express_route_entry_t
 			return m_matcher( h, target_path, params );
 		}
 
+		//! Checks if request header matches entry,
+		//! and if so, set route params.
+		/*!
+		 * This version allows to reuse @a matches between several
+		 * match attempts.
+		 *
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		bool
+		match(
+			const http_request_header_t & h,
+			impl::target_path_holder_t & target_path,
+			route_params_t & params,
+			typename Regex_Engine::match_results_t & matches ) const
+		{
+			return m_matcher( h, target_path, params, matches );
+		}
+
 		//! Calls a handler of given request with given params.
 		RESTINIO_NODISCARD
 		request_handling_status_t
@@ -557,8 +668,45 @@ class generic_express_route_entry_t
 			return m_handler( std::move( rh ), std::move( rp ) );
 		}
 
+		//! Get access to the matcher of the route.
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		const impl::route_matcher_t< Regex_Engine > &
+		matcher() const noexcept { return m_matcher; }
+
+		//! Get the source of the route regex.
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		const std::string &
+		regex_source() const noexcept { return m_regex_source; }
+
+		//! Should the route regex be case sensitive?
+		/*!
+		 * @since v.0.6.14
+		 */
+		RESTINIO_NODISCARD
+		bool
+		is_case_sensitive() const noexcept { return m_is_case_sensitive; }
+
 	private:
 		impl::route_matcher_t< Regex_Engine > m_matcher;
+
+		//! Source of the route regex.
+		/*!
+		 * @since v.0.6.14
+		 */
+		std::string m_regex_source;
+
+		//! Case sensitivity of the route regex.
+		/*!
+		 * @since v.0.6.14
+		 */
+		bool m_is_case_sensitive{ false };
+
 		actual_request_handler_t m_handler;
 };
 
@@ -577,6 +725,228 @@ using express_route_entry_t = generic_express_route_entry_t<
 		Regex_Engine,
 		no_extra_data_factory_t >;
 
+namespace impl
+{
+
+//
+// combined_route_regex_t
+//
+
+//! A matcher that uses combined regexes for a sequence of routes.
+/*!
+	Regexes of several consecutive routes are joined into one
+	alternation:
+	@code
+	(^route_0_regex)|(^route_1_regex)|...
+	@endcode
+	Every alternative is wrapped into a capture group, so the group
+	that spans the whole match identifies the matched route. Groups
+	of route parameters follow that group.
+
+	Because alternatives are tried in the order of registration the
+	first route that matches the path is found by a single regex match.
+	If HTTP method of the found route doesn't match then the rest of
+	routes are tried one by one (this keeps the order of routes as it
+	is without combined regex).
+
+	Routes are split into several combined regexes if the total number
+	of capture groups exceeds Regex_Engine::max_capture_groups() or if
+	case sensitivity of routes is different.
+
+	Combined regexes are built at the first match attempt. Routes
+	should not be added during the matching.
+
+	@since v.0.6.14
+*/
+template < typename Regex_Engine >
+class combined_route_regex_t
+{
+	public:
+		using regex_t = typename Regex_Engine::compiled_regex_t;
+		using match_results_t = typename Regex_Engine::match_results_t;
+
+		//! Try to find a matching route.
+		/*!
+			@return pointer to the matched entry or nullptr if there is
+			no matching route.
+		*/
+		template < typename Route_Entry >
+		RESTINIO_NODISCARD
+		const Route_Entry *
+		match(
+			const std::vector< Route_Entry > & entries,
+			const http_request_header_t & h,
+			target_path_holder_t & target_path,
+			route_params_t & parameters ) const
+		{
+			std::call_once( m_build_flag, [&]{ build( entries ); } );
+
+			const auto path = target_path.view();
+			match_results_t matches;
+			for( const auto & chunk : m_chunks )
+			{
+				std::size_t next_route = chunk.m_first_route;
+				const std::size_t end_route =
+						chunk.m_first_route + chunk.m_route_groups.size();
+
+				// An empty path can't be handled by combined regex
+				// because positions of unmatched groups are indistinguishable
+				// from an empty match.
+				if( chunk.m_regex && !path.empty() )
+				{
+					if( !Regex_Engine::try_match( path, *chunk.m_regex, matches ) )
+						// There is no matching route in this chunk.
+						continue;
+
+					const auto k = find_matched_route( chunk, matches );
+					if( k < chunk.m_route_groups.size() )
+					{
+						const auto & entry = entries[ chunk.m_first_route + k ];
+						if( entry.matcher().match_method( h.method() ) )
+						{
+							entry.matcher().assign_params(
+									target_path,
+									matches,
+									chunk.m_route_groups[ k ],
+									parameters );
+							return &entry;
+						}
+
+						next_route = chunk.m_first_route + k + 1u;
+					}
+				}
+
+				for( ; next_route < end_route; ++next_route )
+				{
+					const auto & entry = entries[ next_route ];
+					if( entry.match( h, target_path, parameters, matches ) )
+						return &entry;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+		//! A combined regex for a sequence of routes.
+		struct chunk_t
+		{
+			//! Index of the first route in the chunk.
+			std::size_t m_first_route;
+
+			//! Indexes of whole-route groups for every route in the chunk.
+			std::vector< std::size_t > m_route_groups;
+
+			//! Combined regex.
+			/*!
+				It is empty if the combined regex can't be compiled.
+				Routes from the chunk are tried one by one in that case.
+			*/
+			optional_t< regex_t > m_regex;
+		};
+
+		mutable std::once_flag m_build_flag;
+		mutable std::vector< chunk_t > m_chunks;
+
+		RESTINIO_NODISCARD
+		static std::size_t
+		find_matched_route( const chunk_t & chunk, const match_results_t & matches )
+		{
+			const auto & whole = matches[ 0 ];
+
+			// Some engines report unmatched groups as empty groups at
+			// the beginning of the path. So an empty match can't be used
+			// for the detection of the matched route.
+			if( Regex_Engine::submatch_begin_pos( whole ) ==
+					Regex_Engine::submatch_end_pos( whole ) )
+				return chunk.m_route_groups.size();
+
+			std::size_t k = 0;
+			for( ; k < chunk.m_route_groups.size(); ++k )
+			{
+				const auto group = chunk.m_route_groups[ k ];
+				if( group < matches.size() )
+				{
+					const auto & m = matches[ group ];
+					if( Regex_Engine::submatch_begin_pos( m ) ==
+							Regex_Engine::submatch_begin_pos( whole ) &&
+						Regex_Engine::submatch_end_pos( m ) ==
+							Regex_Engine::submatch_end_pos( whole ) )
+						break;
+				}
+			}
+
+			return k;
+		}
+
+		template < typename Route_Entry >
+		void
+		build( const std::vector< Route_Entry > & entries ) const
+		{
+			std::string source;
+			// The group 0 is the whole match.
+			std::size_t groups_count = 1u;
+			bool chunk_started = false;
+
+			const auto finish_chunk = [&] {
+				auto & chunk = m_chunks.back();
+				// A single route can require more groups than the engine
+				// supports because of the additional whole-route group.
+				if( groups_count <= Regex_Engine::max_capture_groups() )
+				{
+					try
+					{
+						chunk.m_regex = Regex_Engine::compile_regex(
+								source,
+								entries[ chunk.m_first_route ].is_case_sensitive() );
+					}
+					catch( const std::exception & )
+					{
+						// Routes from this chunk will be tried one by one.
+					}
+				}
+
+				source.clear();
+				groups_count = 1u;
+				chunk_started = false;
+			};
+
+			for( std::size_t i = 0; i != entries.size(); ++i )
+			{
+				const auto & entry = entries[ i ];
+				const auto route_groups = 1u + entry.matcher().params_groups_count();
+
+				if( chunk_started &&
+					( groups_count + route_groups > Regex_Engine::max_capture_groups() ||
+						entry.is_case_sensitive() !=
+							entries[ m_chunks.back().m_first_route ].is_case_sensitive() ) )
+				{
+					finish_chunk();
+				}
+
+				if( !chunk_started )
+				{
+					m_chunks.push_back( chunk_t{ i, {}, nullopt } );
+					chunk_started = true;
+				}
+				else
+					source += '|';
+
+				m_chunks.back().m_route_groups.push_back( groups_count );
+				groups_count += route_groups;
+
+				source += '(';
+				source += entry.regex_source();
+				source += ')';
+			}
+
+			if( chunk_started )
+				finish_chunk();
+		}
+};
+
+} /* namespace impl */
+
 //
 // generic_express_router_t
 //
@@ -632,11 +1002,25 @@ class generic_express_router_t
 		{
 			impl::target_path_holder_t target_path{ req->header().path() };
 			route_params_t params;
-			for( const auto & entry : m_handlers )
+			if( m_combined_regex )
 			{
-				if( entry.match( req->header(), target_path, params ) )
+				const auto * entry = m_combined_regex->match(
+						m_handlers, req->header(), target_path, params );
+				if( entry )
 				{
-					return entry.handle( std::move( req ), std::move( params ) );
+					return entry->handle( std::move( req ), std::move( params ) );
+				}
+			}
+			else
+			{
+				// Storage for match results is reused between match attempts.
+				typename Regex_Engine::match_results_t matches;
+				for( const auto & entry : m_handlers )
+				{
+					if( entry.match( req->header(), target_path, params, matches ) )
+					{
+						return entry.handle( std::move( req ), std::move( params ) );
+					}
 				}
 			}
 
@@ -681,6 +1065,10 @@ class generic_express_router_t
 					route_path,
 					options,
 					std::move( handler ) );
+
+			// Combined regexes have to be rebuilt to include the new route.
+			if( m_combined_regex )
+				m_combined_regex = std::make_unique< combined_regex_t >();
 		}
 
 		void
@@ -811,15 +1199,63 @@ class generic_express_router_t
 			m_non_matched_request_handler = std::move( nmrh );
 		}
 
+		//! Turn on/off the usage of combined regexes for route matching.
+		/*!
+			When turned on regexes of all routes are joined into one
+			alternation (or into several alternations if the regex engine
+			limits the number of capture groups). It allows to find
+			the matching route by one regex match instead of trying
+			routes one by one.
+
+			The order of routes is preserved: the first route registered
+			that matches the request is selected.
+
+			Combined regexes are built at the first request handled by
+			the router.
+
+			Usage example:
+			@code
+			auto router = std::make_unique< restinio::router::express_router_t<
+					restinio::router::pcre2_regex_engine_t<> > >();
+			router->use_combined_regex( true );
+			router->http_get( "/users/:id", ... );
+			router->http_get( "/books/:id", ... );
+			@endcode
+
+			@note
+			Routes shouldn't be added after the router started to
+			handle requests.
+
+			@since v.0.6.14
+		*/
+		void
+		use_combined_regex( bool enabled )
+		{
+			if( enabled )
+				m_combined_regex = std::make_unique< combined_regex_t >();
+			else
+				m_combined_regex.reset();
+		}
+
 	private:
 		using route_entry_t = generic_express_route_entry_t<
 				Regex_Engine,
 				Extra_Data_Factory
 		>;
 
+		using combined_regex_t = impl::combined_route_regex_t< Regex_Engine >;
+
 		//! A list of existing routes.
 		std::vector< route_entry_t > m_handlers;
 
+		//! Combined regexes for all routes.
+		/*!
+			It is nullptr if combined regexes are not used.
+
+			@since v.0.6.14
+		*/
+		std::unique_ptr< combined_regex_t > m_combined_regex;
+
 		//! Handler that is called for requests that don't match any route.
 		non_matched_handler_t m_non_matched_request_handler;
 };
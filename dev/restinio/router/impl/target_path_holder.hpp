@@ -15,6 +15,7 @@
 
 #include <restinio/string_view.hpp>
 
+#include <algorithm>
 #include <memory>
 
 namespace restinio
@@ -40,6 +41,11 @@ namespace impl
  * target_path `/%7Etest` will be automatically transformed into
  * `/~test`.
  *
+ * Since v.0.6.14 a copy of target_path is made only if the normalization
+ * is necessary or if the data is given out from the holder. Otherwise
+ * the holder refers to the original value of target_path. It means that
+ * the original value should outlive the holder.
+ *
  * @since v.0.6.2
  */
 class target_path_holder_t
@@ -50,10 +56,14 @@ class target_path_holder_t
 		//! Initializing constructor.
 		/*!
 		 * Copies the value of @a original_path into a unique and 
-		 * dynamically allocated array of chars.
+		 * dynamically allocated array of chars if basic URI normalization
+		 * procedure is necessary. The normalization is automatically
+		 * performed in that case.
 		 *
-		 * Basic URI normalization procedure is automatically performed
-		 * if necessary.
+		 * @attention
+		 * If the normalization isn't necessary the holder refers to
+		 * @a original_path. The value of @a original_path should
+		 * outlive the holder.
 		 *
 		 * @note
 		 * Can throws if allocation of new data buffer fails or if
@@ -63,17 +73,17 @@ class target_path_holder_t
 			:	m_size{ restinio::utils::uri_normalization::
 					unreserved_chars::estimate_required_capacity( original_path ) }
 		{
-			m_data.reset( new char[ m_size ] );
-
 			if( m_size != original_path.size() )
+			{
 				// Transformation is actually needed.
+				m_data.reset( new char[ m_size ] );
 				restinio::utils::uri_normalization::unreserved_chars::
 						normalize_to( original_path, m_data.get() );
+				m_view = string_view_t{ m_data.get(), m_size };
+			}
 			else
-				// Just copy original value to the destination.
-				std::copy(
-						original_path.begin(), original_path.end(),
-						m_data.get() );
+				// Original value can be used as is.
+				m_view = original_path;
 		}
 
 		//! Get access to the value of target_path.
@@ -85,7 +95,7 @@ class target_path_holder_t
 		string_view_t
 		view() const noexcept
 		{
-			return { m_data.get(), m_size };
+			return m_view;
 		}
 
 		//! Give out the value from holder.
@@ -93,11 +103,22 @@ class target_path_holder_t
 		 * @attention
 		 * The holder becomes empty after the return from that method and
 		 * should not be used anymore.
+		 *
+		 * @note
+		 * Since v.0.6.14 can throw if a copy of the original value has to be
+		 * made and the allocation of new data buffer fails.
 		 */
 		RESTINIO_NODISCARD
 		data_t
-		giveout_data() noexcept
+		giveout_data()
 		{
+			if( !m_data )
+			{
+				m_data.reset( new char[ m_size ] );
+				std::copy( m_view.begin(), m_view.end(), m_data.get() );
+			}
+
+			m_view = string_view_t{};
 			return std::move(m_data);
 		}
 
@@ -105,11 +126,19 @@ class target_path_holder_t
 		//! Actual data with target_path.
 		/*!
 		 * @note
-		 * It becomes empty after a call to giveout_data().
+		 * It is empty if the normalization wasn't necessary or
+		 * after a call to giveout_data().
 		 */
 		data_t m_data;
 		//! The length of target_path.
 		std::size_t m_size;
+		//! The actual value of target_path.
+		/*!
+		 * Refers to m_data or to the original value.
+		 *
+		 * @since v.0.6.14
+		 */
+		string_view_t m_view;
 };
 
 } /* namespace impl */
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include <pcre2.h>
 
@@ -25,6 +26,77 @@ namespace router
 namespace pcre2_details
 {
 
+//
+// match_data_cache_t
+//
+
+//! A per-thread cache of pcre2 match data blocks.
+/*!
+ * Match data blocks are reused by match_results_t objects created
+ * on the same thread, so there is no allocation for every request.
+ *
+ * @since v.0.6.14
+ */
+template < typename Traits >
+class match_data_cache_t final
+{
+	public:
+		match_data_cache_t() = default;
+
+		match_data_cache_t( const match_data_cache_t & ) = delete;
+		match_data_cache_t & operator = ( const match_data_cache_t & ) = delete;
+
+		~match_data_cache_t()
+		{
+			for( auto * match_data : m_free )
+				pcre2_match_data_free( match_data );
+		}
+
+		//! Get the cache of the current thread.
+		static match_data_cache_t &
+		instance()
+		{
+			static thread_local match_data_cache_t cache;
+			return cache;
+		}
+
+		//! Get a match data block from the cache or create a new one.
+		pcre2_match_data *
+		acquire()
+		{
+			if( m_free.empty() )
+			{
+				auto * match_data = pcre2_match_data_create(
+						Traits::max_capture_groups, nullptr );
+				if( nullptr == match_data )
+					throw exception_t{ "unable to create pcre2 match data" };
+
+				return match_data;
+			}
+
+			auto * match_data = m_free.back();
+			m_free.pop_back();
+			return match_data;
+		}
+
+		//! Return a match data block to the cache.
+		void
+		release( pcre2_match_data * match_data ) noexcept
+		{
+			try
+			{
+				m_free.push_back( match_data );
+			}
+			catch( ... )
+			{
+				pcre2_match_data_free( match_data );
+			}
+		}
+
+	private:
+		std::vector< pcre2_match_data * > m_free;
+};
+
 //
 // match_results_t
 //
@@ -34,14 +106,12 @@ template < typename Traits >
 struct match_results_t final
 {
 	match_results_t()
-	{
-		m_match_data = pcre2_match_data_create( Traits::max_capture_groups, nullptr );
-	}
+		:	m_match_data{ match_data_cache_t< Traits >::instance().acquire() }
+	{}
 
 	~match_results_t()
 	{
-		if( nullptr != m_match_data )
-			pcre2_match_data_free( m_match_data );
+		match_data_cache_t< Traits >::instance().release( m_match_data );
 	}
 
 	match_results_t( const match_results_t & ) = delete;
@@ -60,7 +60,10 @@ struct std_regex_engine_t
 		const compiled_regex_t & r,
 		match_results_t & match_results )
 	{
-		std::cmatch matches;
+		// Storage for submatches is reused between calls.
+		static thread_local std::cmatch matches;
+
+		match_results.clear();
 		if(
 			std::regex_search(
 				target_path.data(),
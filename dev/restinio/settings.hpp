@@ -422,6 +422,125 @@ struct ip_blocker_holder_t< ip_blocker::noop_ip_blocker_t >
 	}
 };
 
+//
+// metrics_holder_t
+//
+/*!
+ * @brief A special class for holding actual metrics object.
+ *
+ * This class holds shared pointer to actual metrics object
+ * and provides an actual implementation of
+ * check_valid_metrics_pointer() method.
+ *
+ * @since v.0.6.14
+ */
+template< typename Metrics >
+struct metrics_holder_t
+{
+	static_assert(
+			noexcept( std::declval<Metrics>().increment(
+					std::declval<metrics::counter_t>(),
+					std::declval<std::uint64_t>() ) ),
+			"Metrics::increment() method should be noexcept" );
+
+	static_assert(
+			noexcept( std::declval<Metrics>().record(
+					std::declval<metrics::histogram_t>(),
+					std::declval<std::chrono::steady_clock::duration>() ) ),
+			"Metrics::record() method should be noexcept" );
+
+	std::shared_ptr< Metrics > m_metrics;
+
+	static constexpr bool has_actual_metrics = true;
+
+	//! Checks that pointer to metrics object is not null.
+	/*!
+	 * Throws an exception if m_metrics is nullptr.
+	 */
+	void
+	check_valid_metrics_pointer() const
+	{
+		if( !m_metrics )
+			throw exception_t{ "metrics object is not specified" };
+	}
+};
+
+/*!
+ * @brief A special class for case when no-op metrics are used.
+ *
+ * Doesn't hold anything and contains empty
+ * check_valid_metrics_pointer() method.
+ *
+ * @since v.0.6.14
+ */
+template<>
+struct metrics_holder_t< metrics::noop_metrics_t >
+{
+	static constexpr bool has_actual_metrics = false;
+
+	void
+	check_valid_metrics_pointer() const
+	{
+		// Nothing to do.
+	}
+};
+
+//
+// request_tracer_holder_t
+//
+/*!
+ * @brief A special class for holding actual request tracer object.
+ *
+ * This class holds shared pointer to actual tracer object
+ * and provides an actual implementation of
+ * check_valid_request_tracer_pointer() method.
+ *
+ * @since v.0.6.14
+ */
+template< typename Tracer >
+struct request_tracer_holder_t
+{
+	static_assert(
+			noexcept( std::declval<Tracer>().on_event(
+					std::declval<const tracing::event_t &>() ) ),
+			"Tracer::on_event() method should be noexcept" );
+
+	std::shared_ptr< Tracer > m_request_tracer;
+
+	static constexpr bool has_actual_request_tracer = true;
+
+	//! Checks that pointer to tracer object is not null.
+	/*!
+	 * Throws an exception if m_request_tracer is nullptr.
+	 */
+	void
+	check_valid_request_tracer_pointer() const
+	{
+		if( !m_request_tracer )
+			throw exception_t{ "request tracer object is not specified" };
+	}
+};
+
+/*!
+ * @brief A special class for case when no-op tracer is used.
+ *
+ * Doesn't hold anything and contains empty
+ * check_valid_request_tracer_pointer() method.
+ *
+ * @since v.0.6.14
+ */
+template<>
+struct request_tracer_holder_t< tracing::noop_tracer_t >
+{
+	static constexpr bool has_actual_request_tracer = false;
+
+	void
+	check_valid_request_tracer_pointer() const
+	{
+		// Nothing to do.
+	}
+};
+
 //
 // acceptor_post_bind_hook_t
 //
@@ -551,6 +670,8 @@ class basic_server_settings_t
 	,	protected connection_state_listener_holder_t<
 			typename Traits::connection_state_listener_t >
 	,	protected ip_blocker_holder_t< typename Traits::ip_blocker_t >
+	,	protected metrics_holder_t< typename Traits::metrics_t >
+	,	protected request_tracer_holder_t< typename Traits::request_tracer_t >
 	,	protected details::max_parallel_connections_holder_t<
 			typename connection_count_limit_types<Traits>::limiter_t >
 {
@@ -569,6 +690,14 @@ class basic_server_settings_t
 						typename Traits::ip_blocker_t
 					>::has_actual_ip_blocker;
 
+		using metrics_holder_t<
+						typename Traits::metrics_t
+					>::has_actual_metrics;
+
+		using request_tracer_holder_t<
+						typename Traits::request_tracer_t
+					>::has_actual_request_tracer;
+
 		using max_parallel_connections_holder_base_t::has_actual_max_parallel_connections;
 
 	public:
@@ -839,6 +968,100 @@ class basic_server_settings_t
 		}
 		//! \}
 
+		//! Max number of concurrent streams on single HTTP/2 connection.
+		/*!
+			The value is advertised to the peer as
+			SETTINGS_MAX_CONCURRENT_STREAMS. Streams above that limit
+			are refused.
+
+			It is used only if Traits::use_http2 is true.
+
+			@since v.0.6.14
+		*/
+		//! \{
+		Derived &
+		http2_max_concurrent_streams( std::size_t v ) &
+		{
+			m_http2_max_concurrent_streams = v;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		http2_max_concurrent_streams( std::size_t v ) &&
+		{
+			return std::move( this->http2_max_concurrent_streams( v ) );
+		}
+
+		std::size_t
+		http2_max_concurrent_streams() const
+		{
+			return m_http2_max_concurrent_streams;
+		}
+		//! \}
+
+		//! A period of inactivity on websocket connection after which
+		//! a ping frame is sent to the peer.
+		/*!
+			A zero value (the default) disables automatic pings.
+
+			The check is performed by the same timer guard that controls
+			other websocket timeouts, so the actual resolution is limited
+			by the check period of the timer manager.
+
+			@since v.0.6.14
+		*/
+		//! \{
+		Derived &
+		websocket_ping_interval( std::chrono::steady_clock::duration d ) &
+		{
+			m_websocket_ping_interval = std::move( d );
+			return reference_to_derived();
+		}
+
+		Derived &&
+		websocket_ping_interval( std::chrono::steady_clock::duration d ) &&
+		{
+			return std::move( this->websocket_ping_interval( std::move( d ) ) );
+		}
+
+		std::chrono::steady_clock::duration
+		websocket_ping_interval() const
+		{
+			return m_websocket_ping_interval;
+		}
+		//! \}
+
+		//! A period of time to wait for a response from the peer
+		//! after an automatic ping was sent.
+		/*!
+			If nothing is received from the peer during that period
+			the websocket connection is treated as dead and is closed.
+
+			Has no effect if websocket_ping_interval() is zero.
+
+			@since v.0.6.14
+		*/
+		//! \{
+		Derived &
+		websocket_pong_timeout( std::chrono::steady_clock::duration d ) &
+		{
+			m_websocket_pong_timeout = std::move( d );
+			return reference_to_derived();
+		}
+
+		Derived &&
+		websocket_pong_timeout( std::chrono::steady_clock::duration d ) &&
+		{
+			return std::move( this->websocket_pong_timeout( std::move( d ) ) );
+		}
+
+		std::chrono::steady_clock::duration
+		websocket_pong_timeout() const
+		{
+			return m_websocket_pong_timeout;
+		}
+		//! \}
+
 
 		//! Request handler.
 		//! \{
@@ -1318,6 +1541,166 @@ class basic_server_settings_t
 			this->check_valid_ip_blocker_pointer();
 		}
 
+		/*!
+		 * @brief Setter for metrics object.
+		 *
+		 * @note metrics() method should be called if
+		 * user specify its type for metrics_t traits.
+		 * For example:
+		 * @code
+		 * struct my_traits_t : public restinio::default_traits_t {
+		 * 	using metrics_t = restinio::metrics::server_metrics_t;
+		 * };
+		 *
+		 * auto metrics = std::make_shared<restinio::metrics::server_metrics_t>();
+		 * restinio::server_setting_t<my_traits_t> settings;
+		 * setting.metrics( metrics );
+		 * ...
+		 * @endcode
+		 *
+		 * @attention This method can't be called if the default no-op
+		 * metrics are used in server traits.
+		 *
+		 * @since v.0.6.14
+		 */
+		Derived &
+		metrics(
+			std::shared_ptr< typename Traits::metrics_t > metrics_object ) &
+		{
+			static_assert(
+					basic_server_settings_t::has_actual_metrics,
+					"metrics(metrics_object) can't be used "
+					"for the default metrics::noop_metrics_t" );
+
+			this->m_metrics = std::move(metrics_object);
+			return reference_to_derived();
+		}
+
+		/*!
+		 * @brief Setter for metrics object.
+		 *
+		 * @since v.0.6.14
+		 */
+		Derived &&
+		metrics(
+			std::shared_ptr< typename Traits::metrics_t > metrics_object ) &&
+		{
+			return std::move(this->metrics(std::move(metrics_object)));
+		}
+
+		/*!
+		 * @brief Get reference to metrics object.
+		 *
+		 * @attention This method can't be called if the default no-op
+		 * metrics are used in server traits.
+		 *
+		 * @since v.0.6.14
+		 */
+		const std::shared_ptr< typename Traits::metrics_t > &
+		metrics() const noexcept
+		{
+			static_assert(
+					basic_server_settings_t::has_actual_metrics,
+					"metrics() can't be used "
+					"for the default metrics::noop_metrics_t" );
+
+			return this->m_metrics;
+		}
+
+		/*!
+		 * @brief Internal method for checking presence of metrics object.
+		 *
+		 * If a user specifies custom metrics type but doesn't
+		 * set a pointer to metrics object that method throws an exception.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		ensure_valid_metrics()
+		{
+			this->check_valid_metrics_pointer();
+		}
+
+		/*!
+		 * @brief Setter for request tracer object.
+		 *
+		 * @note request_tracer() method should be called if
+		 * user specify its type for request_tracer_t traits.
+		 * For example:
+		 * @code
+		 * struct my_traits_t : public restinio::default_traits_t {
+		 * 	using request_tracer_t = restinio::tracing::ring_tracer_t;
+		 * };
+		 *
+		 * auto tracer = std::make_shared<restinio::tracing::ring_tracer_t>(4096u);
+		 * restinio::server_setting_t<my_traits_t> settings;
+		 * setting.request_tracer( tracer );
+		 * ...
+		 * @endcode
+		 *
+		 * @attention This method can't be called if the default no-op
+		 * tracer is used in server traits.
+		 *
+		 * @since v.0.6.14
+		 */
+		Derived &
+		request_tracer(
+			std::shared_ptr< typename Traits::request_tracer_t > tracer ) &
+		{
+			static_assert(
+					basic_server_settings_t::has_actual_request_tracer,
+					"request_tracer(tracer) can't be used "
+					"for the default tracing::noop_tracer_t" );
+
+			this->m_request_tracer = std::move(tracer);
+			return reference_to_derived();
+		}
+
+		/*!
+		 * @brief Setter for request tracer object.
+		 *
+		 * @since v.0.6.14
+		 */
+		Derived &&
+		request_tracer(
+			std::shared_ptr< typename Traits::request_tracer_t > tracer ) &&
+		{
+			return std::move(this->request_tracer(std::move(tracer)));
+		}
+
+		/*!
+		 * @brief Get reference to request tracer object.
+		 *
+		 * @attention This method can't be called if the default no-op
+		 * tracer is used in server traits.
+		 *
+		 * @since v.0.6.14
+		 */
+		const std::shared_ptr< typename Traits::request_tracer_t > &
+		request_tracer() const noexcept
+		{
+			static_assert(
+					basic_server_settings_t::has_actual_request_tracer,
+					"request_tracer() can't be used "
+					"for the default tracing::noop_tracer_t" );
+
+			return this->m_request_tracer;
+		}
+
+		/*!
+		 * @brief Internal method for checking presence of request tracer.
+		 *
+		 * If a user specifies custom tracer type but doesn't
+		 * set a pointer to tracer object that method throws an exception.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		ensure_valid_request_tracer()
+		{
+			this->check_valid_request_tracer_pointer();
+		}
+
 		// Acceptor post-bind hook.
 		/*!
 		 * @brief A setter for post-bind callback.
@@ -1709,6 +2092,24 @@ class basic_server_settings_t
 		//! Max pipelined requests to receive on single connection.
 		std::size_t m_max_pipelined_requests{ 1 };
 
+		//! Max concurrent streams on single HTTP/2 connection.
+		/*!
+		 * @since v.0.6.14
+		 */
+		std::size_t m_http2_max_concurrent_streams{ 100 };
+
+		//! Websocket keep-alive parameters.
+		/*!
+		 * @since v.0.6.14
+		 */
+		//! \{
+		std::chrono::steady_clock::duration
+			m_websocket_ping_interval{ std::chrono::steady_clock::duration::zero() };
+
+		std::chrono::steady_clock::duration
+			m_websocket_pong_timeout{ std::chrono::seconds( 10 ) };
+		//! \}
+
 		//! Request handler.
 		std::unique_ptr< request_handler_t > m_request_handler;
 
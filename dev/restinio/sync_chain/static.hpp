@@ -0,0 +1,181 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Stuff related to static chain of request-headers.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/request_handler.hpp>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace restinio
+{
+
+namespace sync_chain
+{
+
+//
+// static_chain_t
+//
+/*!
+ * @brief A holder of a chain of synchronous handlers whose types are
+ * known at the compile time.
+ *
+ * Unlike fixed_size_chain_t and growable_size_chain_t handlers are
+ * stored by value in a `std::tuple` without wrapping them into
+ * `std::function`. So there is no indirect call and no dynamic memory
+ * allocation, and the whole chain can be inlined by a compiler.
+ *
+ * Handlers are tried in the order of their declaration. The semantics
+ * is the same as for fixed_size_chain_t: the first handler that returns
+ * request_accepted() or request_rejected() stops the chain. If all
+ * handlers return request_not_handled() then request_not_handled() is
+ * returned.
+ *
+ * Because the types of handlers are part of the type of the chain, it
+ * is more convenient to use handlers of named types (function objects):
+ * @code
+ * struct headers_checker {
+ * 	template<typename Request_Handle>
+ * 	restinio::request_handling_status_t
+ * 	operator()(const Request_Handle & req) const {...}
+ * };
+ * struct authentificator {...};
+ * struct actual_handler {...};
+ *
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using request_handler_t = restinio::sync_chain::static_chain_t<
+ * 			headers_checker,
+ * 			authentificator,
+ * 			actual_handler>;
+ * };
+ *
+ * restinio::run(
+ * 	on_thread_pool<my_traits>(16)
+ * 		.address(...)
+ * 		.port(...)
+ * 		.request_handler(
+ * 			headers_checker{...},
+ * 			authentificator{...},
+ * 			actual_handler{...} )
+ * );
+ * @endcode
+ *
+ * Request handle is passed to handlers as is, so the chain can be used
+ * with any extra-data-factory.
+ *
+ * @note
+ * Handlers are called as const objects. It's because a request handler
+ * can be called from several threads at the same time.
+ *
+ * @tparam Handlers Types of handlers in the chain.
+ *
+ * @since v.0.6.14
+ */
+template< typename... Handlers >
+class static_chain_t
+{
+	static_assert( 0u != sizeof...(Handlers),
+			"static_chain_t should contain at least one handler" );
+
+	using handlers_count_t =
+			std::integral_constant< std::size_t, sizeof...(Handlers) >;
+
+	std::tuple< Handlers... > m_handlers;
+
+	template< typename Request_Handle >
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	call_from( const Request_Handle &, handlers_count_t ) const
+	{
+		return request_not_handled();
+	}
+
+	template< typename Request_Handle, std::size_t Index >
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	call_from(
+		const Request_Handle & req,
+		std::integral_constant< std::size_t, Index > ) const
+	{
+		const request_handling_status_t result =
+				std::get< Index >( m_handlers )( req );
+
+		if( request_handling_status_t::not_handled != result )
+			// There is no need to try next handler.
+			return result;
+
+		return call_from( req,
+				std::integral_constant< std::size_t, Index + 1u >{} );
+	}
+
+public:
+	/*!
+	 * @brief Initializing constructor.
+	 *
+	 * A chain should be initialized by handlers at the creation time.
+	 * Because of that static_chain_t isn't a DefaultConstructible type.
+	 */
+	static_chain_t( Handlers... handlers )
+		:	m_handlers{ std::move(handlers)... }
+	{}
+
+	template< typename Request_Handle >
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	operator()( const Request_Handle & req ) const
+	{
+		return call_from( req, std::integral_constant< std::size_t, 0u >{} );
+	}
+};
+
+//
+// make_static_chain
+//
+/*!
+ * @brief A helper for creation of static_chain_t with deduction of
+ * handlers types.
+ *
+ * Usage example:
+ * @code
+ * auto make_chain() {
+ * 	return restinio::sync_chain::make_static_chain(
+ * 			[](const auto & req) {...},
+ * 			[](const auto & req) {...});
+ * }
+ *
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using request_handler_t = decltype(make_chain());
+ * };
+ *
+ * restinio::run(
+ * 	on_thread_pool<my_traits>(16)
+ * 		.address(...)
+ * 		.port(...)
+ * 		.request_handler( make_chain() )
+ * );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+template< typename... Handlers >
+RESTINIO_NODISCARD
+static_chain_t< std::decay_t<Handlers>... >
+make_static_chain( Handlers && ...handlers )
+{
+	return static_chain_t< std::decay_t<Handlers>... >{
+			std::forward<Handlers>(handlers)... };
+}
+
+} /* namespace sync_chain */
+
+} /* namespace restinio */
@@ -9,8 +9,11 @@
 #pragma once
 
 #include <restinio/traits.hpp>
+#include <restinio/settings.hpp>
 #include <restinio/impl/tls_socket.hpp>
 
+#include <cstring>
+
 namespace restinio
 {
 
@@ -344,6 +347,87 @@ make_tls_socket_pointer_for_state_listener(
 	return &socket;
 }
 
+// An overload for the case of TLS-connection.
+/*!
+	@return true if `h2` protocol is selected via ALPN.
+
+	@since v.0.6.14
+*/
+inline bool
+is_http2_negotiated( tls_socket_t & socket ) noexcept
+{
+	const unsigned char * protocol = nullptr;
+	unsigned int length = 0u;
+	SSL_get0_alpn_selected(
+			socket.asio_ssl_stream().native_handle(), &protocol, &length );
+
+	return 2u == length && 0 == std::memcmp( protocol, "h2", 2u );
+}
+
+//! ALPN callback that prefers `h2` protocol to `http/1.1`.
+/*!
+	@since v.0.6.14
+*/
+inline int
+select_alpn_protocol(
+	SSL * /*ssl*/,
+	const unsigned char ** out,
+	unsigned char * outlen,
+	const unsigned char * in,
+	unsigned int inlen,
+	void * /*arg*/ ) noexcept
+{
+	// Protocols in the wire format (RFC 7301, section 3.1).
+	static const unsigned char server_protocols[] = {
+		2u, 'h', '2',
+		8u, 'h', 't', 't', 'p', '/', '1', '.', '1'
+	};
+
+	unsigned char * selected = nullptr;
+	if( OPENSSL_NPN_NEGOTIATED != SSL_select_next_proto(
+			&selected, outlen,
+			server_protocols, sizeof( server_protocols ),
+			in, inlen ) )
+		return SSL_TLSEXT_ERR_NOACK;
+
+	*out = selected;
+	return SSL_TLSEXT_ERR_OK;
+}
+
+//! ALPN isn't used if HTTP/2 support is turned off.
+/*!
+	@since v.0.6.14
+*/
+inline void
+setup_alpn( std::false_type, asio_ns::ssl::context & ) noexcept
+{}
+
+//! Install ALPN callback if HTTP/2 support is turned on.
+/*!
+	@since v.0.6.14
+*/
+inline void
+setup_alpn( std::true_type, asio_ns::ssl::context & tls_context ) noexcept
+{
+	SSL_CTX_set_alpn_select_cb(
+			tls_context.native_handle(), &select_alpn_protocol, nullptr );
+}
+
+//! Setup ALPN for TLS-context with the respect to server's traits.
+/*!
+	@since v.0.6.14
+*/
+template< typename Derived, typename Traits >
+void
+setup_alpn(
+	const basic_server_settings_t< Derived, Traits > & /*settings*/,
+	asio_ns::ssl::context & tls_context ) noexcept
+{
+	setup_alpn(
+			std::integral_constant< bool, Traits::use_http2 >{},
+			tls_context );
+}
+
 //
 // socket_supplier_t
 //
@@ -360,6 +444,8 @@ class socket_supplier_t< tls_socket_t >
 			:	m_tls_context{ settings.giveaway_tls_context() }
 			,	m_io_context{ io_context }
 		{
+			setup_alpn( settings, *m_tls_context );
+
 			m_sockets.reserve( settings.concurrent_accepts_count() );
 
 			while( m_sockets.size() < settings.concurrent_accepts_count() )
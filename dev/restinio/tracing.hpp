@@ -0,0 +1,407 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Stuff related to tracing of request processing stages.
+ *
+ * @since v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/common_types.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/optional.hpp>
+#include <restinio/string_view.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace restinio
+{
+
+namespace tracing
+{
+
+//
+// stage_t
+//
+/*!
+ * @brief Stages of request processing reported to a tracer.
+ *
+ * @since v.0.6.14
+ */
+enum class stage_t : std::uint8_t
+{
+	//! The first byte of a request was read from the socket.
+	/*!
+	 * For a pipelined request that was read together with the previous
+	 * one it is the moment when parsing of that request starts.
+	 */
+	first_byte_read,
+	//! All leading HTTP-fields of a request were parsed.
+	headers_completed,
+	//! The whole request (including its body) was parsed.
+	body_completed,
+	//! The request handler is about to be invoked.
+	handler_invoked,
+	//! A part of the response was passed to the response coordinator.
+	/*!
+	 * This stage can be reported several times for one request
+	 * (e.g. for chunked or user controlled output).
+	 */
+	response_appended,
+	//! The first write operation for the response completed.
+	first_byte_written,
+	//! The last write operation for the response completed.
+	last_byte_written
+};
+
+//! The count of items in stage_t.
+constexpr std::size_t stages_count =
+		static_cast< std::size_t >( stage_t::last_byte_written ) + 1u;
+
+//! Get the name of a stage.
+RESTINIO_NODISCARD
+inline string_view_t
+stage_name( stage_t stage ) noexcept
+{
+	switch( stage )
+	{
+		case stage_t::first_byte_read: return "first_byte_read";
+		case stage_t::headers_completed: return "headers_completed";
+		case stage_t::body_completed: return "body_completed";
+		case stage_t::handler_invoked: return "handler_invoked";
+		case stage_t::response_appended: return "response_appended";
+		case stage_t::first_byte_written: return "first_byte_written";
+		case stage_t::last_byte_written: return "last_byte_written";
+	}
+
+	return "unknown";
+}
+
+//! Clock used for timestamps of tracing events.
+using clock_type_t = std::chrono::steady_clock;
+
+//! Type of timestamp of tracing event.
+using timestamp_t = clock_type_t::time_point;
+
+//
+// event_t
+//
+/*!
+ * @brief Description of one tracing event.
+ *
+ * @since v.0.6.14
+ */
+struct event_t
+{
+	connection_id_t m_connection_id;
+	request_id_t m_request_id;
+	stage_t m_stage;
+	timestamp_t m_timestamp;
+};
+
+//
+// noop_tracer_t
+//
+/*!
+ * @brief The default no-op tracer.
+ *
+ * If this type is used as request_tracer_t in server traits then
+ * RESTinio doesn't even read the clock for tracing purposes.
+ *
+ * @since v.0.6.14
+ */
+struct noop_tracer_t
+{
+	void
+	on_event( const event_t & ) noexcept { /* nothing to do */ }
+};
+
+//
+// request_trace_t
+//
+/*!
+ * @brief Collected stages of one request.
+ *
+ * @since v.0.6.14
+ */
+struct request_trace_t
+{
+	connection_id_t m_connection_id;
+	request_id_t m_request_id;
+	//! Timestamps of stages. If a stage is reported several times
+	//! the first timestamp is stored.
+	std::array< optional_t< timestamp_t >, stages_count > m_stages;
+
+	//! Get the timestamp of a stage (if that stage was recorded).
+	RESTINIO_NODISCARD
+	const optional_t< timestamp_t > &
+	at( stage_t stage ) const noexcept
+	{
+		return m_stages[ static_cast< std::size_t >( stage ) ];
+	}
+
+	//! Time between the first and the last recorded stages.
+	RESTINIO_NODISCARD
+	clock_type_t::duration
+	duration() const noexcept
+	{
+		optional_t< timestamp_t > first;
+		optional_t< timestamp_t > last;
+		for( const auto & ts : m_stages )
+			if( ts )
+			{
+				if( !first || *ts < *first ) first = ts;
+				if( !last || *last < *ts ) last = ts;
+			}
+
+		return first ? *last - *first : clock_type_t::duration::zero();
+	}
+};
+
+//
+// ring_tracer_t
+//
+/*!
+ * @brief A sample tracer that stores the last events into a
+ * fixed-size lock-free ring buffer.
+ *
+ * on_event() only does an atomic increment of the write position and
+ * a few relaxed atomic stores, so it can be called from several I/O
+ * threads without locking. When the ring is full the oldest events are
+ * overwritten.
+ *
+ * Every slot is protected by a sequence number, so a reader skips
+ * slots that are being modified. Please note that a slot can be
+ * damaged if two writers that are exactly `capacity` events apart
+ * modify it at the same time. It is very unlikely for a reasonable
+ * capacity and tolerable for a diagnostic tool.
+ *
+ * Usage example:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using request_tracer_t = restinio::tracing::ring_tracer_t;
+ * };
+ * ...
+ * auto tracer = std::make_shared< restinio::tracing::ring_tracer_t >( 65536u );
+ * restinio::run(
+ * 	restinio::on_thread_pool< my_traits >( 4 )
+ * 		.request_tracer( tracer )
+ * 		...
+ * 	);
+ * ...
+ * tracer->dump_slow_requests( std::cerr, std::chrono::milliseconds(100) );
+ * @endcode
+ *
+ * @since v.0.6.14
+ */
+class ring_tracer_t
+{
+	public:
+		//! Initializing constructor.
+		/*!
+		 * @note @a capacity is rounded up to the power of two.
+		 */
+		ring_tracer_t( std::size_t capacity )
+			:	m_slots( round_up_capacity( capacity ) )
+			,	m_mask{ m_slots.size() - 1u }
+		{}
+
+		ring_tracer_t( const ring_tracer_t & ) = delete;
+		ring_tracer_t & operator=( const ring_tracer_t & ) = delete;
+
+		//! Capacity of the ring.
+		RESTINIO_NODISCARD
+		std::size_t
+		capacity() const noexcept { return m_slots.size(); }
+
+		//! Store a new event.
+		void
+		on_event( const event_t & event ) noexcept
+		{
+			const auto pos = m_next_position.fetch_add(
+					1u, std::memory_order_relaxed );
+			auto & slot = m_slots[ pos & m_mask ];
+
+			slot.m_sequence.store( 2u * pos + 1u, std::memory_order_relaxed );
+			std::atomic_thread_fence( std::memory_order_release );
+
+			slot.m_connection_id.store(
+					event.m_connection_id, std::memory_order_relaxed );
+			slot.m_request_id.store(
+					event.m_request_id, std::memory_order_relaxed );
+			slot.m_stage.store(
+					event.m_stage, std::memory_order_relaxed );
+			slot.m_timestamp.store(
+					event.m_timestamp.time_since_epoch().count(),
+					std::memory_order_relaxed );
+
+			slot.m_sequence.store( 2u * pos + 2u, std::memory_order_release );
+		}
+
+		//! Get all events stored in the ring in order of their arrival.
+		RESTINIO_NODISCARD
+		std::vector< event_t >
+		events() const
+		{
+			std::vector< std::pair< std::uint64_t, event_t > > sequenced;
+			sequenced.reserve( m_slots.size() );
+
+			for( const auto & slot : m_slots )
+			{
+				const auto seq = slot.m_sequence.load( std::memory_order_acquire );
+				if( 0u == seq || 0u != ( seq & 1u ) )
+					continue;
+
+				const event_t event{
+						slot.m_connection_id.load( std::memory_order_relaxed ),
+						slot.m_request_id.load( std::memory_order_relaxed ),
+						slot.m_stage.load( std::memory_order_relaxed ),
+						timestamp_t{ clock_type_t::duration{
+								slot.m_timestamp.load( std::memory_order_relaxed ) } }
+					};
+
+				std::atomic_thread_fence( std::memory_order_acquire );
+				if( seq == slot.m_sequence.load( std::memory_order_relaxed ) )
+					sequenced.emplace_back( seq, event );
+			}
+
+			std::sort( sequenced.begin(), sequenced.end(),
+					[]( const auto & a, const auto & b ) {
+						return a.first < b.first;
+					} );
+
+			std::vector< event_t > result;
+			result.reserve( sequenced.size() );
+			for( const auto & p : sequenced )
+				result.push_back( p.second );
+
+			return result;
+		}
+
+		//! Get traces of requests that took at least @a threshold.
+		/*!
+		 * Only events that are still in the ring are taken into account.
+		 * Traces are ordered by connection and request ids.
+		 */
+		RESTINIO_NODISCARD
+		std::vector< request_trace_t >
+		slow_requests( clock_type_t::duration threshold ) const
+		{
+			using key_t = std::pair< connection_id_t, request_id_t >;
+			std::map< key_t, request_trace_t > traces;
+
+			for( const auto & e : events() )
+			{
+				auto it = traces.find( key_t{ e.m_connection_id, e.m_request_id } );
+				if( traces.end() == it )
+					it = traces.emplace(
+							key_t{ e.m_connection_id, e.m_request_id },
+							request_trace_t{ e.m_connection_id, e.m_request_id, {} } )
+						.first;
+
+				auto & ts = it->second.m_stages[
+						static_cast< std::size_t >( e.m_stage ) ];
+				if( !ts )
+					ts = e.m_timestamp;
+			}
+
+			std::vector< request_trace_t > result;
+			for( auto & t : traces )
+				if( t.second.duration() >= threshold )
+					result.push_back( t.second );
+
+			return result;
+		}
+
+		//! Print traces of requests that took at least @a threshold.
+		/*!
+		 * Every trace is printed as a line with connection and request ids,
+		 * the total duration and offsets of every recorded stage from
+		 * the first one (in microseconds).
+		 */
+		void
+		dump_slow_requests(
+			std::ostream & to,
+			clock_type_t::duration threshold ) const
+		{
+			for( const auto & trace : slow_requests( threshold ) )
+			{
+				optional_t< timestamp_t > first;
+				for( const auto & ts : trace.m_stages )
+					if( ts && ( !first || *ts < *first ) )
+						first = ts;
+
+				fmt::memory_buffer line;
+				fmt::format_to( std::back_inserter( line ),
+						"[connection:{}] request #{}: {}us",
+						trace.m_connection_id,
+						trace.m_request_id,
+						to_microseconds( trace.duration() ) );
+
+				for( std::size_t i = 0u; i != stages_count; ++i )
+					if( trace.m_stages[ i ] )
+						fmt::format_to( std::back_inserter( line ),
+								" {}=+{}us",
+								stage_name( static_cast< stage_t >( i ) ),
+								to_microseconds( *trace.m_stages[ i ] - *first ) );
+
+				to.write( line.data(),
+						static_cast< std::streamsize >( line.size() ) );
+				to << '\n';
+			}
+		}
+
+	private:
+		//! One slot of the ring.
+		struct slot_t
+		{
+			std::atomic< std::uint64_t > m_sequence{ 0u };
+			std::atomic< connection_id_t > m_connection_id{ 0u };
+			std::atomic< request_id_t > m_request_id{ 0u };
+			std::atomic< stage_t > m_stage{ stage_t::first_byte_read };
+			std::atomic< clock_type_t::rep > m_timestamp{ 0 };
+		};
+
+		static std::size_t
+		round_up_capacity( std::size_t capacity )
+		{
+			if( !capacity )
+				throw exception_t{ "capacity of ring_tracer can't be zero" };
+
+			std::size_t result = 1u;
+			while( result < capacity )
+				result <<= 1u;
+
+			return result;
+		}
+
+		static double
+		to_microseconds( clock_type_t::duration d ) noexcept
+		{
+			return std::chrono::duration< double, std::micro >( d ).count();
+		}
+
+		std::vector< slot_t > m_slots;
+		const std::size_t m_mask;
+		std::atomic< std::uint64_t > m_next_position{ 0u };
+};
+
+} /* namespace tracing */
+
+} /* namespace restinio */
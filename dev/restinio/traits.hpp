@@ -13,6 +13,9 @@
 #include <restinio/null_logger.hpp>
 #include <restinio/connection_state_listener.hpp>
 #include <restinio/ip_blocker.hpp>
+#include <restinio/metrics.hpp>
+#include <restinio/tracing.hpp>
+#include <restinio/http_parser_backend.hpp>
 #include <restinio/default_strands.hpp>
 #include <restinio/connection_count_limiter.hpp>
 
@@ -246,6 +249,89 @@ struct traits_t
 	 */
 	using ip_blocker_t = ip_blocker::noop_ip_blocker_t;
 
+	/*!
+	 * @brief A type for server metrics.
+	 *
+	 * By default RESTinio doesn't collect any metrics. But if a user
+	 * specifies its type of metrics object then RESTinio will update
+	 * that object on every accepted connection, read and write operation,
+	 * request handler call and so on.
+	 *
+	 * The metrics type should have the following methods:
+	 * @code
+	 * void increment(restinio::metrics::counter_t counter,
+	 * 		std::uint64_t value) noexcept;
+	 * void record(restinio::metrics::histogram_t histogram,
+	 * 		std::chrono::steady_clock::duration value) noexcept;
+	 * @endcode
+	 * Those methods are called on I/O threads, so they should be cheap.
+	 * There is a ready to use restinio::metrics::server_metrics_t type.
+	 *
+	 * An example:
+	 * @code
+	 * struct my_server_traits : public restinio::default_traits_t {
+	 * 	using metrics_t = restinio::metrics::server_metrics_t;
+	 * };
+	 * @endcode
+	 *
+	 * @since v.0.6.14
+	 */
+	using metrics_t = metrics::noop_metrics_t;
+
+	/*!
+	 * @brief A type for tracing stages of request processing.
+	 *
+	 * By default RESTinio doesn't trace anything. If a user specifies
+	 * its type of tracer then every connection reports the following
+	 * stages of every request: the first byte read, headers completed,
+	 * body completed, handler invoked, response appended to the response
+	 * coordinator, the first and the last byte of the response written.
+	 *
+	 * The tracer type should have the following method:
+	 * @code
+	 * void on_event(const restinio::tracing::event_t & event) noexcept;
+	 * @endcode
+	 * That method is called on I/O threads, so it should be cheap.
+	 * There is a ready to use restinio::tracing::ring_tracer_t type.
+	 *
+	 * An example:
+	 * @code
+	 * struct my_server_traits : public restinio::default_traits_t {
+	 * 	using request_tracer_t = restinio::tracing::ring_tracer_t;
+	 * };
+	 * @endcode
+	 *
+	 * @since v.0.6.14
+	 */
+	using request_tracer_t = tracing::noop_tracer_t;
+
+	/*!
+	 * @brief A type of parser for incoming HTTP/1.x requests.
+	 *
+	 * By default RESTinio uses nodejs/http_parser. There is also
+	 * restinio::http_parser_backend::fast_backend_t that parses the whole
+	 * header block in one pass with the help of SIMD instructions.
+	 *
+	 * An example:
+	 * @code
+	 * struct my_server_traits : public restinio::default_traits_t {
+	 * 	using http_parser_backend_t =
+	 * 			restinio::http_parser_backend::fast_backend_t;
+	 * };
+	 * @endcode
+	 *
+	 * The interface of a backend is described in
+	 * restinio::http_parser_backend::nodejs_backend_t.
+	 *
+	 * @note
+	 * Methods are reported by parser backends as values of
+	 * nodejs/http_parser's http_method, so http_methods_mapper_t is used
+	 * with any backend.
+	 *
+	 * @since v.0.6.14
+	 */
+	using http_parser_backend_t = http_parser_backend::nodejs_backend_t;
+
 	using timer_manager_t = Timer_Manager;
 	using logger_t = Logger;
 	using request_handler_t = Request_Handler;
@@ -277,6 +363,42 @@ struct traits_t
 	 */
 	static constexpr bool use_connection_count_limiter = false;
 
+	/*!
+	 * @brief A flag that enables or disables the support of HTTP/2.
+	 *
+	 * By default RESTinio answers HTTP/2 clients that HTTP/1.1 is
+	 * required. But the support of HTTP/2 can be turned on explicitly:
+	 * @code
+	 * struct my_traits : public restinio::default_traits_t {
+	 * 	static constexpr bool use_http2 = true;
+	 * };
+	 * @endcode
+	 * In that case a connection is switched to HTTP/2 if:
+	 *
+	 * - a client with prior knowledge of HTTP/2 support (h2c) sends
+	 *   the HTTP/2 connection preface;
+	 * - the protocol `h2` is negotiated via ALPN during TLS handshake
+	 *   (the server prefers `h2` to `http/1.1`).
+	 *
+	 * Every HTTP/2 stream is passed to the request handler as an ordinary
+	 * request with HTTP version 2.0. Responses are created by the usual
+	 * response builders.
+	 *
+	 * The support of HTTP/2 is minimal and has the following limitations:
+	 *
+	 * - sendfile operations aren't supported, a stream with such
+	 *   a response is reset;
+	 * - request tracer isn't informed about HTTP/2 requests;
+	 * - priorities are ignored, server push isn't used;
+	 * - requests for an upgrade to h2c are answered as HTTP/1.1 requests.
+	 *
+	 * The number of concurrent streams on a connection is limited
+	 * by `http2_max_concurrent_streams` server setting.
+	 *
+	 * @since v.0.6.14
+	 */
+	static constexpr bool use_http2 = false;
+
 	/*!
 	 * @brief The type of extra-data-factory.
 	 *
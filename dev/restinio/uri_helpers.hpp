@@ -10,6 +10,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <cstdint>
 
 #include <restinio/impl/include_fmtlib.hpp>
 
@@ -17,6 +18,10 @@
 #include <restinio/utils/percent_encoding.hpp>
 #include <restinio/optional.hpp>
 
+#if !defined( RESTINIO_QUERY_STRING_PARAMS_INDEX_THRESHOLD )
+	#define RESTINIO_QUERY_STRING_PARAMS_INDEX_THRESHOLD 16
+#endif
+
 namespace restinio
 {
 
@@ -32,6 +37,24 @@ modified_memchr( int chr , const char * from, const char * to )
 	return result ? result : to;
 }
 
+//! Hash function for names of query string parameters (FNV-1a).
+/*!
+ * @since v.0.6.14
+ */
+RESTINIO_NODISCARD
+inline std::uint32_t
+query_param_name_hash( string_view_t name ) noexcept
+{
+	std::uint32_t result = 2166136261u;
+	for( const auto ch : name )
+	{
+		result ^= static_cast< unsigned char >( ch );
+		result *= 16777619u;
+	}
+
+	return result;
+}
+
 } /* namespace impl */
 
 //
@@ -39,11 +62,23 @@ modified_memchr( int chr , const char * from, const char * to )
 //
 
 //! Parameters container for query strings parameters.
+/*!
+	Since v.0.6.14 a hash index of parameters is built if the count of
+	parameters is not less than RESTINIO_QUERY_STRING_PARAMS_INDEX_THRESHOLD.
+	It makes the search of a parameter independent of the count of
+	parameters. Definition of RESTINIO_QUERY_STRING_PARAMS_INDEX_THRESHOLD
+	as 0 disables the index.
+*/
 class query_string_params_t final
 {
 	public:
 		using parameters_container_t = std::vector< std::pair< string_view_t, string_view_t > >;
 
+		//! The min count of parameters for building the index.
+		//! @since v.0.6.14
+		static constexpr std::size_t index_threshold =
+				RESTINIO_QUERY_STRING_PARAMS_INDEX_THRESHOLD;
+
 		//! Constructor for the case when query string empty of
 		//! contains a set of key-value pairs.
 		query_string_params_t(
@@ -51,7 +86,10 @@ class query_string_params_t final
 			parameters_container_t parameters )
 			:	m_data_buffer{ std::move( data_buffer ) }
 			,	m_parameters{ std::move( parameters ) }
-		{}
+		{
+			if( 0u != index_threshold && m_parameters.size() >= index_threshold )
+				build_index();
+		}
 
 		//! Constructor for the case when query string contains only tag
 		//! (web beacon).
@@ -130,10 +168,63 @@ class query_string_params_t final
 		*/
 		auto tag() const noexcept { return m_tag; }
 
+		//! Is the hash index of parameters built?
+		//! @since v.0.6.14
+		bool has_index() const noexcept { return !m_index.empty(); }
+
 	private:
+		//! Build the hash index of parameters.
+		/*!
+			The size of the index is a power of 2 and is at least twice
+			as big as the count of parameters. Only the first occurrence
+			of every name gets into the index, so the search via the index
+			gives the same result as the linear search.
+
+			@since v.0.6.14
+		*/
+		void
+		build_index()
+		{
+			std::size_t index_size = 4u;
+			while( index_size < m_parameters.size() * 2u )
+				index_size *= 2u;
+
+			m_index.resize( index_size, 0u );
+			const std::size_t mask = index_size - 1u;
+
+			for( std::size_t i = 0u; i != m_parameters.size(); ++i )
+			{
+				const auto & name = m_parameters[ i ].first;
+				std::size_t slot = impl::query_param_name_hash( name ) & mask;
+				for(; 0u != m_index[ slot ]; slot = ( slot + 1u ) & mask )
+				{
+					if( name == m_parameters[ m_index[ slot ] - 1u ].first )
+						break;
+				}
+
+				if( 0u == m_index[ slot ] )
+					m_index[ slot ] = static_cast< std::uint32_t >( i + 1u );
+			}
+		}
+
 		parameters_container_t::const_iterator
 		find_parameter( string_view_t key ) const noexcept
 		{
+			if( !m_index.empty() )
+			{
+				const std::size_t mask = m_index.size() - 1u;
+				for( std::size_t slot = impl::query_param_name_hash( key ) & mask;
+						0u != m_index[ slot ];
+						slot = ( slot + 1u ) & mask )
+				{
+					const auto it = m_parameters.begin() + ( m_index[ slot ] - 1u );
+					if( key == it->first )
+						return it;
+				}
+
+				return m_parameters.end();
+			}
+
 			return
 				std::find_if(
 					m_parameters.begin(),
@@ -163,6 +254,16 @@ class query_string_params_t final
 		std::unique_ptr< char[] > m_data_buffer;
 		parameters_container_t m_parameters;
 
+		//! Hash index of parameters.
+		/*!
+			Contains positions of parameters in m_parameters increased
+			by 1 (0 means an empty slot). It is empty if the index
+			isn't built.
+
+			@since v.0.6.14
+		*/
+		std::vector< std::uint32_t > m_index;
+
 		//! Tag (or web beacon) part.
 		/*! @since v.0.4.9 */
 		optional_t< string_view_t > m_tag;
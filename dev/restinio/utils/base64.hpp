@@ -12,6 +12,7 @@
 #include <restinio/expected.hpp>
 
 #include <restinio/utils/impl/bitops.hpp>
+#include <restinio/utils/impl/base64_simd.hpp>
 
 #include <restinio/impl/include_fmtlib.hpp>
 
@@ -119,11 +120,29 @@ sixbits_char( uint_type_t bs )
 	return ::restinio::utils::impl::bitops::n_bits_from< char, Shift, 6 >(bs);
 }
 
-inline std::string
-encode( string_view_t str )
+//! The size of base64 representation of @a size bytes.
+/*!
+	@since v.0.6.14
+*/
+RESTINIO_NODISCARD
+constexpr std::size_t
+encoded_size( std::size_t size ) noexcept
 {
-	std::string result;
+	return ( size + 2u ) / 3u * 4u;
+}
+
+//! Encode @a str into a buffer provided by a caller.
+/*!
+	@a dest should have space for at least encoded_size(str.size()) chars.
+	The result isn't null-terminated.
+
+	@return the count of chars written to @a dest.
 
+	@since v.0.6.14
+*/
+inline std::size_t
+encode_to( string_view_t str, char * dest ) noexcept
+{
 	const auto at = [&str](auto index) { return uch(str[index]); };
 
 	const auto alphabet_char = [](auto ch) {
@@ -135,17 +154,19 @@ encode( string_view_t str )
 	constexpr std::size_t group_size = 3u;
 	const auto remaining = str.size() % group_size;
 
-	result.reserve( (str.size()/group_size + (remaining ? 1:0)) * 4 );
+	// The most part of data is processed by vectorized code (if possible).
+	std::size_t i = ::restinio::utils::impl::base64_simd::encode_blocks(
+			str.data(), str.size() - remaining, dest );
+	char * out = dest + i / group_size * 4u;
 
-	std::size_t i = 0;
 	for(; i < str.size() - remaining; i += group_size )
 	{
 		uint_type_t bs = (at(i) << 16) | (at(i+1) << 8) | at(i+2);
 
-		result.push_back( alphabet_char( sixbits_char<18>(bs) ) );
-		result.push_back( alphabet_char( sixbits_char<12>(bs) ) );
-		result.push_back( alphabet_char( sixbits_char<6>(bs) ) );
-		result.push_back( alphabet_char( sixbits_char<0>(bs) ) );
+		*out++ = alphabet_char( sixbits_char<18>(bs) );
+		*out++ = alphabet_char( sixbits_char<12>(bs) );
+		*out++ = alphabet_char( sixbits_char<6>(bs) );
+		*out++ = alphabet_char( sixbits_char<0>(bs) );
 	}
 
 	if( remaining )
@@ -154,23 +175,32 @@ encode( string_view_t str )
 		if( 1u == remaining )
 		{
 			uint_type_t bs = (at(i) << 16);
-			result.push_back( alphabet_char( sixbits_char<18>(bs) ) );
-			result.push_back( alphabet_char( sixbits_char<12>(bs) ) );
+			*out++ = alphabet_char( sixbits_char<18>(bs) );
+			*out++ = alphabet_char( sixbits_char<12>(bs) );
 
-			result.push_back('=');
+			*out++ = '=';
 		}
 		else
 		{
 			uint_type_t bs = (at(i) << 16) | (at(i+1) << 8);
 
-			result.push_back( alphabet_char( sixbits_char<18>(bs) ) );
-			result.push_back( alphabet_char( sixbits_char<12>(bs) ) );
-			result.push_back( alphabet_char( sixbits_char<6>(bs) ) );
+			*out++ = alphabet_char( sixbits_char<18>(bs) );
+			*out++ = alphabet_char( sixbits_char<12>(bs) );
+			*out++ = alphabet_char( sixbits_char<6>(bs) );
 		}
 
-		result.push_back('=');
+		*out++ = '=';
 	}
 
+	return static_cast< std::size_t >( out - dest );
+}
+
+inline std::string
+encode( string_view_t str )
+{
+	std::string result( encoded_size( str.size() ), '\0' );
+	encode_to( str, &result[ 0 ] );
+
 	return result;
 }
 
@@ -180,16 +210,35 @@ enum class decoding_error_t
 	invalid_base64_sequence
 };
 
-inline expected_t< std::string, decoding_error_t >
-try_decode( string_view_t str )
+//! The max size of data represented by @a size base64 chars.
+/*!
+	The actual size can be less by 1 or 2 bytes because of padding.
+
+	@since v.0.6.14
+*/
+RESTINIO_NODISCARD
+constexpr std::size_t
+max_decoded_size( std::size_t size ) noexcept
 {
-	if( !is_valid_base64_string( str ) )
-		return make_unexpected( decoding_error_t::invalid_base64_sequence );
+	return size / 4u * 3u;
+}
 
+//! Decode @a str into a buffer provided by a caller.
+/*!
+	@a dest should have space for at least max_decoded_size(str.size())
+	bytes. The content of @a dest after the decoded data is unspecified.
+
+	@return the count of decoded bytes.
+
+	@since v.0.6.14
+*/
+inline expected_t< std::size_t, decoding_error_t >
+try_decode_to( string_view_t str, char * dest ) noexcept
+{
 	constexpr std::size_t group_size = 4;
 
-	std::string result;
-	result.reserve( (str.size() / group_size) * 3 );
+	if( str.size() < group_size || 0u != str.size() % group_size )
+		return make_unexpected( decoding_error_t::invalid_base64_sequence );
 
 	const unsigned char * const decode_table = base64_decode_lut< unsigned char >();
 
@@ -197,8 +246,26 @@ try_decode( string_view_t str )
 		return static_cast<unsigned char>(str[index]);
 	};
 
-	for( size_t i = 0 ; i < str.size(); i += group_size)
+	// Because '=' is a part of base64_chars, it should be checked
+	// individually.
+	const auto is_b64ch = [&str](auto index) {
+		return '=' != str[index] && is_base64_char( str[index] );
+	};
+
+	// The most part of data is processed by vectorized code (if possible).
+	// Vectorized code stops on the first block with invalid chars or
+	// padding, all the rest is checked here.
+	std::size_t i = ::restinio::utils::impl::base64_simd::decode_blocks(
+			str.data(), str.size(), dest );
+	char * out = dest + i / group_size * 3u;
+
+	for( ; i < str.size(); i += group_size)
 	{
+		// Padding is allowed only at the end.
+		const bool is_last_group = i + group_size == str.size();
+
+		if( !is_b64ch(i) || !is_b64ch(i+1) )
+			return make_unexpected( decoding_error_t::invalid_base64_sequence );
 
 		uint_type_t bs{};
 		int paddings_found = 0u;
@@ -209,38 +276,58 @@ try_decode( string_view_t str )
 		bs |= decode_table[ at(i+1) ];
 
 		bs <<= 6;
-		if( '=' == str[i+2] )
+		if( is_last_group && '=' == str[i+2] )
 		{
+			if( '=' != str[i+3] )
+				return make_unexpected( decoding_error_t::invalid_base64_sequence );
 			++paddings_found;
 		}
-		else
+		else if( is_b64ch(i+2) )
 		{
 			bs |= decode_table[ at(i+2) ];
 		}
+		else
+			return make_unexpected( decoding_error_t::invalid_base64_sequence );
 
 		bs <<= 6;
-		if( '=' == str[i+3] )
+		if( is_last_group && '=' == str[i+3] )
 		{
 			++paddings_found;
 		}
-		else
+		else if( is_b64ch(i+3) )
 		{
 			bs |= decode_table[ at(i+3) ];
 		}
+		else
+			return make_unexpected( decoding_error_t::invalid_base64_sequence );
 
 		using ::restinio::utils::impl::bitops::n_bits_from;
 
-		result.push_back( n_bits_from< char, 16 >(bs) );
+		*out++ = n_bits_from< char, 16 >(bs);
 		if( paddings_found < 2 )
 		{
-			result.push_back( n_bits_from< char, 8 >(bs) );
+			*out++ = n_bits_from< char, 8 >(bs);
 		}
 		if( paddings_found < 1 )
 		{
-			result.push_back( n_bits_from< char, 0 >(bs) );
+			*out++ = n_bits_from< char, 0 >(bs);
 		}
 	}
 
+	return static_cast< std::size_t >( out - dest );
+}
+
+inline expected_t< std::string, decoding_error_t >
+try_decode( string_view_t str )
+{
+	std::string result( max_decoded_size( str.size() ), '\0' );
+
+	const auto decoded = try_decode_to( str, &result[ 0 ] );
+	if( !decoded )
+		return make_unexpected( decoded.error() );
+
+	result.resize( *decoded );
+
 	return result;
 }
 
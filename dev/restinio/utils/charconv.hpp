@@ -0,0 +1,593 @@
+/*
+	restinio
+*/
+
+/*!
+	Locale-independent conversions between numbers and chars.
+
+	The interface mimics std::from_chars() and std::to_chars() from C++17
+	(only decimal representation is supported).
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/string_view.hpp>
+
+#include <restinio/impl/include_fmtlib.hpp>
+
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if !defined(RESTINIO_NO_STD_FLOAT_FROM_CHARS) && defined(__has_include)
+	#if __has_include(<charconv>) && \
+			( __cplusplus >= 201703L || \
+				( defined(_MSVC_LANG) && _MSVC_LANG >= 201703L ) )
+		#include <charconv>
+		#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+			#define RESTINIO_HAS_STD_FLOAT_FROM_CHARS
+		#endif
+	#endif
+#endif
+
+namespace restinio
+{
+
+namespace utils
+{
+
+//! The result of from_chars().
+struct from_chars_result_t
+{
+	//! Pointer to the first char that isn't a part of the value.
+	const char * ptr;
+	//! Error code (a value-initialized std::errc means success).
+	std::errc ec;
+};
+
+//! The result of to_chars().
+struct to_chars_result_t
+{
+	//! Pointer to the char right after the written value.
+	char * ptr;
+	//! Error code (a value-initialized std::errc means success).
+	std::errc ec;
+};
+
+namespace charconv_details
+{
+
+RESTINIO_NODISCARD
+constexpr bool
+is_digit( char ch ) noexcept
+{
+	return '0' <= ch && ch <= '9';
+}
+
+//
+// integer_from_chars
+//
+template< typename Integer >
+RESTINIO_NODISCARD
+from_chars_result_t
+integer_from_chars(
+	const char * first, const char * last, Integer & value ) noexcept
+{
+	using unsigned_t = typename std::make_unsigned< Integer >::type;
+
+	const char * p = first;
+	bool negative = false;
+	if( p != last )
+	{
+		if( '-' == *p )
+		{
+			if( !std::is_signed< Integer >::value )
+				return { first, std::errc::invalid_argument };
+			negative = true;
+			++p;
+		}
+		else if( '+' == *p )
+			++p;
+	}
+
+	// The absolute value of the min value is greater than the max value
+	// by one for signed types.
+	const unsigned_t limit = static_cast< unsigned_t >(
+			static_cast< unsigned_t >( std::numeric_limits< Integer >::max() ) +
+			( negative ? 1u : 0u ) );
+
+	const char * const digits_begin = p;
+	unsigned_t result = 0u;
+	bool overflow = false;
+	for( ; p != last && is_digit( *p ); ++p )
+	{
+		const unsigned_t digit = static_cast< unsigned_t >( *p - '0' );
+		if( result > ( limit - digit ) / 10u )
+			overflow = true;
+		else
+			result = static_cast< unsigned_t >( result * 10u + digit );
+	}
+
+	if( digits_begin == p )
+		return { first, std::errc::invalid_argument };
+
+	if( overflow )
+		return { p, std::errc::result_out_of_range };
+
+	if( negative && 0u != result )
+		// Written this way to avoid overflow for the min value.
+		value = static_cast< Integer >(
+				-static_cast< Integer >( result - 1u ) - 1 );
+	else
+		value = static_cast< Integer >( result );
+
+	return { p, std::errc{} };
+}
+
+//
+// scan_float
+//
+//! Find the end of a floating point value.
+/*!
+	The format is `digits[.[digits]][(e|E)[+|-]digits]` or
+	`.digits[(e|E)[+|-]digits]`, the sign should be handled by a caller.
+
+	@return nullptr if there is no value at @a first.
+*/
+RESTINIO_NODISCARD
+inline const char *
+scan_float( const char * first, const char * last ) noexcept
+{
+	const char * p = first;
+	for( ; p != last && is_digit( *p ); ++p ) {}
+	bool has_digits = p != first;
+
+	if( p != last && '.' == *p )
+	{
+		const char * const fraction_begin = ++p;
+		for( ; p != last && is_digit( *p ); ++p ) {}
+		has_digits = has_digits || p != fraction_begin;
+	}
+
+	if( !has_digits )
+		return nullptr;
+
+	// An exponent is a part of the value only if it has digits.
+	if( p != last && ( 'e' == *p || 'E' == *p ) )
+	{
+		const char * e = p + 1;
+		if( e != last && ( '+' == *e || '-' == *e ) )
+			++e;
+		if( e != last && is_digit( *e ) )
+			for( p = e; p != last && is_digit( *p ); ++p ) {}
+	}
+
+	return p;
+}
+
+//! Exact powers of 10 for the fast path of conversion.
+template< typename Float >
+struct fast_path_traits_t;
+
+template<>
+struct fast_path_traits_t< double >
+{
+	static constexpr int max_exponent = 22;
+	static constexpr std::uint64_t max_mantissa = std::uint64_t{1} << 53;
+
+	static double
+	power_of_10( int e ) noexcept
+	{
+		static constexpr double powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		return powers[ e ];
+	}
+};
+
+template<>
+struct fast_path_traits_t< float >
+{
+	static constexpr int max_exponent = 10;
+	static constexpr std::uint64_t max_mantissa = std::uint64_t{1} << 24;
+
+	static float
+	power_of_10( int e ) noexcept
+	{
+		static constexpr float powers[] = {
+			1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+		return powers[ e ];
+	}
+};
+
+//
+// try_fast_float_conversion
+//
+//! Conversion for values that can be computed exactly.
+/*!
+	If both the mantissa and the power of 10 are exactly representable
+	by @a Float then a single multiplication or division gives the
+	correctly rounded result (Clinger's fast path).
+
+	@return false if the fast path isn't applicable.
+*/
+template< typename Float >
+RESTINIO_NODISCARD
+bool
+try_fast_float_conversion(
+	const char * first, const char * last, Float & value ) noexcept
+{
+#if defined(FLT_EVAL_METHOD) && 0 == FLT_EVAL_METHOD
+	using traits_t = fast_path_traits_t< Float >;
+
+	// 19 decimal digits always fit into 64 bits.
+	constexpr int max_digits = 19;
+
+	std::uint64_t mantissa = 0u;
+	int digits = 0;
+	int exponent = 0;
+	bool in_fraction = false;
+
+	const char * p = first;
+	for( ; p != last; ++p )
+	{
+		if( '.' == *p )
+		{
+			in_fraction = true;
+			continue;
+		}
+		if( !is_digit( *p ) )
+			break;
+
+		if( 0u == mantissa && '0' == *p )
+		{
+			// Leading zeros aren't significant.
+			if( in_fraction )
+				--exponent;
+			continue;
+		}
+		if( max_digits == digits )
+			return false;
+
+		mantissa = mantissa * 10u + static_cast< unsigned >( *p - '0' );
+		++digits;
+		if( in_fraction )
+			--exponent;
+	}
+
+	if( p != last )
+	{
+		// It's an exponent.
+		++p;
+		bool negative_exponent = false;
+		if( '+' == *p || '-' == *p )
+			negative_exponent = '-' == *p++;
+
+		int explicit_exponent = 0;
+		for( ; p != last; ++p )
+		{
+			// Big exponents aren't handled by the fast path anyway.
+			if( explicit_exponent > 10000 )
+				return false;
+			explicit_exponent = explicit_exponent * 10 + ( *p - '0' );
+		}
+
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+	}
+
+	if( 0u == mantissa )
+	{
+		value = Float{};
+		return true;
+	}
+
+	if( mantissa > traits_t::max_mantissa ||
+			exponent > traits_t::max_exponent ||
+			exponent < -traits_t::max_exponent )
+		return false;
+
+	value = static_cast< Float >( mantissa );
+	if( exponent < 0 )
+		value /= traits_t::power_of_10( -exponent );
+	else
+		value *= traits_t::power_of_10( exponent );
+
+	return true;
+#else
+	(void)first;
+	(void)last;
+	(void)value;
+	return false;
+#endif
+}
+
+//! There is no fast path for long double.
+inline bool
+try_fast_float_conversion(
+	const char *, const char *, long double & ) noexcept
+{
+	return false;
+}
+
+//
+// float_from_chars
+//
+template< typename Float >
+RESTINIO_NODISCARD
+from_chars_result_t
+float_from_chars(
+	const char * first, const char * last, Float & value )
+{
+	const char * p = first;
+	bool negative = false;
+	if( p != last && ( '-' == *p || '+' == *p ) )
+		negative = '-' == *p++;
+
+	const char * const end = scan_float( p, last );
+	if( !end )
+		return { first, std::errc::invalid_argument };
+
+#if defined(RESTINIO_HAS_STD_FLOAT_FROM_CHARS)
+	// std::from_chars() handles the minus itself but not the plus.
+	const auto r = std::from_chars( negative ? p - 1 : p, end, value );
+	return { r.ptr, r.ec };
+#else
+	Float result{};
+	if( !try_fast_float_conversion( p, end, result ) )
+	{
+		// Values that require arbitrary-precision arithmetic are
+		// handled by the standard library in the classic locale.
+		std::istringstream stream{ std::string{ p, end } };
+		stream.imbue( std::locale::classic() );
+		stream >> result;
+		if( stream.fail() )
+			return { end, std::errc::result_out_of_range };
+	}
+
+	value = negative ? -result : result;
+	return { end, std::errc{} };
+#endif
+}
+
+template< typename Integer >
+RESTINIO_NODISCARD
+constexpr bool
+is_negative( Integer value, std::true_type /* is signed */ ) noexcept
+{
+	return value < 0;
+}
+
+template< typename Integer >
+RESTINIO_NODISCARD
+constexpr bool
+is_negative( Integer, std::false_type /* is signed */ ) noexcept
+{
+	return false;
+}
+
+//
+// integer_to_chars
+//
+template< typename Integer >
+RESTINIO_NODISCARD
+to_chars_result_t
+integer_to_chars( char * first, char * last, Integer value ) noexcept
+{
+	using unsigned_t = typename std::make_unsigned< Integer >::type;
+
+	static constexpr char digit_pairs[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	const bool negative = is_negative(
+			value, typename std::is_signed< Integer >::type{} );
+	unsigned_t u = negative ?
+			static_cast< unsigned_t >( 0u - static_cast< unsigned_t >( value ) ) :
+			static_cast< unsigned_t >( value );
+
+	// Digits are written from the end, two at a time.
+	std::array< char, std::numeric_limits< unsigned_t >::digits10 + 1 > digits;
+	char * d = digits.data() + digits.size();
+	while( u >= 100u )
+	{
+		const auto pair = static_cast< std::size_t >( u % 100u ) * 2u;
+		u = static_cast< unsigned_t >( u / 100u );
+		*(--d) = digit_pairs[ pair + 1u ];
+		*(--d) = digit_pairs[ pair ];
+	}
+	if( u >= 10u )
+	{
+		const auto pair = static_cast< std::size_t >( u ) * 2u;
+		*(--d) = digit_pairs[ pair + 1u ];
+		*(--d) = digit_pairs[ pair ];
+	}
+	else
+		*(--d) = static_cast< char >( '0' + u );
+
+	const auto digits_count =
+			static_cast< std::size_t >( digits.data() + digits.size() - d );
+	if( static_cast< std::size_t >( last - first ) <
+			digits_count + ( negative ? 1u : 0u ) )
+		return { last, std::errc::value_too_large };
+
+	if( negative )
+		*first++ = '-';
+	std::memcpy( first, d, digits_count );
+
+	return { first + digits_count, std::errc{} };
+}
+
+//
+// float_to_chars
+//
+template< typename Float >
+RESTINIO_NODISCARD
+to_chars_result_t
+float_to_chars( char * first, char * last, Float value )
+{
+	// fmtlib produces the shortest representation that can be read back
+	// without a loss of precision and doesn't depend on the locale.
+	const auto capacity = static_cast< std::size_t >( last - first );
+	const auto r = fmt::format_to_n( first, capacity, "{}", value );
+	if( r.size > capacity )
+		return { last, std::errc::value_too_large };
+
+	return { r.out, std::errc{} };
+}
+
+} /* namespace charconv_details */
+
+//
+// from_chars
+//
+//! Read an integer value from [first, last).
+/*!
+	Unlike std::from_chars() a leading plus sign is allowed.
+
+	@return a pointer to the first char after the value and an error
+	code (std::errc::invalid_argument if there is no value at @a first,
+	std::errc::result_out_of_range if the value doesn't fit into
+	@a Integer). @a value isn't modified in the case of an error.
+
+	@since v.0.6.14
+*/
+template< typename Integer >
+RESTINIO_NODISCARD
+typename std::enable_if<
+		std::is_integral< Integer >::value &&
+				!std::is_same< Integer, bool >::value,
+		from_chars_result_t >::type
+from_chars( const char * first, const char * last, Integer & value ) noexcept
+{
+	return charconv_details::integer_from_chars( first, last, value );
+}
+
+//! Read a floating point value from [first, last).
+/*!
+	Only the decimal representation is supported (without "inf" and
+	"nan"). Unlike std::from_chars() a leading plus sign is allowed.
+
+	std::from_chars() is used if it is available. Otherwise values
+	that can be computed exactly are converted without allocations
+	and all other values are converted by the standard library
+	in the classic locale.
+
+	@since v.0.6.14
+*/
+template< typename Float >
+RESTINIO_NODISCARD
+typename std::enable_if<
+		std::is_floating_point< Float >::value,
+		from_chars_result_t >::type
+from_chars( const char * first, const char * last, Float & value )
+{
+	return charconv_details::float_from_chars( first, last, value );
+}
+
+//
+// to_chars
+//
+//! Write the decimal representation of an integer value.
+/*!
+	@return a pointer to the char after the written value or @a last
+	and std::errc::value_too_large if there isn't enough space.
+
+	@since v.0.6.14
+*/
+template< typename Integer >
+RESTINIO_NODISCARD
+typename std::enable_if<
+		std::is_integral< Integer >::value &&
+				!std::is_same< Integer, bool >::value,
+		to_chars_result_t >::type
+to_chars( char * first, char * last, Integer value ) noexcept
+{
+	return charconv_details::integer_to_chars( first, last, value );
+}
+
+//! Write the shortest representation of a floating point value.
+/*!
+	@since v.0.6.14
+*/
+template< typename Float >
+RESTINIO_NODISCARD
+typename std::enable_if<
+		std::is_floating_point< Float >::value,
+		to_chars_result_t >::type
+to_chars( char * first, char * last, Float value )
+{
+	return charconv_details::float_to_chars( first, last, value );
+}
+
+//
+// number_chars_t
+//
+//! The textual representation of a number in an internal buffer.
+/*!
+	Intended to be used for building headers and bodies without
+	temporary strings:
+	@code
+	resp.append_header( "X-Items-Count",
+			restinio::utils::number_to_chars( items.size() ).str() );
+	@endcode
+
+	@since v.0.6.14
+*/
+class number_chars_t
+{
+	//! Enough for any integer and for the shortest representation
+	//! of any floating point value.
+	std::array< char, 64 > m_buffer;
+	std::size_t m_size;
+
+public:
+	template< typename Number >
+	explicit number_chars_t( Number value )
+	{
+		const auto r = to_chars(
+				m_buffer.data(), m_buffer.data() + m_buffer.size(), value );
+		m_size = static_cast< std::size_t >( r.ptr - m_buffer.data() );
+	}
+
+	RESTINIO_NODISCARD
+	string_view_t
+	view() const noexcept { return { m_buffer.data(), m_size }; }
+
+	RESTINIO_NODISCARD
+	std::string
+	str() const { return { m_buffer.data(), m_size }; }
+};
+
+//! Make the textual representation of a number.
+/*!
+	@since v.0.6.14
+*/
+template< typename Number >
+RESTINIO_NODISCARD
+number_chars_t
+number_to_chars( Number value )
+{
+	return number_chars_t{ value };
+}
+
+} /* namespace utils */
+
+} /* namespace restinio */
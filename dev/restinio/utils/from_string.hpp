@@ -8,18 +8,16 @@
 
 #pragma once
 
-#include <cctype>
 #include <string>
-#include <limits>
 #include <stdexcept>
-#include <algorithm>
+#include <type_traits>
 
 #include <restinio/impl/include_fmtlib.hpp>
 
 #include <restinio/string_view.hpp>
 #include <restinio/exception.hpp>
 
-#include "from_string_details.ipp"
+#include <restinio/utils/charconv.hpp>
 
 namespace restinio
 {
@@ -27,77 +25,71 @@ namespace restinio
 namespace utils
 {
 
-//! Read int values.
-//! \{
-
-inline void
-read_value( std::int64_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::int64_parse_traits_t >( data, data + size );
-}
-
-inline void
-read_value( std::uint64_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::uint64_parse_traits_t >( data, data + size );
-}
-
-inline void
-read_value( std::int32_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::int32_parse_traits_t >( data, data + size );
-}
-
-inline void
-read_value( std::uint32_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::uint32_parse_traits_t >( data, data + size );
-}
-
-inline void
-read_value( std::int16_t & v, const char * data, std::size_t size )
+namespace details
 {
-	v = details::parse_integer< details::int16_parse_traits_t >( data, data + size );
-}
 
-inline void
-read_value( std::uint16_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::uint16_parse_traits_t >( data, data + size );
-}
+//! Read a number and throw on failure.
+/*!
+	The whole string should be occupied by the value.
 
-inline void
-read_value( std::int8_t & v, const char * data, std::size_t size )
-{
-	v = details::parse_integer< details::int8_parse_traits_t >( data, data + size );
-}
+	@throw std::out_of_range if the value doesn't fit into @a Number.
+	@throw exception_t for all other errors.
 
-inline void
-read_value( std::uint8_t & v, const char * data, std::size_t size )
+	@since v.0.6.14
+*/
+template< typename Number >
+void
+read_number( Number & v, const char * data, std::size_t size )
 {
-	v = details::parse_integer< details::uint8_parse_traits_t >( data, data + size );
+	const auto type_name = []() -> std::string {
+		if( std::is_same< Number, float >::value )
+			return "float";
+		if( std::is_same< Number, double >::value )
+			return "double";
+		if( std::is_same< Number, long double >::value )
+			return "long double";
+
+		return fmt::format( "{}int{}_t",
+				std::is_signed< Number >::value ? "" : "u",
+				sizeof( Number ) * 8u );
+	};
+
+	if( 0u == size )
+		throw exception_t{
+			fmt::format( "invalid {} value: empty string", type_name() ) };
+
+	const char * const last = data + size;
+	const auto r = from_chars( data, last, v );
+	if( std::errc::result_out_of_range == r.ec )
+		throw std::out_of_range{
+			fmt::format( "invalid {} value: out of range", type_name() ) };
+
+	if( std::errc{} != r.ec || last != r.ptr )
+		throw exception_t{
+			fmt::format( "invalid {} value: invalid representation",
+					type_name() ) };
 }
-//! \}
 
+} /* namespace details */
 
-//! Read float values.
-//! \{
-inline void
-read_value( float & v, const char * data, std::size_t size )
-{
-	std::string buf{ data, size };
-
-	v = std::stof( buf );
-}
+//! Read numeric values.
+/*!
+	Since v.0.6.14 values of all integral and floating point types are
+	read by locale-independent utils::from_chars() without
+	allocations (except the rare case of floating point values which
+	can't be converted exactly without std::from_chars() support).
 
-inline void
-read_value( double & v, const char * data, std::size_t size )
+	@throw std::out_of_range if the value doesn't fit into @a Number.
+	@throw exception_t for all other errors.
+*/
+template< typename Number >
+typename std::enable_if<
+		std::is_arithmetic< Number >::value &&
+				!std::is_same< Number, bool >::value >::type
+read_value( Number & v, const char * data, std::size_t size )
 {
-	std::string buf{ data, size };
-
-	v = std::stod( buf );
+	details::read_number( v, data, size );
 }
-//! \}
 
 //! Get a value from string.
 template < typename Value_Type >
@@ -0,0 +1,501 @@
+/*
+	restinio
+*/
+
+/*!
+	Vectorized parts of base64 encoding and decoding.
+
+	On x86/x86_64 with GCC or Clang the code for SSSE3 and AVX2 is always
+	compiled and the best instruction set is selected at run-time.
+	With other compilers SSSE3 or AVX2 is used only if it is enabled
+	for the whole translation unit (e.g. /arch:AVX2 for MSVC).
+
+	Definition of RESTINIO_BASE64_NO_SIMD disables vectorized code.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(RESTINIO_BASE64_NO_SIMD)
+	#if (defined(__GNUC__) || defined(__clang__)) && \
+			(defined(__x86_64__) || defined(__i386__))
+		#include <immintrin.h>
+		#define RESTINIO_BASE64_SIMD_RUNTIME_DISPATCH
+		#define RESTINIO_BASE64_SIMD_SSSE3
+		#define RESTINIO_BASE64_SIMD_AVX2
+		#define RESTINIO_BASE64_SIMD_TARGET( isa ) __attribute__(( target( isa ) ))
+	#elif defined(__AVX2__)
+		#include <immintrin.h>
+		#define RESTINIO_BASE64_SIMD_SSSE3
+		#define RESTINIO_BASE64_SIMD_AVX2
+		#define RESTINIO_BASE64_SIMD_TARGET( isa )
+	#elif defined(__SSSE3__)
+		#include <tmmintrin.h>
+		#define RESTINIO_BASE64_SIMD_SSSE3
+		#define RESTINIO_BASE64_SIMD_TARGET( isa )
+	#endif
+#endif
+
+namespace restinio
+{
+
+namespace utils
+{
+
+namespace impl
+{
+
+namespace base64_simd
+{
+
+//! Instruction sets that can be used for base64.
+enum class instruction_set_t
+{
+	scalar,
+	ssse3,
+	avx2
+};
+
+//! Detect the best instruction set available.
+RESTINIO_NODISCARD
+inline instruction_set_t
+detect_instruction_set() noexcept
+{
+#if defined(RESTINIO_BASE64_SIMD_RUNTIME_DISPATCH)
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports( "avx2" ) )
+		return instruction_set_t::avx2;
+	if( __builtin_cpu_supports( "ssse3" ) )
+		return instruction_set_t::ssse3;
+	return instruction_set_t::scalar;
+#elif defined(RESTINIO_BASE64_SIMD_AVX2)
+	return instruction_set_t::avx2;
+#elif defined(RESTINIO_BASE64_SIMD_SSSE3)
+	return instruction_set_t::ssse3;
+#else
+	return instruction_set_t::scalar;
+#endif
+}
+
+//! The instruction set used for base64.
+/*!
+	Detection is performed only once.
+*/
+RESTINIO_NODISCARD
+inline instruction_set_t
+instruction_set() noexcept
+{
+	static const instruction_set_t result = detect_instruction_set();
+	return result;
+}
+
+//! The name of the instruction set used for base64.
+RESTINIO_NODISCARD
+inline const char *
+instruction_set_name() noexcept
+{
+	switch( instruction_set() )
+	{
+		case instruction_set_t::avx2: return "avx2";
+		case instruction_set_t::ssse3: return "ssse3";
+		case instruction_set_t::scalar: break;
+	}
+
+	return "scalar";
+}
+
+#if defined(RESTINIO_BASE64_SIMD_SSSE3)
+
+//
+// SSSE3
+//
+// Encoding and decoding are made by the algorithms of Wojciech Mula
+// (http://0x80.pl/articles/index.html#base64-algorithm-new).
+//
+
+//! Convert 12 bytes from the beginning of @a in to 16 base64 chars.
+RESTINIO_BASE64_SIMD_TARGET( "ssse3" )
+inline __m128i
+encode_block_ssse3( __m128i in ) noexcept
+{
+	// Every 3 bytes are placed to 4 bytes: [b1, b0, b2, b1].
+	in = _mm_shuffle_epi8( in, _mm_setr_epi8(
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 ) );
+
+	// Extraction of 6-bit indexes.
+	const __m128i t0 = _mm_and_si128( in, _mm_set1_epi32( 0x0fc0fc00 ) );
+	const __m128i t1 = _mm_mulhi_epu16( t0, _mm_set1_epi32( 0x04000040 ) );
+	const __m128i t2 = _mm_and_si128( in, _mm_set1_epi32( 0x003f03f0 ) );
+	const __m128i t3 = _mm_mullo_epi16( t2, _mm_set1_epi32( 0x01000010 ) );
+	const __m128i indexes = _mm_or_si128( t1, t3 );
+
+	// Translation of indexes to chars: an offset is added to every index.
+	// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+	__m128i offset_index = _mm_subs_epu8( indexes, _mm_set1_epi8( 51 ) );
+	offset_index = _mm_or_si128( offset_index, _mm_and_si128(
+			_mm_cmpgt_epi8( _mm_set1_epi8( 26 ), indexes ),
+			_mm_set1_epi8( 13 ) ) );
+
+	const __m128i offsets = _mm_setr_epi8(
+			'a' - 26,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'+' - 62, '/' - 63, 'A', 0, 0 );
+
+	return _mm_add_epi8(
+			_mm_shuffle_epi8( offsets, offset_index ), indexes );
+}
+
+//! Encode as many 12-byte blocks as possible.
+/*!
+	@return the count of encoded bytes from @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "ssse3" )
+inline std::size_t
+encode_blocks_ssse3(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+	// 16 bytes are loaded but only 12 of them are used.
+	for( ; size - processed >= 16u; processed += 12u, dest += 16 )
+	{
+		_mm_storeu_si128(
+				reinterpret_cast< __m128i * >( dest ),
+				encode_block_ssse3( _mm_loadu_si128(
+						reinterpret_cast< const __m128i * >( src + processed ) ) ) );
+	}
+
+	return processed;
+}
+
+//! Convert 16 base64 chars to 12 bytes.
+/*!
+	16 bytes are written to @a dest, the last 4 of them are garbage.
+
+	@return false if there is an invalid char (including '=') in @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "ssse3" )
+inline bool
+decode_block_ssse3( const char * src, char * dest ) noexcept
+{
+	const __m128i in = _mm_loadu_si128(
+			reinterpret_cast< const __m128i * >( src ) );
+
+	const __m128i nibble_mask = _mm_set1_epi8( 0x0f );
+	const __m128i hi_nibbles = _mm_and_si128(
+			_mm_srli_epi32( in, 4 ), nibble_mask );
+	const __m128i lo_nibbles = _mm_and_si128( in, nibble_mask );
+
+	// A char is valid if its bits in both tables do not intersect.
+	const __m128i lo_bits = _mm_shuffle_epi8( _mm_setr_epi8(
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a ), lo_nibbles );
+	const __m128i hi_bits = _mm_shuffle_epi8( _mm_setr_epi8(
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 ), hi_nibbles );
+	if( _mm_movemask_epi8( _mm_cmpgt_epi8(
+			_mm_and_si128( lo_bits, hi_bits ), _mm_setzero_si128() ) ) )
+		return false;
+
+	// Translation of chars to 6-bit values.
+	const __m128i is_slash = _mm_cmpeq_epi8( in, _mm_set1_epi8( '/' ) );
+	const __m128i offsets = _mm_shuffle_epi8( _mm_setr_epi8(
+			0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 ),
+			_mm_add_epi8( is_slash, hi_nibbles ) );
+	const __m128i values = _mm_add_epi8( in, offsets );
+
+	// Packing of 6-bit values.
+	const __m128i merged_pairs = _mm_maddubs_epi16(
+			values, _mm_set1_epi32( 0x01400140 ) );
+	const __m128i merged = _mm_madd_epi16(
+			merged_pairs, _mm_set1_epi32( 0x00011000 ) );
+
+	_mm_storeu_si128(
+			reinterpret_cast< __m128i * >( dest ),
+			_mm_shuffle_epi8( merged, _mm_setr_epi8(
+					2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) ) );
+
+	return true;
+}
+
+//! Decode as many 16-char blocks as possible.
+/*!
+	At least one group of 4 chars is always left for the scalar code
+	because it can contain padding. Decoding stops on the first block
+	with invalid chars.
+
+	@return the count of decoded chars from @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "ssse3" )
+inline std::size_t
+decode_blocks_ssse3(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+	// Garbage bytes written by decode_block_ssse3() should be
+	// inside the space required for the remaining data.
+	for( ; size - processed >= 24u; processed += 16u, dest += 12 )
+	{
+		if( !decode_block_ssse3( src + processed, dest ) )
+			break;
+	}
+
+	return processed;
+}
+
+#endif
+
+#if defined(RESTINIO_BASE64_SIMD_AVX2)
+
+//
+// AVX2
+//
+// The same algorithms as for SSSE3, but two 128-bit lanes are
+// processed at once.
+//
+
+RESTINIO_BASE64_SIMD_TARGET( "avx2" )
+inline __m256i
+encode_block_avx2( __m256i in ) noexcept
+{
+	in = _mm256_shuffle_epi8( in, _mm256_setr_epi8(
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 ) );
+
+	const __m256i t0 = _mm256_and_si256( in, _mm256_set1_epi32( 0x0fc0fc00 ) );
+	const __m256i t1 = _mm256_mulhi_epu16( t0, _mm256_set1_epi32( 0x04000040 ) );
+	const __m256i t2 = _mm256_and_si256( in, _mm256_set1_epi32( 0x003f03f0 ) );
+	const __m256i t3 = _mm256_mullo_epi16( t2, _mm256_set1_epi32( 0x01000010 ) );
+	const __m256i indexes = _mm256_or_si256( t1, t3 );
+
+	__m256i offset_index = _mm256_subs_epu8( indexes, _mm256_set1_epi8( 51 ) );
+	offset_index = _mm256_or_si256( offset_index, _mm256_and_si256(
+			_mm256_cmpgt_epi8( _mm256_set1_epi8( 26 ), indexes ),
+			_mm256_set1_epi8( 13 ) ) );
+
+	const __m256i offsets = _mm256_setr_epi8(
+			'a' - 26,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'+' - 62, '/' - 63, 'A', 0, 0,
+			'a' - 26,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'+' - 62, '/' - 63, 'A', 0, 0 );
+
+	return _mm256_add_epi8(
+			_mm256_shuffle_epi8( offsets, offset_index ), indexes );
+}
+
+//! Encode as many 24-byte blocks as possible.
+/*!
+	@return the count of encoded bytes from @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "avx2" )
+inline std::size_t
+encode_blocks_avx2(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+	// Every lane gets 12 bytes (16 bytes are loaded for every lane).
+	for( ; size - processed >= 28u; processed += 24u, dest += 32 )
+	{
+		const char * from = src + processed;
+		const __m256i in = _mm256_inserti128_si256(
+				_mm256_castsi128_si256( _mm_loadu_si128(
+						reinterpret_cast< const __m128i * >( from ) ) ),
+				_mm_loadu_si128(
+						reinterpret_cast< const __m128i * >( from + 12 ) ),
+				1 );
+
+		_mm256_storeu_si256(
+				reinterpret_cast< __m256i * >( dest ),
+				encode_block_avx2( in ) );
+	}
+
+	return processed;
+}
+
+//! Convert 32 base64 chars to 24 bytes.
+/*!
+	32 bytes are written to @a dest, the last 8 of them are garbage.
+
+	@return false if there is an invalid char (including '=') in @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "avx2" )
+inline bool
+decode_block_avx2( const char * src, char * dest ) noexcept
+{
+	const __m256i in = _mm256_loadu_si256(
+			reinterpret_cast< const __m256i * >( src ) );
+
+	const __m256i nibble_mask = _mm256_set1_epi8( 0x0f );
+	const __m256i hi_nibbles = _mm256_and_si256(
+			_mm256_srli_epi32( in, 4 ), nibble_mask );
+	const __m256i lo_nibbles = _mm256_and_si256( in, nibble_mask );
+
+	const __m256i lo_bits = _mm256_shuffle_epi8( _mm256_setr_epi8(
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a ), lo_nibbles );
+	const __m256i hi_bits = _mm256_shuffle_epi8( _mm256_setr_epi8(
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 ), hi_nibbles );
+	if( _mm256_movemask_epi8( _mm256_cmpgt_epi8(
+			_mm256_and_si256( lo_bits, hi_bits ), _mm256_setzero_si256() ) ) )
+		return false;
+
+	const __m256i is_slash = _mm256_cmpeq_epi8( in, _mm256_set1_epi8( '/' ) );
+	const __m256i offsets = _mm256_shuffle_epi8( _mm256_setr_epi8(
+			0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 ),
+			_mm256_add_epi8( is_slash, hi_nibbles ) );
+	const __m256i values = _mm256_add_epi8( in, offsets );
+
+	const __m256i merged_pairs = _mm256_maddubs_epi16(
+			values, _mm256_set1_epi32( 0x01400140 ) );
+	const __m256i merged = _mm256_madd_epi16(
+			merged_pairs, _mm256_set1_epi32( 0x00011000 ) );
+
+	// 12 bytes in every lane, then both lanes are joined.
+	const __m256i packed = _mm256_shuffle_epi8( merged, _mm256_setr_epi8(
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+
+	_mm256_storeu_si256(
+			reinterpret_cast< __m256i * >( dest ),
+			_mm256_permutevar8x32_epi32(
+					packed, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 7, 7 ) ) );
+
+	return true;
+}
+
+//! Decode as many 32-char blocks as possible.
+/*!
+	@return the count of decoded chars from @a src.
+*/
+RESTINIO_BASE64_SIMD_TARGET( "avx2" )
+inline std::size_t
+decode_blocks_avx2(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+	for( ; size - processed >= 48u; processed += 32u, dest += 24 )
+	{
+		if( !decode_block_avx2( src + processed, dest ) )
+			break;
+	}
+
+	return processed;
+}
+
+#endif
+
+//
+// encode_blocks
+//
+//! Encode the beginning of @a src by the best available instruction set.
+/*!
+	@return the count of encoded bytes from @a src (a multiple of 3).
+	The remaining bytes have to be encoded by the scalar code.
+*/
+RESTINIO_NODISCARD
+inline std::size_t
+encode_blocks(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+
+#if !defined(RESTINIO_BASE64_SIMD_SSSE3)
+	(void)src;
+	(void)size;
+	(void)dest;
+#endif
+
+	switch( instruction_set() )
+	{
+		case instruction_set_t::avx2:
+#if defined(RESTINIO_BASE64_SIMD_AVX2)
+			processed = encode_blocks_avx2( src, size, dest );
+#endif
+			RESTINIO_FALLTHROUGH;
+
+		case instruction_set_t::ssse3:
+#if defined(RESTINIO_BASE64_SIMD_SSSE3)
+			processed += encode_blocks_ssse3(
+					src + processed,
+					size - processed,
+					dest + processed / 3u * 4u );
+#endif
+		break;
+
+		case instruction_set_t::scalar:
+		break;
+	}
+
+	return processed;
+}
+
+//
+// decode_blocks
+//
+//! Decode the beginning of @a src by the best available instruction set.
+/*!
+	@a dest should have space for size / 4 * 3 bytes.
+
+	@return the count of decoded chars from @a src (a multiple of 4).
+	The remaining chars have to be decoded by the scalar code.
+*/
+RESTINIO_NODISCARD
+inline std::size_t
+decode_blocks(
+	const char * src, std::size_t size, char * dest ) noexcept
+{
+	std::size_t processed = 0u;
+
+#if !defined(RESTINIO_BASE64_SIMD_SSSE3)
+	(void)src;
+	(void)size;
+	(void)dest;
+#endif
+
+	switch( instruction_set() )
+	{
+		case instruction_set_t::avx2:
+#if defined(RESTINIO_BASE64_SIMD_AVX2)
+			processed = decode_blocks_avx2( src, size, dest );
+#endif
+			RESTINIO_FALLTHROUGH;
+
+		case instruction_set_t::ssse3:
+#if defined(RESTINIO_BASE64_SIMD_SSSE3)
+			processed += decode_blocks_ssse3(
+					src + processed,
+					size - processed,
+					dest + processed / 4u * 3u );
+#endif
+		break;
+
+		case instruction_set_t::scalar:
+		break;
+	}
+
+	return processed;
+}
+
+} /* namespace base64_simd */
+
+} /* namespace impl */
+
+} /* namespace utils */
+
+} /* namespace restinio */
@@ -0,0 +1,114 @@
+/*
+	restinio
+*/
+
+/*!
+	Helpers for fast scanning of percent-encoded strings.
+
+	SSE2 is used to process 16 bytes at a time (it is always available
+	on x86_64). If it isn't available (or RESTINIO_PERCENT_ENCODING_NO_SIMD
+	is defined) scalar code is used.
+
+	@since v.0.6.14
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <cstdint>
+
+#if !defined(RESTINIO_PERCENT_ENCODING_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || \
+			( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+		#include <emmintrin.h>
+		#define RESTINIO_PERCENT_ENCODING_SIMD_SSE2
+	#endif
+#endif
+
+#if defined(_MSC_VER) && defined(RESTINIO_PERCENT_ENCODING_SIMD_SSE2)
+	#include <intrin.h>
+#endif
+
+namespace restinio
+{
+
+namespace utils
+{
+
+namespace impl
+{
+
+namespace percent_encoding_simd
+{
+
+//! Is a char an ASCII letter or digit.
+RESTINIO_NODISCARD
+constexpr bool
+is_alnum( char ch ) noexcept
+{
+	return ( '0' <= ch && ch <= '9' ) ||
+			( 'a' <= ch && ch <= 'z' ) ||
+			( 'A' <= ch && ch <= 'Z' );
+}
+
+//! Find the first char that isn't an ASCII letter or digit.
+/*!
+	Letters and digits are ordinary chars for every traits of
+	percent encoding, so such runs can be skipped without looking
+	at the traits.
+
+	@return @a last if there is no such char.
+*/
+RESTINIO_NODISCARD
+inline const char *
+skip_alnum( const char * first, const char * last ) noexcept
+{
+#if defined(RESTINIO_PERCENT_ENCODING_SIMD_SSE2)
+	// Signed comparisons are used: bytes >= 0x80 are negative and
+	// are never in the ranges.
+	const auto in_range = []( __m128i v, char low, char high ) noexcept {
+		return _mm_and_si128(
+				_mm_cmpgt_epi8( v, _mm_set1_epi8( static_cast<char>( low - 1 ) ) ),
+				_mm_cmpgt_epi8( _mm_set1_epi8( static_cast<char>( high + 1 ) ), v ) );
+	};
+
+	for( ; last - first >= 16; first += 16 )
+	{
+		const __m128i v = _mm_loadu_si128(
+				reinterpret_cast< const __m128i * >( first ) );
+
+		const __m128i digits = in_range( v, '0', '9' );
+		const __m128i letters = in_range(
+				_mm_or_si128( v, _mm_set1_epi8( 0x20 ) ), 'a', 'z' );
+
+		const auto mask = static_cast< std::uint32_t >(
+				_mm_movemask_epi8( _mm_or_si128( digits, letters ) ) );
+		if( 0xFFFFu != mask )
+		{
+			const std::uint32_t others = ~mask & 0xFFFFu;
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward( &index, others );
+			return first + index;
+#else
+			return first + __builtin_ctz( others );
+#endif
+		}
+	}
+#endif
+
+	for( ; first != last; ++first )
+		if( !is_alnum( *first ) )
+			break;
+
+	return first;
+}
+
+} /* namespace percent_encoding_simd */
+
+} /* namespace impl */
+
+} /* namespace utils */
+
+} /* namespace restinio */
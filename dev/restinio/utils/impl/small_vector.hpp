@@ -0,0 +1,200 @@
+/*
+ * restinio
+ */
+
+/*!
+ * \file
+ * \brief A simple vector with a small inline storage.
+ *
+ * \since
+ * v.0.6.14
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace restinio {
+
+namespace utils {
+
+namespace impl {
+
+//
+// small_vector_t
+//
+/*!
+ * \brief A simple vector that doesn't allocate memory until the number
+ * of items exceeds Inline_Capacity.
+ *
+ * Items are stored in an inline array while their number is not
+ * greater than Inline_Capacity. If a new item doesn't fit into the
+ * inline array then all items are moved to a std::vector.
+ *
+ * \note
+ * This type is intended to be used for small and cheap to copy types
+ * like string_view_t. T should be default constructible.
+ *
+ * \since
+ * v.0.6.14
+ */
+template< typename T, std::size_t Inline_Capacity >
+class small_vector_t
+{
+	std::array< T, Inline_Capacity > m_inline_items;
+	std::size_t m_inline_size{ 0u };
+
+	//! Storage for items if they don't fit into m_inline_items.
+	/*!
+	 * It is used only if m_is_inline is false.
+	 */
+	std::vector< T > m_items;
+
+	bool m_is_inline{ true };
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = T &;
+	using const_reference = const T &;
+	using iterator = T *;
+	using const_iterator = const T *;
+
+	small_vector_t() = default;
+
+	small_vector_t( std::initializer_list< T > items )
+	{
+		for( const auto & i : items )
+			push_back( i );
+	}
+
+	RESTINIO_NODISCARD
+	size_type
+	size() const noexcept
+	{
+		return m_is_inline ? m_inline_size : m_items.size();
+	}
+
+	RESTINIO_NODISCARD
+	bool
+	empty() const noexcept { return 0u == size(); }
+
+	RESTINIO_NODISCARD
+	iterator
+	begin() noexcept
+	{
+		return m_is_inline ? m_inline_items.data() : m_items.data();
+	}
+
+	RESTINIO_NODISCARD
+	iterator
+	end() noexcept { return begin() + size(); }
+
+	RESTINIO_NODISCARD
+	const_iterator
+	begin() const noexcept
+	{
+		return m_is_inline ? m_inline_items.data() : m_items.data();
+	}
+
+	RESTINIO_NODISCARD
+	const_iterator
+	end() const noexcept { return begin() + size(); }
+
+	RESTINIO_NODISCARD
+	reference
+	operator[]( size_type i ) noexcept { return begin()[ i ]; }
+
+	RESTINIO_NODISCARD
+	const_reference
+	operator[]( size_type i ) const noexcept { return begin()[ i ]; }
+
+	RESTINIO_NODISCARD
+	const_reference
+	at( size_type i ) const
+	{
+		if( i >= size() )
+			throw std::out_of_range{ "small_vector_t: index is out of range" };
+		return begin()[ i ];
+	}
+
+	RESTINIO_NODISCARD
+	reference
+	front() noexcept { return *begin(); }
+
+	RESTINIO_NODISCARD
+	const_reference
+	front() const noexcept { return *begin(); }
+
+	RESTINIO_NODISCARD
+	reference
+	back() noexcept { return *(end() - 1); }
+
+	RESTINIO_NODISCARD
+	const_reference
+	back() const noexcept { return *(end() - 1); }
+
+	template< typename... Args >
+	reference
+	emplace_back( Args && ...args )
+	{
+		if( m_is_inline )
+		{
+			if( m_inline_size < Inline_Capacity )
+			{
+				auto & item = m_inline_items[ m_inline_size ];
+				item = T( std::forward<Args>(args)... );
+				++m_inline_size;
+				return item;
+			}
+
+			move_to_heap();
+		}
+
+		m_items.emplace_back( std::forward<Args>(args)... );
+		return m_items.back();
+	}
+
+	void
+	push_back( const T & item ) { emplace_back( item ); }
+
+	void
+	push_back( T && item ) { emplace_back( std::move(item) ); }
+
+	//! Remove all items.
+	/*!
+	 * Memory allocated for the heap storage is kept.
+	 */
+	void
+	clear() noexcept
+	{
+		m_inline_size = 0u;
+		m_items.clear();
+		m_is_inline = true;
+	}
+
+private:
+	void
+	move_to_heap()
+	{
+		m_items.reserve( Inline_Capacity * 2u );
+		for( std::size_t i = 0u; i != m_inline_size; ++i )
+			m_items.push_back( std::move(m_inline_items[ i ]) );
+
+		m_inline_size = 0u;
+		m_is_inline = false;
+	}
+};
+
+} /* namespace impl */
+
+} /* namespace utils */
+
+} /* namespace restinio */
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <string>
+#include <cstring>
 
 #include <restinio/impl/include_fmtlib.hpp>
 
@@ -17,6 +18,7 @@
 #include <restinio/expected.hpp>
 
 #include <restinio/utils/utf8_checker.hpp>
+#include <restinio/utils/impl/percent_encoding_simd.hpp>
 
 namespace restinio
 {
@@ -221,24 +223,56 @@ extract_escaped_char( char c1,  char c2 )
 	return result;
 }
 
+//
+// find_plain_run_end
+//
+/*!
+ * @brief Find the end of a run of chars that don't require unescaping.
+ *
+ * Such chars are ordinary chars for @a Traits except '%' and '+'.
+ *
+ * @return @a last if all chars in [first, last) don't require unescaping.
+ *
+ * @since v.0.6.14
+ */
+template< typename Traits >
+RESTINIO_NODISCARD
+const char *
+find_plain_run_end( const char * first, const char * last ) noexcept
+{
+	for(;;)
+	{
+		first = percent_encoding_simd::skip_alnum( first, last );
+		if( first == last || '%' == *first || '+' == *first ||
+				!Traits::ordinary_char( *first ) )
+			return first;
+		++first;
+	}
+}
+
 //
 // do_unescape_percent_encoding
 //
 /*!
  * @brief The actual implementation of unescape-percent-encoding procedure.
  *
+ * Since v.0.6.14 runs of chars that don't require unescaping are
+ * passed to @a run_collector as a whole.
+ *
  * @since v.0.6.5
  */
 template<
 	typename Traits,
-	typename Chars_Collector >
+	typename Chars_Collector,
+	typename Run_Collector >
 RESTINIO_NODISCARD
 expected_t<
 	unescape_percent_encoding_success_t,
 	unescape_percent_encoding_failure_t >
 do_unescape_percent_encoding(
 	const string_view_t data,
-	Chars_Collector && collector )
+	Chars_Collector && collector,
+	Run_Collector && run_collector )
 {
 	std::size_t chars_to_handle = data.size();
 	const char * d = data.data();
@@ -250,6 +284,22 @@ do_unescape_percent_encoding(
 
 	while( 0 < chars_to_handle )
 	{
+		if( !expect_next_utf8_byte )
+		{
+			const char * run_end = find_plain_run_end< Traits >(
+					d, d + chars_to_handle );
+			if( run_end != d )
+			{
+				const auto run_size = static_cast< std::size_t >( run_end - d );
+				run_collector( d, run_size );
+				chars_to_handle -= run_size;
+				d = run_end;
+
+				if( 0 == chars_to_handle )
+					break;
+			}
+		}
+
 		char c = *d;
 		if( expect_next_utf8_byte && '%' != c )
 			return make_unexpected( unescape_percent_encoding_failure_t{
@@ -367,7 +417,10 @@ unescape_percent_encoding( const string_view_t data )
 
 	auto r = impl::do_unescape_percent_encoding<Traits>(
 			data,
-			[&result]( char ch ) { result += ch; } );
+			[&result]( char ch ) { result += ch; },
+			[&result]( const char * run, std::size_t size ) {
+				result.append( run, size );
+			} );
 	if( !r )
 		throw exception_t{ r.error().giveout_description() };
 
@@ -396,7 +449,10 @@ try_unescape_percent_encoding( const string_view_t data )
 
 	auto r = impl::do_unescape_percent_encoding<Traits>(
 			data,
-			[&result]( char ch ) { result += ch; } );
+			[&result]( char ch ) { result += ch; },
+			[&result]( const char * run, std::size_t size ) {
+				result.append( run, size );
+			} );
 	if( !r )
 		return make_unexpected( std::move(r.error()) );
 
@@ -416,6 +472,13 @@ inplace_unescape_percent_encoding( char * data, std::size_t size )
 			[&result_size, &dest]( char ch ) {
 				*dest++ = ch;
 				++result_size;
+			},
+			[&result_size, &dest]( const char * run, std::size_t size ) {
+				// There is nothing to move until the first escaped char.
+				if( dest != run )
+					std::memmove( dest, run, size );
+				dest += size;
+				result_size += size;
 			} );
 	if( !r )
 		throw exception_t{ r.error().giveout_description() };
@@ -448,6 +511,13 @@ try_inplace_unescape_percent_encoding( char * data, std::size_t size )
 			[&result_size, &dest]( char ch ) {
 				*dest++ = ch;
 				++result_size;
+			},
+			[&result_size, &dest]( const char * run, std::size_t size ) {
+				// There is nothing to move until the first escaped char.
+				if( dest != run )
+					std::memmove( dest, run, size );
+				dest += size;
+				result_size += size;
 			} );
 	if( !r )
 		return make_unexpected( std::move(r.error()) );
@@ -159,6 +159,9 @@ class ws_connection_t final
 			,	m_msg_handler{ std::move( msg_handler ) }
 			,	m_logger{ *( m_settings->m_logger ) }
 		{
+			m_settings->increment_metric(
+					metrics::counter_t::websocket_connections_opened );
+
 			// Notify of a new connection instance.
 			m_logger.trace( [&]{
 					return fmt::format(
@@ -191,6 +194,9 @@ class ws_connection_t final
 
 		~ws_connection_t() override
 		{
+			m_settings->increment_metric(
+					metrics::counter_t::websocket_connections_closed );
+
 			try
 			{
 				// Notify of a new connection instance.
@@ -296,6 +302,7 @@ class ws_connection_t final
 					{
 						// Start timeout checking.
 						m_prepared_weak_ctx = shared_from_this();
+						mark_peer_activity();
 						init_next_timeout_checking();
 
 						m_websocket_weak_handle = std::move( wswh );
@@ -572,6 +579,11 @@ class ws_connection_t final
 							length );
 				} );
 
+				mark_peer_activity();
+
+				m_settings->increment_metric(
+						metrics::counter_t::websocket_bytes_read, length );
+
 				m_input.m_buf.obtained_bytes( length );
 				consume_header_from_buffer( m_input.m_buf.bytes(), length );
 			}
@@ -761,6 +773,11 @@ class ws_connection_t final
 							length );
 				} );
 
+				mark_peer_activity();
+
+				m_settings->increment_metric(
+						metrics::counter_t::websocket_bytes_read, length );
+
 				assert( length <= length_remaining );
 
 				const std::size_t next_length_remaining =
@@ -1168,6 +1185,10 @@ class ws_connection_t final
 						{
 							if( !ec )
 							{
+								m_settings->increment_metric(
+										metrics::counter_t::websocket_bytes_written,
+										written );
+
 								m_logger.trace( [&]{
 									return fmt::format(
 											"[ws_connection:{}] outgoing data was sent: {} bytes",
@@ -1300,6 +1321,23 @@ class ws_connection_t final
 		std::chrono::steady_clock::time_point m_write_operation_timeout_after;
 		std::chrono::steady_clock::time_point m_close_frame_from_peer_timeout_after =
 			std::chrono::steady_clock::time_point::max();
+
+		/*!
+		 * @name Keep-alive stuff.
+		 * @since v.0.6.14
+		 * @{
+		 */
+		//! Time point of the last incoming data from the peer.
+		std::chrono::steady_clock::time_point m_last_peer_activity_at;
+		//! Deadline for a response to the automatic ping.
+		/*!
+		 * Has the max value if there is no awaited response.
+		 */
+		std::chrono::steady_clock::time_point m_pong_from_peer_timeout_after =
+			std::chrono::steady_clock::time_point::max();
+		/*!
+		 * @}
+		 */
 		tcp_connection_ctx_weak_handle_t m_prepared_weak_ctx;
 		timer_guard_t m_timer_guard;
 
@@ -1327,12 +1365,81 @@ class ws_connection_t final
 					} );
 				close_impl();
 			}
+			else if( now > m_pong_from_peer_timeout_after )
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+							"[ws_connection:{}] no response from peer for ping, "
+							"connection is treated as dead",
+							connection_id() );
+					} );
+				m_close_frame_to_peer.disable();
+				call_close_handler_if_necessary( status_code_t::connection_lost );
+				close_impl();
+			}
 			else
 			{
+				send_ping_if_necessary( now );
 				init_next_timeout_checking();
 			}
 		}
 
+		//! Remember that something was received from the peer.
+		/*!
+		 * Any incoming data proves that the peer is alive, so a pending
+		 * deadline for pong-frame is dropped.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		mark_peer_activity() noexcept
+		{
+			m_last_peer_activity_at = std::chrono::steady_clock::now();
+			m_pong_from_peer_timeout_after =
+				std::chrono::steady_clock::time_point::max();
+		}
+
+		//! Send ping-frame if the peer is silent for too long.
+		/*!
+		 * Does nothing if automatic pings are disabled or if ping was already
+		 * sent and the response is still awaited.
+		 *
+		 * @since v.0.6.14
+		 */
+		void
+		send_ping_if_necessary( std::chrono::steady_clock::time_point now )
+		{
+			const auto ping_interval = m_settings->m_websocket_ping_interval;
+
+			if( std::chrono::steady_clock::duration::zero() == ping_interval ||
+				write_state_t::write_enabled != m_write_state ||
+				read_state_t::read_any_frame != m_read_state ||
+				std::chrono::steady_clock::time_point::max() !=
+						m_pong_from_peer_timeout_after ||
+				now - m_last_peer_activity_at < ping_interval )
+				return;
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						"[ws_connection:{}] peer is silent, send ping",
+						connection_id() );
+				} );
+
+			writable_items_container_t bufs;
+			bufs.reserve( 1 );
+			bufs.emplace_back(
+				impl::write_message_details(
+					final_frame,
+					opcode_t::ping_frame,
+					0u ) );
+			m_outgoing_data.append( write_group_t{ std::move( bufs ) } );
+
+			init_write_if_necessary();
+
+			m_pong_from_peer_timeout_after =
+				now + m_settings->m_websocket_pong_timeout;
+		}
+
 		//! schedule next timeout checking.
 		void
 		init_next_timeout_checking()
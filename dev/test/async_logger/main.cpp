@@ -0,0 +1,118 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/async_logger.hpp>
+
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+RESTINIO_NODISCARD
+std::size_t
+count_of( const std::string & where, const std::string & what )
+{
+	std::size_t result = 0u;
+	for( auto pos = where.find( what ); std::string::npos != pos;
+			pos = where.find( what, pos + what.size() ) )
+		++result;
+
+	return result;
+}
+
+} /* namespace anonymous */
+
+TEST_CASE( "Level filtering", "[async_logger]" )
+{
+	std::ostringstream out;
+	int calls = 0;
+
+	{
+		restinio::async_logger_t< restinio::log_level_t::info > logger{
+				out,
+				restinio::async_logger_settings_t{}
+					.level( restinio::log_level_t::trace ) };
+
+		// Trace messages are disabled at compile time.
+		logger.trace( [&calls]{ ++calls; return std::string{ "trace" }; } );
+		logger.info( [&calls]{ ++calls; return std::string{ "info" }; } );
+
+		logger.level( restinio::log_level_t::warn );
+		logger.info( [&calls]{ ++calls; return std::string{ "info-2" }; } );
+		logger.warn( [&calls]{ ++calls; return std::string{ "warn" }; } );
+		logger.error( [&calls]{ ++calls; return std::string{ "error" }; } );
+
+		logger.flush();
+		const auto text = out.str();
+		REQUIRE( std::string::npos == text.find( "trace" ) );
+		REQUIRE( std::string::npos != text.find( " INFO: info\n" ) );
+		REQUIRE( std::string::npos == text.find( "info-2" ) );
+		REQUIRE( std::string::npos != text.find( " WARN: warn\n" ) );
+		REQUIRE( std::string::npos != text.find( "ERROR: error\n" ) );
+	}
+
+	REQUIRE( 3 == calls );
+	REQUIRE( 3u == count_of( out.str(), "\n" ) );
+}
+
+TEST_CASE( "Messages from several threads", "[async_logger]" )
+{
+	constexpr int threads_count = 4;
+	constexpr int messages_count = 1000;
+
+	std::ostringstream out;
+	{
+		restinio::async_logger_t<> logger{
+				out,
+				restinio::async_logger_settings_t{}
+					.buffer_capacity( messages_count )
+					.flush_interval( std::chrono::milliseconds( 1 ) ) };
+
+		std::vector< std::thread > threads;
+		for( int t = 0; t != threads_count; ++t )
+			threads.emplace_back( [&logger, t] {
+				for( int i = 0; i != messages_count; ++i )
+					logger.error( [&]{
+						return fmt::format( "thread {} message {}", t, i );
+					} );
+			} );
+
+		for( auto & t : threads )
+			t.join();
+
+		REQUIRE( 0u == logger.dropped() );
+	}
+
+	// All messages are written on destruction of the logger.
+	const auto text = out.str();
+	REQUIRE( static_cast< std::size_t >( threads_count * messages_count ) ==
+			count_of( text, "\n" ) );
+	REQUIRE( std::string::npos != text.find( "thread 3 message 999\n" ) );
+}
+
+TEST_CASE( "Dropped messages", "[async_logger]" )
+{
+	std::ostringstream out;
+	{
+		restinio::async_logger_t<> logger{
+				out,
+				restinio::async_logger_settings_t{}
+					.buffer_capacity( 4u )
+					.flush_interval( std::chrono::hours( 1 ) ) };
+
+		for( int i = 0; i != 10; ++i )
+			logger.error( [i]{ return fmt::format( "message {}", i ); } );
+
+		REQUIRE( 6u == logger.dropped() );
+	}
+
+	const auto text = out.str();
+	REQUIRE( std::string::npos != text.find( "message 3\n" ) );
+	REQUIRE( std::string::npos == text.find( "message 4\n" ) );
+	REQUIRE( std::string::npos !=
+			text.find( " WARN: async_logger: 6 message(s) dropped\n" ) );
+}
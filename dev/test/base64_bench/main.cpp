@@ -0,0 +1,161 @@
+/*
+	restinio
+*/
+
+/*!
+	Benchmark for base64 encoding and decoding.
+*/
+
+#include <restinio/utils/base64.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+// The implementation of encoding that was used before v.0.6.14.
+inline std::string
+push_back_encode( restinio::string_view_t str )
+{
+	using namespace restinio::utils::base64;
+
+	std::string result;
+
+	const auto at = [&str](auto index) { return uch(str[index]); };
+
+	const auto alphabet_char = [](auto ch) {
+		return static_cast<char>(
+				base64_alphabet< unsigned char >()[
+						static_cast<unsigned char>(ch) ]);
+	};
+
+	constexpr std::size_t group_size = 3u;
+	const auto remaining = str.size() % group_size;
+
+	result.reserve( (str.size()/group_size + (remaining ? 1:0)) * 4 );
+
+	std::size_t i = 0;
+	for(; i < str.size() - remaining; i += group_size )
+	{
+		uint_type_t bs = (at(i) << 16) | (at(i+1) << 8) | at(i+2);
+
+		result.push_back( alphabet_char( sixbits_char<18>(bs) ) );
+		result.push_back( alphabet_char( sixbits_char<12>(bs) ) );
+		result.push_back( alphabet_char( sixbits_char<6>(bs) ) );
+		result.push_back( alphabet_char( sixbits_char<0>(bs) ) );
+	}
+
+	if( remaining )
+	{
+		uint_type_t bs = (at(i) << 16) | (2u == remaining ? (at(i+1) << 8) : 0u);
+		result.push_back( alphabet_char( sixbits_char<18>(bs) ) );
+		result.push_back( alphabet_char( sixbits_char<12>(bs) ) );
+		result.push_back( 2u == remaining ?
+				alphabet_char( sixbits_char<6>(bs) ) : '=' );
+		result.push_back('=');
+	}
+
+	return result;
+}
+
+std::string
+create_test_data( std::size_t size )
+{
+	std::string result;
+	result.reserve( size );
+
+	unsigned int seed = 42u;
+	for( std::size_t i = 0u; i < size; ++i )
+	{
+		seed = seed * 1103515245u + 12345u;
+		result.push_back( static_cast<char>( seed >> 16 ) );
+	}
+
+	return result;
+}
+
+template < typename LAMBDA >
+void
+run_bench( const std::string & tag, LAMBDA lambda )
+{
+	try
+	{
+		auto started_at = std::chrono::high_resolution_clock::now();
+		lambda();
+		auto finished_at = std::chrono::high_resolution_clock::now();
+		const double duration =
+			std::chrono::duration_cast< std::chrono::microseconds >(
+				finished_at - started_at ).count() / 1000.0;
+
+		std::cout << "Done '" << tag << "': " << duration << " ms" << std::endl;
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Failed to run '" << tag << "': " << ex.what() << std::endl;
+	}
+}
+
+int
+main()
+{
+	using namespace restinio::utils::base64;
+
+	std::cout << "Instruction set: "
+		<< restinio::utils::impl::base64_simd::instruction_set_name()
+		<< std::endl;
+
+	// Sizes of typical Authorization and Sec-WebSocket-Key values and
+	// sizes of small and big bodies.
+	for( const std::size_t size : { 16u, 48u, 1024u, 64u * 1024u } )
+	{
+		const std::size_t iterations_count = 64u * 1024u * 1024u / size;
+
+		const auto data = create_test_data( size );
+		const auto encoded = encode( data );
+		if( encoded != push_back_encode( data ) )
+			throw std::runtime_error{ "MUST NEVER HAPPEN" };
+
+		std::cout << "--- size: " << size
+			<< ", iterations: " << iterations_count << std::endl;
+
+		std::size_t total{};
+
+		run_bench( "push_back_encode", [&] {
+			for( std::size_t i = 0; i < iterations_count; ++i )
+				total += push_back_encode( data ).size();
+		} );
+
+		run_bench( "encode", [&] {
+			for( std::size_t i = 0; i < iterations_count; ++i )
+				total += encode( data ).size();
+		} );
+
+		run_bench( "encode_to", [&] {
+			std::vector< char > buf( encoded_size( data.size() ) );
+			for( std::size_t i = 0; i < iterations_count; ++i )
+				total += encode_to( data, buf.data() );
+		} );
+
+		run_bench( "decode", [&] {
+			for( std::size_t i = 0; i < iterations_count; ++i )
+				total += decode( encoded ).size();
+		} );
+
+		run_bench( "try_decode_to", [&] {
+			std::vector< char > buf( max_decoded_size( encoded.size() ) );
+			for( std::size_t i = 0; i < iterations_count; ++i )
+			{
+				const auto r = try_decode_to( encoded, buf.data() );
+				if( !r )
+					throw std::runtime_error{ "MUST NEVER HAPPEN" };
+				total += *r;
+			}
+		} );
+
+		// Prevents the optimizer from throwing away the benchmarks.
+		std::cout << "(total: " << total << ")" << std::endl;
+	}
+
+	return 0;
+}
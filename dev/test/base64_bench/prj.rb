@@ -0,0 +1,10 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'fmt_mxxru/prj.rb'
+
+	target( "_bench.test.base64_bench" )
+
+	cpp_source( "main.cpp" )
+}
@@ -14,6 +14,8 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/multipart_body/prj.ut.rb" )
 
 	required_prj( "test/header/prj.ut.rb" )
+	required_prj( "test/http2_hpack/prj.ut.rb" )
+	required_prj( "test/http_parser_backend/prj.ut.rb" )
 	required_prj( "test/default_constructed_settings/prj.ut.rb" )
 	required_prj( "test/ref_qualifiers_settings/prj.ut.rb" )
 	required_prj( "test/buffers/prj.ut.rb" )
@@ -29,6 +31,7 @@ MxxRu::Cpp::composite_target {
 	if RestinioOpenSSLFind.has_openssl(toolset)
 		if not $sanitizer_build or $sanitizer_build != 'thread_sanitizer'
 			required_prj( "test/socket_options_tls/prj.ut.rb" )
+			required_prj( "test/http2_tls/prj.ut.rb" )
 		end
 	end
 
@@ -59,6 +62,7 @@ MxxRu::Cpp::composite_target {
 	# ================================================================
 	# Benches for implementation tuning.
 	required_prj( "test/to_lower_bench/prj.rb" )
+	required_prj( "test/base64_bench/prj.rb" )
 
 	# ================================================================
 	# Websocket tests
@@ -66,6 +70,7 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/handle_requests/upgrade/prj.ut.rb" )
 	required_prj( "test/websocket/parser/prj.ut.rb" )
 	required_prj( "test/websocket/validators/prj.ut.rb" )
+	required_prj( "test/websocket/keepalive/prj.ut.rb" )
 	required_prj( "test/websocket/ws_connection/prj.ut.rb" )
 	required_prj( "test/websocket/notificators/prj.ut.rb" )
 
@@ -78,5 +83,29 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/basic_auth/prj.ut.rb" )
 	# Bearer Authentification support
 	required_prj( "test/bearer_auth/prj.ut.rb" )
+
+	# ================================================================
+	# Response cache.
+	required_prj( "test/response_cache/prj.ut.rb" )
+
+	# ================================================================
+	# IP blockers.
+	required_prj( "test/cidr_ip_blocker/prj.ut.rb" )
+
+	# ================================================================
+	# Rate limiting.
+	required_prj( "test/rate_limiter/prj.ut.rb" )
+
+	# ================================================================
+	# Connection count limiter.
+	required_prj( "test/connection_count_limiter/prj.ut.rb" )
+
+	# ================================================================
+	# Loggers.
+	required_prj( "test/async_logger/prj.ut.rb" )
+
+	# ================================================================
+	# Coroutines.
+	required_prj( "test/coroutine/prj.ut.rb" )
 }
 
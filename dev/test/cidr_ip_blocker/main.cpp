@@ -0,0 +1,187 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/cidr_ip_blocker.hpp>
+
+#include <thread>
+
+using namespace restinio::ip_blocker;
+
+namespace
+{
+
+RESTINIO_NODISCARD
+inspection_result_t
+find( const cidr_rules_t & rules, const char * address )
+{
+	return rules.find( restinio::asio_ns::ip::make_address( address ) );
+}
+
+RESTINIO_NODISCARD
+restinio::endpoint_t
+endpoint( const char * address )
+{
+	return { restinio::asio_ns::ip::make_address( address ), 12345u };
+}
+
+} /* namespace anonymous */
+
+TEST_CASE( "CIDR parsing", "[cidr]" )
+{
+	{
+		const auto b = cidr_t::parse( "10.0.0.0/8" );
+		REQUIRE( b.address().is_v4() );
+		REQUIRE( 8u == b.prefix_length() );
+	}
+	{
+		const auto b = cidr_t::parse( "2001:db8::/32" );
+		REQUIRE( b.address().is_v6() );
+		REQUIRE( 32u == b.prefix_length() );
+	}
+	{
+		const auto b = cidr_t::parse( "192.168.1.1" );
+		REQUIRE( 32u == b.prefix_length() );
+	}
+	{
+		const auto b = cidr_t::parse( "::1" );
+		REQUIRE( 128u == b.prefix_length() );
+	}
+
+	REQUIRE_THROWS( cidr_t::parse( "" ) );
+	REQUIRE_THROWS( cidr_t::parse( "10.0.0.0/" ) );
+	REQUIRE_THROWS( cidr_t::parse( "10.0.0.0/33" ) );
+	REQUIRE_THROWS( cidr_t::parse( "10.0.0.0/a" ) );
+	REQUIRE_THROWS( cidr_t::parse( "10.0.0/8" ) );
+	REQUIRE_THROWS( cidr_t::parse( "::/129" ) );
+}
+
+TEST_CASE( "Longest prefix wins", "[cidr]" )
+{
+	cidr_rules_t rules;
+	rules.deny( "10.0.0.0/8" );
+	rules.allow( "10.1.0.0/16" );
+	rules.deny( "10.1.2.0/24" );
+	rules.allow( "10.1.2.3" );
+	REQUIRE( 4u == rules.size() );
+
+	REQUIRE( inspection_result_t::allow == find( rules, "11.0.0.1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "10.0.0.1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "10.255.0.1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "10.1.0.1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "10.1.2.1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "10.1.2.3" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "10.1.2.4" ) );
+}
+
+TEST_CASE( "Rules added in different order", "[cidr]" )
+{
+	cidr_rules_t rules{ inspection_result_t::deny };
+	rules.allow( "192.168.1.0/24" );
+	rules.allow( "192.168.2.0/24" );
+	rules.deny( "192.168.1.128/25" );
+	rules.allow( "192.168.0.0/16" );
+	rules.deny( "192.168.3.7" );
+	// Replaces the previous rule.
+	rules.deny( "192.168.2.0/24" );
+	REQUIRE( 5u == rules.size() );
+
+	REQUIRE( inspection_result_t::deny == find( rules, "172.16.0.1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "192.168.0.1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "192.168.1.1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "192.168.1.200" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "192.168.2.1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "192.168.3.6" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "192.168.3.7" ) );
+}
+
+TEST_CASE( "IPv6 rules", "[cidr]" )
+{
+	cidr_rules_t rules;
+	rules.deny( "2001:db8::/32" );
+	rules.allow( "2001:db8:1::/48" );
+	rules.deny( "::1" );
+	rules.deny( "0.0.0.0/0" );
+
+	REQUIRE( inspection_result_t::deny == find( rules, "2001:db8::1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "2001:db8:1::1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "2001:db9::1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "::1" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "::2" ) );
+
+	// IPv4 rules are applied to IPv4-mapped IPv6 addresses.
+	REQUIRE( inspection_result_t::deny == find( rules, "127.0.0.1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "::ffff:127.0.0.1" ) );
+}
+
+TEST_CASE( "Whole address space", "[cidr]" )
+{
+	cidr_rules_t rules;
+	rules.deny( "::/0" );
+	rules.allow( "10.0.0.0/8" );
+
+	REQUIRE( inspection_result_t::deny == find( rules, "2001:db8::1" ) );
+	REQUIRE( inspection_result_t::deny == find( rules, "1.2.3.4" ) );
+	REQUIRE( inspection_result_t::allow == find( rules, "10.2.3.4" ) );
+}
+
+TEST_CASE( "Update of cidr_ip_blocker", "[cidr]" )
+{
+	cidr_ip_blocker_t blocker;
+
+	REQUIRE( inspection_result_t::allow ==
+			blocker.inspect( incoming_info_t{ endpoint( "10.0.0.1" ) } ) );
+
+	cidr_rules_t rules;
+	rules.deny( "10.0.0.0/8" );
+	const auto old_rules = blocker.rules();
+	blocker.update( std::move(rules) );
+
+	REQUIRE( inspection_result_t::deny ==
+			blocker.inspect( incoming_info_t{ endpoint( "10.0.0.1" ) } ) );
+	REQUIRE( inspection_result_t::allow ==
+			blocker.inspect( incoming_info_t{ endpoint( "11.0.0.1" ) } ) );
+
+	// Old rules are still available for those who hold them.
+	REQUIRE( inspection_result_t::allow == find( *old_rules, "10.0.0.1" ) );
+}
+
+TEST_CASE( "Concurrent update of cidr_ip_blocker", "[cidr][concurrent]" )
+{
+	cidr_ip_blocker_t blocker;
+
+	std::atomic< bool > stop{ false };
+	std::atomic< std::size_t > inconsistencies{ 0u };
+
+	std::vector< std::thread > readers;
+	for( int i = 0; i != 4; ++i )
+		readers.emplace_back( [&] {
+			while( !stop )
+			{
+				(void)blocker.inspect( incoming_info_t{ endpoint( "10.0.0.1" ) } );
+
+				// Every set of rules allows or denies both addresses.
+				const auto rules = blocker.rules();
+				if( find( *rules, "10.0.0.1" ) != find( *rules, "10.1.0.1" ) )
+					++inconsistencies;
+			}
+		} );
+
+	for( int i = 0; i != 1000; ++i )
+	{
+		cidr_rules_t rules;
+		if( 0 == i % 2 )
+			rules.deny( "10.0.0.0/8" );
+		blocker.update( std::move(rules) );
+	}
+
+	stop = true;
+	for( auto & t : readers )
+		t.join();
+
+	REQUIRE( 0u == inconsistencies );
+	REQUIRE( inspection_result_t::allow ==
+			blocker.inspect( incoming_info_t{ endpoint( "10.0.0.1" ) } ) );
+}
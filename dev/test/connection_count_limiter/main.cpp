@@ -0,0 +1,147 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/connection_count_limiter.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace ccl = restinio::connection_count_limits;
+
+namespace
+{
+
+class acceptor_t final : public ccl::impl::acceptor_callback_iface_t
+{
+public:
+	std::mutex m_lock;
+	std::vector< std::size_t > m_accepted;
+	std::vector< std::size_t > m_scheduled;
+
+	void
+	call_accept_now( std::size_t index ) noexcept override
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_accepted.push_back( index );
+	}
+
+	void
+	schedule_next_accept_attempt( std::size_t index ) noexcept override
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_scheduled.push_back( index );
+	}
+};
+
+using limiter_t = ccl::connection_count_limiter_t< restinio::default_strand_t >;
+
+} /* namespace anonymous */
+
+TEST_CASE( "Accept suspension", "[connection_count_limiter]" )
+{
+	acceptor_t acceptor;
+	limiter_t limiter{
+			&acceptor,
+			ccl::max_parallel_connections_t{ 2u },
+			ccl::max_active_accepts_t{ 4u } };
+
+	limiter.accept_next( 0u );
+	limiter.accept_next( 1u );
+	limiter.accept_next( 2u );
+	limiter.accept_next( 3u );
+
+	REQUIRE( std::vector< std::size_t >{ 0u, 1u } == acceptor.m_accepted );
+	REQUIRE( acceptor.m_scheduled.empty() );
+
+	// Accepts become connections. There are no free slots yet.
+	limiter.increment_parallel_connections();
+	limiter.increment_parallel_connections();
+	REQUIRE( acceptor.m_scheduled.empty() );
+
+	limiter.decrement_parallel_connections();
+	REQUIRE( std::vector< std::size_t >{ 3u } == acceptor.m_scheduled );
+
+	// The next attempt for the scheduled slot.
+	limiter.accept_next( 3u );
+	REQUIRE( std::vector< std::size_t >{ 0u, 1u, 3u } == acceptor.m_accepted );
+	limiter.increment_parallel_connections();
+
+	limiter.decrement_parallel_connections();
+	limiter.decrement_parallel_connections();
+	REQUIRE( std::vector< std::size_t >{ 3u, 2u } == acceptor.m_scheduled );
+
+	// Nothing is pending now.
+	limiter.decrement_parallel_connections();
+	REQUIRE( 2u == acceptor.m_scheduled.size() );
+}
+
+TEST_CASE( "Concurrent connections", "[connection_count_limiter]" )
+{
+	constexpr std::size_t max_connections = 3u;
+	constexpr std::size_t threads_count = 8u;
+	constexpr int iterations = 20000;
+
+	// Every thread emulates an acceptor's slot. If the slot isn't
+	// accepted the thread waits until the slot is scheduled for the
+	// next attempt. A lost pending slot hangs the test.
+	struct slot_acceptor_t final : public ccl::impl::acceptor_callback_iface_t
+	{
+		std::atomic< std::size_t > m_connections{ 0u };
+		std::atomic< std::size_t > m_max_connections{ 0u };
+		std::atomic< int > m_slot_states[ threads_count ];
+
+		void
+		call_accept_now( std::size_t index ) noexcept override
+		{
+			const auto v = ++m_connections;
+			auto max = m_max_connections.load();
+			while( v > max &&
+					!m_max_connections.compare_exchange_weak( max, v ) )
+			{}
+			m_slot_states[ index ] = 1;
+		}
+
+		void
+		schedule_next_accept_attempt( std::size_t index ) noexcept override
+		{
+			m_slot_states[ index ] = 2;
+		}
+	} acceptor;
+
+	limiter_t limiter{
+			&acceptor,
+			ccl::max_parallel_connections_t{ max_connections },
+			ccl::max_active_accepts_t{ threads_count } };
+
+	std::vector< std::thread > threads;
+	for( std::size_t i = 0u; i != threads_count; ++i )
+		threads.emplace_back( [&acceptor, &limiter, i] {
+			for( int n = 0; n != iterations; )
+			{
+				acceptor.m_slot_states[ i ] = 0;
+				limiter.accept_next( i );
+
+				int state;
+				while( 0 == (state = acceptor.m_slot_states[ i ].load()) )
+					std::this_thread::yield();
+
+				if( 1 == state )
+				{
+					limiter.increment_parallel_connections();
+					--acceptor.m_connections;
+					limiter.decrement_parallel_connections();
+					++n;
+				}
+			}
+		} );
+
+	for( auto & t : threads )
+		t.join();
+
+	REQUIRE( max_connections >= acceptor.m_max_connections.load() );
+	REQUIRE( 0u == acceptor.m_connections.load() );
+}
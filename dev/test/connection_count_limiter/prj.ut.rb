@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"test/connection_count_limiter/prj.ut.rb",
+		"test/connection_count_limiter/prj.rb" )
+)
@@ -0,0 +1,221 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/coroutine.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#if defined(RESTINIO_HAS_COROUTINES)
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+const std::string request_str{
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"Connection: close\r\n"
+	"\r\n" };
+
+restinio::coro::handler_task_t
+streaming_handler(
+	restinio::request_handle_t req,
+	std::thread::id server_thread,
+	std::vector< bool > * resumed_on_server_thread )
+{
+	auto resp = req->create_response< restinio::chunked_output_t >();
+	resp.append_header( restinio::http_field::content_type, "text/plain" );
+
+	for( const char * part : { "one,", "two,", "three" } )
+	{
+		resp.append_chunk( restinio::const_buffer( part ) );
+		const auto ec = co_await restinio::coro::async_flush( resp );
+		resumed_on_server_thread->push_back(
+				!ec && server_thread == std::this_thread::get_id() );
+	}
+
+	const auto ec = co_await restinio::coro::async_done( resp );
+	resumed_on_server_thread->push_back( !ec );
+
+	co_return restinio::request_accepted();
+}
+
+TEST_CASE( "Coroutine with awaitable flush" , "[coroutine][flush]" )
+{
+	std::promise< std::thread::id > server_thread;
+	auto server_thread_id = server_thread.get_future().share();
+	std::vector< bool > resumed_on_server_thread;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( restinio::coro::as_request_handler(
+					[&]( restinio::request_handle_t req ) {
+						return streaming_handler(
+								std::move( req ),
+								server_thread_id.get(),
+								&resumed_on_server_thread );
+					} ) );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	restinio::asio_ns::post( http_server.io_context(), [&] {
+			server_thread.set_value( std::this_thread::get_id() );
+		} );
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+
+	other_thread.stop_and_join();
+
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "4\r\none,\r\n" ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "4\r\ntwo,\r\n" ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "5\r\nthree\r\n0\r\n\r\n" ) );
+	REQUIRE( std::vector< bool >( 4u, true ) == resumed_on_server_thread );
+}
+
+TEST_CASE( "Coroutine completed without suspension" , "[coroutine][sync]" )
+{
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( restinio::coro::as_request_handler(
+					[]( restinio::request_handle_t ) -> restinio::coro::handler_task_t {
+						co_return restinio::request_rejected();
+					} ) );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+
+	other_thread.stop_and_join();
+
+	REQUIRE_THAT( response,
+			Catch::Matchers::StartsWith( "HTTP/1.1 501 Not Implemented" ) );
+}
+
+TEST_CASE( "Coroutine throws before suspension" , "[coroutine][exception]" )
+{
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.handle_request_timeout( std::chrono::seconds( 30 ) )
+				.request_handler( restinio::coro::as_request_handler(
+					[]( restinio::request_handle_t ) -> restinio::coro::handler_task_t {
+						throw std::runtime_error( "unit test exception" );
+						co_return restinio::request_accepted();
+					} ) );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	const auto started_at = std::chrono::steady_clock::now();
+
+	// The exception is handled by the connection, it doesn't wait
+	// for handle_request_timeout.
+	do_with_socket( [ & ]( auto & socket, auto & /*io_context*/ ){
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request_str ) );
+
+		std::array< char, 64 > data{};
+		restinio::asio_ns::error_code error;
+		const auto length = restinio::asio_ns::read(
+				socket, restinio::asio_ns::buffer(data), error );
+		REQUIRE( 0 == length );
+		REQUIRE( error == restinio::asio_ns::error::eof );
+	} );
+
+	REQUIRE( std::chrono::steady_clock::now() - started_at <
+			std::chrono::seconds( 10 ) );
+
+	other_thread.stop_and_join();
+}
+
+//! A logger that remembers errors.
+struct error_collector_t
+{
+	std::mutex m_lock;
+	std::vector< std::string > m_errors;
+	std::promise< void > m_first_error;
+
+	template< typename Message_Builder >
+	void
+	error( Message_Builder && msg_builder )
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_errors.push_back( msg_builder() );
+		if( 1u == m_errors.size() )
+			m_first_error.set_value();
+	}
+};
+
+TEST_CASE( "Coroutine throws after suspension" , "[coroutine][exception]" )
+{
+	error_collector_t errors;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.handle_request_timeout( std::chrono::milliseconds( 100 ) )
+				.request_handler( restinio::coro::as_request_handler(
+					[]( restinio::request_handle_t req ) -> restinio::coro::handler_task_t {
+						auto resp = req->create_response<
+								restinio::user_controlled_output_t >();
+						resp.set_content_length( 10u );
+						co_await restinio::coro::async_flush( resp );
+
+						throw std::runtime_error( "unit test exception" );
+					},
+					errors ) );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	do_with_socket( [ & ]( auto & socket, auto & /*io_context*/ ){
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request_str ) );
+
+		errors.m_first_error.get_future().get();
+	} );
+
+	other_thread.stop_and_join();
+
+	std::lock_guard< std::mutex > lock{ errors.m_lock };
+	REQUIRE( 1u == errors.m_errors.size() );
+	REQUIRE_THAT( errors.m_errors.front(),
+			Catch::Matchers::Contains( "unit test exception" ) );
+}
+
+#else
+
+TEST_CASE( "Coroutines are not supported" , "[coroutine]" )
+{
+	SUCCEED( "C++20 coroutines are not supported by the compiler" );
+}
+
+#endif
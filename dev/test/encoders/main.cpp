@@ -167,6 +167,190 @@ TEST_CASE(
 	}
 }
 
+namespace
+{
+
+// Straightforward implementation of base64 encoding for comparison.
+std::string
+reference_base64_encode( const std::string & str )
+{
+	static const char alphabet[] =
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string result;
+	std::size_t i = 0u;
+	for( ; i + 3u <= str.size(); i += 3u )
+	{
+		const unsigned long bs =
+				(static_cast<unsigned char>(str[i]) << 16) |
+				(static_cast<unsigned char>(str[i+1]) << 8) |
+				static_cast<unsigned char>(str[i+2]);
+		result += alphabet[ (bs >> 18) & 0x3Fu ];
+		result += alphabet[ (bs >> 12) & 0x3Fu ];
+		result += alphabet[ (bs >> 6) & 0x3Fu ];
+		result += alphabet[ bs & 0x3Fu ];
+	}
+
+	if( str.size() - i == 1u )
+	{
+		const unsigned long bs = static_cast<unsigned char>(str[i]) << 16;
+		result += alphabet[ (bs >> 18) & 0x3Fu ];
+		result += alphabet[ (bs >> 12) & 0x3Fu ];
+		result += "==";
+	}
+	else if( str.size() - i == 2u )
+	{
+		const unsigned long bs =
+				(static_cast<unsigned char>(str[i]) << 16) |
+				(static_cast<unsigned char>(str[i+1]) << 8);
+		result += alphabet[ (bs >> 18) & 0x3Fu ];
+		result += alphabet[ (bs >> 12) & 0x3Fu ];
+		result += alphabet[ (bs >> 6) & 0x3Fu ];
+		result += '=';
+	}
+
+	return result;
+}
+
+std::string
+make_test_data( std::size_t size )
+{
+	std::string result;
+	result.reserve( size );
+
+	unsigned int seed = 2166136261u;
+	for( std::size_t i = 0u; i < size; ++i )
+	{
+		seed = seed * 1103515245u + 12345u;
+		result.push_back( static_cast<char>( seed >> 16 ) );
+	}
+
+	return result;
+}
+
+} /* namespace anonymous */
+
+TEST_CASE(
+	"Base64 long strings" ,
+	"[encoders][base64][long]" )
+{
+	INFO( "instruction set: " <<
+			restinio::utils::impl::base64_simd::instruction_set_name() );
+
+	for( std::size_t size = 0u; size <= 300u; ++size )
+	{
+		const auto data = make_test_data( size );
+		const auto expected = reference_base64_encode( data );
+
+		const auto encoded = restinio::utils::base64::encode( data );
+		REQUIRE( expected == encoded );
+
+		if( !encoded.empty() )
+		{
+			const auto decoded = restinio::utils::base64::try_decode( encoded );
+			REQUIRE( decoded );
+			REQUIRE( data == *decoded );
+		}
+	}
+
+	// All chars from the alphabet in different positions.
+	{
+		std::string data;
+		for( int i = 0; i < 4; ++i )
+			for( int ch = 0; ch < 256; ++ch )
+				data.push_back( static_cast<char>( ch + i ) );
+
+		const auto encoded = restinio::utils::base64::encode( data );
+		REQUIRE( reference_base64_encode( data ) == encoded );
+		REQUIRE( data == restinio::utils::base64::decode( encoded ) );
+	}
+}
+
+TEST_CASE(
+	"Base64 decode invalid long strings" ,
+	"[encoders][base64][long]" )
+{
+	const auto encoded = restinio::utils::base64::encode(
+			make_test_data( 120u ) );
+	REQUIRE( 160u == encoded.size() );
+
+	for( std::size_t pos = 0u; pos < encoded.size(); ++pos )
+	{
+		for( const char ch : { '=', '\0', '\n', '-', '_', '\x80', '\xFF' } )
+		{
+			// Padding is allowed at the end.
+			if( '=' == ch && pos + 1u == encoded.size() )
+				continue;
+
+			auto str = encoded;
+			str[ pos ] = ch;
+
+			INFO( "pos: " << pos << ", ch: " << static_cast<int>(ch) );
+			REQUIRE_FALSE( restinio::utils::base64::try_decode( str ) );
+		}
+	}
+
+	// Padding in the middle of a string.
+	REQUIRE_FALSE( restinio::utils::base64::try_decode(
+			"QQ==" + encoded ) );
+	REQUIRE_FALSE( restinio::utils::base64::try_decode(
+			encoded.substr( 0u, 64u ) + "QQ==" + encoded.substr( 64u ) ) );
+
+	// The length isn't a multiple of 4.
+	REQUIRE_FALSE( restinio::utils::base64::try_decode(
+			encoded.substr( 0u, encoded.size() - 1u ) ) );
+	REQUIRE_FALSE( restinio::utils::base64::try_decode( "TWFueQ" ) );
+	REQUIRE_FALSE( restinio::utils::base64::try_decode( "TWFueQ=" ) );
+}
+
+TEST_CASE(
+	"Base64 encode/decode into buffer" ,
+	"[encoders][base64][buffer]" )
+{
+	using namespace restinio::utils::base64;
+
+	REQUIRE( 0u == encoded_size( 0u ) );
+	REQUIRE( 4u == encoded_size( 1u ) );
+	REQUIRE( 4u == encoded_size( 3u ) );
+	REQUIRE( 8u == encoded_size( 4u ) );
+
+	REQUIRE( 0u == max_decoded_size( 0u ) );
+	REQUIRE( 3u == max_decoded_size( 4u ) );
+	REQUIRE( 6u == max_decoded_size( 8u ) );
+
+	{
+		char buf[ 8 ];
+		REQUIRE( 8u == encode_to( "Many", buf ) );
+		REQUIRE( "TWFueQ==" == std::string( buf, 8u ) );
+
+		REQUIRE( 0u == encode_to( "", buf ) );
+	}
+
+	{
+		char buf[ 6 ];
+		const auto r = try_decode_to( "TWFueQ==", buf );
+		REQUIRE( r );
+		REQUIRE( 4u == *r );
+		REQUIRE( "Many" == std::string( buf, *r ) );
+
+		REQUIRE_FALSE( try_decode_to( "TWFue===", buf ) );
+		REQUIRE_FALSE( try_decode_to( "", buf ) );
+	}
+
+	{
+		const auto data = make_test_data( 1000u );
+		std::vector< char > encoded( encoded_size( data.size() ) );
+		REQUIRE( encoded.size() == encode_to( data, encoded.data() ) );
+
+		std::vector< char > decoded( max_decoded_size( encoded.size() ) );
+		const auto r = try_decode_to(
+				restinio::string_view_t{ encoded.data(), encoded.size() },
+				decoded.data() );
+		REQUIRE( r );
+		REQUIRE( data == std::string( decoded.data(), *r ) );
+	}
+}
+
 TEST_CASE(
 	"SHA-1 helper functions" ,
 	"[encoders][sha-1][helper functions]" )
@@ -431,3 +431,164 @@ TEST_CASE( "uint64" , "[uint64]" )
 		REQUIRE( v == i );
 	} while( i != std::numeric_limits< type_t >::max() );
 }
+
+TEST_CASE( "invalid integers" , "[integer][invalid]" )
+{
+	REQUIRE_THROWS_AS( from_string< int >( "" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( "-" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( "+" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( "1a" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( " 1" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( "1 " ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< int >( "+-1" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< unsigned >( "-1" ), restinio::exception_t );
+
+	REQUIRE_THROWS_AS( from_string< std::int16_t >( "32768" ), std::out_of_range );
+	REQUIRE_THROWS_AS( from_string< std::int16_t >( "-32769" ), std::out_of_range );
+	REQUIRE_THROWS_AS( from_string< std::uint64_t >( "18446744073709551616" ),
+			std::out_of_range );
+	REQUIRE_THROWS_AS( from_string< std::uint64_t >( "99999999999999999999999" ),
+			std::out_of_range );
+
+	// Leading zeros don't count.
+	REQUIRE( 127 == from_string< std::int8_t >( "0000000127" ) );
+	REQUIRE( -128 == from_string< std::int8_t >( "-0000000128" ) );
+}
+
+TEST_CASE( "other integral types" , "[integer]" )
+{
+	REQUIRE( 42 == from_string< int >( "42" ) );
+	REQUIRE( -42L == from_string< long >( "-42" ) );
+	REQUIRE( std::numeric_limits< long long >::min() ==
+			from_string< long long >( "-9223372036854775808" ) );
+	REQUIRE( std::numeric_limits< unsigned long long >::max() ==
+			from_string< unsigned long long >( "18446744073709551615" ) );
+	REQUIRE( 65535u == from_string< unsigned short >( "65535" ) );
+}
+
+TEST_CASE( "floating point" , "[float][double]" )
+{
+	REQUIRE( 0.0 == from_string< double >( "0" ) );
+	REQUIRE( 0.0 == from_string< double >( "-0.0" ) );
+	REQUIRE( 42.0 == from_string< double >( "42" ) );
+	REQUIRE( 42.0 == from_string< double >( "+42." ) );
+	REQUIRE( 0.5 == from_string< double >( ".5" ) );
+	REQUIRE( -1.25 == from_string< double >( "-1.25" ) );
+	REQUIRE( 1.5e10 == from_string< double >( "1.5e10" ) );
+	REQUIRE( 1.5e-10 == from_string< double >( "15E-11" ) );
+	REQUIRE( 0.1 == from_string< double >( "0.1" ) );
+	REQUIRE( 0.3 == from_string< double >( "0.3" ) );
+	REQUIRE( 1e300 == from_string< double >( "1e300" ) );
+	REQUIRE( 2.2250738585072014e-308 ==
+			from_string< double >( "2.2250738585072014e-308" ) );
+	REQUIRE( 3.141592653589793 ==
+			from_string< double >( "3.14159265358979323846264338327950288" ) );
+	REQUIRE( 9007199254740993.0 ==
+			from_string< double >( "9007199254740993" ) );
+
+	REQUIRE( 0.1f == from_string< float >( "0.1" ) );
+	REQUIRE( 3.4028235e38f == from_string< float >( "3.4028235e38" ) );
+	REQUIRE( 16777217.0f == from_string< float >( "16777217" ) );
+	REQUIRE( 1.5L == from_string< long double >( "1.5" ) );
+
+	REQUIRE_THROWS_AS( from_string< double >( "" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "." ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "e5" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "1e" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "1.5abc" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( " 1.5" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "inf" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "nan" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( from_string< double >( "1,5" ), restinio::exception_t );
+
+	REQUIRE_THROWS_AS( from_string< double >( "1e400" ), std::out_of_range );
+	REQUIRE_THROWS_AS( from_string< float >( "1e39" ), std::out_of_range );
+}
+
+TEST_CASE( "from_chars" , "[from_chars]" )
+{
+	{
+		const restinio::string_view_t str{ "123abc" };
+		int v = 0;
+		const auto r = from_chars( str.data(), str.data() + str.size(), v );
+		REQUIRE( std::errc{} == r.ec );
+		REQUIRE( 123 == v );
+		REQUIRE( str.data() + 3 == r.ptr );
+	}
+	{
+		const restinio::string_view_t str{ "abc" };
+		int v = 42;
+		const auto r = from_chars( str.data(), str.data() + str.size(), v );
+		REQUIRE( std::errc::invalid_argument == r.ec );
+		REQUIRE( 42 == v );
+		REQUIRE( str.data() == r.ptr );
+	}
+	{
+		const restinio::string_view_t str{ "300;" };
+		std::uint8_t v = 42;
+		const auto r = from_chars( str.data(), str.data() + str.size(), v );
+		REQUIRE( std::errc::result_out_of_range == r.ec );
+		REQUIRE( 42 == v );
+		REQUIRE( str.data() + 3 == r.ptr );
+	}
+	{
+		const restinio::string_view_t str{ "1.5e3x" };
+		double v = 0.0;
+		const auto r = from_chars( str.data(), str.data() + str.size(), v );
+		REQUIRE( std::errc{} == r.ec );
+		REQUIRE( 1500.0 == v );
+		REQUIRE( str.data() + 5 == r.ptr );
+	}
+	{
+		const restinio::string_view_t str{ "2e+" };
+		double v = 0.0;
+		const auto r = from_chars( str.data(), str.data() + str.size(), v );
+		REQUIRE( std::errc{} == r.ec );
+		REQUIRE( 2.0 == v );
+		REQUIRE( str.data() + 1 == r.ptr );
+	}
+}
+
+TEST_CASE( "to_chars" , "[to_chars]" )
+{
+	const auto check = []( auto value ) {
+		char buf[ 64 ];
+		const auto r = to_chars( buf, buf + sizeof(buf), value );
+		REQUIRE( std::errc{} == r.ec );
+		return std::string( buf, r.ptr );
+	};
+
+	REQUIRE( "0" == check( 0 ) );
+	REQUIRE( "7" == check( 7u ) );
+	REQUIRE( "10" == check( 10 ) );
+	REQUIRE( "-99" == check( -99 ) );
+	REQUIRE( "100" == check( std::uint8_t{ 100 } ) );
+	REQUIRE( "-128" == check( std::int8_t{ -128 } ) );
+	REQUIRE( "-9223372036854775808" ==
+			check( std::numeric_limits< std::int64_t >::min() ) );
+	REQUIRE( "18446744073709551615" ==
+			check( std::numeric_limits< std::uint64_t >::max() ) );
+
+	for( std::int64_t i = -100000; i <= 100000; i += 7 )
+		REQUIRE( std::to_string( i ) == check( i ) );
+
+	REQUIRE( "0.1" == check( 0.1 ) );
+	REQUIRE( "1.5" == check( 1.5f ) );
+	REQUIRE( 0.3 == from_string< double >( check( 0.3 ) ) );
+	REQUIRE( 1e300 == from_string< double >( check( 1e300 ) ) );
+
+	{
+		char buf[ 3 ];
+		const auto r = to_chars( buf, buf + sizeof(buf), 1234 );
+		REQUIRE( std::errc::value_too_large == r.ec );
+		REQUIRE( buf + sizeof(buf) == r.ptr );
+	}
+	{
+		char buf[ 3 ];
+		const auto r = to_chars( buf, buf + sizeof(buf), 123.5 );
+		REQUIRE( std::errc::value_too_large == r.ec );
+	}
+
+	REQUIRE( "-42" == number_to_chars( -42 ).str() );
+	REQUIRE( "2.5" == number_to_chars( 2.5 ).view() );
+}
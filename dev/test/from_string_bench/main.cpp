@@ -136,6 +136,23 @@ cast_dataset_t< std::uint32_t > uints32_data;
 cast_dataset_t< std::int64_t > ints64_data;
 cast_dataset_t< std::uint64_t > uints64_data;
 
+cast_dataset_t< double > doubles_data;
+
+auto
+create_doubles( std::size_t n )
+{
+	cast_dataset_t< double > result;
+	while( n-- )
+	{
+		// Values like prices and coordinates: a few digits after the point.
+		const auto str = fmt::format( "{}.{:03}",
+				std::rand() % 100000 - 50000, std::rand() % 1000 );
+		result.emplace_back( str, std::stod( str ) );
+	}
+
+	return result;
+}
+
 void
 init_datasets( size_t n )
 {
@@ -149,6 +166,7 @@ init_datasets( size_t n )
 	uints32_data = create_ints< std::uint32_t >( n );
 	ints64_data = create_ints< std::int64_t >( n );
 	uints64_data = create_ints< std::uint64_t >( n );
+	doubles_data = create_doubles( n );
 }
 
 constexpr std::size_t iterations = 1000;
@@ -175,6 +193,53 @@ void bench_int32(){ bench_intN( ints32_data ); }
 void bench_uint32(){ bench_intN( uints32_data ); }
 void bench_int64(){ bench_intN( ints64_data ); }
 void bench_uint64(){ bench_intN( uints64_data ); }
+void bench_double(){ bench_intN( doubles_data ); }
+
+void
+std_bench_double()
+{
+	for( std::size_t i = 0; i < iterations; ++i )
+	{
+		for( const auto & p : doubles_data )
+		{
+			if( p.m_int != std::stod( p.m_str ) )
+				throw std::runtime_error{ "std_bench_double failed" };
+		}
+	}
+}
+
+template < typename Integer >
+void
+to_chars_bench_intN( const cast_dataset_t< Integer > & data )
+{
+	for( std::size_t i = 0; i < iterations; ++i )
+	{
+		for( const auto & p : data )
+		{
+			char buf[ 32 ];
+			const auto r = restinio::utils::to_chars( buf, buf + sizeof(buf), p.m_int );
+			if( static_cast< std::size_t >( r.ptr - buf ) > p.m_str.size() )
+				throw std::runtime_error{ "to_chars_bench_intN failed" };
+		}
+	}
+}
+
+template < typename Integer >
+void
+std_to_string_bench_intN( const cast_dataset_t< Integer > & data )
+{
+	for( std::size_t i = 0; i < iterations; ++i )
+	{
+		for( const auto & p : data )
+		{
+			if( std::to_string( p.m_int ).size() > p.m_str.size() )
+				throw std::runtime_error{ "std_to_string_bench_intN failed" };
+		}
+	}
+}
+
+void to_chars_bench_int64(){ to_chars_bench_intN( ints64_data ); }
+void std_to_string_bench_int64(){ std_to_string_bench_intN( ints64_data ); }
 
 template < typename Integer >
 void
@@ -235,6 +300,14 @@ main()
 		run_bench( "uint32", bench_uint32 );
 		run_bench( "int64", bench_int64 );
 		run_bench( "uint64", bench_uint64 );
+		run_bench( "double", bench_double );
+
+		std::cout << "\nstd:" << std::endl;
+		run_bench( "std::stod", std_bench_double );
+
+		std::cout << "\nto_chars:" << std::endl;
+		run_bench( "to_chars int64", to_chars_bench_int64 );
+		run_bench( "std::to_string int64", std_to_string_bench_int64 );
 
 		std::cout << "\nBoost:" << std::endl;
 		// run_bench( "boost int8", boost_bench_int8 );
@@ -0,0 +1,225 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/async_chain/fixed_size.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include "../../common/test_extra_data_factory.ipp"
+
+namespace ac = restinio::async_chain;
+
+template< typename Extra_Data_Factory >
+struct test_traits_t : public restinio::traits_t<
+	restinio::asio_timer_manager_t, utest_logger_t >
+{
+	using request_handler_t = ac::fixed_size_chain_t< 3u, Extra_Data_Factory >;
+	using extra_data_factory_t = Extra_Data_Factory;
+};
+
+const char * request_str =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"User-Agent: unit-test\r\n"
+	"Accept: */*\r\n"
+	"Connection: close\r\n"
+	"\r\n";
+
+// Stage that resumes the chain from another thread with a given status.
+struct deferring_stage_t
+{
+	std::vector< std::thread > * m_resumers;
+	std::thread::id * m_resumer_id;
+	ac::stage_status_t m_status;
+
+	template< typename Request_Handle, typename Ctx >
+	ac::stage_status_t
+	operator()( const Request_Handle &, const Ctx & ctx ) const
+	{
+		auto resumer_id = m_resumer_id;
+		m_resumers->emplace_back(
+			[continuation = ctx.make_continuation(), resumer_id,
+				status = m_status] {
+				*resumer_id = std::this_thread::get_id();
+				std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+				continuation.resume( status );
+			} );
+
+		return ac::stage_deferred();
+	}
+};
+
+template< typename Extra_Data_Factory >
+std::string
+run_chain(
+	ac::stage_status_t deferred_status,
+	ac::stage_status_t last_status,
+	int & stages_completed,
+	std::thread::id & resumer_id,
+	std::thread::id & last_stage_thread_id )
+{
+	using http_server_t = restinio::http_server_t<
+			test_traits_t< Extra_Data_Factory > >;
+
+	std::vector< std::thread > resumers;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler(
+					[&stages_completed]( const auto &, const auto & ) {
+						++stages_completed;
+						return ac::next_stage();
+					},
+					deferring_stage_t{ &resumers, &resumer_id, deferred_status },
+					[&]( const auto & req, const auto & ) {
+						++stages_completed;
+						last_stage_thread_id = std::this_thread::get_id();
+
+						if( ac::stage_status_t::accepted == last_status )
+							req->create_response()
+								.append_header( "Server", "RESTinio utest server" )
+								.append_header_date_field()
+								.append_header( "Content-Type", "text/plain; charset=utf-8" )
+								.set_body(
+									restinio::const_buffer( req->header().method().c_str() ) )
+								.done();
+
+						return last_status;
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+
+	other_thread.stop_and_join();
+
+	for( auto & t : resumers )
+		t.join();
+
+	return response;
+}
+
+template< typename Extra_Data_Factory >
+void
+tc_deferred_stage()
+{
+	int stages_completed = 0;
+	std::thread::id resumer_id;
+	std::thread::id last_stage_thread_id;
+
+	const auto response = run_chain< Extra_Data_Factory >(
+			ac::next_stage(),
+			ac::stage_accepted(),
+			stages_completed,
+			resumer_id,
+			last_stage_thread_id );
+
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "GET" ) );
+	REQUIRE( 2 == stages_completed );
+	REQUIRE( std::thread::id{} != last_stage_thread_id );
+	REQUIRE( resumer_id != last_stage_thread_id );
+}
+
+TEST_CASE( "async_chain deferred stage (no_user_data)" ,
+		"[async_chain][no_user_data]" )
+{
+	tc_deferred_stage< restinio::no_extra_data_factory_t >();
+}
+
+TEST_CASE( "async_chain deferred stage (test_user_data)" ,
+		"[async_chain][test_user_data]" )
+{
+	tc_deferred_stage< test::ud_factory_t >();
+}
+
+TEST_CASE( "async_chain rejected by deferred stage" ,
+		"[async_chain][rejected]" )
+{
+	int stages_completed = 0;
+	std::thread::id resumer_id;
+	std::thread::id last_stage_thread_id;
+
+	const auto response = run_chain< restinio::no_extra_data_factory_t >(
+			ac::stage_rejected(),
+			ac::stage_accepted(),
+			stages_completed,
+			resumer_id,
+			last_stage_thread_id );
+
+	REQUIRE_THAT( response,
+			Catch::Matchers::StartsWith( "HTTP/1.1 501 Not Implemented" ) );
+	REQUIRE( 1 == stages_completed );
+}
+
+TEST_CASE( "async_chain not handled after resume" ,
+		"[async_chain][not_handled]" )
+{
+	int stages_completed = 0;
+	std::thread::id resumer_id;
+	std::thread::id last_stage_thread_id;
+
+	const auto response = run_chain< restinio::no_extra_data_factory_t >(
+			ac::next_stage(),
+			ac::next_stage(),
+			stages_completed,
+			resumer_id,
+			last_stage_thread_id );
+
+	REQUIRE_THAT( response,
+			Catch::Matchers::StartsWith( "HTTP/1.1 501 Not Implemented" ) );
+	REQUIRE( 2 == stages_completed );
+}
+
+TEST_CASE( "async_chain without deferred stages" , "[async_chain][sync]" )
+{
+	using chain_t = ac::fixed_size_chain_t< 3u >;
+
+	int stages_completed = 0;
+	const auto stage = [&stages_completed]( ac::stage_status_t status ) {
+		return [&stages_completed, status](
+			const restinio::request_handle_t &,
+			const chain_t::stage_context_t & )
+		{
+			++stages_completed;
+			return status;
+		};
+	};
+
+	const restinio::request_handle_t req;
+
+	const chain_t accepting{
+			stage( ac::next_stage() ),
+			stage( ac::stage_accepted() ),
+			stage( ac::stage_rejected() ) };
+	REQUIRE( restinio::request_handling_status_t::accepted == accepting( req ) );
+	REQUIRE( 2 == stages_completed );
+
+	stages_completed = 0;
+	const chain_t rejecting{
+			stage( ac::stage_rejected() ),
+			stage( ac::stage_accepted() ),
+			stage( ac::stage_accepted() ) };
+	REQUIRE( restinio::request_handling_status_t::rejected == rejecting( req ) );
+	REQUIRE( 1 == stages_completed );
+
+	stages_completed = 0;
+	const chain_t not_handled{
+			stage( ac::next_stage() ),
+			stage( ac::next_stage() ),
+			stage( ac::next_stage() ) };
+	REQUIRE( restinio::request_handling_status_t::not_handled ==
+			not_handled( req ) );
+	REQUIRE( 3 == stages_completed );
+}
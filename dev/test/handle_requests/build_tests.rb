@@ -12,10 +12,15 @@ MxxRu::Cpp::composite_target {
 		remote_endpoint
 		connection_state
 		ip_blocker
+		metrics
+		tracing
 		slow_transmit
 		throw_exception
 		timeouts
 		upgrade
+		http2_fallback
+		graceful_drain
+		http2
 		user_controlled_output
 		chunked_input
       acceptor_post_bind_hook
@@ -23,6 +28,7 @@ MxxRu::Cpp::composite_target {
       connection_count_limit
       user_data_simple
       chained_handlers
+      async_chain
 	].each do |name|
 		required_prj "test/handle_requests/#{name}/prj.ut.rb"
 	end
@@ -7,6 +7,7 @@
 #include <restinio/all.hpp>
 #include <restinio/sync_chain/fixed_size.hpp>
 #include <restinio/sync_chain/growable_size.hpp>
+#include <restinio/sync_chain/static.hpp>
 
 #include <test/common/utest_logger.hpp>
 #include <test/common/pub.hpp>
@@ -532,3 +533,141 @@ TEST_CASE( "growable_size_chain_accept_in_middle (test_user_data)" ,
 	tc_growable_size_chain_accept_in_middle< test::ud_factory_t >();
 }
 
+
+// A handler for static_chain that only counts its calls.
+struct counting_stage_t
+{
+	int * m_stages_completed;
+	restinio::request_handling_status_t m_result;
+
+	template< typename Request_Handle >
+	restinio::request_handling_status_t
+	operator()( const Request_Handle & /*req*/ ) const
+	{
+		++(*m_stages_completed);
+		return m_result;
+	}
+};
+
+// A handler for static_chain that sends a response.
+struct responding_stage_t
+{
+	int * m_stages_completed;
+
+	template< typename Request_Handle >
+	restinio::request_handling_status_t
+	operator()( const Request_Handle & req ) const
+	{
+		++(*m_stages_completed);
+
+		req->create_response()
+			.append_header( "Server", "RESTinio utest server" )
+			.append_header_date_field()
+			.append_header( "Content-Type", "text/plain; charset=utf-8" )
+			.set_body(
+				restinio::const_buffer( req->header().method().c_str() ) )
+			.done();
+
+		return restinio::request_accepted();
+	}
+};
+
+template< typename Extra_Data_Factory >
+void
+tc_static_chain()
+{
+	using http_server_t = restinio::http_server_t<
+			test_traits_t<
+					restinio::sync_chain::static_chain_t<
+							counting_stage_t,
+							counting_stage_t,
+							responding_stage_t,
+							counting_stage_t >,
+					Extra_Data_Factory >
+	>;
+
+	int stages_completed = 0;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&stages_completed]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler(
+					counting_stage_t{
+						&stages_completed, restinio::request_not_handled() },
+					counting_stage_t{
+						&stages_completed, restinio::request_not_handled() },
+					responding_stage_t{ &stages_completed },
+					counting_stage_t{
+						&stages_completed, restinio::request_rejected() } );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	std::string response;
+	const char * request_str =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"User-Agent: unit-test\r\n"
+		"Accept: */*\r\n"
+		"Connection: close\r\n"
+		"\r\n";
+
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "GET" ) );
+
+	other_thread.stop_and_join();
+
+	REQUIRE( 3 == stages_completed );
+}
+
+TEST_CASE( "static_chain (no_user_data)" ,
+		"[static_chain][no_user_data]" )
+{
+	tc_static_chain< restinio::no_extra_data_factory_t >();
+}
+
+TEST_CASE( "static_chain (test_user_data)" ,
+		"[static_chain][test_user_data]" )
+{
+	tc_static_chain< test::ud_factory_t >();
+}
+
+TEST_CASE( "static_chain results" , "[static_chain][results]" )
+{
+	using restinio::request_handling_status_t;
+
+	int stages_completed = 0;
+	const auto stage = [&stages_completed]( request_handling_status_t r ) {
+		return counting_stage_t{ &stages_completed, r };
+	};
+
+	const restinio::request_handle_t req;
+
+	auto rejecting = restinio::sync_chain::make_static_chain(
+			stage( restinio::request_not_handled() ),
+			stage( restinio::request_rejected() ),
+			stage( restinio::request_accepted() ) );
+	REQUIRE( request_handling_status_t::rejected == rejecting( req ) );
+	REQUIRE( 2 == stages_completed );
+
+	stages_completed = 0;
+	auto not_handled = restinio::sync_chain::make_static_chain(
+			stage( restinio::request_not_handled() ),
+			[&stages_completed]( const restinio::request_handle_t & ) {
+				++stages_completed;
+				return restinio::request_not_handled();
+			} );
+	REQUIRE( request_handling_status_t::not_handled == not_handled( req ) );
+	REQUIRE( 2 == stages_completed );
+
+	stages_completed = 0;
+	const restinio::sync_chain::static_chain_t< counting_stage_t > single{
+			stage( restinio::request_accepted() ) };
+	REQUIRE( request_handling_status_t::accepted == single( req ) );
+	REQUIRE( 1 == stages_completed );
+}
@@ -0,0 +1,497 @@
+/*
+	restinio
+*/
+
+/*!
+	Test graceful drain of HTTP-server.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include <condition_variable>
+#include <future>
+
+namespace
+{
+
+using http_server_t =
+	restinio::http_server_t<
+		restinio::traits_t<
+			restinio::asio_timer_manager_t,
+			utest_logger_t > >;
+
+//! Requests that are waiting for a response.
+struct delayed_requests_t
+{
+	std::mutex m_lock;
+	std::condition_variable m_arrived;
+	std::vector< restinio::request_handle_t > m_requests;
+
+	void
+	push( restinio::request_handle_t req )
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_requests.push_back( std::move( req ) );
+		m_arrived.notify_all();
+	}
+
+	void
+	wait_for( std::size_t count )
+	{
+		std::unique_lock< std::mutex > lock{ m_lock };
+		m_arrived.wait( lock, [&]{ return m_requests.size() >= count; } );
+	}
+
+	void
+	respond_all()
+	{
+		std::vector< restinio::request_handle_t > requests;
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+			requests.swap( m_requests );
+		}
+
+		for( auto & req : requests )
+			req->create_response()
+				.append_header( "Content-Type", "text/plain; charset=utf-8" )
+				.set_body( "delayed" )
+				.done();
+	}
+};
+
+auto
+make_server(
+	delayed_requests_t & delayed,
+	restinio::io_context_holder_t io_context = restinio::own_io_context() )
+{
+	return std::make_unique< http_server_t >(
+		std::move( io_context ),
+		[&delayed]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.max_pipelined_requests( 4u )
+				.request_handler(
+					[&delayed]( auto req ){
+						if( "/delayed" == req->header().path() )
+						{
+							delayed.push( std::move( req ) );
+						}
+						else
+						{
+							req->create_response()
+								.append_header( "Content-Type", "text/plain; charset=utf-8" )
+								.set_body( "ordinary" )
+								.done();
+						}
+
+						return restinio::request_accepted();
+					} );
+		} );
+}
+
+//! Collector of drain progress notifications.
+struct drain_results_t
+{
+	std::mutex m_lock;
+	std::vector< restinio::drain_progress_t > m_notifications;
+	std::promise< restinio::drain_progress_t > m_finished;
+
+	void
+	start(
+		http_server_t & server,
+		std::chrono::steady_clock::duration timeout )
+	{
+		server.drain_async(
+			timeout,
+			[this]( const restinio::drain_progress_t & progress ) {
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_notifications.push_back( progress );
+				if( progress.m_finished )
+					m_finished.set_value( progress );
+			},
+			[this]( std::exception_ptr ex ) {
+				m_finished.set_exception( ex );
+			} );
+	}
+};
+
+const std::string keep_alive_request{
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"\r\n" };
+
+const std::string delayed_request{
+	"GET /delayed HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"\r\n" };
+
+std::string
+read_all( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	std::string result;
+
+	restinio::asio_ns::error_code error;
+	char buf[ 256 ];
+	for(;;)
+	{
+		const auto n = socket.read_some(
+				restinio::asio_ns::buffer( buf ), error );
+		if( error )
+			break;
+		result.append( buf, n );
+	}
+
+	if( !restinio::error_is_eof( error ) )
+		throw std::runtime_error{ fmt::format( "read error: {}", error ) };
+
+	return result;
+}
+
+std::string
+read_response_header( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	restinio::asio_ns::streambuf response_stream;
+	const auto header_size = restinio::asio_ns::read_until(
+			socket, response_stream, "\r\n\r\n" );
+
+	return std::string{
+			restinio::asio_ns::buffers_begin( response_stream.data() ),
+			restinio::asio_ns::buffers_begin( response_stream.data() ) +
+					static_cast< std::ptrdiff_t >( header_size ) };
+}
+
+} /* anonymous namespace */
+
+TEST_CASE( "Drain without connections" , "[drain]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+	drain.start( *http_server, std::chrono::seconds{ 5 } );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( result.m_finished );
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	// New connections aren't accepted.
+	REQUIRE_THROWS( do_request( keep_alive_request ) );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain of idle keep-alive connection" , "[drain][keep_alive]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( keep_alive_request ) );
+
+		const auto header = read_response_header( socket );
+		REQUIRE_THAT( header, Catch::Matchers::Contains( "Connection: keep-alive" ) );
+
+		drain.start( *http_server, std::chrono::seconds{ 5 } );
+
+		// The connection is closed by the server.
+		REQUIRE_NOTHROW( read_all( socket ) );
+	} );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain with request in progress" , "[drain][in_progress]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( delayed_request ) );
+
+		delayed.wait_for( 1u );
+
+		drain.start( *http_server, std::chrono::seconds{ 5 } );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		delayed.respond_all();
+
+		std::string response;
+		REQUIRE_NOTHROW( response = read_all( socket ) );
+		REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+		REQUIRE_THAT( response, Catch::Matchers::Contains( "Connection: close" ) );
+		REQUIRE_THAT( response, Catch::Matchers::EndsWith( "delayed" ) );
+	} );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	std::lock_guard< std::mutex > lock{ drain.m_lock };
+	REQUIRE( 2u == drain.m_notifications.size() );
+	REQUIRE( 1u == drain.m_notifications.front().m_alive_connections );
+	REQUIRE_FALSE( drain.m_notifications.front().m_finished );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain with request body in progress" , "[drain][body]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( std::string{
+						"POST / HTTP/1.1\r\n"
+						"Host: 127.0.0.1\r\n"
+						"Content-Length: 4\r\n"
+						"\r\n" } ) );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		// The drain starts between the header block and the body.
+		drain.start( *http_server, std::chrono::seconds{ 5 } );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( std::string{ "body" } ) );
+
+		std::string response;
+		REQUIRE_NOTHROW( response = read_all( socket ) );
+		REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+		REQUIRE_THAT( response, Catch::Matchers::Contains( "Connection: close" ) );
+		REQUIRE_THAT( response, Catch::Matchers::EndsWith( "ordinary" ) );
+	} );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain deadline" , "[drain][deadline]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( delayed_request ) );
+
+		delayed.wait_for( 1u );
+
+		drain.start( *http_server, std::chrono::milliseconds{ 100 } );
+
+		// The connection is closed forcibly without a response.
+		std::string response;
+		REQUIRE_NOTHROW( response = read_all( socket ) );
+		REQUIRE( response.empty() );
+	} );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( result.m_deadline_expired );
+
+	// The request is still held by the delayed handler.
+	REQUIRE( 1u == result.m_alive_connections );
+
+	delayed.respond_all();
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain with pipelined requests" , "[drain][pipelining]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	drain_results_t drain;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( delayed_request + delayed_request ) );
+
+		delayed.wait_for( 2u );
+
+		drain.start( *http_server, std::chrono::seconds{ 5 } );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		// This request is received after the start of the drain,
+		// it isn't handled.
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( keep_alive_request ) );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		delayed.respond_all();
+
+		std::string response;
+		REQUIRE_NOTHROW( response = read_all( socket ) );
+
+		// Both pipelined requests are answered and only the last
+		// response closes the connection.
+		const auto second_response_pos = response.find( "HTTP/1.1 200 OK", 1u );
+		REQUIRE( std::string::npos != second_response_pos );
+
+		const auto first_response = response.substr( 0u, second_response_pos );
+		const auto second_response = response.substr( second_response_pos );
+
+		REQUIRE_THAT( first_response,
+				Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+		REQUIRE_THAT( first_response,
+				Catch::Matchers::Contains( "Connection: keep-alive" ) );
+		REQUIRE_THAT( first_response, Catch::Matchers::EndsWith( "delayed" ) );
+
+		REQUIRE_THAT( second_response,
+				Catch::Matchers::Contains( "Connection: close" ) );
+		REQUIRE_THAT( second_response, Catch::Matchers::EndsWith( "delayed" ) );
+	} );
+
+	const auto result = drain.m_finished.get_future().get();
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Open after drain" , "[drain][reopen]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	{
+		other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+		other_thread.run();
+
+		drain_results_t drain;
+		drain.start( *http_server, std::chrono::seconds{ 5 } );
+
+		const auto result = drain.m_finished.get_future().get();
+		REQUIRE( result.m_finished );
+
+		other_thread.stop_and_join();
+	}
+
+	http_server->io_context().restart();
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::streambuf response_stream;
+
+		// The connection isn't in the drain mode and survives
+		// several requests.
+		for( int i = 0; i != 2; ++i )
+		{
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer( keep_alive_request ) );
+
+			const auto size = restinio::asio_ns::read_until(
+					socket, response_stream, "ordinary" );
+			const std::string response{
+					restinio::asio_ns::buffers_begin( response_stream.data() ),
+					restinio::asio_ns::buffers_begin( response_stream.data() ) +
+							static_cast< std::ptrdiff_t >( size ) };
+			response_stream.consume( size );
+
+			REQUIRE_THAT( response,
+					Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+			REQUIRE_THAT( response,
+					Catch::Matchers::Contains( "Connection: keep-alive" ) );
+		}
+	} );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Destruction of server during drain" , "[drain][destroy]" )
+{
+	delayed_requests_t delayed;
+	restinio::asio_ns::io_context io_context;
+	auto work = restinio::asio_ns::make_work_guard( io_context );
+
+	auto http_server = make_server(
+			delayed, restinio::external_io_context( io_context ) );
+
+	std::thread io_thread{ [&io_context] { io_context.run(); } };
+
+	std::promise< void > opened;
+	http_server->open_async(
+		[&opened]{ opened.set_value(); },
+		[&opened]( std::exception_ptr ex ){ opened.set_exception( ex ); } );
+	opened.get_future().get();
+
+	drain_results_t drain;
+	std::promise< void > destroyed;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( delayed_request ) );
+
+		delayed.wait_for( 1u );
+
+		drain.start( *http_server, std::chrono::milliseconds{ 200 } );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+		// The server is destroyed on its context during the drain.
+		restinio::asio_ns::post( io_context, [&] {
+				http_server.reset();
+				destroyed.set_value();
+			} );
+		destroyed.get_future().get();
+
+		// The connection is closed after the destruction of the server.
+		delayed.respond_all();
+
+		REQUIRE_NOTHROW( read_all( socket ) );
+	} );
+
+	// The deadline of the drain has passed.
+	std::this_thread::sleep_for( std::chrono::milliseconds( 300 ) );
+
+	work.reset();
+	io_context.stop();
+	io_thread.join();
+
+	std::lock_guard< std::mutex > lock{ drain.m_lock };
+	REQUIRE( 1u == drain.m_notifications.size() );
+	REQUIRE_FALSE( drain.m_notifications.front().m_finished );
+}
@@ -0,0 +1,867 @@
+/*
+	restinio
+*/
+
+/*!
+	Test handling of HTTP/2 connections.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <restinio/impl/http2/frames.hpp>
+#include <restinio/impl/http2/hpack.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include <condition_variable>
+#include <future>
+#include <map>
+
+namespace
+{
+
+namespace h2 = restinio::impl::http2;
+
+struct http2_traits_t
+	:	public restinio::traits_t< restinio::asio_timer_manager_t, utest_logger_t >
+{
+	static constexpr bool use_http2 = true;
+};
+
+using http_server_t = restinio::http_server_t< http2_traits_t >;
+
+//! Requests that are waiting for a response.
+struct delayed_requests_t
+{
+	std::mutex m_lock;
+	std::condition_variable m_arrived;
+	std::vector< restinio::request_handle_t > m_requests;
+
+	void
+	push( restinio::request_handle_t req )
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+		m_requests.push_back( std::move( req ) );
+		m_arrived.notify_all();
+	}
+
+	void
+	wait_for( std::size_t count )
+	{
+		std::unique_lock< std::mutex > lock{ m_lock };
+		m_arrived.wait( lock, [&]{ return m_requests.size() >= count; } );
+	}
+
+	void
+	respond_all()
+	{
+		std::vector< restinio::request_handle_t > requests;
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+			requests.swap( m_requests );
+		}
+
+		for( auto & req : requests )
+			req->create_response()
+				.append_header( "Content-Type", "text/plain; charset=utf-8" )
+				.set_body( "delayed" )
+				.done();
+	}
+};
+
+template< typename Settings_Tweaker >
+auto
+make_server( delayed_requests_t & delayed, Settings_Tweaker tweaker )
+{
+	return std::make_unique< http_server_t >(
+		restinio::own_io_context(),
+		[&delayed, &tweaker]( auto & settings ){
+			tweaker( settings );
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.http2_max_concurrent_streams( 4u )
+				.request_handler(
+					[&delayed]( auto req ){
+						const auto path = req->header().path();
+						if( "/" == path )
+						{
+							req->create_response()
+								.append_header( "Server", "RESTinio utest server" )
+								.append_header( "Content-Type", "text/plain; charset=utf-8" )
+								.set_body( fmt::format( "hello {}.{} {}",
+										req->header().http_major(),
+										req->header().http_minor(),
+										req->header().get_field_or( "Host", "-" ) ) )
+								.done();
+						}
+						else if( "/echo" == path )
+						{
+							req->create_response()
+								.set_body( req->body() )
+								.done();
+						}
+						else if( "/big" == path )
+						{
+							req->create_response()
+								.set_body( std::string( 100000u, 'x' ) )
+								.done();
+						}
+						else if( "/chunked" == path )
+						{
+							auto resp = req->template create_response<
+									restinio::chunked_output_t >();
+							resp.append_chunk( "abc" );
+							resp.flush();
+							resp.append_chunk( "def" );
+							resp.done();
+						}
+						else if( "/delayed" == path )
+						{
+							delayed.push( std::move( req ) );
+						}
+						else
+							return restinio::request_rejected();
+
+						return restinio::request_accepted();
+					} );
+		} );
+}
+
+auto
+make_server( delayed_requests_t & delayed )
+{
+	return make_server( delayed, []( auto & /*settings*/ ){} );
+}
+
+//! A frame received from the server.
+struct frame_t
+{
+	h2::frame_header_t m_header;
+	std::string m_payload;
+};
+
+//! A response received from the server.
+struct response_t
+{
+	restinio::impl::http2::hpack::header_list_t m_fields;
+	std::string m_body;
+	bool m_completed{ false };
+	//! Error code of RST_STREAM (if the stream was reset).
+	std::uint32_t m_reset_error{};
+	bool m_reset{ false };
+
+	std::string
+	status() const
+	{
+		for( const auto & f : m_fields )
+			if( ":status" == f.first )
+				return f.second;
+		return {};
+	}
+};
+
+//! A minimal HTTP/2 client.
+class client_t
+{
+public:
+	explicit client_t( restinio::asio_ns::ip::tcp::socket & socket )
+		:	m_socket{ socket }
+	{}
+
+	//! Send the client preface and SETTINGS frame.
+	void
+	start( std::uint32_t initial_window_size = 65535u )
+	{
+		std::string settings;
+		h2::append_setting(
+				settings, h2::setting_id_t::initial_window_size, initial_window_size );
+
+		std::string data{ "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n" };
+		h2::append_frame( data, h2::frame_type_t::settings, 0u, 0u, settings );
+		write( data );
+	}
+
+	//! Append HEADERS frame of a request to @a to.
+	void
+	make_request(
+		std::string & to,
+		std::uint32_t stream_id,
+		restinio::string_view_t method,
+		restinio::string_view_t path,
+		restinio::string_view_t body = {} )
+	{
+		std::string block;
+		m_encoder.start_block( block );
+		m_encoder.encode_field( block, ":method", method );
+		m_encoder.encode_field( block, ":scheme", "http" );
+		m_encoder.encode_field( block, ":path", path );
+		m_encoder.encode_field( block, ":authority", "127.0.0.1" );
+		if( !body.empty() )
+			m_encoder.encode_field( block, "content-length",
+					std::to_string( body.size() ) );
+
+		h2::append_frame(
+				to,
+				h2::frame_type_t::headers,
+				static_cast< std::uint8_t >( h2::flag_end_headers |
+						( body.empty() ? h2::flag_end_stream : 0u ) ),
+				stream_id,
+				block );
+
+		if( !body.empty() )
+			h2::append_frame(
+					to, h2::frame_type_t::data, h2::flag_end_stream, stream_id, body );
+	}
+
+	void
+	send_request(
+		std::uint32_t stream_id,
+		restinio::string_view_t method,
+		restinio::string_view_t path,
+		restinio::string_view_t body = {} )
+	{
+		std::string data;
+		make_request( data, stream_id, method, path, body );
+		write( data );
+	}
+
+	void
+	write( const std::string & data )
+	{
+		restinio::asio_ns::write( m_socket, restinio::asio_ns::buffer( data ) );
+	}
+
+	frame_t
+	read_frame()
+	{
+		char header[ h2::frame_header_size ];
+		restinio::asio_ns::read( m_socket, restinio::asio_ns::buffer( header ) );
+
+		frame_t frame;
+		frame.m_header = h2::parse_frame_header( header );
+		frame.m_payload.resize( frame.m_header.m_length );
+		if( !frame.m_payload.empty() )
+			restinio::asio_ns::read(
+					m_socket,
+					restinio::asio_ns::buffer( &frame.m_payload[ 0 ], frame.m_payload.size() ) );
+
+		m_frames.push_back( frame.m_header.m_type );
+
+		return frame;
+	}
+
+	//! Read frames until @a count streams are completed or reset.
+	/*!
+		@param window_updates If true then WINDOW_UPDATE frames are sent
+		for every DATA frame.
+	*/
+	void
+	read_responses( std::size_t count, bool window_updates = false )
+	{
+		std::size_t finished = 0u;
+		while( finished < count )
+		{
+			const auto frame = read_frame();
+			const auto & header = frame.m_header;
+			auto & response = m_responses[ header.m_stream_id ];
+
+			switch( header.m_type )
+			{
+				case h2::frame_type_t::settings:
+					if( !header.has_flag( h2::flag_ack ) )
+					{
+						const char * p = frame.m_payload.data();
+						for( std::size_t pos = 0u;
+							pos + 6u <= frame.m_payload.size();
+							pos += 6u )
+						{
+							m_server_settings[ h2::read_uint16( p + pos ) ] =
+									h2::read_uint32( p + pos + 2u );
+						}
+
+						std::string ack;
+						h2::append_frame( ack, h2::frame_type_t::settings, h2::flag_ack, 0u, {} );
+						write( ack );
+					}
+				break;
+
+				case h2::frame_type_t::headers:
+					REQUIRE( header.has_flag( h2::flag_end_headers ) );
+					REQUIRE( h2::hpack::decoding_result_t::success ==
+							m_decoder.decode(
+									frame.m_payload,
+									restinio::incoming_http_msg_limits_t{},
+									h2::max_header_list_size,
+									response.m_fields ) );
+				break;
+
+				case h2::frame_type_t::data:
+					response.m_body += frame.m_payload;
+					if( window_updates && !frame.m_payload.empty() )
+					{
+						std::string update;
+						const auto size = static_cast< std::uint32_t >( frame.m_payload.size() );
+						h2::append_window_update( update, 0u, size );
+						h2::append_window_update( update, header.m_stream_id, size );
+						write( update );
+					}
+				break;
+
+				case h2::frame_type_t::rst_stream:
+					response.m_reset = true;
+					response.m_reset_error = h2::read_uint32( frame.m_payload.data() );
+					++finished;
+				break;
+
+				case h2::frame_type_t::goaway:
+					m_goaway_error = h2::read_uint32( frame.m_payload.data() + 4 );
+				break;
+
+				default:
+				break;
+			}
+
+			if( header.has_flag( h2::flag_end_stream ) &&
+				( h2::frame_type_t::headers == header.m_type ||
+					h2::frame_type_t::data == header.m_type ) )
+			{
+				response.m_completed = true;
+				++finished;
+			}
+		}
+	}
+
+	//! Decode a header block received from the server.
+	h2::hpack::decoding_result_t
+	decode(
+		restinio::string_view_t block,
+		h2::hpack::header_list_t & fields )
+	{
+		return m_decoder.decode(
+				block,
+				restinio::incoming_http_msg_limits_t{},
+				h2::max_header_list_size,
+				fields );
+	}
+
+	//! Read frames until EOF.
+	void
+	read_till_eof()
+	{
+		std::string data;
+
+		restinio::asio_ns::error_code error;
+		char buf[ 256 ];
+		for(;;)
+		{
+			const auto n = m_socket.read_some(
+					restinio::asio_ns::buffer( buf ), error );
+			if( error )
+				break;
+			data.append( buf, n );
+		}
+
+		if( !restinio::error_is_eof( error ) )
+			throw std::runtime_error{ fmt::format( "read error: {}", error ) };
+
+		for( std::size_t pos = 0u; data.size() - pos >= h2::frame_header_size; )
+		{
+			const auto header = h2::parse_frame_header( data.data() + pos );
+			pos += h2::frame_header_size;
+
+			if( h2::frame_type_t::goaway == header.m_type )
+				m_goaway_error = h2::read_uint32( data.data() + pos + 4 );
+
+			pos += header.m_length;
+		}
+	}
+
+	std::map< std::uint32_t, response_t > m_responses;
+	std::vector< h2::frame_type_t > m_frames;
+	//! Parameters from the server SETTINGS frames.
+	std::map< std::uint16_t, std::uint32_t > m_server_settings;
+	//! Error code from GOAWAY frame (if received).
+	restinio::optional_t< std::uint32_t > m_goaway_error;
+
+private:
+	restinio::asio_ns::ip::tcp::socket & m_socket;
+	h2::hpack::encoder_t m_encoder;
+	h2::hpack::decoder_t m_decoder;
+};
+
+std::string
+field_value( const response_t & response, restinio::string_view_t name )
+{
+	for( const auto & f : response.m_fields )
+		if( name == f.first )
+			return f.second;
+	return {};
+}
+
+} /* anonymous namespace */
+
+TEST_CASE( "HTTP/2 with prior knowledge" , "[http2][prior_knowledge]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	SECTION( "simple request" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+			client.send_request( 1u, "GET", "/" );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+
+			// The server connection preface is SETTINGS frame.
+			REQUIRE( h2::frame_type_t::settings == client.m_frames.front() );
+			REQUIRE( 4u == client.m_server_settings[ static_cast< std::uint16_t >(
+					h2::setting_id_t::max_concurrent_streams ) ] );
+			REQUIRE( h2::max_header_list_size ==
+					client.m_server_settings[ static_cast< std::uint16_t >(
+							h2::setting_id_t::max_header_list_size ) ] );
+
+			const auto & response = client.m_responses[ 1u ];
+			REQUIRE( response.m_completed );
+			REQUIRE( "200" == response.status() );
+			REQUIRE( "RESTinio utest server" == field_value( response, "server" ) );
+			REQUIRE( field_value( response, "connection" ).empty() );
+			REQUIRE( "hello 2.0 127.0.0.1" == response.m_body );
+		} );
+	}
+
+	SECTION( "preface in parts" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.write( "PRI * HTTP/2.0\r\n" );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			client.write( "\r\nSM\r\n\r\n" );
+
+			std::string data;
+			h2::append_frame( data, h2::frame_type_t::settings, 0u, 0u, {} );
+			client.make_request( data, 1u, "GET", "/" );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( "hello 2.0 127.0.0.1" == client.m_responses[ 1u ].m_body );
+		} );
+	}
+
+	SECTION( "request body" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+			client.send_request( 1u, "POST", "/echo", "request body" );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( "request body" == client.m_responses[ 1u ].m_body );
+		} );
+	}
+
+	SECTION( "multiple streams" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			std::string data;
+			client.make_request( data, 1u, "GET", "/" );
+			client.make_request( data, 3u, "GET", "/chunked" );
+			client.make_request( data, 5u, "POST", "/echo", "echo" );
+			client.make_request( data, 7u, "GET", "/unknown" );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 4u ) );
+
+			REQUIRE( "hello 2.0 127.0.0.1" == client.m_responses[ 1u ].m_body );
+			REQUIRE( "abcdef" == client.m_responses[ 3u ].m_body );
+			REQUIRE( field_value( client.m_responses[ 3u ], "transfer-encoding" ).empty() );
+			REQUIRE( "echo" == client.m_responses[ 5u ].m_body );
+			REQUIRE( "501" == client.m_responses[ 7u ].status() );
+		} );
+	}
+
+	SECTION( "too many streams" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			std::string data;
+			for( std::uint32_t id = 1u; id != 11u; id += 2u )
+				client.make_request( data, id, "GET", "/delayed" );
+			client.write( data );
+
+			// http2_max_concurrent_streams is 4.
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 9u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::refused_stream ) ==
+					client.m_responses[ 9u ].m_reset_error );
+
+			delayed.wait_for( 4u );
+			delayed.respond_all();
+
+			REQUIRE_NOTHROW( client.read_responses( 4u ) );
+			for( std::uint32_t id = 1u; id != 9u; id += 2u )
+				REQUIRE( "delayed" == client.m_responses[ id ].m_body );
+		} );
+	}
+
+	SECTION( "reset streams with running handlers" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			std::string data;
+			for( std::uint32_t id = 1u; id != 9u; id += 2u )
+			{
+				client.make_request( data, id, "GET", "/delayed" );
+				h2::append_rst_stream( data, id, h2::error_code_t::cancel );
+			}
+			client.write( data );
+
+			delayed.wait_for( 4u );
+
+			// Handlers of the reset streams occupy the limit.
+			client.send_request( 9u, "GET", "/" );
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 9u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::refused_stream ) ==
+					client.m_responses[ 9u ].m_reset_error );
+
+			delayed.respond_all();
+			std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+			client.send_request( 11u, "GET", "/" );
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( "hello 2.0 127.0.0.1" == client.m_responses[ 11u ].m_body );
+		} );
+	}
+
+	SECTION( "flow control" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start( 1000u );
+			client.send_request( 1u, "GET", "/big" );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u, true ) );
+
+			const auto & response = client.m_responses[ 1u ];
+			REQUIRE( std::string( 100000u, 'x' ) == response.m_body );
+		} );
+	}
+
+	SECTION( "negative send window" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start( 100u );
+			client.send_request( 1u, "GET", "/big" );
+
+			// Wait for the first DATA frame that exhausts the stream window.
+			std::size_t received = 0u;
+			while( received < 100u )
+			{
+				frame_t frame;
+				REQUIRE_NOTHROW( frame = client.read_frame() );
+				if( h2::frame_type_t::settings == frame.m_header.m_type &&
+					!frame.m_header.has_flag( h2::flag_ack ) )
+				{
+					std::string ack;
+					h2::append_frame( ack, h2::frame_type_t::settings, h2::flag_ack, 0u, {} );
+					client.write( ack );
+				}
+				else if( h2::frame_type_t::headers == frame.m_header.m_type )
+				{
+					REQUIRE( h2::hpack::decoding_result_t::success ==
+							client.decode( frame.m_payload, client.m_responses[ 1u ].m_fields ) );
+				}
+				else if( h2::frame_type_t::data == frame.m_header.m_type )
+					received += frame.m_payload.size();
+			}
+			REQUIRE( 100u == received );
+
+			// The stream window becomes -100, then -50 (RFC 7540, 6.9.2).
+			std::string data;
+			std::string settings;
+			h2::append_setting(
+					settings, h2::setting_id_t::initial_window_size, 0u );
+			h2::append_frame( data, h2::frame_type_t::settings, 0u, 0u, settings );
+			h2::append_window_update( data, 1u, 50u );
+			h2::append_frame( data, h2::frame_type_t::ping, 0u, 0u, "12345678" );
+			client.write( data );
+
+			// Nothing is sent for the blocked stream.
+			frame_t frame;
+			do
+			{
+				REQUIRE_NOTHROW( frame = client.read_frame() );
+				REQUIRE( h2::frame_type_t::data != frame.m_header.m_type );
+			}
+			while( h2::frame_type_t::ping != frame.m_header.m_type );
+
+			// Open the windows, the stream is still alive.
+			data.clear();
+			h2::append_window_update( data, 0u, 100000u );
+			h2::append_window_update( data, 1u, 100000u );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+
+			const auto & response = client.m_responses[ 1u ];
+			REQUIRE( "200" == response.status() );
+			REQUIRE( std::string( 100000u - received, 'x' ) == response.m_body );
+		} );
+	}
+
+	SECTION( "PING" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			std::string data;
+			h2::append_frame( data, h2::frame_type_t::ping, 0u, 0u, "12345678" );
+			client.write( data );
+
+			frame_t frame;
+			do
+			{
+				REQUIRE_NOTHROW( frame = client.read_frame() );
+			}
+			while( h2::frame_type_t::ping != frame.m_header.m_type );
+
+			REQUIRE( frame.m_header.has_flag( h2::flag_ack ) );
+			REQUIRE( "12345678" == frame.m_payload );
+		} );
+	}
+
+	SECTION( "protocol error" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			// DATA frame for stream 0.
+			std::string data;
+			h2::append_frame( data, h2::frame_type_t::data, 0u, 0u, "data" );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_till_eof() );
+			REQUIRE( client.m_goaway_error );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::protocol_error ) ==
+					*client.m_goaway_error );
+		} );
+	}
+
+	SECTION( "malformed request" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			h2::hpack::encoder_t encoder;
+			std::string block;
+			encoder.start_block( block );
+			encoder.encode_field( block, ":method", "GET" );
+			encoder.encode_field( block, ":path", "/" );
+			// No :scheme, connection-specific field.
+			encoder.encode_field( block, "connection", "keep-alive" );
+
+			std::string data;
+			h2::append_frame(
+					data,
+					h2::frame_type_t::headers,
+					h2::flag_end_headers | h2::flag_end_stream,
+					1u,
+					block );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 1u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::protocol_error ) ==
+					client.m_responses[ 1u ].m_reset_error );
+
+			// The connection is still alive.
+			client.send_request( 3u, "GET", "/" );
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( "hello 2.0 127.0.0.1" == client.m_responses[ 3u ].m_body );
+		} );
+	}
+
+	SECTION( "pseudo-header after regular field" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			h2::hpack::encoder_t encoder;
+			std::string block;
+			encoder.start_block( block );
+			encoder.encode_field( block, ":method", "GET" );
+			encoder.encode_field( block, ":scheme", "http" );
+			encoder.encode_field( block, "accept", "*/*" );
+			encoder.encode_field( block, ":path", "/" );
+
+			std::string data;
+			h2::append_frame(
+					data,
+					h2::frame_type_t::headers,
+					h2::flag_end_headers | h2::flag_end_stream,
+					1u,
+					block );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 1u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::protocol_error ) ==
+					client.m_responses[ 1u ].m_reset_error );
+		} );
+	}
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Timeouts of HTTP/2 streams" , "[http2][timeouts]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed, []( auto & settings ) {
+			settings
+				.read_next_http_message_timelimit( std::chrono::seconds( 1 ) )
+				.write_http_response_timelimit( std::chrono::seconds( 1 ) );
+		} );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	SECTION( "incomplete request" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			client.start();
+
+			// HEADERS without END_STREAM and no DATA after it.
+			h2::hpack::encoder_t encoder;
+			std::string block;
+			encoder.start_block( block );
+			encoder.encode_field( block, ":method", "POST" );
+			encoder.encode_field( block, ":scheme", "http" );
+			encoder.encode_field( block, ":path", "/echo" );
+
+			std::string data;
+			h2::append_frame(
+					data, h2::frame_type_t::headers, h2::flag_end_headers, 1u, block );
+			client.write( data );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 1u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::cancel ) ==
+					client.m_responses[ 1u ].m_reset_error );
+		} );
+	}
+
+	SECTION( "exhausted send window" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			client_t client{ socket };
+			// The client never opens the window.
+			client.start( 0u );
+			client.send_request( 1u, "GET", "/big" );
+
+			REQUIRE_NOTHROW( client.read_responses( 1u ) );
+			REQUIRE( client.m_responses[ 1u ].m_reset );
+			REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::cancel ) ==
+					client.m_responses[ 1u ].m_reset_error );
+		} );
+	}
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "HTTP/1.1 on HTTP/2 enabled server" , "[http2][http1]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request(
+			"GET / HTTP/1.1\r\n"
+			"Host: 127.0.0.1\r\n"
+			"Connection: close\r\n"
+			"\r\n" ) );
+
+	REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "hello 1.1 127.0.0.1" ) );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Drain of HTTP/2 connection" , "[http2][drain]" )
+{
+	delayed_requests_t delayed;
+	auto http_server = make_server( delayed );
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	std::promise< restinio::drain_progress_t > finished;
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		client_t client{ socket };
+		client.start();
+		client.send_request( 1u, "GET", "/delayed" );
+
+		delayed.wait_for( 1u );
+
+		http_server->drain_async(
+			std::chrono::seconds{ 5 },
+			[&]( const restinio::drain_progress_t & progress ) {
+				if( progress.m_finished )
+					finished.set_value( progress );
+			},
+			[&]( std::exception_ptr ex ) {
+				finished.set_exception( ex );
+			} );
+
+		// GOAWAY is sent at the start of the drain.
+		frame_t frame;
+		do
+		{
+			REQUIRE_NOTHROW( frame = client.read_frame() );
+		}
+		while( h2::frame_type_t::goaway != frame.m_header.m_type );
+
+		REQUIRE( 1u == h2::read_uint32( frame.m_payload.data() ) );
+		REQUIRE( static_cast< std::uint32_t >( h2::error_code_t::no_error ) ==
+				h2::read_uint32( frame.m_payload.data() + 4 ) );
+
+		delayed.respond_all();
+
+		REQUIRE_NOTHROW( client.read_responses( 1u ) );
+		REQUIRE( "delayed" == client.m_responses[ 1u ].m_body );
+
+		// The connection is closed after the response.
+		REQUIRE_NOTHROW( client.read_till_eof() );
+	} );
+
+	const auto result = finished.get_future().get();
+	REQUIRE( 0u == result.m_alive_connections );
+	REQUIRE_FALSE( result.m_deadline_expired );
+
+	other_thread.stop_and_join();
+}
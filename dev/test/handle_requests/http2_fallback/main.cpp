@@ -0,0 +1,233 @@
+/*
+	restinio
+*/
+
+/*!
+	Test handling of HTTP/2 clients.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+namespace
+{
+
+using http_server_t =
+	restinio::http_server_t<
+		restinio::traits_t<
+			restinio::asio_timer_manager_t,
+			utest_logger_t > >;
+
+auto
+make_server()
+{
+	return std::make_unique< http_server_t >(
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler(
+					[]( auto req ){
+						const bool is_upgrade =
+							restinio::http_connection_header_t::upgrade ==
+								req->header().connection();
+
+						req->create_response()
+							.append_header( "Server", "RESTinio utest server" )
+							.append_header( "Content-Type", "text/plain; charset=utf-8" )
+							.set_body( is_upgrade ? "upgrade" : "ordinary" )
+							.done();
+
+						return restinio::request_accepted();
+					} );
+		} );
+}
+
+std::string
+read_all( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	std::string result;
+
+	restinio::asio_ns::error_code error;
+	char buf[ 256 ];
+	for(;;)
+	{
+		const auto n = socket.read_some(
+				restinio::asio_ns::buffer( buf ), error );
+		if( error )
+			break;
+		result.append( buf, n );
+	}
+
+	if( !restinio::error_is_eof( error ) )
+		throw std::runtime_error{ fmt::format( "read error: {}", error ) };
+
+	return result;
+}
+
+const std::string http_1_1_required_answer{
+	"\x00\x00\x00\x04\x00\x00\x00\x00\x00"
+	"\x00\x00\x08\x07\x00\x00\x00\x00\x00"
+	"\x00\x00\x00\x00"
+	"\x00\x00\x00\x0d",
+	26u
+};
+
+const std::string client_preface{ "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n" };
+
+} /* anonymous namespace */
+
+TEST_CASE( "HTTP/2 with prior knowledge" , "[http2][prior_knowledge]" )
+{
+	auto http_server = make_server();
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	SECTION( "whole preface" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			// The preface is followed by SETTINGS frame.
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer(
+							client_preface + std::string{ "\x00\x00\x00\x04\x00\x00\x00\x00\x00", 9u } ) );
+
+			std::string answer;
+			REQUIRE_NOTHROW( answer = read_all( socket ) );
+			REQUIRE( http_1_1_required_answer == answer );
+		} );
+	}
+
+	SECTION( "preface in parts" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			for( std::size_t pos = 0u; pos < client_preface.size(); pos += 5u )
+			{
+				restinio::asio_ns::write( socket,
+						restinio::asio_ns::buffer(
+								client_preface.substr( pos, 5u ) ) );
+				std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			}
+
+			std::string answer;
+			REQUIRE_NOTHROW( answer = read_all( socket ) );
+			REQUIRE( http_1_1_required_answer == answer );
+		} );
+	}
+
+	SECTION( "HTTP/1.1 request in parts" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer( std::string{ "P" } ) );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer( std::string{
+							"OST / HTTP/1.1\r\n"
+							"Host: 127.0.0.1\r\n"
+							"Content-Length: 4\r\n"
+							"Connection: close\r\n"
+							"\r\n"
+							"DATA" } ) );
+
+			std::string response;
+			REQUIRE_NOTHROW( response = read_all( socket ) );
+			REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+			REQUIRE_THAT( response, Catch::Matchers::EndsWith( "ordinary" ) );
+		} );
+	}
+
+	SECTION( "invalid HTTP/1.1 request in parts" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer( std::string{ "P" } ) );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			// "PXST" isn't a valid method.
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer( std::string{
+							"XST / HTTP/1.1\r\n"
+							"Host: 127.0.0.1\r\n"
+							"\r\n" } ) );
+
+			std::string response;
+			REQUIRE_NOTHROW( response = read_all( socket ) );
+			REQUIRE( response.empty() );
+		} );
+	}
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Upgrade to h2c" , "[http2][upgrade]" )
+{
+	auto http_server = make_server();
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ) {
+		const std::string upgrade_request{
+				"GET / HTTP/1.1\r\n"
+				"Host: 127.0.0.1\r\n"
+				"Connection: Upgrade, HTTP2-Settings\r\n"
+				"Upgrade: h2c\r\n"
+				"HTTP2-Settings: AAMAAABkAARAAAAAAAIAAAAA\r\n"
+				"\r\n" };
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( upgrade_request ) );
+
+		restinio::asio_ns::streambuf response_stream;
+		const auto header_size = restinio::asio_ns::read_until(
+				socket, response_stream, "\r\n\r\n" );
+
+		std::string response{
+				restinio::asio_ns::buffers_begin( response_stream.data() ),
+				restinio::asio_ns::buffers_begin( response_stream.data() ) +
+						static_cast< std::ptrdiff_t >( header_size ) };
+
+		REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+		REQUIRE_THAT( response, Catch::Matchers::Contains( "Connection: keep-alive" ) );
+
+		// The connection is still alive.
+		restinio::asio_ns::write( socket,
+				restinio::asio_ns::buffer( std::string{
+						"GET / HTTP/1.1\r\n"
+						"Host: 127.0.0.1\r\n"
+						"Connection: close\r\n"
+						"\r\n" } ) );
+
+		std::string tail;
+		REQUIRE_NOTHROW( tail = read_all( socket ) );
+
+		REQUIRE_THAT( tail, Catch::Matchers::Contains( "HTTP/1.1 200 OK" ) );
+		REQUIRE_THAT( tail, Catch::Matchers::EndsWith( "ordinary" ) );
+	} );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Upgrade to other protocols" , "[http2][upgrade]" )
+{
+	auto http_server = make_server();
+
+	other_work_thread_for_server_t<http_server_t> other_thread(*http_server);
+	other_thread.run();
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request(
+			"GET / HTTP/1.1\r\n"
+			"Host: 127.0.0.1\r\n"
+			"Connection: Upgrade\r\n"
+			"Upgrade: h2c, websocket\r\n"
+			"\r\n" ) );
+
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "upgrade" ) );
+
+	other_thread.stop_and_join();
+}
@@ -0,0 +1,166 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+namespace rm = restinio::metrics;
+
+TEST_CASE( "Latency buckets" , "[metrics][buckets]" )
+{
+	namespace lb = rm::impl::latency_buckets;
+
+	for( std::uint64_t v : std::initializer_list< std::uint64_t >{
+			0u, 1u, 3u, 4u, 5u, 7u, 8u, 100u, 1000u,
+			1024u, 2047u, 123456789u, 1000000000000u } )
+	{
+		const auto index = lb::index_of( v );
+		REQUIRE( index < lb::count );
+		REQUIRE( v < lb::upper_bound_of( index ) );
+		if( index )
+			REQUIRE( v >= lb::upper_bound_of( index - 1u ) );
+	}
+
+	REQUIRE( lb::count - 1u == lb::index_of( ~std::uint64_t{} ) );
+}
+
+TEST_CASE( "Snapshot of metrics" , "[metrics][snapshot]" )
+{
+	rm::server_metrics_t metrics{ 2u };
+
+	metrics.increment( rm::counter_t::connections_accepted, 3u );
+	metrics.increment( rm::counter_t::connections_closed );
+	metrics.increment( rm::counter_t::websocket_connections_opened );
+
+	std::thread other{ [&metrics] {
+		metrics.increment( rm::counter_t::connections_accepted );
+		for( int i = 0; i != 90; ++i )
+			metrics.record( rm::histogram_t::handler_latency,
+					std::chrono::microseconds( 10 ) );
+	} };
+	other.join();
+
+	for( int i = 0; i != 10; ++i )
+		metrics.record( rm::histogram_t::handler_latency,
+				std::chrono::milliseconds( 10 ) );
+
+	const auto snapshot = metrics.snapshot();
+	REQUIRE( 4u == snapshot.counter( rm::counter_t::connections_accepted ) );
+	REQUIRE( 4u == snapshot.active_connections() );
+
+	REQUIRE( 100u == snapshot.count( rm::histogram_t::handler_latency ) );
+	REQUIRE( std::chrono::microseconds( 100900 ) ==
+			snapshot.sum( rm::histogram_t::handler_latency ) );
+
+	const auto p50 = snapshot.percentile( rm::histogram_t::handler_latency, 0.5 );
+	REQUIRE( p50 > std::chrono::microseconds( 10 ) );
+	REQUIRE( p50 <= std::chrono::microseconds( 13 ) );
+	const auto p99 = snapshot.percentile( rm::histogram_t::handler_latency, 0.99 );
+	REQUIRE( p99 > std::chrono::milliseconds( 10 ) );
+	REQUIRE( p99 <= std::chrono::microseconds( 12500 ) );
+
+	const auto text = snapshot.to_prometheus_text( "my" );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"# TYPE my_connections_accepted_total counter\n"
+			"my_connections_accepted_total 4\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"my_active_connections 4\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"# TYPE my_handler_latency_seconds histogram\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"my_handler_latency_seconds_bucket{le=\"1.024e-06\"} 0\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"my_handler_latency_seconds_bucket{le=\"1.6384e-05\"} 90\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"my_handler_latency_seconds_bucket{le=\"0.016777216\"} 100\n" ) );
+	REQUIRE_THAT( text, Catch::Matchers::Contains(
+			"my_handler_latency_seconds_bucket{le=\"+Inf\"} 100\n"
+			"my_handler_latency_seconds_sum 0.1009\n"
+			"my_handler_latency_seconds_count 100\n" ) );
+}
+
+struct test_traits : public restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >
+{
+	using metrics_t = rm::server_metrics_t;
+};
+
+TEST_CASE( "No metrics object" , "[metrics][no_object]" )
+{
+	using http_server_t = restinio::http_server_t< test_traits >;
+
+	REQUIRE_THROWS( std::unique_ptr<http_server_t>{
+		new http_server_t{
+				restinio::own_io_context(),
+				[]( auto & settings ){
+					settings
+						.port( utest_default_port() )
+						.address( "127.0.0.1" )
+						.request_handler(
+							[]( auto ){
+								return restinio::request_rejected();
+							} );
+				} }
+	} );
+}
+
+TEST_CASE( "Metrics of HTTP server" , "[metrics][server]" )
+{
+	using http_server_t = restinio::http_server_t< test_traits >;
+
+	auto metrics = std::make_shared< rm::server_metrics_t >();
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[metrics]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.metrics( metrics )
+				.request_handler(
+					[]( auto req ){
+						return req->create_response()
+							.append_header( "Content-Type", "text/plain; charset=utf-8" )
+							.set_body( "Hello" )
+							.done();
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	const std::string request_str =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Connection: close\r\n"
+		"\r\n";
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "Hello" ) );
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "Hello" ) );
+
+	// Parse error. The connection is closed without a response.
+	const std::string bad_request_str = "XYZ / HTTP/1.1\r\n\r\n";
+	REQUIRE_THROWS( response = do_request( bad_request_str ) );
+
+	other_thread.stop_and_join();
+
+	const auto snapshot = metrics->snapshot();
+	REQUIRE( 3u == snapshot.counter( rm::counter_t::connections_accepted ) );
+	REQUIRE( 3u == snapshot.counter( rm::counter_t::connections_closed ) );
+	REQUIRE( 0u == snapshot.active_connections() );
+	REQUIRE( 2u == snapshot.counter( rm::counter_t::requests ) );
+	REQUIRE( 1u == snapshot.counter( rm::counter_t::parse_errors ) );
+	REQUIRE( 2u * request_str.size() + bad_request_str.size() ==
+			snapshot.counter( rm::counter_t::bytes_read ) );
+	REQUIRE( 0u < snapshot.counter( rm::counter_t::bytes_written ) );
+	REQUIRE( 2u == snapshot.count( rm::histogram_t::handler_latency ) );
+}
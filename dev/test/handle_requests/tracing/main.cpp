@@ -0,0 +1,155 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include <sstream>
+
+namespace rt = restinio::tracing;
+
+TEST_CASE( "Ring tracer" , "[tracing][ring]" )
+{
+	rt::ring_tracer_t tracer{ 5u };
+	REQUIRE( 8u == tracer.capacity() );
+	REQUIRE( tracer.events().empty() );
+
+	const rt::timestamp_t start{};
+	const auto at = [&]( int us ) {
+		return start + std::chrono::microseconds( us );
+	};
+
+	// Request #0 of connection 1 is fast, request #1 is slow.
+	tracer.on_event( { 1u, 0u, rt::stage_t::first_byte_read, at( 0 ) } );
+	tracer.on_event( { 1u, 0u, rt::stage_t::handler_invoked, at( 10 ) } );
+	tracer.on_event( { 1u, 0u, rt::stage_t::last_byte_written, at( 20 ) } );
+	tracer.on_event( { 1u, 1u, rt::stage_t::first_byte_read, at( 20 ) } );
+	tracer.on_event( { 1u, 1u, rt::stage_t::response_appended, at( 1000 ) } );
+	tracer.on_event( { 1u, 1u, rt::stage_t::response_appended, at( 3000 ) } );
+	tracer.on_event( { 1u, 1u, rt::stage_t::last_byte_written, at( 5020 ) } );
+
+	const auto events = tracer.events();
+	REQUIRE( 7u == events.size() );
+	REQUIRE( rt::stage_t::first_byte_read == events.front().m_stage );
+	REQUIRE( at( 5020 ) == events.back().m_timestamp );
+
+	const auto slow = tracer.slow_requests( std::chrono::milliseconds( 1 ) );
+	REQUIRE( 1u == slow.size() );
+	REQUIRE( 1u == slow[ 0 ].m_connection_id );
+	REQUIRE( 1u == slow[ 0 ].m_request_id );
+	REQUIRE( std::chrono::microseconds( 5000 ) == slow[ 0 ].duration() );
+	REQUIRE( at( 1000 ) == *slow[ 0 ].at( rt::stage_t::response_appended ) );
+	REQUIRE( !slow[ 0 ].at( rt::stage_t::handler_invoked ) );
+
+	REQUIRE( 2u == tracer.slow_requests( rt::clock_type_t::duration::zero() ).size() );
+
+	std::ostringstream dump;
+	tracer.dump_slow_requests( dump, std::chrono::milliseconds( 1 ) );
+	REQUIRE( "[connection:1] request #1: 5000us first_byte_read=+0us "
+			"response_appended=+980us last_byte_written=+5000us\n" == dump.str() );
+
+	// The oldest events are overwritten.
+	tracer.on_event( { 2u, 0u, rt::stage_t::first_byte_read, at( 6000 ) } );
+	tracer.on_event( { 2u, 0u, rt::stage_t::headers_completed, at( 6001 ) } );
+
+	const auto last_events = tracer.events();
+	REQUIRE( 8u == last_events.size() );
+	REQUIRE( rt::stage_t::handler_invoked == last_events.front().m_stage );
+	REQUIRE( 2u == last_events.back().m_connection_id );
+}
+
+struct test_traits : public restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >
+{
+	using request_tracer_t = rt::ring_tracer_t;
+};
+
+TEST_CASE( "No tracer object" , "[tracing][no_object]" )
+{
+	using http_server_t = restinio::http_server_t< test_traits >;
+
+	REQUIRE_THROWS( std::unique_ptr<http_server_t>{
+		new http_server_t{
+				restinio::own_io_context(),
+				[]( auto & settings ){
+					settings
+						.port( utest_default_port() )
+						.address( "127.0.0.1" )
+						.request_handler(
+							[]( auto ){
+								return restinio::request_rejected();
+							} );
+				} }
+	} );
+}
+
+TEST_CASE( "Tracing of pipelined requests" , "[tracing][server]" )
+{
+	using http_server_t = restinio::http_server_t< test_traits >;
+
+	auto tracer = std::make_shared< rt::ring_tracer_t >( 1024u );
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[tracer]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_tracer( tracer )
+				.request_handler(
+					[]( auto req ){
+						return req->create_response()
+							.append_header( "Content-Type", "text/plain; charset=utf-8" )
+							.set_body( "Hello" )
+							.done();
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	const std::string request_str =
+		"POST / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Content-Length: 4\r\n"
+		"\r\n"
+		"body"
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Connection: close\r\n"
+		"\r\n";
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "Hello" ) );
+
+	other_thread.stop_and_join();
+
+	const auto traces = tracer->slow_requests(
+			rt::clock_type_t::duration::zero() );
+	REQUIRE( 2u == traces.size() );
+
+	for( const auto & trace : traces )
+	{
+		REQUIRE( traces[ 0 ].m_connection_id == trace.m_connection_id );
+
+		restinio::optional_t< rt::timestamp_t > previous;
+		for( const auto & ts : trace.m_stages )
+		{
+			REQUIRE( ts );
+			if( previous )
+				REQUIRE( *previous <= *ts );
+			previous = ts;
+		}
+	}
+	REQUIRE( 0u == traces[ 0 ].m_request_id );
+	REQUIRE( 1u == traces[ 1 ].m_request_id );
+
+	REQUIRE( 2u * restinio::tracing::stages_count == tracer->events().size() );
+}
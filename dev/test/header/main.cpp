@@ -921,6 +921,69 @@ TEST_CASE( "working with string_to_field()" , "[header][string_to_field]" )
 	RESTINIO_FIELD_FROM_STRIN_TEST( x_device_accept_language,     X-Device-Accept-Language )
 	RESTINIO_FIELD_FROM_STRIN_TEST( x_device_user_agent,          X-Device-User-Agent )
 #undef RESTINIO_FIELD_FROM_STRIN_TEST
+
+	REQUIRE( http_field::content_type == string_to_field( "CONTENT-TYPE" ) );
+	REQUIRE( http_field::content_type == string_to_field( "content-type" ) );
+	REQUIRE( http_field::field_unspecified == string_to_field( "" ) );
+	REQUIRE( http_field::field_unspecified == string_to_field( "Content-Typ" ) );
+	REQUIRE( http_field::field_unspecified == string_to_field( "Content-Type2" ) );
+	REQUIRE( http_field::field_unspecified == string_to_field( "Content_Type" ) );
+	REQUIRE( http_field::field_unspecified == string_to_field( "X-Custom" ) );
+}
+
+TEST_CASE( "Index of known fields" , "[header][fields][index]" )
+{
+	http_header_fields_t fields;
+
+	fields.add_field( "X-Custom", "1" );
+	fields.add_field( http_field::accept, "text/plain" );
+	fields.add_field( "Host", "localhost" );
+	fields.add_field( http_field::accept, "text/html" );
+
+	REQUIRE( "text/plain" == fields.value_of( http_field::accept ) );
+	REQUIRE( "text/plain" == fields.value_of( "ACCEPT" ) );
+	REQUIRE( "localhost" == fields.value_of( http_field::host ) );
+	REQUIRE( fields.has_field( http_field::field_unspecified ) );
+	REQUIRE_FALSE( fields.has_field( http_field::date ) );
+
+	REQUIRE( fields.remove_field( "X-Custom" ) );
+	REQUIRE( "text/plain" == fields.value_of( http_field::accept ) );
+	REQUIRE( "localhost" == fields.value_of( "host" ) );
+
+	REQUIRE( fields.remove_field( http_field::accept ) );
+	REQUIRE( "text/html" == fields.value_of( http_field::accept ) );
+	REQUIRE( "localhost" == fields.value_of( http_field::host ) );
+
+	fields.set_field( "HOST", "example.com" );
+	REQUIRE( 2u == fields.fields_count() );
+	REQUIRE( "example.com" == fields.value_of( http_field::host ) );
+
+	REQUIRE( 1u == fields.remove_all_of( http_field::host ) );
+	REQUIRE_FALSE( fields.has_field( "Host" ) );
+	REQUIRE( "text/html" == fields.value_of( http_field::accept ) );
+
+	http_header_fields_t other;
+	other.add_field( http_field::date, "today" );
+	fields.swap_fields( other );
+	REQUIRE( "today" == fields.value_of( http_field::date ) );
+	REQUIRE_FALSE( fields.has_field( http_field::accept ) );
+	REQUIRE( "text/html" == other.value_of( http_field::accept ) );
+	REQUIRE_FALSE( other.has_field( http_field::date ) );
+
+	http_header_fields_t moved{ std::move( other ) };
+	REQUIRE( "text/html" == moved.value_of( http_field::accept ) );
+	REQUIRE( 0u == other.fields_count() );
+	REQUIRE_FALSE( other.has_field( http_field::accept ) );
+
+	// Fields located far from the beginning.
+	http_header_fields_t many;
+	for( int i = 0; i != 300; ++i )
+		many.add_field( "X-Field-" + std::to_string( i ), "v" );
+	many.add_field( http_field::etag, "abc" );
+	many.add_field( http_field::etag, "def" );
+	REQUIRE( "abc" == many.value_of( http_field::etag ) );
+	REQUIRE( many.remove_field( http_field::etag ) );
+	REQUIRE( "def" == many.value_of( "ETag" ) );
 }
 
 TEST_CASE( "Connection" , "[header][connection]" )
@@ -986,6 +1049,101 @@ TEST_CASE( "Connection" , "[header][connection]" )
 }
 
 
+TEST_CASE( "Content-Length" , "[header][content_length]" )
+{
+	using namespace Catch;
+
+	const auto check = []( std::uint64_t content_length, const char * expected ) {
+		http_response_header_t h;
+		h.content_length( content_length );
+		REQUIRE_THAT(
+			impl::create_header_string( h ),
+			Contains( expected ) );
+	};
+
+	check( 0u, "\r\nContent-Length: 0\r\n" );
+	check( 7u, "\r\nContent-Length: 7\r\n" );
+	check( 10u, "\r\nContent-Length: 10\r\n" );
+	check( 1234567890u, "\r\nContent-Length: 1234567890\r\n" );
+	check( 18446744073709551615ull,
+			"\r\nContent-Length: 18446744073709551615\r\n" );
+}
+
+TEST_CASE( "Cached Date field" , "[header][date]" )
+{
+	const std::time_t t1 = 1577836800; // 2020-01-01 00:00:00
+	const std::time_t t2 = t1 + 1;
+
+	REQUIRE( "Wed, 01 Jan 2020 00:00:00 GMT" ==
+			impl::cached_date_field_value( t1 ) );
+	REQUIRE( "Wed, 01 Jan 2020 00:00:00 GMT" ==
+			impl::cached_date_field_value( t1 ) );
+	REQUIRE( "Wed, 01 Jan 2020 00:00:01 GMT" ==
+			impl::cached_date_field_value( t2 ) );
+	REQUIRE( make_date_field_value( t2 ) ==
+			impl::cached_date_field_value( t2 ) );
+}
+
+TEST_CASE( "Response header template" , "[header][template]" )
+{
+	using namespace Catch;
+
+	const auto header_template =
+		response_header_template_t{ status_created() }
+			.append_header( http_field::server, "RESTinio utest server" )
+			.append_header( "Content-Type", "text/plain" );
+
+	REQUIRE( 201 == header_template.status_line().status_code().raw_code() );
+
+	{
+		http_response_header_t h{ header_template.status_line() };
+		h.should_keep_alive( true );
+		h.content_length( 42u );
+
+		REQUIRE( impl::create_header_string( h ) ==
+			"HTTP/1.1 201 Created\r\n"
+			"Connection: keep-alive\r\n"
+			"Content-Length: 42\r\n"
+			"\r\n" );
+
+		REQUIRE( header_template.make_header_string( h ) ==
+			"HTTP/1.1 201 Created\r\n"
+			"Connection: keep-alive\r\n"
+			"Content-Length: 42\r\n"
+			"Server: RESTinio utest server\r\n"
+			"Content-Type: text/plain\r\n"
+			"\r\n" );
+	}
+
+	{
+		http_response_header_t h{ header_template.status_line() };
+		h.set_field( "X-Request-Id", "123" );
+
+		REQUIRE( header_template.make_header_string( h ) ==
+			"HTTP/1.1 201 Created\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 0\r\n"
+			"Server: RESTinio utest server\r\n"
+			"Content-Type: text/plain\r\n"
+			"X-Request-Id: 123\r\n"
+			"\r\n" );
+	}
+
+	{
+		const auto with_date =
+			response_header_template_t{ status_ok() }.append_date_field();
+
+		const auto serialized =
+			with_date.make_header_string( http_response_header_t{} );
+
+		REQUIRE_THAT( serialized,
+			StartsWith( "HTTP/1.1 200 OK\r\n" ) &&
+			Contains( "\r\nDate: " ) &&
+			EndsWith( " GMT\r\n\r\n" ) );
+	}
+}
+
+
 TEST_CASE( "Query" , "[header][query string][query path]" )
 {
 	auto append = []( http_request_header_t & h, const std::string & part ){
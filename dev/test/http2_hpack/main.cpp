@@ -0,0 +1,407 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for HPACK implementation.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <restinio/impl/http2/hpack.hpp>
+#include <restinio/impl/http2/response_converter.hpp>
+
+using namespace restinio::impl::http2;
+
+namespace
+{
+
+std::string
+from_hex( restinio::string_view_t hex )
+{
+	std::string result;
+	unsigned value = 0u;
+	bool half = false;
+	for( const auto ch : hex )
+	{
+		if( ' ' == ch )
+			continue;
+
+		value = value * 16u + static_cast< unsigned >(
+				ch <= '9' ? ch - '0' : ch - 'a' + 10 );
+		if( half )
+		{
+			result.push_back( static_cast< char >( value ) );
+			value = 0u;
+		}
+		half = !half;
+	}
+
+	return result;
+}
+
+using fields_t = std::vector< std::pair< std::string, std::string > >;
+
+constexpr auto success = hpack::decoding_result_t::success;
+constexpr auto compression_error = hpack::decoding_result_t::compression_error;
+constexpr auto limit_exceeded = hpack::decoding_result_t::limit_exceeded;
+
+hpack::decoding_result_t
+decode(
+	hpack::decoder_t & decoder,
+	restinio::string_view_t block,
+	hpack::header_list_t & headers )
+{
+	return decoder.decode(
+			block,
+			restinio::incoming_http_msg_limits_t{},
+			std::numeric_limits< std::size_t >::max(),
+			headers );
+}
+
+} /* anonymous namespace */
+
+TEST_CASE( "Integer representation" , "[hpack][integer]" )
+{
+	// RFC 7541, appendix C.1.
+	std::string to;
+	hpack::encode_integer( to, 0u, 5u, 10u );
+	REQUIRE( from_hex( "0a" ) == to );
+
+	to.clear();
+	hpack::encode_integer( to, 0u, 5u, 1337u );
+	REQUIRE( from_hex( "1f9a0a" ) == to );
+
+	to.clear();
+	hpack::encode_integer( to, 0u, 8u, 42u );
+	REQUIRE( from_hex( "2a" ) == to );
+}
+
+TEST_CASE( "Header field representations" , "[hpack][decoder]" )
+{
+	hpack::decoder_t decoder;
+	hpack::header_list_t headers;
+
+	SECTION( "literal with indexing" )
+	{
+		REQUIRE( success == decode( decoder,
+				from_hex( "400a 6375 7374 6f6d 2d6b 6579 0d63 7573"
+						"746f 6d2d 6865 6164 6572" ),
+				headers ) );
+		REQUIRE( fields_t{ { "custom-key", "custom-header" } } == headers );
+		REQUIRE( 55u == decoder.dynamic_table_size() );
+	}
+
+	SECTION( "literal without indexing" )
+	{
+		REQUIRE( success == decode( decoder,
+				from_hex( "040c 2f73 616d 706c 652f 7061 7468" ),
+				headers ) );
+		REQUIRE( fields_t{ { ":path", "/sample/path" } } == headers );
+		REQUIRE( 0u == decoder.dynamic_table_size() );
+	}
+
+	SECTION( "literal never indexed" )
+	{
+		REQUIRE( success == decode( decoder,
+				from_hex( "1008 7061 7373 776f 7264 0673 6563 7265 74" ),
+				headers ) );
+		REQUIRE( fields_t{ { "password", "secret" } } == headers );
+		REQUIRE( 0u == decoder.dynamic_table_size() );
+	}
+
+	SECTION( "indexed" )
+	{
+		REQUIRE( success == decode( decoder, from_hex( "82" ), headers ) );
+		REQUIRE( fields_t{ { ":method", "GET" } } == headers );
+	}
+}
+
+TEST_CASE( "Requests without Huffman coding" , "[hpack][decoder]" )
+{
+	// RFC 7541, appendix C.3.
+	hpack::decoder_t decoder;
+
+	hpack::header_list_t headers;
+	REQUIRE( success == decode( decoder,
+			from_hex( "8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "http" },
+			{ ":path", "/" },
+			{ ":authority", "www.example.com" } } == headers );
+	REQUIRE( 57u == decoder.dynamic_table_size() );
+
+	headers.clear();
+	REQUIRE( success == decode( decoder,
+			from_hex( "8286 84be 5808 6e6f 2d63 6163 6865" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "http" },
+			{ ":path", "/" },
+			{ ":authority", "www.example.com" },
+			{ "cache-control", "no-cache" } } == headers );
+	REQUIRE( 110u == decoder.dynamic_table_size() );
+
+	headers.clear();
+	REQUIRE( success == decode( decoder,
+			from_hex( "8287 85bf 400a 6375 7374 6f6d 2d6b 6579"
+					"0c63 7573 746f 6d2d 7661 6c75 65" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "https" },
+			{ ":path", "/index.html" },
+			{ ":authority", "www.example.com" },
+			{ "custom-key", "custom-value" } } == headers );
+	REQUIRE( 164u == decoder.dynamic_table_size() );
+}
+
+TEST_CASE( "Requests with Huffman coding" , "[hpack][decoder][huffman]" )
+{
+	// RFC 7541, appendix C.4.
+	hpack::decoder_t decoder;
+
+	hpack::header_list_t headers;
+	REQUIRE( success == decode( decoder,
+			from_hex( "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "http" },
+			{ ":path", "/" },
+			{ ":authority", "www.example.com" } } == headers );
+
+	headers.clear();
+	REQUIRE( success == decode( decoder,
+			from_hex( "8286 84be 5886 a8eb 1064 9cbf" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "http" },
+			{ ":path", "/" },
+			{ ":authority", "www.example.com" },
+			{ "cache-control", "no-cache" } } == headers );
+
+	headers.clear();
+	REQUIRE( success == decode( decoder,
+			from_hex( "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925"
+					"a849 e95b b8e8 b4bf" ),
+			headers ) );
+	REQUIRE( fields_t{
+			{ ":method", "GET" },
+			{ ":scheme", "https" },
+			{ ":path", "/index.html" },
+			{ ":authority", "www.example.com" },
+			{ "custom-key", "custom-value" } } == headers );
+	REQUIRE( 164u == decoder.dynamic_table_size() );
+}
+
+TEST_CASE( "Compression errors" , "[hpack][decoder][errors]" )
+{
+	hpack::decoder_t decoder;
+	hpack::header_list_t headers;
+
+	SECTION( "zero index" )
+	{
+		REQUIRE( compression_error == decode( decoder, from_hex( "80" ), headers ) );
+	}
+
+	SECTION( "index out of the tables" )
+	{
+		REQUIRE( compression_error == decode( decoder, from_hex( "be" ), headers ) );
+	}
+
+	SECTION( "truncated string" )
+	{
+		REQUIRE( compression_error == decode( decoder, from_hex( "0408 2f73" ), headers ) );
+	}
+
+	SECTION( "too large table size update" )
+	{
+		// 4097 with 5-bit prefix.
+		REQUIRE( compression_error == decode( decoder, from_hex( "3fe2 1f" ), headers ) );
+	}
+
+	SECTION( "table size update after a field" )
+	{
+		REQUIRE( compression_error == decode( decoder, from_hex( "8220" ), headers ) );
+	}
+
+	SECTION( "invalid Huffman padding" )
+	{
+		// "a" (00011) followed by zero bits instead of EOS prefix.
+		REQUIRE( compression_error == decode( decoder, from_hex( "0481 18" ), headers ) );
+	}
+}
+
+TEST_CASE( "Decoding limits" , "[hpack][decoder][limits]" )
+{
+	hpack::decoder_t decoder;
+	hpack::header_list_t headers;
+	restinio::incoming_http_msg_limits_t limits;
+
+	// Literal with indexing "custom-key: custom-header" and
+	// the reference to that entry.
+	const auto literal = from_hex( "400a 6375 7374 6f6d 2d6b 6579 0d63 7573"
+			"746f 6d2d 6865 6164 6572" );
+
+	SECTION( "field count" )
+	{
+		limits.max_field_count( 2u );
+		REQUIRE( limit_exceeded == decoder.decode(
+				from_hex( "8286 84" ), limits, 1024u, headers ) );
+		REQUIRE( headers.empty() );
+	}
+
+	SECTION( "field value size" )
+	{
+		limits.max_field_value_size( 12u );
+		REQUIRE( limit_exceeded == decoder.decode(
+				literal, limits, 1024u, headers ) );
+		REQUIRE( headers.empty() );
+		// The dynamic table is updated anyway.
+		REQUIRE( 55u == decoder.dynamic_table_size() );
+
+		headers.clear();
+		REQUIRE( success == decoder.decode(
+				from_hex( "82" ), limits, 1024u, headers ) );
+		REQUIRE( fields_t{ { ":method", "GET" } } == headers );
+	}
+
+	SECTION( "header list size" )
+	{
+		// Expansion of the dynamic table entry is limited.
+		std::string block = literal;
+		block.append( 100000u, '\xbe' );
+
+		REQUIRE( limit_exceeded == decoder.decode(
+				block, limits, 16u * 1024u, headers ) );
+		REQUIRE( headers.empty() );
+
+		headers.clear();
+		REQUIRE( success == decoder.decode(
+				from_hex( "be" ), limits, 1024u, headers ) );
+		REQUIRE( fields_t{ { "custom-key", "custom-header" } } == headers );
+	}
+}
+
+TEST_CASE( "Encoder" , "[hpack][encoder]" )
+{
+	hpack::encoder_t encoder;
+	hpack::decoder_t decoder;
+
+	std::string block;
+	encoder.start_block( block );
+	encoder.encode_status( block, 200u );
+	encoder.encode_field( block, "content-type", "text/plain" );
+	encoder.encode_field( block, "x-custom", "value" );
+
+	// Size update, indexed :status 200, literals.
+	REQUIRE( '\x20' == block[ 0 ] );
+	REQUIRE( '\x88' == block[ 1 ] );
+
+	hpack::header_list_t headers;
+	REQUIRE( success == decode( decoder, block, headers ) );
+	REQUIRE( fields_t{
+			{ ":status", "200" },
+			{ "content-type", "text/plain" },
+			{ "x-custom", "value" } } == headers );
+	REQUIRE( 0u == decoder.dynamic_table_size() );
+
+	// The size update is only in the first block.
+	block.clear();
+	encoder.start_block( block );
+	encoder.encode_status( block, 501u );
+
+	headers.clear();
+	REQUIRE( success == decode( decoder, block, headers ) );
+	REQUIRE( fields_t{ { ":status", "501" } } == headers );
+}
+
+TEST_CASE( "Response conversion" , "[response_converter]" )
+{
+	SECTION( "ordinary body" )
+	{
+		response_converter_t converter;
+		std::string body;
+
+		REQUIRE( converter.feed(
+				"HTTP/1.1 200 OK\r\n"
+				"Connection: keep-alive\r\n"
+				"Content-Type: text/plain\r\n"
+				"Content-Length: 5\r\n"
+				"\r\n"
+				"hel",
+				body ) );
+		REQUIRE( converter.feed( "lo", body ) );
+
+		REQUIRE( converter.header_completed() );
+		REQUIRE( 200u == converter.status() );
+		REQUIRE( fields_t{
+				{ "content-type", "text/plain" },
+				{ "content-length", "5" } } == converter.fields() );
+		REQUIRE( "hello" == body );
+	}
+
+	SECTION( "header in parts" )
+	{
+		response_converter_t converter;
+		std::string body;
+
+		REQUIRE( converter.feed( "HTTP/1.1 404 Not Found\r\nServer: x\r", body ) );
+		REQUIRE_FALSE( converter.header_completed() );
+		REQUIRE( converter.feed( "\n\r", body ) );
+		REQUIRE_FALSE( converter.header_completed() );
+		REQUIRE( converter.feed( "\n", body ) );
+
+		REQUIRE( converter.header_completed() );
+		REQUIRE( 404u == converter.status() );
+		REQUIRE( fields_t{ { "server", "x" } } == converter.fields() );
+		REQUIRE( body.empty() );
+	}
+
+	SECTION( "chunked body" )
+	{
+		response_converter_t converter;
+		std::string body;
+
+		REQUIRE( converter.feed(
+				"HTTP/1.1 200 OK\r\n"
+				"Transfer-Encoding: chunked\r\n"
+				"\r\n"
+				"5\r\nhello\r\n"
+				"7;ext=1\r\n, world\r",
+				body ) );
+		REQUIRE( converter.feed( "\n0\r\n", body ) );
+		REQUIRE( converter.feed( "Trailer: ignored\r\n\r\n", body ) );
+
+		REQUIRE( converter.fields().empty() );
+		REQUIRE( "hello, world" == body );
+	}
+
+	SECTION( "malformed status line" )
+	{
+		response_converter_t converter;
+		std::string body;
+
+		REQUIRE_FALSE( converter.feed( "HTTP/1.1 2x0 OK\r\n\r\n", body ) );
+	}
+
+	SECTION( "data after chunked body" )
+	{
+		response_converter_t converter;
+		std::string body;
+
+		REQUIRE_FALSE( converter.feed(
+				"HTTP/1.1 200 OK\r\n"
+				"Transfer-Encoding: chunked\r\n"
+				"\r\n"
+				"0\r\n\r\nextra",
+				body ) );
+	}
+}
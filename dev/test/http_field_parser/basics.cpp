@@ -2548,3 +2548,115 @@ TEST_CASE( "IPv4 parser", "[non_negative_decimal_number_p]" )
 	}
 
 }
+
+TEST_CASE( "char_set", "[char_set]" )
+{
+	using namespace restinio::easy_parser;
+
+	constexpr auto lower = char_set_t::range( 'a', 'z' );
+	constexpr auto digits = char_set_t::range( '0', '9' );
+	constexpr auto ident = lower | digits | char_set_t::of( "_-" );
+	constexpr auto letters_only = ident - digits - char_set_t::of( "_-" );
+
+	static_assert( ident.contains( 'x' ), "'x' should be in ident" );
+	static_assert( ident.contains( '_' ), "'_' should be in ident" );
+	static_assert( !ident.contains( 'X' ), "'X' shouldn't be in ident" );
+	static_assert( !letters_only.contains( '5' ),
+			"'5' shouldn't be in letters_only" );
+	static_assert( ( ~ident ).contains( '\xFF' ),
+			"'\\xFF' should be in ~ident" );
+	static_assert( !( ident & digits ).contains( 'a' ),
+			"'a' shouldn't be in ident & digits" );
+
+	for( unsigned int i = 0u; i != 256u; ++i )
+	{
+		const char ch = static_cast<char>( i );
+		REQUIRE( ( ( ch >= 'a' && ch <= 'z' ) || ( ch >= '0' && ch <= '9' ) ||
+				ch == '_' || ch == '-' ) == ident.contains( ch ) );
+		REQUIRE( ( ch >= 'a' && ch <= 'z' ) == letters_only.contains( ch ) );
+		REQUIRE( ident.contains( ch ) != ( ~ident ).contains( ch ) );
+	}
+
+	const auto full = char_set_t::range( '\x00', '\xFF' );
+	REQUIRE( full.contains( '\x00' ) );
+	REQUIRE( full.contains( '\xFF' ) );
+}
+
+TEST_CASE( "repeat of symbol_from_set", "[repeat][symbol_from_set]" )
+{
+	using namespace restinio::easy_parser;
+
+	constexpr auto ident = char_set_t::range( 'a', 'z' ) |
+			char_set_t::range( '0', '9' );
+
+	SECTION( "to string" )
+	{
+		const auto rule = produce< std::string >(
+				repeat( 2, 5, symbol_from_set_p( ident ) >> to_container() ),
+				symbol( ';' ) );
+
+		REQUIRE( !try_parse( "", rule ) );
+		REQUIRE( !try_parse( "a;", rule ) );
+		REQUIRE( !try_parse( "abcdef;", rule ) );
+
+		auto result = try_parse( "ab;", rule );
+		REQUIRE( result );
+		REQUIRE( "ab" == *result );
+
+		result = try_parse( "a1b2c;", rule );
+		REQUIRE( result );
+		REQUIRE( "a1b2c" == *result );
+	}
+
+	SECTION( "to vector" )
+	{
+		const auto rule = produce< std::vector< char > >(
+				repeat( 1, N, symbol_from_set_p( ident ) >> to_container() ) );
+
+		const auto result = try_parse( "x9z", rule );
+		REQUIRE( result );
+		REQUIRE( ( std::vector< char >{ 'x', '9', 'z' } ) == *result );
+	}
+
+	SECTION( "skip" )
+	{
+		const auto rule = produce< std::string >(
+				repeat( 0, N, symbol_from_set( ident ) ),
+				repeat( 1, N, any_symbol_p() >> to_container() ) );
+
+		const auto result = try_parse( "abc123-+=", rule );
+		REQUIRE( result );
+		REQUIRE( "-+=" == *result );
+	}
+
+	SECTION( "rollback on failure" )
+	{
+		const auto rule = produce< std::string >(
+				alternatives(
+					sequence(
+						repeat( 4, N,
+							symbol_from_set_p( ident ) >> skip() ),
+						symbol( '!' ) ),
+					repeat( 1, 3,
+						symbol_from_set_p( ident ) >> to_container() ) ) );
+
+		auto result = try_parse( "abc", rule );
+		REQUIRE( result );
+		REQUIRE( "abc" == *result );
+
+		result = try_parse( "abcd!", rule );
+		REQUIRE( result );
+		REQUIRE( "" == *result );
+	}
+
+	SECTION( "error position" )
+	{
+		const auto rule = produce< std::string >(
+				repeat( 3, N, symbol_from_set_p( ident ) >> to_container() ) );
+
+		const auto result = try_parse( "ab-", rule );
+		REQUIRE( !result );
+		REQUIRE( 2u == result.error().position() );
+		REQUIRE( error_reason_t::pattern_not_found == result.error().reason() );
+	}
+}
@@ -0,0 +1,360 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for HTTP-parser backends.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+namespace backend = restinio::http_parser_backend;
+
+// Feed data to a parser by portions of the specified size.
+template< typename Backend >
+std::size_t
+feed( Backend & parser, const std::string & data, std::size_t portion )
+{
+	std::size_t consumed = 0u;
+	while( consumed != data.size() &&
+		!parser.is_error() &&
+		!parser.ctx().m_message_complete )
+	{
+		const auto size = std::min( portion, data.size() - consumed );
+		consumed += parser.parse( data.data() + consumed, size );
+	}
+
+	return consumed;
+}
+
+template< typename Backend >
+void
+tc_simple_requests( std::size_t portion )
+{
+	Backend parser{ restinio::incoming_http_msg_limits_t{} };
+
+	const std::string first =
+		"\r\nGET /first?a=b HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"User-Agent:\t unit-test\r\n"
+		"Accept: */*\r\n"
+		"\r\n";
+	const std::string second =
+		"POST /second HTTP/1.0\r\n"
+		"Content-Length: 16\r\n"
+		"Connection: keep-alive\r\n"
+		"\r\n"
+		"DATADATADATADATA";
+	const std::string all = first + second;
+
+	REQUIRE( first.size() == feed( parser, all, portion ) );
+	REQUIRE_FALSE( parser.is_error() );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE( HTTP_GET == parser.method() );
+	REQUIRE( parser.should_keep_alive() );
+	REQUIRE_FALSE( parser.is_upgrade() );
+
+	const auto & h = parser.ctx().m_header;
+	REQUIRE( "/first?a=b" == h.request_target() );
+	REQUIRE( "/first" == h.path() );
+	REQUIRE( "a=b" == h.query() );
+	REQUIRE( 1 == h.http_major() );
+	REQUIRE( 1 == h.http_minor() );
+	REQUIRE( 3u == h.fields_count() );
+	REQUIRE( "unit-test" == h.get_field( restinio::http_field::user_agent ) );
+	REQUIRE( "*/*" == h.get_field( "accept" ) );
+	REQUIRE( parser.ctx().m_body.empty() );
+
+	parser.reset();
+	REQUIRE( second.size() == feed( parser, second, portion ) );
+	REQUIRE_FALSE( parser.is_error() );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE( HTTP_POST == parser.method() );
+	REQUIRE( parser.should_keep_alive() );
+	REQUIRE( 0 == parser.ctx().m_header.http_minor() );
+	REQUIRE( "DATADATADATADATA" == parser.ctx().m_body );
+}
+
+TEST_CASE( "Simple requests" , "[simple]" )
+{
+	for( const std::size_t portion : { 1u, 7u, 64u, 4096u } )
+	{
+		tc_simple_requests< backend::nodejs_backend_t >( portion );
+		tc_simple_requests< backend::fast_backend_t >( portion );
+	}
+}
+
+template< typename Backend >
+void
+tc_message_started()
+{
+	Backend parser{ restinio::incoming_http_msg_limits_t{} };
+
+	// Empty lines before the request line aren't a part of a message.
+	REQUIRE( 2u == parser.parse( "\r\n", 2u ) );
+	REQUIRE_FALSE( parser.ctx().m_message_started );
+
+	const std::string header =
+		"POST / HTTP/1.1\r\n"
+		"Content-Length: 4\r\n"
+		"\r\n";
+	REQUIRE( header.size() == parser.parse( header.data(), header.size() ) );
+	REQUIRE_FALSE( parser.is_error() );
+	REQUIRE( parser.ctx().m_message_started );
+	REQUIRE_FALSE( parser.ctx().m_message_complete );
+
+	REQUIRE( 4u == parser.parse( "body", 4u ) );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE_FALSE( parser.ctx().m_message_started );
+
+	parser.reset();
+	REQUIRE_FALSE( parser.ctx().m_message_started );
+}
+
+TEST_CASE( "Message start flag" , "[message_started]" )
+{
+	tc_message_started< backend::nodejs_backend_t >();
+	tc_message_started< backend::fast_backend_t >();
+}
+
+template< typename Backend >
+void
+tc_chunked_request( std::size_t portion )
+{
+	Backend parser{ restinio::incoming_http_msg_limits_t{} };
+
+	const std::string request =
+		"POST / HTTP/1.1\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Connection: close\r\n"
+		"\r\n"
+		"5\r\nHello\r\n"
+		"A;ext=1\r\n, World!!!\r\n"
+		"0\r\n"
+		"Expires: never\r\n"
+		"\r\n";
+
+	REQUIRE( request.size() == feed( parser, request, portion ) );
+	REQUIRE_FALSE( parser.is_error() );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE_FALSE( parser.should_keep_alive() );
+	REQUIRE( "Hello, World!!!" == parser.ctx().m_body );
+
+	const auto info = parser.ctx().make_chunked_input_info_if_necessary();
+	REQUIRE( info );
+	REQUIRE( 2u == info->chunk_count() );
+	REQUIRE( "Hello" == info->chunk_at( 0u ).make_string_view(
+			parser.ctx().m_body ) );
+	REQUIRE( 1u == info->trailing_fields().fields_count() );
+	REQUIRE( "never" == info->trailing_fields().get_field( "Expires" ) );
+}
+
+TEST_CASE( "Chunked request" , "[chunked]" )
+{
+	for( const std::size_t portion : { 1u, 5u, 4096u } )
+	{
+		tc_chunked_request< backend::nodejs_backend_t >( portion );
+		tc_chunked_request< backend::fast_backend_t >( portion );
+	}
+}
+
+template< typename Backend >
+void
+tc_upgrade_request()
+{
+	Backend parser{ restinio::incoming_http_msg_limits_t{} };
+
+	const std::string request =
+		"GET /chat HTTP/1.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: keep-alive, Upgrade\r\n"
+		"\r\n"
+		"\x81\x05hello";
+
+	REQUIRE( request.size() - 7u == feed( parser, request, 4096u ) );
+	REQUIRE_FALSE( parser.is_error() );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE( parser.is_upgrade() );
+}
+
+TEST_CASE( "Upgrade request" , "[upgrade]" )
+{
+	tc_upgrade_request< backend::nodejs_backend_t >();
+	tc_upgrade_request< backend::fast_backend_t >();
+}
+
+template< typename Backend >
+bool
+is_invalid(
+	const std::string & request,
+	restinio::incoming_http_msg_limits_t limits =
+		restinio::incoming_http_msg_limits_t{} )
+{
+	Backend parser{ limits };
+	feed( parser, request, 4096u );
+	return parser.is_error();
+}
+
+template< typename Backend >
+void
+tc_invalid_requests()
+{
+	REQUIRE( is_invalid< Backend >( "XYZ / HTTP/1.1\r\n\r\n" ) );
+	REQUIRE( is_invalid< Backend >( "GET / HTTP/1.1\r\nName: a\x01z\r\n\r\n" ) );
+	REQUIRE( is_invalid< Backend >(
+			"POST / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n" ) );
+	REQUIRE( is_invalid< Backend >(
+			"POST / HTTP/1.1\r\nContent-Length: 1\r\n"
+			"Transfer-Encoding: chunked\r\n\r\n" ) );
+	REQUIRE( is_invalid< Backend >(
+			"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nZ\r\n" ) );
+	REQUIRE( is_invalid< Backend >(
+			"GET " + std::string( 100u * 1024u, 'a' ) + " HTTP/1.1\r\n\r\n" ) );
+
+	REQUIRE( is_invalid< Backend >(
+			"GET /12345 HTTP/1.1\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}.max_url_size( 5u ) ) );
+	REQUIRE( is_invalid< Backend >(
+			"GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}.max_field_count( 1u ) ) );
+	REQUIRE( is_invalid< Backend >(
+			"GET / HTTP/1.1\r\nLong-Name: 1\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}.max_field_name_size( 5u ) ) );
+	REQUIRE( is_invalid< Backend >(
+			"GET / HTTP/1.1\r\nA: 12345\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}.max_field_value_size( 5u ) ) );
+	REQUIRE( is_invalid< Backend >(
+			"POST / HTTP/1.1\r\nContent-Length: 6\r\n\r\n123456",
+			restinio::incoming_http_msg_limits_t{}.max_body_size( 5u ) ) );
+	REQUIRE( is_invalid< Backend >(
+			"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+			"6\r\n123456\r\n0\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}.max_body_size( 5u ) ) );
+
+	REQUIRE_FALSE( is_invalid< Backend >(
+			"GET /1234 HTTP/1.1\r\nA: 1234\r\n\r\n",
+			restinio::incoming_http_msg_limits_t{}
+				.max_url_size( 5u )
+				.max_field_count( 1u )
+				.max_field_value_size( 5u ) ) );
+}
+
+TEST_CASE( "Invalid requests" , "[invalid]" )
+{
+	tc_invalid_requests< backend::nodejs_backend_t >();
+	tc_invalid_requests< backend::fast_backend_t >();
+
+	// nodejs/http_parser is more lenient here.
+	REQUIRE( is_invalid< backend::fast_backend_t >(
+			"GET / HTTP/1.1\r\nBad Name: v\r\n\r\n" ) );
+	REQUIRE( is_invalid< backend::fast_backend_t >(
+			"GET / HTTP/1.1\r\nName: v\r\n folded\r\n\r\n" ) );
+
+	// The whole oversized header block is in a single portion.
+	backend::fast_backend_t parser{ restinio::incoming_http_msg_limits_t{} };
+	const auto request = "GET / HTTP/1.1\r\nName: " +
+			std::string( 100u * 1024u, 'a' ) + "\r\n\r\n";
+	feed( parser, request, request.size() );
+	REQUIRE( parser.is_error() );
+}
+
+TEST_CASE( "Whitespaces around field value" , "[fast][ows]" )
+{
+	backend::fast_backend_t parser{ restinio::incoming_http_msg_limits_t{} };
+
+	const std::string request =
+		"GET / HTTP/1.1\r\n"
+		"User-Agent:\t unit-test \t\r\n"
+		"Empty:\r\n"
+		"\r\n";
+
+	REQUIRE( request.size() == feed( parser, request, 4096u ) );
+	REQUIRE( parser.ctx().m_message_complete );
+	REQUIRE( "unit-test" == parser.ctx().m_header.get_field( "User-Agent" ) );
+	REQUIRE( "" == parser.ctx().m_header.get_field( "Empty" ) );
+}
+
+TEST_CASE( "Header block scanning" , "[simd]" )
+{
+	namespace simd = restinio::impl::http_parser_simd;
+
+	INFO( "instruction set: " << simd::instruction_set_name() );
+
+	// Check every position of delimiters around 16/32 bytes boundaries.
+	for( std::size_t pos = 0u; pos != 80u; ++pos )
+	{
+		std::string block( pos, 'a' );
+		block += "\r\n\r\n";
+		block += std::string( 40u, 'b' );
+
+		const char * first = block.data();
+		const char * last = first + block.size();
+		REQUIRE( first + pos + 4u == simd::find_header_block_end( first, last ) );
+		REQUIRE( nullptr == simd::find_header_block_end( first, first + pos + 3u ) );
+
+		block[ pos ] = '\x7F';
+		REQUIRE( first + pos == simd::find_value_end( first, last ) );
+		block[ pos ] = '\t';
+		REQUIRE( first + pos + 1u == simd::find_value_end( first, last ) );
+		REQUIRE( first + pos == simd::find_target_end( first, last ) );
+		block[ pos ] = '\xC0';
+		REQUIRE( first + pos + 1u == simd::find_target_end( first, last ) );
+	}
+}
+
+struct fast_parser_traits_t : public restinio::traits_t<
+	restinio::asio_timer_manager_t, utest_logger_t >
+{
+	using http_parser_backend_t = backend::fast_backend_t;
+};
+
+TEST_CASE( "Server with fast parser" , "[server]" )
+{
+	using http_server_t = restinio::http_server_t< fast_parser_traits_t >;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler(
+					[]( auto req ){
+						return req->create_response()
+							.append_header( "Content-Type", "text/plain; charset=utf-8" )
+							.set_body(
+								fmt::format( "{}:{}:{}",
+									req->header().method().c_str(),
+									req->header().request_target(),
+									req->body() ) )
+							.done();
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	std::string response;
+	const char * request_str =
+		"GET /first HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"\r\n"
+		"POST /second HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Connection: close\r\n"
+		"\r\n"
+		"4\r\nDATA\r\n0\r\n\r\n";
+
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+
+	other_thread.stop_and_join();
+
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "GET:/first:" ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "POST:/second:DATA" ) );
+}
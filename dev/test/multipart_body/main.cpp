@@ -586,3 +586,268 @@ TEST_CASE( "Several parts in the body", "[body]" )
 	REQUIRE( 5 == ordinal );
 }
 
+
+namespace
+{
+
+struct collected_part_t
+{
+	restinio::http_header_fields_t m_fields;
+	std::string m_body;
+	bool m_completed{ false };
+};
+
+struct collector_t
+{
+	std::vector< collected_part_t > m_parts;
+	std::size_t m_stop_after{ 100u };
+	bool m_terminate{ false };
+
+	restinio::multipart_body::handling_result_t
+	on_part_begin( restinio::http_header_fields_t && fields )
+	{
+		m_parts.emplace_back();
+		m_parts.back().m_fields = std::move(fields);
+		return restinio::multipart_body::handling_result_t::continue_enumeration;
+	}
+
+	restinio::multipart_body::handling_result_t
+	on_part_data( restinio::string_view_t fragment )
+	{
+		REQUIRE( !fragment.empty() );
+		m_parts.back().m_body.append( fragment.data(), fragment.size() );
+		return restinio::multipart_body::handling_result_t::continue_enumeration;
+	}
+
+	restinio::multipart_body::handling_result_t
+	on_part_end()
+	{
+		using restinio::multipart_body::handling_result_t;
+
+		m_parts.back().m_completed = true;
+		if( m_terminate )
+			return handling_result_t::terminate_enumeration;
+		if( m_parts.size() >= m_stop_after )
+			return handling_result_t::stop_enumeration;
+		return handling_result_t::continue_enumeration;
+	}
+};
+
+template< typename Parser >
+restinio::expected_t<
+	std::size_t,
+	restinio::multipart_body::enumeration_error_t >
+feed_by_chunks(
+	Parser & parser,
+	restinio::string_view_t body,
+	std::size_t chunk_size )
+{
+	while( !body.empty() && !parser.is_completed() )
+	{
+		const auto size = (std::min)( chunk_size, body.size() );
+		parser.consume( body.substr( 0u, size ) );
+		body = body.substr( size );
+	}
+
+	return parser.finish();
+}
+
+} /* namespace anonymous */
+
+TEST_CASE( "Streaming parser", "[streaming]" )
+{
+	using namespace restinio::multipart_body;
+
+	const std::string body =
+			"This is a preamble\r\n"
+			"--1234567890\r\n"
+			"Content-Disposition: form-data; name=\"file1\"; filename=\"t1.txt\"\r\n"
+			"Content-Type: text/plain\r\n"
+			"\r\n"
+			"Hello, World!\r\n--12345\r\n-\r\r\n\r\n--123456789\r\n"
+			"--1234567890\r\n"
+			"\r\n"
+			"No headers\r\n"
+			"--1234567890\r\n"
+			"Content-Disposition: form-data; name=\"empty\"\r\n"
+			"\r\n"
+			"\r\n"
+			"--1234567890--\r\n"
+			"This is an epilogue\r\n"
+			"--1234567890\r\n";
+
+	for( std::size_t chunk_size : { 1u, 2u, 3u, 5u, 7u, 13u, 16u, 64u, 1024u } )
+	{
+		CAPTURE( chunk_size );
+
+		auto parser = make_streaming_parser( "--1234567890", collector_t{} );
+		const auto result = feed_by_chunks( parser, body, chunk_size );
+
+		REQUIRE( result );
+		REQUIRE( 3u == *result );
+
+		const auto & parts = parser.handler().m_parts;
+		REQUIRE( 3u == parts.size() );
+
+		REQUIRE( parts[0].m_completed );
+		REQUIRE( "text/plain" ==
+				parts[0].m_fields.value_of( restinio::http_field::content_type ) );
+		REQUIRE( "Hello, World!\r\n--12345\r\n-\r\r\n\r\n--123456789" ==
+				parts[0].m_body );
+
+		REQUIRE( parts[1].m_completed );
+		REQUIRE( 0u == parts[1].m_fields.fields_count() );
+		REQUIRE( "No headers" == parts[1].m_body );
+
+		REQUIRE( parts[2].m_completed );
+		REQUIRE( 1u == parts[2].m_fields.fields_count() );
+		REQUIRE( parts[2].m_body.empty() );
+	}
+}
+
+TEST_CASE( "Streaming parser and invalid bodies", "[streaming]" )
+{
+	using namespace restinio::multipart_body;
+
+	const auto parse = []( restinio::string_view_t body, std::size_t chunk_size ) {
+		auto parser = make_streaming_parser( "--1234567890", collector_t{} );
+		return feed_by_chunks( parser, body, chunk_size );
+	};
+
+	for( std::size_t chunk_size : { 1u, 3u, 1024u } )
+	{
+		CAPTURE( chunk_size );
+
+		{
+			const auto r = parse( "", chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::no_parts_found == r.error() );
+		}
+
+		{
+			const auto r = parse( "no boundary here", chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::no_parts_found == r.error() );
+		}
+
+		{
+			// The last boundary is missing.
+			const auto r = parse(
+					"--1234567890\r\n\r\nfirst\r\n"
+					"--1234567890\r\n\r\nsecond\r\n", chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::unexpected_error == r.error() );
+		}
+
+		{
+			// Garbage after boundary.
+			const auto r = parse(
+					"--1234567890xx\r\n\r\nfirst\r\n"
+					"--1234567890--\r\n", chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::unexpected_error == r.error() );
+		}
+
+		{
+			// Invalid header.
+			const auto r = parse(
+					"--1234567890\r\n"
+					"Content Type: text/plain\r\n\r\nfirst\r\n"
+					"--1234567890--\r\n", chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::unexpected_error == r.error() );
+		}
+	}
+}
+
+TEST_CASE( "Streaming parser limits and handler results", "[streaming]" )
+{
+	using namespace restinio::multipart_body;
+
+	const std::string body =
+			"--1234567890\r\n"
+			"Content-Type: text/plain\r\n"
+			"\r\n"
+			"first\r\n"
+			"--1234567890\r\n"
+			"\r\n"
+			"second\r\n"
+			"--1234567890--\r\n";
+
+	for( std::size_t chunk_size : { 1u, 4u, 1024u } )
+	{
+		CAPTURE( chunk_size );
+
+		{
+			collector_t collector;
+			collector.m_stop_after = 1u;
+			auto parser = make_streaming_parser( "--1234567890", collector );
+			const auto r = feed_by_chunks( parser, body, chunk_size );
+			REQUIRE( r );
+			REQUIRE( 1u == *r );
+			REQUIRE( 1u == parser.handler().m_parts.size() );
+		}
+
+		{
+			collector_t collector;
+			collector.m_terminate = true;
+			auto parser = make_streaming_parser( "--1234567890", collector );
+			const auto r = feed_by_chunks( parser, body, chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::terminated_by_handler == r.error() );
+		}
+
+		{
+			streaming_parser_t< collector_t > parser{
+					"--1234567890", collector_t{}, 16u };
+			const auto r = feed_by_chunks( parser, body, chunk_size );
+			REQUIRE( !r );
+			REQUIRE( enumeration_error_t::part_headers_too_large == r.error() );
+		}
+
+		{
+			streaming_parser_t< collector_t > parser{
+					"--1234567890", collector_t{}, 28u };
+			const auto r = feed_by_chunks( parser, body, chunk_size );
+			REQUIRE( r );
+			REQUIRE( 2u == *r );
+		}
+	}
+}
+
+TEST_CASE( "Streaming parser and boundary length", "[streaming]" )
+{
+	using namespace restinio::multipart_body;
+
+	{
+		// The longest boundary allowed by RFC 2046.
+		const std::string boundary = "--" + std::string( 70u, 'b' );
+		const std::string body =
+				boundary + "\r\n\r\nfirst\r\n" +
+				boundary + "\r\n\r\nsecond\r\n" +
+				boundary + "--\r\n";
+
+		for( std::size_t chunk_size : { 1u, 7u, 1024u } )
+		{
+			CAPTURE( chunk_size );
+
+			auto parser = make_streaming_parser( boundary, collector_t{} );
+			const auto r = feed_by_chunks( parser, body, chunk_size );
+			REQUIRE( r );
+			REQUIRE( 2u == *r );
+			REQUIRE( "second" == parser.handler().m_parts[1].m_body );
+		}
+	}
+
+	const auto make = []( std::string boundary ) {
+		return make_streaming_parser( boundary, collector_t{} );
+	};
+
+	REQUIRE_THROWS_AS( make( "--" + std::string( 71u, 'b' ) ),
+			restinio::exception_t );
+	REQUIRE_THROWS_AS( make( "--" + std::string( 254u, 'b' ) ),
+			restinio::exception_t );
+	REQUIRE_THROWS_AS( make( "--" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( make( "" ), restinio::exception_t );
+	REQUIRE_THROWS_AS( make( "1234567890" ), restinio::exception_t );
+}
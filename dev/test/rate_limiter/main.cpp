@@ -0,0 +1,212 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/helpers/rate_limiter.hpp>
+
+using namespace std::string_literals;
+
+namespace rl = restinio::rate_limiter;
+
+namespace
+{
+
+class recording_connection_t : public restinio::impl::connection_base_t
+{
+public:
+	using restinio::impl::connection_base_t::connection_base_t;
+
+	std::vector< std::string > m_responses;
+
+	void
+	write_response_parts(
+		restinio::request_id_t /*request_id*/,
+		restinio::response_output_flags_t /*response_output_flags*/,
+		restinio::write_group_t wg ) override
+	{
+		std::string response;
+		for( const auto & item : wg.items() )
+		{
+			const auto buf = item.buf();
+			response.append(
+					static_cast< const char * >( buf.data() ), buf.size() );
+		}
+		m_responses.push_back( std::move( response ) );
+	}
+
+	void
+	check_timeout(
+		std::shared_ptr< restinio::tcp_connection_ctx_base_t > & /*self*/ ) override
+	{}
+};
+
+RESTINIO_NODISCARD
+auto
+make_request(
+	std::shared_ptr< recording_connection_t > connection,
+	const char * remote_address )
+{
+	restinio::http_request_header_t header{
+			restinio::http_method_get(), "/"s };
+
+	restinio::no_extra_data_factory_t extra_data_factory;
+	return std::make_shared< restinio::request_t >(
+			restinio::request_id_t{1},
+			std::move( header ),
+			""s,
+			std::move( connection ),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address( remote_address ),
+				12345u },
+			extra_data_factory );
+}
+
+RESTINIO_NODISCARD
+restinio::asio_ns::ip::address
+addr( const char * what )
+{
+	return restinio::asio_ns::ip::make_address( what );
+}
+
+} /* namespace anonymous */
+
+TEST_CASE( "Token bucket", "[rate_limiter]" )
+{
+	rl::token_bucket_limiter_t limiter{
+			rl::settings_t{}.rate( 2.0 ).burst( 3.0 ) };
+
+	const auto start = std::chrono::steady_clock::now();
+
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), start ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), start ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), start ) );
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), start ) );
+
+	// Other clients have their own buckets.
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.2" ), start ) );
+	// IPv4-mapped IPv6 address is the same client.
+	REQUIRE( !limiter.try_acquire( addr( "::ffff:10.0.0.1" ), start ) );
+	REQUIRE( 2u == limiter.tracked_clients() );
+
+	// One token is added every 500ms.
+	const auto t1 = start + std::chrono::milliseconds( 400 );
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), t1 ) );
+	const auto t2 = start + std::chrono::milliseconds( 600 );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), t2 ) );
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), t2 ) );
+
+	// The bucket can't hold more than burst tokens.
+	const auto t3 = start + std::chrono::seconds( 60 );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), t3 ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), t3 ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), t3 ) );
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), t3 ) );
+}
+
+TEST_CASE( "Address prefixes", "[rate_limiter]" )
+{
+	rl::token_bucket_limiter_t limiter{
+			rl::settings_t{}.burst( 1.0 ).ipv4_prefix_length( 24u ) };
+
+	const auto now = std::chrono::steady_clock::now();
+
+	REQUIRE( limiter.try_acquire( addr( "192.168.1.1" ), now ) );
+	REQUIRE( !limiter.try_acquire( addr( "192.168.1.2" ), now ) );
+	REQUIRE( limiter.try_acquire( addr( "192.168.2.1" ), now ) );
+
+	// The default prefix length for IPv6 is 64.
+	REQUIRE( limiter.try_acquire( addr( "2001:db8:0:1::1" ), now ) );
+	REQUIRE( !limiter.try_acquire( addr( "2001:db8:0:1::2" ), now ) );
+	REQUIRE( limiter.try_acquire( addr( "2001:db8:0:2::1" ), now ) );
+
+	REQUIRE( 4u == limiter.tracked_clients() );
+}
+
+TEST_CASE( "Eviction of old clients", "[rate_limiter]" )
+{
+	rl::token_bucket_limiter_t limiter{
+			rl::settings_t{}.burst( 1.0 ).shards_count( 1u ).max_clients( 2u ) };
+
+	const auto now = std::chrono::steady_clock::now();
+
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.1" ), now ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.2" ), now ) );
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), now ) );
+	// 10.0.0.2 is the least recently seen client now.
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.3" ), now ) );
+	REQUIRE( 2u == limiter.tracked_clients() );
+
+	REQUIRE( !limiter.try_acquire( addr( "10.0.0.1" ), now ) );
+	REQUIRE( limiter.try_acquire( addr( "10.0.0.2" ), now ) );
+}
+
+TEST_CASE( "Connection rate limiter", "[rate_limiter]" )
+{
+	rl::connection_rate_limiter_t limiter{
+			rl::settings_t{}.rate( 0.001 ).burst( 2.0 ) };
+
+	const restinio::ip_blocker::incoming_info_t info{
+			restinio::endpoint_t{ addr( "10.0.0.1" ), 12345u } };
+
+	REQUIRE( restinio::ip_blocker::allow() == limiter.inspect( info ) );
+	REQUIRE( restinio::ip_blocker::allow() == limiter.inspect( info ) );
+	REQUIRE( restinio::ip_blocker::deny() == limiter.inspect( info ) );
+}
+
+TEST_CASE( "Request rate limiter", "[rate_limiter]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rl::request_rate_limiter_t limiter{
+			rl::settings_t{}.rate( 0.25 ).burst( 1.0 ) };
+
+	int calls = 0;
+	auto handler = limiter.wrap(
+		[&calls]( const restinio::request_handle_t & req, int v ) {
+			calls += v;
+			return req->create_response().done();
+		} );
+
+	REQUIRE( restinio::request_accepted() ==
+			handler( make_request( connection, "10.0.0.1" ), 1 ) );
+	REQUIRE( restinio::request_accepted() ==
+			handler( make_request( connection, "10.0.0.1" ), 1 ) );
+	REQUIRE( restinio::request_accepted() ==
+			handler( make_request( connection, "10.0.0.2" ), 1 ) );
+
+	REQUIRE( 2 == calls );
+	REQUIRE( 3u == connection->m_responses.size() );
+	REQUIRE( 0u == connection->m_responses[ 0 ].find( "HTTP/1.1 200 OK" ) );
+
+	const auto & rejected = connection->m_responses[ 1 ];
+	REQUIRE( 0u == rejected.find( "HTTP/1.1 429 Too Many Requests" ) );
+	REQUIRE( std::string::npos != rejected.find( "Retry-After: 4\r\n" ) );
+	REQUIRE( std::string::npos != rejected.find( "\r\n\r\nToo Many Requests" ) );
+}
+
+TEST_CASE( "Retry-After for very small rate", "[rate_limiter]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rl::request_rate_limiter_t limiter{
+			rl::settings_t{}.rate( 1e-30 ).burst( 1.0 ) };
+
+	auto handler = limiter.wrap(
+		[]( const restinio::request_handle_t & req ) {
+			return req->create_response().done();
+		} );
+
+	REQUIRE( restinio::request_accepted() ==
+			handler( make_request( connection, "10.0.0.1" ) ) );
+	REQUIRE( restinio::request_accepted() ==
+			handler( make_request( connection, "10.0.0.1" ) ) );
+
+	REQUIRE( 2u == connection->m_responses.size() );
+
+	// The value is limited by one day.
+	const auto & rejected = connection->m_responses[ 1 ];
+	REQUIRE( std::string::npos != rejected.find( "Retry-After: 86400\r\n" ) );
+}
@@ -0,0 +1,257 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/helpers/response_cache.hpp>
+
+using namespace std::string_literals;
+
+namespace rc = restinio::response_cache;
+
+namespace
+{
+
+class recording_connection_t : public restinio::impl::connection_base_t
+{
+public:
+	using restinio::impl::connection_base_t::connection_base_t;
+
+	std::vector< std::string > m_responses;
+
+	void
+	write_response_parts(
+		restinio::request_id_t /*request_id*/,
+		restinio::response_output_flags_t /*response_output_flags*/,
+		restinio::write_group_t wg ) override
+	{
+		std::string response;
+		for( const auto & item : wg.items() )
+		{
+			const auto buf = item.buf();
+			response.append(
+					static_cast< const char * >( buf.data() ), buf.size() );
+		}
+		m_responses.push_back( std::move( response ) );
+	}
+
+	void
+	check_timeout(
+		std::shared_ptr< restinio::tcp_connection_ctx_base_t > & /*self*/ ) override
+	{}
+};
+
+RESTINIO_NODISCARD
+auto
+make_request(
+	std::shared_ptr< recording_connection_t > connection,
+	restinio::http_method_id_t method,
+	std::string target,
+	std::string accept = std::string{} )
+{
+	restinio::http_request_header_t header{ method, std::move( target ) };
+	if( !accept.empty() )
+		header.set_field( restinio::http_field::accept, std::move( accept ) );
+
+	restinio::no_extra_data_factory_t extra_data_factory;
+	return std::make_shared< restinio::request_t >(
+			restinio::request_id_t{1},
+			std::move( header ),
+			""s,
+			std::move( connection ),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+				12345u },
+			extra_data_factory );
+}
+
+} /* namespace anonymous */
+
+TEST_CASE( "Response is taken from the cache", "[response_cache]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rc::response_cache_t cache;
+
+	int calls = 0;
+	auto handler = cache.wrap( [&calls]( const restinio::request_handle_t & req ) {
+			++calls;
+			const auto path = req->header().path();
+			return rc::cached_response_t{ restinio::status_ok() }
+					.append_header( restinio::http_field::content_type, "text/plain" )
+					.set_body( "Hello from " + std::string{ path.data(), path.size() } );
+		} );
+
+	REQUIRE( restinio::request_accepted() == handler(
+			make_request( connection, restinio::http_method_get(), "/hello" ) ) );
+	REQUIRE( restinio::request_accepted() == handler(
+			make_request( connection, restinio::http_method_get(), "/hello" ) ) );
+	// Percent-encoded unreserved chars are normalized.
+	REQUIRE( restinio::request_accepted() == handler(
+			make_request( connection, restinio::http_method_get(), "/h%65llo" ) ) );
+
+	REQUIRE( 1 == calls );
+	REQUIRE( 3u == connection->m_responses.size() );
+	for( const auto & r : connection->m_responses )
+	{
+		REQUIRE( std::string::npos != r.find( "Content-Type: text/plain\r\n" ) );
+		REQUIRE( std::string::npos != r.find( "\r\n\r\nHello from /hello" ) );
+	}
+
+	const auto stats = cache.stats();
+	REQUIRE( 2u == stats.m_hits );
+	REQUIRE( 1u == stats.m_misses );
+	REQUIRE( 1u == stats.m_entries );
+
+	REQUIRE( restinio::request_accepted() == handler(
+			make_request( connection, restinio::http_method_get(), "/bye" ) ) );
+	REQUIRE( 2 == calls );
+	REQUIRE( 2u == cache.stats().m_entries );
+}
+
+TEST_CASE( "Request with args", "[response_cache]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rc::response_cache_t cache;
+
+	int calls = 0;
+	auto handler = cache.wrap(
+		[&calls]( const restinio::request_handle_t &, int a, std::string b ) {
+			++calls;
+			return rc::cached_response_t{ restinio::status_ok() }
+					.set_body( std::to_string( a ) + b );
+		} );
+
+	REQUIRE( restinio::request_accepted() == handler(
+			make_request( connection, restinio::http_method_get(), "/a" ),
+			42, "b"s ) );
+	REQUIRE( 1 == calls );
+	REQUIRE( std::string::npos != connection->m_responses.back().find( "42b" ) );
+}
+
+TEST_CASE( "Vary by header fields", "[response_cache]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rc::response_cache_t cache{ rc::settings_t{}.vary_by( { "Accept" } ) };
+
+	int calls = 0;
+	auto handler = cache.wrap( [&calls]( const restinio::request_handle_t & req ) {
+			++calls;
+			return rc::cached_response_t{ restinio::status_ok() }
+					.set_body( "accept=" +
+							req->header().get_field_or( "Accept", "none" ) );
+		} );
+
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/r", "text/plain" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/r", "application/json" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/r" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/r", "application/json" ) );
+
+	REQUIRE( 3 == calls );
+	REQUIRE( 4u == connection->m_responses.size() );
+	REQUIRE( std::string::npos !=
+			connection->m_responses[ 3 ].find( "accept=application/json" ) );
+
+	// Invalidation removes all variants.
+	cache.invalidate( restinio::http_method_get(), "/r" );
+	REQUIRE( 0u == cache.stats().m_entries );
+
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/r", "text/plain" ) );
+	REQUIRE( 4 == calls );
+}
+
+TEST_CASE( "Not cacheable responses", "[response_cache]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	rc::response_cache_t cache;
+
+	int calls = 0;
+	auto handler = cache.wrap( [&calls]( const restinio::request_handle_t & req ) {
+			++calls;
+			return rc::cached_response_t{ restinio::status_not_found() }
+					.cacheable( req->header().path() != "/not-cacheable" );
+		} );
+
+	(void)handler( make_request( connection,
+			restinio::http_method_post(), "/post" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_post(), "/post" ) );
+	REQUIRE( 2 == calls );
+
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/not-cacheable" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/not-cacheable" ) );
+	REQUIRE( 4 == calls );
+
+	// Invalid percent-encoding.
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/%Z" ) );
+	(void)handler( make_request( connection,
+			restinio::http_method_get(), "/%Z" ) );
+	REQUIRE( 6 == calls );
+
+	REQUIRE( 0u == cache.stats().m_entries );
+	REQUIRE( 6u == connection->m_responses.size() );
+}
+
+TEST_CASE( "Time to live and size limit", "[response_cache]" )
+{
+	auto connection = std::make_shared< recording_connection_t >( 1u );
+
+	int calls = 0;
+	const auto producer = [&calls]( const restinio::request_handle_t & ) {
+			++calls;
+			return rc::cached_response_t{ restinio::status_ok() }
+					.set_body( std::string( 1000u, 'x' ) );
+		};
+
+	{
+		rc::response_cache_t cache{
+				rc::settings_t{}.time_to_live( std::chrono::seconds::zero() ) };
+		auto handler = cache.wrap( producer );
+
+		(void)handler( make_request( connection,
+				restinio::http_method_get(), "/a" ) );
+		(void)handler( make_request( connection,
+				restinio::http_method_get(), "/a" ) );
+		REQUIRE( 2 == calls );
+	}
+
+	calls = 0;
+	{
+		rc::response_cache_t cache{
+				rc::settings_t{}.shards_count( 1u ).max_size( 3000u ) };
+		auto handler = cache.wrap( producer );
+
+		for( int i = 0; i != 10; ++i )
+			(void)handler( make_request( connection,
+					restinio::http_method_get(), "/" + std::to_string( i ) ) );
+		REQUIRE( 10 == calls );
+
+		const auto stats = cache.stats();
+		REQUIRE( 2u == stats.m_entries );
+		REQUIRE( 3000u >= stats.m_size );
+
+		// The most recently used responses are kept.
+		(void)handler( make_request( connection,
+				restinio::http_method_get(), "/9" ) );
+		REQUIRE( 10 == calls );
+		(void)handler( make_request( connection,
+				restinio::http_method_get(), "/0" ) );
+		REQUIRE( 11 == calls );
+
+		cache.invalidate_all();
+		REQUIRE( 0u == cache.stats().m_entries );
+	}
+}
@@ -9,6 +9,7 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/router/easy_parser_router_dsl/prj.ut.rb" )
 	required_prj( "test/router/easy_parser_path_to_tuple/prj.ut.rb" )
 	required_prj( "test/router/easy_parser_path_to_params/prj.ut.rb" )
+	required_prj( "test/router/easy_parser_router_dispatch/prj.ut.rb" )
 
 	required_prj( "test/router/express/prj.ut.rb" )
 	required_prj( "test/router/express_router/prj.ut.rb" )
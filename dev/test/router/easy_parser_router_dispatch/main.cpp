@@ -0,0 +1,270 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for dispatching requests by HTTP method and the first
+	segment of path in easy_parser_router.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <restinio/all.hpp>
+#include <restinio/router/easy_parser_router.hpp>
+
+using namespace restinio;
+
+namespace epr = restinio::router::easy_parser_router;
+
+#include "../fake_connection_and_request.ipp"
+
+using router_t = restinio::router::easy_parser_router_t;
+
+namespace
+{
+
+struct stats_collector_t
+{
+	std::vector< epr::match_stats_t > m_stats;
+
+	void
+	attach( router_t & router )
+	{
+		router.match_stats_listener(
+				[this]( const epr::match_stats_t & s ) {
+					m_stats.push_back( s );
+				} );
+	}
+
+	epr::match_stats_t
+	last() const
+	{
+		REQUIRE( !m_stats.empty() );
+		return m_stats.back();
+	}
+};
+
+} /* namespace anonymous */
+
+TEST_CASE( "First path segment of a route" , "[literal_prefix]" )
+{
+	using epr::impl::first_path_segment_of;
+	using epr::impl::route_literal_prefix_t;
+
+	REQUIRE( "api" == *first_path_segment_of(
+			route_literal_prefix_t{ "/api/v1/", false } ) );
+	REQUIRE( "api" == *first_path_segment_of(
+			route_literal_prefix_t{ "/api", true } ) );
+	REQUIRE( "" == *first_path_segment_of(
+			route_literal_prefix_t{ "/", true } ) );
+	REQUIRE( !first_path_segment_of(
+			route_literal_prefix_t{ "/api", false } ) );
+	REQUIRE( !first_path_segment_of(
+			route_literal_prefix_t{ "", false } ) );
+	REQUIRE( !first_path_segment_of(
+			route_literal_prefix_t{ "api/", false } ) );
+}
+
+TEST_CASE( "Literal prefix detection" , "[literal_prefix]" )
+{
+	const restinio::string_view_t slash{ "/" };
+
+	{
+		auto r = epr::path_to_params(
+				slash, "api", std::string{ "/" }, epr::exact( "v1/" ),
+				epr::non_negative_decimal_number_p<int>() );
+		REQUIRE( "/api/v1/" == r.literal_prefix().m_fragment );
+		REQUIRE( !r.literal_prefix().m_is_whole_route );
+	}
+
+	{
+		auto r = epr::path_to_tuple( "/api", epr::exact( "/v1" ) );
+		REQUIRE( "/api/v1" == r.literal_prefix().m_fragment );
+		REQUIRE( r.literal_prefix().m_is_whole_route );
+	}
+
+	{
+		auto r = epr::path_to_params(
+				epr::non_negative_decimal_number_p<int>(), "/api" );
+		REQUIRE( r.literal_prefix().m_fragment.empty() );
+		REQUIRE( !r.literal_prefix().m_is_whole_route );
+	}
+}
+
+TEST_CASE( "Only applicable routes are tried" , "[dispatch]" )
+{
+	router_t router;
+	stats_collector_t stats;
+	stats.attach( router );
+
+	int last_handler_called = -1;
+
+	auto id_p = epr::non_negative_decimal_number_p<int>();
+
+	router.http_get( epr::path_to_params( "/users/", id_p ),
+		[&]( const auto &, int ) {
+			last_handler_called = 0;
+			return request_accepted();
+		} );
+	router.http_post( epr::path_to_params( "/users/", id_p ),
+		[&]( const auto &, int ) {
+			last_handler_called = 1;
+			return request_accepted();
+		} );
+	router.http_get( epr::path_to_params( "/books/", id_p ),
+		[&]( const auto &, int ) {
+			last_handler_called = 2;
+			return request_accepted();
+		} );
+	router.http_get( epr::path_to_params( "/books" ),
+		[&]( const auto & ) {
+			last_handler_called = 3;
+			return request_accepted();
+		} );
+	router.http_get( epr::path_to_params( "/" ),
+		[&]( const auto & ) {
+			last_handler_called = 4;
+			return request_accepted();
+		} );
+
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/books/42" ) ) );
+	REQUIRE( 2 == last_handler_called );
+	REQUIRE( 1u == stats.last().m_attempts );
+	REQUIRE( 5u == stats.last().m_total_routes );
+	REQUIRE( stats.last().m_matched );
+
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/books/" ) ) );
+	REQUIRE( 3 == last_handler_called );
+	REQUIRE( 2u == stats.last().m_attempts );
+
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/users/42", http_method_post() ) ) );
+	REQUIRE( 1 == last_handler_called );
+	REQUIRE( 1u == stats.last().m_attempts );
+
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/" ) ) );
+	REQUIRE( 4 == last_handler_called );
+	REQUIRE( 1u == stats.last().m_attempts );
+
+	// Percent-encoded unreserved chars are normalized before dispatching.
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/%75sers/42" ) ) );
+	REQUIRE( 0 == last_handler_called );
+	REQUIRE( 1u == stats.last().m_attempts );
+
+	REQUIRE( request_not_handled() == router(
+			create_fake_request( router, "/authors/42" ) ) );
+	REQUIRE( 0u == stats.last().m_attempts );
+	REQUIRE( !stats.last().m_matched );
+
+	REQUIRE( request_not_handled() == router(
+			create_fake_request( router, "/books/42", http_method_delete() ) ) );
+	REQUIRE( 0u == stats.last().m_attempts );
+}
+
+TEST_CASE( "Order of registration is preserved" , "[dispatch]" )
+{
+	// Every route is placed into its own bucket of the dispatch table
+	// but all of them match the same request.
+	const auto add_route = []( router_t & router, int id, int & handled_by ) {
+		auto any_p = epr::path_fragment_p();
+		auto handler = [id, &handled_by]( const auto &, const auto &... ) {
+			handled_by = id;
+			return request_accepted();
+		};
+		const auto get_or_post = restinio::router::any_of_methods(
+				http_method_get(), http_method_post() );
+
+		switch( id )
+		{
+			case 0: // Known method, known first segment.
+				router.http_get(
+						epr::path_to_params( "/api/", any_p ), handler );
+			break;
+
+			case 1: // Any method, known first segment.
+				router.add_handler( get_or_post,
+						epr::path_to_params( "/api/", any_p ), handler );
+			break;
+
+			case 2: // Known method, any first segment.
+				router.http_get(
+						epr::path_to_params( "/", any_p, "/", any_p ), handler );
+			break;
+
+			case 3: // Any method, any first segment.
+				router.add_handler( get_or_post,
+						epr::path_to_params( "/", any_p, "/", any_p ), handler );
+			break;
+		}
+	};
+
+	std::array< int, 4 > ids{ { 0, 1, 2, 3 } };
+	do
+	{
+		router_t router;
+		stats_collector_t stats;
+		stats.attach( router );
+
+		int handled_by = -1;
+		for( const auto id : ids )
+			add_route( router, id, handled_by );
+
+		REQUIRE( request_accepted() == router(
+				create_fake_request( router, "/api/v1" ) ) );
+		REQUIRE( ids[ 0 ] == handled_by );
+		REQUIRE( 1u == stats.last().m_attempts );
+	}
+	while( std::next_permutation( ids.begin(), ids.end() ) );
+}
+
+TEST_CASE( "Failed registration of a route" , "[dispatch]" )
+{
+	//! A handler that can't be copied into the router.
+	struct throwing_handler_t
+	{
+		throwing_handler_t() = default;
+		throwing_handler_t( const throwing_handler_t & )
+		{
+			throw std::runtime_error{ "copy failed" };
+		}
+
+		request_handling_status_t
+		operator()( const generic_request_handle_t<no_extra_data_factory_t::data_t> & ) const
+		{
+			return request_accepted();
+		}
+	};
+
+	router_t router;
+	stats_collector_t stats;
+	stats.attach( router );
+
+	const throwing_handler_t throwing_handler;
+	REQUIRE_THROWS_AS(
+			router.http_get( epr::path_to_params( "/books" ), throwing_handler ),
+			std::runtime_error );
+
+	int handled = 0;
+	router.http_get( epr::path_to_params( "/users" ),
+		[&]( const auto & ) {
+			++handled;
+			return request_accepted();
+		} );
+
+	// The failed route isn't in the dispatch table.
+	REQUIRE( request_not_handled() == router(
+			create_fake_request( router, "/books" ) ) );
+	REQUIRE( 0u == stats.last().m_attempts );
+	REQUIRE( 1u == stats.last().m_total_routes );
+
+	REQUIRE( request_accepted() == router(
+			create_fake_request( router, "/users" ) ) );
+	REQUIRE( 1 == handled );
+}
@@ -15,3 +15,33 @@
 #include "usings.ipp"
 
 #include "../express/additional_tests.ipp"
+
+TEST_CASE( "Reuse of pcre2 match data" , "[pcre2][match_data]" )
+{
+	using match_results_t = regex_engine_t::match_results_t;
+
+	pcre2_match_data * first_data = nullptr;
+	{
+		match_results_t first;
+		match_results_t second;
+		REQUIRE( first.m_match_data != second.m_match_data );
+
+		first_data = first.m_match_data;
+	}
+
+	// Match data is taken from the cache of the thread.
+	match_results_t third;
+	match_results_t fourth;
+	REQUIRE( ( first_data == third.m_match_data ||
+			first_data == fourth.m_match_data ) );
+
+	auto regex = regex_engine_t::compile_regex( R"(^/(\d+)$)", true );
+	REQUIRE( regex_engine_t::try_match( "/42", regex, third ) );
+	REQUIRE( regex_engine_t::try_match( "/7", regex, fourth ) );
+
+	// Results of simultaneous matches don't overlap.
+	REQUIRE( 1u == regex_engine_t::submatch_begin_pos( third[ 1 ] ) );
+	REQUIRE( 3u == regex_engine_t::submatch_end_pos( third[ 1 ] ) );
+	REQUIRE( 1u == regex_engine_t::submatch_begin_pos( fourth[ 1 ] ) );
+	REQUIRE( 2u == regex_engine_t::submatch_end_pos( fourth[ 1 ] ) );
+}
@@ -1016,3 +1016,130 @@ TEST_CASE( "Parameters cast" , "[express][parameters_cast]" )
 		REQUIRE_THROWS( restinio::cast_to< int_type_t >( route_params[ 0 ] ) );
 	}
 }
+
+TEST_CASE( "Combined regex" , "[express][combined_regex]" )
+{
+	struct handling_result_t
+	{
+		int m_handler{ -1 };
+		std::string m_match;
+		std::vector< std::pair< std::string, std::string > > m_named;
+		std::vector< std::string > m_indexed;
+
+		bool
+		operator==( const handling_result_t & o ) const
+		{
+			return m_handler == o.m_handler && m_match == o.m_match &&
+					m_named == o.m_named && m_indexed == o.m_indexed;
+		}
+	};
+
+	handling_result_t last_result;
+
+	const auto fill_router = [&]( express_router_t & router ) {
+		const auto make_handler = [&]( int id ) {
+			return [&last_result, id]( auto, route_params_t p ) {
+				last_result.m_handler = id;
+				last_result.m_match = std::string{ p.match().data(), p.match().size() };
+
+				const auto & nps =
+						restinio::router::impl::route_params_accessor_t::named_parameters( p );
+				for( const auto & np : nps )
+					last_result.m_named.emplace_back(
+							std::string{ np.first.data(), np.first.size() },
+							std::string{ np.second.data(), np.second.size() } );
+
+				const auto & ips =
+						restinio::router::impl::route_params_accessor_t::indexed_parameters( p );
+				for( const auto & ip : ips )
+					last_result.m_indexed.emplace_back( ip.data(), ip.size() );
+
+				return request_accepted();
+			};
+		};
+
+		router.http_get( "/users/:id(\\d+)", make_handler( 0 ) );
+		router.http_post( "/users/:id", make_handler( 1 ) );
+		router.http_get( "/users/:id/:action?", make_handler( 2 ) );
+		router.http_get( "/CaseSensitive",
+				restinio::path2regex::options_t{}.sensitive( true ),
+				make_handler( 3 ) );
+		router.http_get( "/casesensitive", make_handler( 4 ) );
+		router.http_get( R"(/news/:year(\d{4})-:month(\d{2})-:day(\d{2}))",
+				make_handler( 5 ) );
+		// A lot of params to exceed the limit of capture groups
+		// for some regex engines.
+		router.http_get( "/:a/:b/:c/:d/:e/:f/:g/:h/:i/:j", make_handler( 6 ) );
+		router.http_get( "/:a/:b/:c/:d/:e/:f/:g/:h/:i/:j/:k", make_handler( 7 ) );
+		router.http_get( "/events/(\\d{4})", make_handler( 8 ) );
+		router.add_handler(
+				restinio::router::none_of_methods( http_method_get() ),
+				"/events/(\\d{4})",
+				make_handler( 9 ) );
+		router.http_get( "/", make_handler( 10 ) );
+	};
+
+	express_router_t ordinary_router;
+	fill_router( ordinary_router );
+
+	express_router_t combined_router;
+	combined_router.use_combined_regex( true );
+	fill_router( combined_router );
+
+	const auto handle = [&]( express_router_t & router,
+			const char * target,
+			http_method_id_t method ) {
+		last_result = handling_result_t{};
+		const auto status = router(
+				create_fake_request( router, target, method ) );
+		return std::make_pair( status, last_result );
+	};
+
+	const std::pair< const char *, http_method_id_t > requests[] = {
+		{ "/users/42", http_method_get() },
+		{ "/users/42", http_method_post() },
+		{ "/users/abc", http_method_get() },
+		{ "/users/abc/delete", http_method_get() },
+		{ "/users/abc/", http_method_get() },
+		{ "/users/abc/delete", http_method_delete() },
+		{ "/CaseSensitive", http_method_get() },
+		{ "/CASESENSITIVE", http_method_get() },
+		{ "/casesensitive", http_method_get() },
+		{ "/news/2017-04-01", http_method_get() },
+		{ "/news/2017-04-XX", http_method_get() },
+		{ "/1/2/3/4/5/6/7/8/9/10", http_method_get() },
+		{ "/1/2/3/4/5/6/7/8/9/10/11", http_method_get() },
+		{ "/1/2/3/4/5/6/7/8/9/10/11/12", http_method_get() },
+		{ "/events/2020", http_method_get() },
+		{ "/events/2020", http_method_post() },
+		{ "/", http_method_get() },
+		{ "", http_method_get() },
+		{ "/unknown", http_method_get() },
+	};
+
+	for( const auto & r : requests )
+	{
+		INFO( "target: '" << r.first << "', method: " << r.second.c_str() );
+
+		const auto expected = handle( ordinary_router, r.first, r.second );
+		const auto actual = handle( combined_router, r.first, r.second );
+
+		REQUIRE( expected.first == actual.first );
+		REQUIRE( expected.second == actual.second );
+	}
+
+	REQUIRE( 0 == handle( combined_router, "/users/42", http_method_get() ).second.m_handler );
+	REQUIRE( 1 == handle( combined_router, "/users/42", http_method_post() ).second.m_handler );
+	REQUIRE( 2 == handle( combined_router, "/users/abc", http_method_get() ).second.m_handler );
+	REQUIRE( 4 == handle( combined_router, "/CASESENSITIVE", http_method_get() ).second.m_handler );
+	REQUIRE( 6 == handle( combined_router, "/1/2/3/4/5/6/7/8/9/10", http_method_get() ).second.m_handler );
+	REQUIRE( 7 == handle( combined_router, "/1/2/3/4/5/6/7/8/9/10/11", http_method_get() ).second.m_handler );
+	REQUIRE( 9 == handle( combined_router, "/events/2020", http_method_post() ).second.m_handler );
+
+	// A route added after the first request is taken into account.
+	combined_router.http_get( "/late", [&]( auto, auto ) {
+			last_result.m_handler = 11;
+			return request_accepted();
+		} );
+	REQUIRE( 11 == handle( combined_router, "/late", http_method_get() ).second.m_handler );
+}
@@ -6,6 +6,9 @@
 
 #include <restinio/helpers/http_field_parsers/try_parse_field.hpp>
 #include <restinio/helpers/http_field_parsers/content-encoding.hpp>
+#include <restinio/helpers/http_field_parsers/content-type.hpp>
+#include <restinio/helpers/http_field_parsers/basic_auth.hpp>
+#include <restinio/helpers/http_field_parsers/bearer_auth.hpp>
 
 #include <test/common/dummy_connection.hpp>
 
@@ -295,3 +298,152 @@ TEST_CASE( "Normal Content-Encoding field with get_if", "[try_parse_field]" )
 	}
 }
 
+TEST_CASE( "Cached parsing of fields", "[try_parse_field][cached]" )
+{
+	using namespace restinio::http_field_parsers;
+
+	restinio::http_request_header_t dummy_header{
+			restinio::http_method_post(),
+			"/"
+	};
+	dummy_header.set_field(
+			restinio::http_field::content_encoding,
+			"UTF-8"s );
+	dummy_header.set_field(
+			restinio::http_field::content_type,
+			"text/plain; charset=utf-8"s );
+	dummy_header.set_field( "X-Encoding"s, "gzip, Deflate"s );
+	dummy_header.set_field( "X-Bad-Encoding"s, ",,,"s );
+
+	restinio::no_extra_data_factory_t extra_data_factory;
+	auto req = std::make_shared< restinio::request_t >(
+			restinio::request_id_t{1},
+			std::move(dummy_header),
+			"Body"s,
+			dummy_connection_t::make(1u),
+			make_dummy_endpoint(),
+			extra_data_factory );
+
+	const auto & encoding = try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			restinio::http_field::content_encoding );
+	const auto * encoding_value = restinio::get_if< content_encoding_value_t >(
+			&encoding );
+	REQUIRE( encoding_value );
+	REQUIRE( std::vector<std::string>{ "utf-8"s } == encoding_value->values );
+
+	// The same object should be returned for the same field.
+	REQUIRE( &encoding == &try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			restinio::http_field::content_encoding ) );
+	REQUIRE( &encoding == &try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			"content-encoding" ) );
+
+	const auto & content_type = try_parse_field_cached< content_type_value_t >(
+			*req,
+			restinio::http_field::content_type );
+	const auto * content_type_value = restinio::get_if< content_type_value_t >(
+			&content_type );
+	REQUIRE( content_type_value );
+	REQUIRE( "text" == content_type_value->media_type.type );
+	REQUIRE( &content_type == &try_parse_field_cached< content_type_value_t >(
+			*req,
+			restinio::http_field::content_type ) );
+
+	// The same field can be parsed into a different type.
+	const auto & content_type_as_encoding =
+			try_parse_field_cached< content_encoding_value_t >(
+					*req,
+					restinio::http_field::content_type );
+	REQUIRE( static_cast< const void * >( &content_type_as_encoding ) !=
+			static_cast< const void * >( &content_type ) );
+
+	const auto & custom = try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			"X-Encoding" );
+	const auto * custom_value = restinio::get_if< content_encoding_value_t >(
+			&custom );
+	REQUIRE( custom_value );
+	REQUIRE( (std::vector<std::string>{ "gzip"s, "deflate"s }) ==
+			custom_value->values );
+	REQUIRE( &encoding != &custom );
+
+	const auto & bad = try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			"X-Bad-Encoding" );
+	REQUIRE( restinio::get_if< restinio::easy_parser::parse_error_t >( &bad ) );
+	REQUIRE( &bad == &try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			"x-bad-encoding" ) );
+
+	const auto & missing = try_parse_field_cached< content_encoding_value_t >(
+			*req,
+			restinio::http_field::accept );
+	REQUIRE( restinio::get_if< field_not_found_t >( &missing ) );
+
+	// Results obtained earlier are still valid.
+	REQUIRE( std::vector<std::string>{ "utf-8"s } == encoding_value->values );
+	REQUIRE( "plain" == content_type_value->media_type.subtype );
+}
+
+TEST_CASE( "Cached parsing of Authorization", "[try_parse_field][cached]" )
+{
+	using namespace restinio::http_field_parsers;
+
+	restinio::http_request_header_t dummy_header{
+			restinio::http_method_post(),
+			"/"
+	};
+	dummy_header.set_field(
+			restinio::http_field::authorization,
+			"Basic dXNlcjpwYXNzd29yZA=="s );
+
+	restinio::no_extra_data_factory_t extra_data_factory;
+	auto req = std::make_shared< restinio::request_t >(
+			restinio::request_id_t{1},
+			std::move(dummy_header),
+			"Body"s,
+			dummy_connection_t::make(1u),
+			make_dummy_endpoint(),
+			extra_data_factory );
+
+	const auto bearer_params = bearer_auth::try_extract_params_cached(
+			*req,
+			restinio::http_field::authorization );
+	REQUIRE( !bearer_params );
+	REQUIRE( bearer_auth::extraction_error_t::not_bearer_auth_scheme ==
+			bearer_params.error() );
+
+	const auto basic_params = basic_auth::try_extract_params_cached(
+			*req,
+			restinio::http_field::authorization );
+	REQUIRE( basic_params );
+	REQUIRE( "user" == basic_params->username );
+	REQUIRE( "password" == basic_params->password );
+
+	// The uncached version doesn't touch the cache.
+	const auto uncached_params = basic_auth::try_extract_params(
+			*req,
+			restinio::http_field::authorization );
+	REQUIRE( uncached_params );
+	REQUIRE( "user" == uncached_params->username );
+
+	const auto & parsed = try_parse_field_cached< authorization_value_t >(
+			*req,
+			"Authorization" );
+	// The value was cached by try_extract_params_cached().
+	REQUIRE( &parsed == &try_parse_field_cached< authorization_value_t >(
+			*req,
+			restinio::http_field::authorization ) );
+	const auto * auth = restinio::get_if< authorization_value_t >( &parsed );
+	REQUIRE( auth );
+	REQUIRE( "basic" == auth->auth_scheme );
+
+	const auto no_field = basic_auth::try_extract_params_cached(
+			*req,
+			"X-My-Authorization" );
+	REQUIRE( !no_field );
+	REQUIRE( basic_auth::extraction_error_t::no_auth_http_field ==
+			no_field.error() );
+}
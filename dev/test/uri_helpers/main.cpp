@@ -1188,3 +1188,101 @@ TEST_CASE( "Query string with only web-beacon" , "[web-beacon]" )
 	}
 }
 
+
+TEST_CASE( "Unescape long strings" , "[unescape][percent_encoding][long]" )
+{
+	// Escaped chars in all positions of a long string.
+	const std::string plain{
+			"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ" };
+
+	for( std::size_t pos = 0u; pos <= plain.size(); ++pos )
+	{
+		std::string input_data = plain;
+		input_data.insert( pos, "%D0%B0+-" );
+
+		std::string expected_result = plain;
+		expected_result.insert( pos, "\xD0\xB0 -" );
+
+		INFO( "pos: " << pos );
+		REQUIRE( expected_result ==
+				restinio::utils::unescape_percent_encoding( input_data ) );
+
+		std::string result = input_data;
+		result.resize( restinio::utils::inplace_unescape_percent_encoding(
+				&result[0], result.size() ) );
+		REQUIRE( expected_result == result );
+	}
+
+	// Invalid chars in all positions of a long string.
+	for( std::size_t pos = 0u; pos < plain.size(); ++pos )
+	{
+		for( const char ch : { '*', ' ', '\x80', '\xFF', '\0' } )
+		{
+			std::string input_data = plain;
+			input_data[ pos ] = ch;
+
+			INFO( "pos: " << pos << ", ch: " << static_cast<int>(ch) );
+			REQUIRE_FALSE( restinio::utils::try_unescape_percent_encoding(
+					input_data ) );
+		}
+	}
+
+	// Invalid escape sequence after a long run of plain chars.
+	REQUIRE_FALSE( restinio::utils::try_unescape_percent_encoding(
+			plain + "%G0" ) );
+
+	// A part of UTF-8 sequence followed by a long run of plain chars.
+	REQUIRE_FALSE( restinio::utils::try_unescape_percent_encoding(
+			"%D0" + plain ) );
+}
+
+TEST_CASE( "Index of query string parameters" , "[parse_query][index]" )
+{
+	const auto make_query = []( std::size_t count ) {
+		std::string result;
+		for( std::size_t i = 0u; i != count; ++i )
+		{
+			if( i )
+				result += '&';
+			result += fmt::format( "param{}=value{}", i, i );
+		}
+		return result;
+	};
+
+	{
+		const auto params = restinio::parse_query(
+				make_query( query_string_params_t::index_threshold - 1u ) );
+		REQUIRE_FALSE( params.has_index() );
+	}
+
+	for( const std::size_t count : { std::size_t{ 16u }, std::size_t{ 50u },
+			std::size_t{ 200u } } )
+	{
+		const auto query = make_query( count ) +
+				"&param1=duplicate&param%31=duplicate";
+		const auto params = restinio::parse_query( query );
+
+		REQUIRE( params.has_index() );
+		REQUIRE( count + 2u == params.size() );
+
+		for( std::size_t i = 0u; i != count; ++i )
+		{
+			const auto name = fmt::format( "param{}", i );
+			REQUIRE( params.has( name ) );
+			REQUIRE( fmt::format( "value{}", i ) == params[ name ] );
+		}
+
+		// The first occurrence is found.
+		REQUIRE( "value1" == params[ "param1" ] );
+
+		REQUIRE_FALSE( params.has( "param" ) );
+		REQUIRE_FALSE( params.has( fmt::format( "param{}", count ) ) );
+		REQUIRE_FALSE( params.get_param( "value1" ) );
+		REQUIRE_THROWS( params[ "unknown" ] );
+
+		// The index is still valid after moving.
+		auto original = restinio::parse_query( query );
+		const auto moved = std::move( original );
+		REQUIRE( "value0" == moved[ "param0" ] );
+	}
+}
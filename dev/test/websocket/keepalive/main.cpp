@@ -0,0 +1,182 @@
+/*
+	restinio
+*/
+
+/*!
+	Test automatic ping/pong keep-alive for websocket connections.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/websocket.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+#include <test/websocket/common/pub.hpp>
+
+namespace rws = restinio::websocket::basic;
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+const std::string upgrade_request{
+	"GET /chat HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"Upgrade: websocket\r\n"
+	"Connection: Upgrade\r\n"
+	"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+	"Sec-WebSocket-Version: 13\r\n"
+	"\r\n" };
+
+struct server_state_t
+{
+	std::mutex m_lock;
+	rws::ws_handle_t m_ws;
+	std::atomic< std::uint16_t > m_last_close_code{ 0 };
+};
+
+auto
+make_configurator( server_state_t & state )
+{
+	return [&state]( auto & settings ){
+		settings
+			.port( utest_default_port() )
+			.address( "127.0.0.1" )
+			.timer_manager( std::chrono::milliseconds( 50 ) )
+			.websocket_ping_interval( std::chrono::milliseconds( 200 ) )
+			.websocket_pong_timeout( std::chrono::milliseconds( 300 ) )
+			.request_handler(
+				[&state]( auto req ){
+					if( restinio::http_connection_header_t::upgrade ==
+						req->header().connection() )
+					{
+						auto ws = rws::upgrade< traits_t >(
+							*req,
+							rws::activation_t::immediate,
+							[&state]( rws::ws_handle_t, rws::message_handle_t m ){
+								if( rws::opcode_t::connection_close_frame ==
+									m->opcode() )
+								{
+									state.m_last_close_code =
+										static_cast< std::uint16_t >(
+											rws::status_code_from_bin(
+												m->payload() ) );
+
+									std::lock_guard< std::mutex > l{ state.m_lock };
+									state.m_ws.reset();
+								}
+							} );
+
+						std::lock_guard< std::mutex > l{ state.m_lock };
+						state.m_ws = std::move( ws );
+
+						return restinio::request_accepted();
+					}
+
+					return restinio::request_rejected();
+				} );
+	};
+}
+
+template< typename Socket >
+void
+do_upgrade( Socket & socket, restinio::asio_ns::streambuf & input )
+{
+	restinio::asio_ns::write(
+		socket, restinio::asio_ns::buffer( upgrade_request ) );
+
+	const auto header_size = restinio::asio_ns::read_until(
+		socket, input, "\r\n\r\n" );
+
+	std::string response(
+		restinio::asio_ns::buffers_begin( input.data() ),
+		restinio::asio_ns::buffers_begin( input.data() ) + header_size );
+	input.consume( header_size );
+
+	REQUIRE_THAT( response,
+		Catch::StartsWith( "HTTP/1.1 101 Switching Protocols" ) );
+}
+
+template< typename Socket >
+std::string
+read_frame_header( Socket & socket, restinio::asio_ns::streambuf & input )
+{
+	if( input.size() < 2u )
+		restinio::asio_ns::read( socket, input,
+			restinio::asio_ns::transfer_exactly( 2u - input.size() ) );
+
+	std::string result(
+		restinio::asio_ns::buffers_begin( input.data() ),
+		restinio::asio_ns::buffers_begin( input.data() ) + 2 );
+	input.consume( 2u );
+
+	return result;
+}
+
+TEST_CASE( "Ping is sent to silent peer" , "[websocket][keepalive]" )
+{
+	server_state_t state;
+	http_server_t http_server{
+		restinio::own_io_context(),
+		make_configurator( state ) };
+
+	other_work_thread_for_server_t< http_server_t > other_thread{ http_server };
+	other_thread.run();
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ){
+		restinio::asio_ns::streambuf input;
+		do_upgrade( socket, input );
+
+		const auto ping_frame = to_char_each( { 0x89, 0x00 } );
+
+		REQUIRE( ping_frame == read_frame_header( socket, input ) );
+
+		// Masked pong frame with empty payload.
+		const auto pong_frame = to_char_each(
+			{ 0x8A, 0x80, 0x01, 0x02, 0x03, 0x04 } );
+		restinio::asio_ns::write(
+			socket, restinio::asio_ns::buffer( pong_frame ) );
+
+		// The peer has answered so the connection is still alive
+		// and the next ping should arrive.
+		REQUIRE( ping_frame == read_frame_header( socket, input ) );
+	} );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Silent peer is disconnected" , "[websocket][keepalive]" )
+{
+	server_state_t state;
+	http_server_t http_server{
+		restinio::own_io_context(),
+		make_configurator( state ) };
+
+	other_work_thread_for_server_t< http_server_t > other_thread{ http_server };
+	other_thread.run();
+
+	do_with_socket( [&]( auto & socket, auto & /*io_context*/ ){
+		restinio::asio_ns::streambuf input;
+		do_upgrade( socket, input );
+
+		REQUIRE( to_char_each( { 0x89, 0x00 } ) ==
+				read_frame_header( socket, input ) );
+
+		// Do not answer and wait for the connection to be closed.
+		restinio::asio_ns::error_code ec;
+		restinio::asio_ns::read( socket, input,
+			restinio::asio_ns::transfer_at_least( 1 ), ec );
+
+		REQUIRE( restinio::error_is_eof( ec ) );
+	} );
+
+	other_thread.stop_and_join();
+
+	REQUIRE( static_cast< std::uint16_t >( rws::status_code_t::connection_lost ) ==
+			state.m_last_close_code );
+}